@@ -0,0 +1,246 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * CameraModel.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INCLUDE_CAMERAMODEL_H_
+#define INCLUDE_CAMERAMODEL_H_
+
+#include <cmath>
+
+// Distortion models of the cameras as compile time policies. The model is
+// resolved once per set of points, so the per point math can be inlined.
+// The models work on blocks of LANES points stored as structure of arrays,
+// every lane runs the same instructions so the loops are vectorized.
+namespace camera_model {
+
+enum {
+    LANES = 16
+};
+
+template<typename T>
+struct UndistortionReport {
+    int iteration_limit;  // number of points where the radius inversion did not converge
+    int negative_radius;  // number of points with a negative undistorted radius
+    T rd_sq;              // radii of the last point with a negative undistorted radius
+    T ru_sq;
+
+    UndistortionReport() :
+                    iteration_limit(0),
+                    negative_radius(0),
+                    rd_sq(0),
+                    ru_sq(0) {
+    }
+};
+
+// Radial distortion with three coefficients. The undistorted radius is found
+// with a Newton iteration on the squared radius. All lanes iterate together,
+// converged lanes are masked until every lane has converged.
+template<typename T>
+class PlumbBob {
+    T fx_, fy_, cx_, cy_;
+    T k1_, k2_, k3_;
+
+public:
+    enum {
+        MAX_ITERATIONS = 100
+    };
+
+    PlumbBob(const T focal_length[2], const T principal_point[2], const T radial_distortion[3]) :
+                    fx_(focal_length[0]),
+                    fy_(focal_length[1]),
+                    cx_(principal_point[0]),
+                    cy_(principal_point[1]),
+                    k1_(radial_distortion[0]),
+                    k2_(radial_distortion[1]),
+                    k3_(radial_distortion[2]) {
+    }
+
+    T cx() const {
+        return cx_;
+    }
+
+    T cy() const {
+        return cy_;
+    }
+
+    inline T poly(T r_sq) const {
+        return 1 + k1_ * r_sq + k2_ * r_sq * r_sq + k3_ * r_sq * r_sq * r_sq;
+    }
+
+    // undistort the first num_points lanes of x and y in place, the remaining lanes are padding
+    inline void undistortLanes(T x[LANES], T y[LANES], int num_points, UndistortionReport<T> &report) const {
+        const T thresh = T(1e-6);
+        T x_n[LANES], y_n[LANES], rd_sq[LANES], ru_sq[LANES];
+        T active[LANES];  // 1 while the lane has not converged, kept in T so the lanes have one width
+
+        for (int i = 0; i < LANES; i++) {
+            x_n[i] = (x[i] - cx_) / fx_;
+            y_n[i] = (y[i] - cy_) / fy_;
+            rd_sq[i] = x_n[i] * x_n[i] + y_n[i] * y_n[i];
+            ru_sq[i] = rd_sq[i];
+            active[i] = 1;
+        }
+
+        T num_active = LANES;
+        for (int it = 0; it < MAX_ITERATIONS && num_active > 0; it++) {
+            num_active = 0;
+            for (int i = 0; i < LANES; i++) {
+                T r = ru_sq[i];
+                T p = poly(r);
+                T diff = (r * p * p - rd_sq[i]) / (p * p + 2 * r * p * p * (k1_ + 2 * k2_ * r + 2 * k3_ * r * r));
+                ru_sq[i] = active[i] > 0 ? r - diff : r;
+                active[i] = diff < thresh && diff > -thresh ? 0 : active[i];
+                num_active += active[i];
+            }
+        }
+
+        for (int i = 0; i < LANES; i++) {
+            T coeff = poly(ru_sq[i]);
+            x[i] = x_n[i] / coeff * fx_ + cx_;
+            y[i] = y_n[i] / coeff * fy_ + cy_;
+        }
+
+        for (int i = 0; i < num_points; i++) {
+            if (active[i] > 0)
+                report.iteration_limit++;
+            if (ru_sq[i] < 0) {
+                report.negative_radius++;
+                report.rd_sq = rd_sq[i];
+                report.ru_sq = ru_sq[i];
+            }
+        }
+    }
+};
+
+// FOV (atan) model. The undistorted radius is the least squares fit of
+// tan(r_d * w) = r_u * 2 * tan(w / 2) over the non-zero coefficients w.
+template<typename T>
+class Atan {
+    T fx_, fy_, cx_, cy_;
+    T w_[3];
+    T a_[3];  // 2 * tan(w / 2) / sum((2 * tan(w / 2))^2)
+    int num_w_;
+
+public:
+    Atan(const T focal_length[2], const T principal_point[2], const T radial_distortion[3]) :
+                    fx_(focal_length[0]),
+                    fy_(focal_length[1]),
+                    cx_(principal_point[0]),
+                    cy_(principal_point[1]),
+                    num_w_(0) {
+        T a_sq = 0;
+        for (int i = 0; i < 3; i++) {
+            T a = 2 * std::tan(radial_distortion[i] / 2);
+            if (a == 0)
+                continue;
+            w_[num_w_] = radial_distortion[i];
+            a_[num_w_] = a;
+            a_sq += a * a;
+            num_w_++;
+        }
+        for (int i = 0; i < num_w_; i++)
+            a_[i] /= a_sq;
+    }
+
+    T cx() const {
+        return cx_;
+    }
+
+    T cy() const {
+        return cy_;
+    }
+
+    // Undistort all lanes of x and y in place. The inverse of the atan model is
+    // closed form, so there is no iteration that could fail to converge and
+    // nothing is reported. The number of points and the report are unused.
+    inline void undistortLanes(T x[LANES], T y[LANES], int, UndistortionReport<T> &) const {
+        T x_n[LANES], y_n[LANES], r_d[LANES], r_u[LANES];
+
+        for (int i = 0; i < LANES; i++) {
+            x_n[i] = (x[i] - cx_) / fx_;
+            y_n[i] = (y[i] - cy_) / fy_;
+            r_d[i] = std::sqrt(x_n[i] * x_n[i] + y_n[i] * y_n[i]);
+            r_u[i] = 0;
+        }
+
+        for (int k = 0; k < num_w_; k++)
+            for (int i = 0; i < LANES; i++)
+                r_u[i] += a_[k] * std::tan(r_d[i] * w_[k]);
+
+        for (int i = 0; i < LANES; i++) {
+            bool distorted = r_d[i] > T(0.001);
+            T s = distorted ? r_u[i] / r_d[i] : T(1);
+            x[i] = distorted ? x_n[i] * s * fx_ + cx_ : x[i];
+            y[i] = distorted ? y_n[i] * s * fy_ + cy_ : y[i];
+        }
+    }
+};
+
+// Undistort num_points interleaved pixel coordinates with the given model.
+// The points are processed in blocks of LANES, a partial block is padded
+// with the principal point, which is a fixed point of every model.
+template<class Model, typename T>
+inline void undistortPoints(const Model &model, const T *pt_d, int num_points, T *pt_u, UndistortionReport<T> &report) {
+    T x[LANES], y[LANES];
+
+    for (int block = 0; block < num_points; block += LANES) {
+        int n = num_points - block < LANES ? num_points - block : LANES;
+        const T *d = pt_d + 2 * block;
+
+        for (int i = 0; i < n; i++) {
+            x[i] = d[2 * i];
+            y[i] = d[2 * i + 1];
+        }
+        for (int i = n; i < LANES; i++) {
+            x[i] = model.cx();
+            y[i] = model.cy();
+        }
+
+        model.undistortLanes(x, y, n, report);
+
+        T *u = pt_u + 2 * block;
+        for (int i = 0; i < n; i++) {
+            u[2 * i] = x[i];
+            u[2 * i + 1] = y[i];
+        }
+    }
+}
+
+}  // namespace camera_model
+
+#endif /* INCLUDE_CAMERAMODEL_H_ */
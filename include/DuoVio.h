@@ -59,6 +59,9 @@
 
 #include <opencv2/opencv.hpp>
 #include <boost/circular_buffer.hpp>
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
 
 #include <vector>
 #include <string>
@@ -70,6 +73,7 @@
 #include "VIO.h"
 #include "dynamic_reconfigure/server.h"
 #include "duo_vio/duo_vioConfig.h"
+#include "duo_vio/VioTelemetry.h"
 
 #include "ait_ros_messages/vio_vis.h"
 #include "ait_ros_messages/VioSensorMsg.h"
@@ -83,12 +87,101 @@
 
 #include "InterfaceStructs.h"
 #include "IMULowpass.h"
+#include "ImageCorrection.h"
+#include "TimeShiftEstimator.h"
+#include "UndistortionMap.h"
 
 #include "Precision.h"
 
+// A VIO sensor message on its way through the pipelined node. The intake
+// fills in the timing and flags, the tracking thread the measurements.
+struct PipelineFrame {
+    ait_ros_messages::VioSensorMsgConstPtr msg;
+    ros::Time tic_total;
+    double dt;
+    bool vision;  // whether the frame is used for an update or only to predict
+    bool update_vis;
+    bool show_image;
+    bool reset;
+    std::vector<int> update_vec;
+    std::vector<int> generation;  // generation of the feature in each slot, see DuoVio::tracker_generation
+    std::vector<FloatType> z_all_l;
+    std::vector<FloatType> z_all_r;
+};
+
+// Counts the frames pushed to a pipeline queue, so the thread that pops them
+// can sleep until there is one. post() is also used to wake the thread on stop.
+class PipelineSemaphore {
+ public:
+    PipelineSemaphore() :
+                    count_(0) {
+    }
+    void post() {
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            count_++;
+        }
+        cond_.notify_one();
+    }
+    void wait() {
+        boost::unique_lock<boost::mutex> lock(mutex_);
+        while (!count_)
+            cond_.wait(lock);
+        count_--;
+    }
+
+ private:
+    boost::mutex mutex_;
+    boost::condition_variable cond_;
+    int count_;
+};
+
+// The estimate of one update for the visualization. The filter copies it into
+// a mailbox, the message is built and published on a background thread.
+struct VisSnapshot {
+    RobotState robot_state;
+    AnchorPose anchor_poses[matlab_consts::numAnchors];
+    FloatType map[matlab_consts::numTrackFeatures * 3];
+    int update_vec[matlab_consts::numTrackFeatures];
+    FloatType z_l[matlab_consts::numTrackFeatures * 2];
+    ait_ros_messages::VioSensorMsgConstPtr sensor_msg;  // only set if the image is shown
+};
+
+// An IMU sample as received, kept so the prediction can be split at the
+// image time and repeated.
+struct IMUSample {
+    ros::Time stamp;
+    double fallback_dt;  // used if the time stamps do not give a valid time difference
+    VIOMeasurements meas;  // not low-pass filtered
+};
+
+// A record of the binary telemetry file, written as laid out in memory by the
+// build that wrote it.
+struct TelemetryRecord {
+    double stamp;  // image time of the update
+    double duration_SLAM;
+    VIOTelemetry telemetry;
+};
+
+// The inputs of one sensor message and the state the filter was in before it.
+// Late IMU samples are merged into the frames of their time, and the filter
+// is run again from the checkpoint of the first frame that changed.
+struct HistoryFrame {
+    ros::Time start;  // stamp of the last IMU sample integrated before the frame
+    std::vector<unsigned char> checkpoint;
+    IMULowpass imulp;
+    std::vector<IMUSample> imu;
+    ros::Time image_stamp;  // time the state was predicted to for the update, zero without image
+    bool vision;
+    std::vector<int> update_vec;  // tracker output the update was run with
+    std::vector<FloatType> z_all_l;
+    std::vector<FloatType> z_all_r;
+};
+
 class DuoVio {
  public:
-    DuoVio();
+    // standalone is false in the nodelet, which shares the process of the camera driver
+    DuoVio(const ros::NodeHandle &nh = ros::NodeHandle("~"), bool standalone = true);
     ~DuoVio();
 
  private:
@@ -97,9 +190,36 @@ class DuoVio {
     // Visualization topics
     ros::Publisher vio_vis_pub;
     ros::Publisher vio_vis_reset_pub;
+    ros::Timer vis_reset_timer;  // resets the visualizer once it had time to connect
+    void visResetTimerCb(const ros::TimerEvent &event);
+
+    // Background visualization. A complete message is sent every VIS_FULL_INTERVAL
+    // messages, after a reset and when the visualizer asks for one. In between,
+    // the map points are only sent if they moved or changed their status since
+    // the last complete message, the anchors only if one of them moved. As every
+    // delta is relative to the complete message, a dropped delta loses nothing.
+    boost::thread vis_thread;
+    boost::mutex vis_mutex;
+    boost::condition_variable vis_cond;
+    bool vis_running;  // guarded by vis_mutex
+    bool vis_pending;  // guarded by vis_mutex
+    VisSnapshot vis_snapshot_pending;  // guarded by vis_mutex
+    VisSnapshot vis_snapshot;  // only used by the visualization thread
+    ait_ros_messages::vio_vis vis_msg;  // reused for every message
+    FloatType vis_sent_map[matlab_consts::numTrackFeatures * 3];  // as of the last complete message
+    int vis_sent_status[matlab_consts::numTrackFeatures];
+    AnchorPose vis_sent_anchors[matlab_consts::numAnchors];
+    int vis_msg_cnt;
+    int vis_full_msg_cnt;  // vis_msg_cnt of the last complete message
+    boost::atomic<bool> vis_full;  // send the next message complete
+    ros::Subscriber vis_request_full_sub;
+    void visRequestFullCb(const std_msgs::Empty &msg);
 
     int vis_publish_delay;
     bool SLAM_reset_flag;
+    ros::Time reset_stamp;  // sensor messages older than this were queued before the reset
+    bool warm_reset;  // keep the IMU biases and the camera-IMU extrinsics on reset
+    bool has_estimate;  // the filter has been updated since the start
     int display_tracks_cnt;
     int max_clicks_;
     int clear_queue_counter;
@@ -113,13 +233,26 @@ class DuoVio {
     ros::NodeHandle nh_;
     IMULowpass imulp_;
 
-    cv::Mat darkCurrentL, darkCurrentR;
+    ImageCorrection imageCorrectionL, imageCorrectionR;
+    // The tracker may keep a shallow reference to the images of the previous frame
+    // for the optical flow. The corrected images alternate between two buffers, and
+    // the message of the last tracked frame is held until the next one is tracked.
+    cv::Mat correctedL[2], correctedR[2];
+    int corrected_idx;  // buffer of the next corrected images
+    ait_ros_messages::VioSensorMsgConstPtr tracked_msg;
     bool use_dark_current;
 
+    UndistortionMap undistortionMapL, undistortionMapR;
+    bool use_undistortion_map;
+    int undistortion_map_step;
+
     ros::Subscriber vio_sensor_sub;
     ros::Subscriber device_serial_nr_sub;
     std::string device_serial_nr;
     bool got_device_serial_nr;
+    bool standalone;  // exit on a bad calibration, otherwise only stop processing
+    bool calibration_failed;
+    void calibrationFailed();
     bool auto_subsample;  // if true, predict with messages without image data, otherwise update
 
     ros::Publisher vio_sensor_processed_pub;
@@ -127,9 +260,12 @@ class DuoVio {
 
     ros::Publisher pose_pub;
     ros::Publisher vel_pub;
+    ros::Publisher imu_pose_pub;  // IMU propagated state between the vision updates
+    ros::Publisher imu_vel_pub;
     ros::Publisher timing_SLAM_pub;
     ros::Publisher timing_feature_tracking_pub;
     ros::Publisher timing_total_pub;
+    ros::Publisher timing_preprocessing_pub;
     ros::Publisher vis_pub_;
     ros::Publisher smoothed_imu_pub;  // debug
 
@@ -139,6 +275,18 @@ class DuoVio {
     tf::Quaternion cam2body;
 
     ros::Time prev_time_;
+    ros::Time prev_imu_stamp_;  // stamp of the last integrated IMU sample
+    RobotState predicted_state_;  // state of the last prediction
+    std::vector<IMUSample> imu_samples_;  // samples of the current message if it is not recorded in the history
+    TimeShiftEstimator time_shift_estimator;
+    bool estimate_time_shift;
+    ros::Publisher time_shift_pub;
+    VIOTelemetry telemetry_;  // of the last update
+    ros::Publisher telemetry_pub;
+    FILE *telemetry_file;  // binary TelemetryRecords, NULL if not written
+    boost::circular_buffer<HistoryFrame> history;  // the last history_size frames, empty in pipelined mode
+    double history_max_reintegration_time;  // late messages that would take longer to re-integrate are dropped [s]
+    double filter_frame_time;  // running average of the filter time of a frame, to predict the re-integration time [s]
     std::vector<int> update_vec_;
     geometry_msgs::Pose pose;
 
@@ -155,16 +303,62 @@ class DuoVio {
     std::vector<FloatType> h_u_apo;
     std::vector<FloatType> map;
     std::vector<AnchorPose> anchor_poses;
-
-    void vioSensorMsgCb(const ait_ros_messages::VioSensorMsg &msg);
+    std::vector<FloatType> delayed_status;
+
+    // Pipelined mode: feature tracking and the filter run on their own threads
+    // and hand the frames over in bounded single producer single consumer queues.
+    // The filter may reject features of frame N while the tracker already works on
+    // frame N+1. Every slot counts the features the tracker put into it, the filter
+    // marks the rejected ones, so they are dropped from the frames in flight.
+    // The PIPELINE_QUEUE_SIZE frames are allocated once and return to the intake
+    // through free_queue. Every queue has a semaphore its consumer sleeps on.
+    enum {
+        PIPELINE_QUEUE_SIZE = 4
+    };
+    bool pipelined;
+    boost::atomic<bool> pipeline_running;
+    boost::lockfree::spsc_queue<PipelineFrame*, boost::lockfree::capacity<PIPELINE_QUEUE_SIZE> > free_queue;  // filter thread to intake
+    boost::lockfree::spsc_queue<PipelineFrame*, boost::lockfree::capacity<PIPELINE_QUEUE_SIZE> > tracking_queue;
+    boost::lockfree::spsc_queue<PipelineFrame*, boost::lockfree::capacity<PIPELINE_QUEUE_SIZE> > filter_queue;
+    PipelineSemaphore free_sem, tracking_sem, filter_sem;
+    boost::thread tracking_thread;
+    boost::thread filter_thread;
+    std::vector<int> tracker_update_vec;  // status of the last tracked frame, only used by the tracking thread
+    std::vector<int> tracker_generation;
+    boost::atomic<int> killed_generation[matlab_consts::numTrackFeatures];  // generation of the last feature the filter rejected in each slot
+
+    void trackingThread();
+    void filterThread();
+    void stopPipeline();
+
+    void vioSensorMsgCb(const ait_ros_messages::VioSensorMsgConstPtr &msg);
     void deviceSerialNrCb(const std_msgs::String &msg);
     void loadCustomCameraCalibration(const std::string calib_path);
-    void update(double dt, const ait_ros_messages::VioSensorMsg &msg, bool debug_publish, bool show_image, bool reset);
+    void loadUndistortionMaps(const std::string &calib_dir, int width, int height);
+    void update(double dt, const ait_ros_messages::VioSensorMsgConstPtr &msg_ptr, bool debug_publish, bool show_image, bool reset);
+    int predict(double dt, const ait_ros_messages::VioSensorMsg &msg, bool reset, std::vector<IMUSample> &imu_samples, const ros::Time &image_stamp);
+    int integrateIMU(const std::vector<IMUSample> &samples, int next, const ros::Time &until, bool publish_imu_pose);
+    ros::Time imageStamp(const ait_ros_messages::VioSensorMsg &msg);
+    void estimateTimeShift(const ros::Time &image_stamp, const std::vector<int> &update_vec, const std::vector<FloatType> &z_all_l);
+    double imuDt(const ros::Time &stamp, double fallback_dt);
+    HistoryFrame &recordHistoryFrame();
+    bool reintegrateLate(const ait_ros_messages::VioSensorMsg &msg);
+    void publishIMUPose(const RobotState &state, const ros::Time &stamp);
+    bool trackFrame(const ait_ros_messages::VioSensorMsgConstPtr &msg, std::vector<int> &update_vec, std::vector<FloatType> &z_all_l, std::vector<FloatType> &z_all_r,
+            double &duration);
+    int filterOutputs(bool update_vis) const;
+    void updateFilter(std::vector<int> &update_vec, std::vector<FloatType> &z_all_l, std::vector<FloatType> &z_all_r, bool update_vis);
+    void publishTelemetry(const ros::Time &image_stamp, double duration_SLAM);
+    void publishVis(const ait_ros_messages::VioSensorMsgConstPtr &msg, std::vector<int> &update_vec, std::vector<FloatType> &z_all_l, bool update_vis,
+            bool show_image);
 
     void getIMUData(const sensor_msgs::Imu& imu, VIOMeasurements& meas);
 
     void updateVis(RobotState &robot_state, std::vector<AnchorPose> &anchor_poses, std::vector<FloatType> &map, std::vector<int> &updateVect,
-            const ait_ros_messages::VioSensorMsg &msg, std::vector<FloatType> &z_l, bool show_image);
+            const ait_ros_messages::VioSensorMsgConstPtr &msg, std::vector<FloatType> &z_l, bool show_image);
+    void visThread();
+    void publishVisMsg(const VisSnapshot &snapshot, bool full);
+    void stopVis();
 
     tf::Quaternion camera2world;  // the rotation that transforms a vector in the camera frame to one in the world frame
 
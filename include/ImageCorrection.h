@@ -0,0 +1,78 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * ImageCorrection.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INCLUDE_IMAGECORRECTION_H_
+#define INCLUDE_IMAGECORRECTION_H_
+
+#include <string>
+
+#include <opencv2/core/core.hpp>
+
+// Per pixel correction of the images of one camera. The dark current is
+// subtracted with saturation and, if a flat field image was recorded, the
+// result is scaled with a per pixel gain that removes the vignetting. The
+// gains are precomputed in fixed point, so the correction runs in 8 and 16
+// bit SIMD lanes.
+class ImageCorrection {
+    cv::Mat dark_;  // CV_8UC1 dark current
+    cv::Mat gain_;  // CV_16UC1 gain * 2^GAIN_SHIFT, empty without flat field
+
+public:
+    enum {
+        GAIN_SHIFT = 8,
+        MAX_GAIN = 32767  // keeps the scaled pixels in the positive range of int16
+    };
+
+    ImageCorrection();
+    bool loadDarkCurrent(const std::string &path, int width, int height);
+    bool loadFlatField(const std::string &path);
+    void clearGain();
+    bool empty() const;
+    bool hasGain() const;
+    cv::Size size() const;
+    void correctRows(const cv::Mat &in, cv::Mat &out, int row_begin, int row_end) const;  // out must be allocated
+    void correct(const cv::Mat &in, cv::Mat &out) const;
+};
+
+// Correct the images of both cameras. The rows of both images are split
+// over the OpenCV thread pool. out may be the same image as in.
+void correctStereo(const ImageCorrection &correction_l, const cv::Mat &in_l, cv::Mat &out_l, const ImageCorrection &correction_r, const cv::Mat &in_r,
+        cv::Mat &out_r);
+
+#endif /* INCLUDE_IMAGECORRECTION_H_ */
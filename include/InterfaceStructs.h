@@ -58,6 +58,11 @@ struct VIOParameters
 	bool mono;
 	bool RANSAC;
 	bool full_stereo;
+	enum {TRIANGULATION_MIDPOINT = 0, TRIANGULATION_QR = 1};
+	int triangulation_method;
+	FloatType jacobian_reuse_thresh;
+	enum {ANCHOR_METRIC_SPECTRAL = 0, ANCHOR_METRIC_TRACE = 1, ANCHOR_METRIC_FROBENIUS = 2, ANCHOR_METRIC_POWER = 3};
+	int origin_anchor_metric;
 };
 
 // ProcessNoise
@@ -118,6 +123,35 @@ struct AnchorPose
 	FloatType att[4];
 };
 
+// VIOTelemetry
+// =========================================================
+struct VIOTelemetry // workload and health of the last vision update
+{
+	int ransac_hypotheses;      // 1-point RANSAC hypotheses evaluated
+	int li_inliers;             // low innovation inliers used for the LI update, 0 if there were too few
+	int hi_inliers;             // high innovation inliers that passed the last EKF iteration
+	int ekf_iterations;         // iterations of the HI update
+	int active_features;        // features with an active depth estimate after the update
+	int delayed_features;       // features with a delayed depth estimate after the update
+	int new_features;           // features inserted into the map
+	int anchor_initializations; // anchors (re-)initialized
+	int origin_anchor_switch;   // 1 if a new origin anchor was chosen
+	FloatType innovation_norm;  // norm of the HI residual of the last EKF iteration
+	FloatType robot_cov_trace;  // trace of the robot state block of the covariance
+};
+
+// SLAMOutputs
+// =========================================================
+enum SLAMOutputs // outputs SLAM() computes, the other output arguments are left as they are
+{
+	SLAM_OUTPUT_NONE = 0,
+	SLAM_OUTPUT_ROBOT_STATE = 1,
+	SLAM_OUTPUT_MAP = 2,
+	SLAM_OUTPUT_ANCHOR_POSES = 4,
+	SLAM_OUTPUT_DELAYED_STATUS = 8,
+	SLAM_OUTPUT_ALL = 15
+};
+
 // ReferenceCommand
 // =========================================================
 struct ReferenceCommand
@@ -0,0 +1,232 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * SmallMatrix.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INCLUDE_SMALLMATRIX_H_
+#define INCLUDE_SMALLMATRIX_H_
+
+#include <cmath>
+#include <limits>
+
+// Fixed size kernels for the small matrices of the filter. The dimensions are
+// template arguments, so every loop has a constant trip count and is unrolled
+// by the compiler. All matrices are column major like the generated code.
+namespace small_matrix {
+
+// Quaternion product in JPL convention, without normalization. The terms are
+// summed in the same order as the matrix product in quatmultJ.
+template<typename T>
+inline void quatMult(const T q[4], const T p[4], T qp[4]) {
+    qp[0] = p[3] * q[0] - p[2] * q[1] + p[1] * q[2] + p[0] * q[3];
+    qp[1] = p[2] * q[0] + p[3] * q[1] - p[0] * q[2] + p[1] * q[3];
+    qp[2] = -p[1] * q[0] + p[0] * q[1] + p[3] * q[2] + p[2] * q[3];
+    qp[3] = -p[0] * q[0] - p[1] * q[1] - p[2] * q[2] + p[3] * q[3];
+}
+
+// Rotation matrix of a JPL quaternion, RotFromQuatJ of the filter.
+template<typename T>
+inline void rotFromQuat(const T q[4], T R[9]) {
+    R[0] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+    R[3] = 2 * (q[0] * q[1] + q[2] * q[3]);
+    R[6] = 2 * (q[0] * q[2] - q[1] * q[3]);
+    R[1] = 2 * (q[0] * q[1] - q[2] * q[3]);
+    R[4] = -q[0] * q[0] + q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+    R[7] = 2 * (q[1] * q[2] + q[0] * q[3]);
+    R[2] = 2 * (q[0] * q[2] + q[1] * q[3]);
+    R[5] = 2 * (q[1] * q[2] - q[0] * q[3]);
+    R[8] = -q[0] * q[0] - q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+}
+
+// r' * inv(S) * r of a symmetric positive definite N x N matrix S, through
+// its Cholesky factor. Returns infinity if S is not positive definite.
+template<int N, typename T>
+inline T mahalanobis(const T S[N * N], const T r[N]) {
+    T L[N * N];
+    T y[N];
+
+    for (int j = 0; j < N; j++) {
+        T d = S[j + N * j];
+        for (int k = 0; k < j; k++)
+            d -= L[j + N * k] * L[j + N * k];
+        if (!(d > 0))
+            return std::numeric_limits<T>::infinity();
+        d = std::sqrt(d);
+        L[j + N * j] = d;
+        for (int i = j + 1; i < N; i++) {
+            T s = S[i + N * j];
+            for (int k = 0; k < j; k++)
+                s -= L[i + N * k] * L[j + N * k];
+            L[i + N * j] = s / d;
+        }
+    }
+
+    T innov = 0;
+    for (int i = 0; i < N; i++) {
+        T s = r[i];
+        for (int k = 0; k < i; k++)
+            s -= L[i + N * k] * y[k];
+        y[i] = s / L[i + N * i];
+        innov += y[i] * y[i];
+    }
+    return innov;
+}
+
+// closed form inverse for the mono residuals
+template<>
+inline float mahalanobis<2, float>(const float S[4], const float r[2]) {
+    float det = S[0] * S[3] - S[1] * S[1];
+    if (!(S[0] > 0) || !(det > 0))
+        return std::numeric_limits<float>::infinity();
+    return (r[0] * r[0] * S[3] - 2 * r[0] * r[1] * S[1] + r[1] * r[1] * S[0]) / det;
+}
+
+template<>
+inline double mahalanobis<2, double>(const double S[4], const double r[2]) {
+    double det = S[0] * S[3] - S[1] * S[1];
+    if (!(S[0] > 0) || !(det > 0))
+        return std::numeric_limits<double>::infinity();
+    return (r[0] * r[0] * S[3] - 2 * r[0] * r[1] * S[1] + r[1] * r[1] * S[0]) / det;
+}
+
+// Number of error states a feature measurement depends on: robot position
+// and attitude, anchor position and attitude, and the inverse depth.
+enum {
+    FEATURE_STATES = 13
+};
+
+// Squared Mahalanobis distance of the residual r of one feature with N rows.
+// H points to the first of its rows in the measurement Jacobian with leading
+// dimension ldH, cols holds the error states the feature depends on and P is
+// the error state covariance with leading dimension ldP. The innovation
+// covariance is H_f * P_f * H_f' + noise * I on the FEATURE_STATES columns.
+template<int N, typename T>
+inline T featureMahalanobis(const T *H, int ldH, const T *P, int ldP, const int cols[FEATURE_STATES], T noise, const T r[N]) {
+    T H_f[N * FEATURE_STATES];
+    T HP[N * FEATURE_STATES];
+    T S[N * N];
+
+    for (int j = 0; j < FEATURE_STATES; j++)
+        for (int i = 0; i < N; i++)
+            H_f[i + N * j] = H[i + ldH * cols[j]];
+
+    for (int j = 0; j < FEATURE_STATES; j++) {
+        const T *P_j = P + ldP * cols[j];
+        for (int i = 0; i < N; i++)
+            HP[i + N * j] = 0;
+        for (int l = 0; l < FEATURE_STATES; l++) {
+            T p = P_j[cols[l]];
+            for (int i = 0; i < N; i++)
+                HP[i + N * j] += H_f[i + N * l] * p;
+        }
+    }
+
+    for (int j = 0; j < N; j++) {
+        for (int i = j; i < N; i++) {
+            T s = 0;
+            for (int l = 0; l < FEATURE_STATES; l++)
+                s += HP[i + N * l] * H_f[j + N * l];
+            S[i + N * j] = s;
+            S[j + N * i] = s;
+        }
+        S[j + N * j] += noise;
+    }
+
+    return mahalanobis<N>(S, r);
+}
+
+// Scalar uncertainty measures of a symmetric positive semi-definite N x N
+// block, cheaper alternatives to its spectral norm.
+template<int N, typename T>
+inline T trace(const T S[N * N]) {
+    T s = 0;
+    for (int i = 0; i < N; i++)
+        s += S[i + N * i];
+    return s;
+}
+
+template<int N, typename T>
+inline T frobeniusNorm(const T S[N * N]) {
+    T s = 0;
+    for (int i = 0; i < N * N; i++)
+        s += S[i] * S[i];
+    return std::sqrt(s);
+}
+
+// Largest eigenvalue of S by power iteration, returned as the Rayleigh
+// quotient of the last iterate. This approaches the spectral norm from below.
+// The iteration starts from the diagonal of S, which for a covariance block
+// is already close to the dominant direction.
+template<int N, typename T>
+inline T spectralNormPower(const T S[N * N], int iterations) {
+    T v[N];
+    T w[N];
+
+    for (int i = 0; i < N; i++)
+        v[i] = S[i + N * i];
+
+    T lambda = 0;
+    for (int it = 0; it <= iterations; it++) {
+        T vv = 0;
+        T vw = 0;
+        for (int i = 0; i < N; i++) {
+            T s = 0;
+            for (int j = 0; j < N; j++)
+                s += S[i + N * j] * v[j];
+            w[i] = s;
+            vv += v[i] * v[i];
+            vw += v[i] * s;
+        }
+        if (!(vv > 0))
+            return vv == 0 ? T(0) : vv;  // zero block or NaN
+        lambda = vw / vv;
+
+        T ww = 0;
+        for (int i = 0; i < N; i++)
+            ww += w[i] * w[i];
+        if (!(ww > 0))
+            break;
+        T scale = 1 / std::sqrt(ww);
+        for (int i = 0; i < N; i++)
+            v[i] = w[i] * scale;
+    }
+    return lambda;
+}
+
+}  // namespace small_matrix
+
+#endif /* INCLUDE_SMALLMATRIX_H_ */
@@ -0,0 +1,164 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * SortingNetwork.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INCLUDE_SORTINGNETWORK_H_
+#define INCLUDE_SORTINGNETWORK_H_
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+// Sorting and selection on the short vectors of the filter, at most one entry
+// per tracked feature. Everything works on stack arrays: the sorts are
+// Batcher odd-even merge networks whose compare-exchanges are selects instead
+// of branches. The order is the one of the generated sort: ascending, NaN last
+// and ties in their original order, with 1-based indices.
+namespace sorting_network {
+
+// largest n the run time sized functions accept
+enum {
+    MAX_SIZE = 64
+};
+
+// strict order on (value, index): NaN after all numbers, ties by index
+template<typename T>
+inline bool before(T a, int ia, T b, int ib) {
+    bool a_nan = a != a;
+    bool b_nan = b != b;
+    return (a < b) | ((a_nan == b_nan) & !(b < a) & (ia < ib)) | (!a_nan & b_nan);
+}
+
+template<typename T>
+inline void compareExchange(T x[], int idx[], int i, int j) {
+    T xi = x[i];
+    T xj = x[j];
+    int ii = idx[i];
+    int ij = idx[j];
+    bool swap = before(xj, ij, xi, ii);
+    x[i] = swap ? xj : xi;
+    x[j] = swap ? xi : xj;
+    idx[i] = swap ? ij : ii;
+    idx[j] = swap ? ii : ij;
+}
+
+// Sorts the N entries of x with their indices idx, N a power of two. The
+// indices have to be distinct, they decide the order of equal values.
+template<int N, typename T>
+inline void sortNetwork(T x[N], int idx[N]) {
+    for (int p = 1; p < N; p <<= 1)
+        for (int k = p; k >= 1; k >>= 1)
+            for (int j = k % p; j + k < N; j += 2 * k)
+                for (int i = 0; i < k && i + j + k < N; i++)
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                        compareExchange(x, idx, i + j, i + j + k);
+}
+
+// [x, idx] = sort(x, 'ascend') for the fixed size vectors of the filter
+template<int N, typename T>
+inline void sort(T x[N], int idx[N]) {
+    for (int i = 0; i < N; i++)
+        idx[i] = i + 1;
+    sortNetwork<N>(x, idx);
+}
+
+// The padding repeats the last entry in sort order with larger indices, so it
+// sorts behind the n entries without relying on special values.
+template<int N, typename T>
+inline void sortPadded(T x[], int idx[], int n) {
+    T x_pad[N];
+    int idx_pad[N];
+    int last = 0;
+    for (int i = 1; i < n; i++)
+        if (before(x[last], last, x[i], i))
+            last = i;
+    for (int i = 0; i < N; i++) {
+        x_pad[i] = i < n ? x[i] : x[last];
+        idx_pad[i] = i + 1;
+    }
+    sortNetwork<N>(x_pad, idx_pad);
+    for (int i = 0; i < n; i++) {
+        x[i] = x_pad[i];
+        idx[i] = idx_pad[i];
+    }
+}
+
+// [x, idx] = sort(x, 'ascend') for 0 <= n <= MAX_SIZE, with the smallest
+// network that fits n.
+template<typename T>
+inline void sort(T x[], int idx[], int n) {
+    if (n == 0)
+        return;
+    if (n <= 8)
+        sortPadded<8>(x, idx, n);
+    else if (n <= 16)
+        sortPadded<16>(x, idx, n);
+    else if (n <= 32)
+        sortPadded<32>(x, idx, n);
+    else
+        sortPadded<MAX_SIZE>(x, idx, n);
+}
+
+// median(x) of 0 <= n <= MAX_SIZE entries by selection. NaN if x is empty or
+// contains NaN, the mean of the middle entries for even n.
+template<typename T>
+inline T median(const T x[], int n) {
+    T work[MAX_SIZE];
+    for (int i = 0; i < n; i++) {
+        if (x[i] != x[i])
+            return x[i];
+        work[i] = x[i];
+    }
+    if (n == 0)
+        return std::numeric_limits<T>::quiet_NaN();
+
+    int mid = n / 2;
+    std::nth_element(work, work + mid, work + n);
+    T upper = work[mid];
+    if (2 * mid != n)
+        return upper;
+
+    T lower = *std::max_element(work, work + mid);
+    if ((lower < 0 && upper >= 0) || std::isinf(lower) || std::isinf(upper))
+        return (lower + upper) / 2;
+    return lower + (upper - lower) / 2;
+}
+
+}  // namespace sorting_network
+
+#endif /* INCLUDE_SORTINGNETWORK_H_ */
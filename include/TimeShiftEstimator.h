@@ -0,0 +1,80 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * TimeShiftEstimator.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INCLUDE_TIMESHIFTESTIMATOR_H_
+#define INCLUDE_TIMESHIFTESTIMATOR_H_
+
+#include "InterfaceStructs.h"
+#include "Precision.h"
+#include "matlab_consts.h"
+
+// Time shift between the image and the IMU time stamps, the image was taken
+// at its stamp plus the shift. The shift can be refined online: if the filter
+// predicts the image at the wrong time, the residual of a feature is its
+// image velocity times the error of the shift. The error is the least squares
+// fit over the tracked features of a frame, the shift follows it with a gain.
+class TimeShiftEstimator {
+    double time_shift_;
+    CameraParameters camera_;
+    double prev_stamp_;
+    FloatType prev_z_u_[matlab_consts::numTrackFeatures * 2];
+    bool prev_valid_[matlab_consts::numTrackFeatures];
+
+public:
+    enum {
+        MIN_FEATURES = 5
+    };
+    static const double GAIN;  // fraction of the error of one frame that is corrected
+    static const double MAX_STEP;  // s, bound of the correction of one frame
+    static const double MAX_TIME_SHIFT;  // s
+    static const double MAX_RESIDUAL;  // px, larger residuals are not caused by the time shift
+    static const double MIN_FLOW;  // px^2/s^2, mean squared image velocity needed to observe the shift
+
+    TimeShiftEstimator();
+    void setTimeShift(double time_shift);
+    double timeShift() const;
+    void setCamera(const CameraParameters &camera);
+    void reset();
+
+    // stamp is the image time the state was predicted to, map holds the map of the
+    // previous update in world coordinates, update_vec and z_l the tracker output
+    void addFrame(double stamp, const RobotState &state, const FloatType *map, const int *update_vec, const FloatType *z_l);
+};
+
+#endif /* INCLUDE_TIMESHIFTESTIMATOR_H_ */
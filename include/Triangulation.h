@@ -0,0 +1,424 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * Triangulation.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INCLUDE_TRIANGULATION_H_
+#define INCLUDE_TRIANGULATION_H_
+
+#include <cmath>
+#include <limits>
+
+// Stereo triangulation of new features. All candidate points of an update
+// are triangulated together in blocks of LANES points stored as structure of
+// arrays, like the undistortion in CameraModel.h.
+namespace triangulation {
+
+enum {
+    LANES = 16
+};
+
+enum Status {
+    SUCCESS = 0,
+    DIVERGENT,     // the rays diverge, the point would be behind the cameras
+    NOT_A_NUMBER,  // the least squares solution contains nan
+    REPROJECTION,  // the reprojection error in one of the cameras is too large
+    TOO_CLOSE      // the point is closer than 0.1 m to the left camera
+};
+
+// Values of VIOParameters::triangulation_method
+enum Method {
+    MIDPOINT = 0,  // closed form, QR for rays with less parallax than minParallax()
+    QR = 1         // Householder QR of the least squares system
+};
+
+// sine of the smallest angle between the rays that is solved in closed form
+template<typename T>
+inline T minParallax() {
+    return T(1e-3);
+}
+
+template<typename T>
+struct StereoRig {
+    T fc_l[2], pp_l[2];  // left focal length and principal point
+    T fc_r[2], pp_r[2];  // right focal length and principal point
+    T r_lr[3];           // position of the right camera in the left frame
+    T R_lr[9];           // column major rotations between the cameras
+    T R_rl[9];
+
+    StereoRig(const T focal_length_l[2], const T principal_point_l[2], const T focal_length_r[2], const T principal_point_r[2], const T r_lr_[3], const T R_lr_[9], const T R_rl_[9]) {
+        for (int i = 0; i < 2; i++) {
+            fc_l[i] = focal_length_l[i];
+            pp_l[i] = principal_point_l[i];
+            fc_r[i] = focal_length_r[i];
+            pp_r[i] = principal_point_r[i];
+        }
+        for (int i = 0; i < 3; i++)
+            r_lr[i] = r_lr_[i];
+        for (int i = 0; i < 9; i++) {
+            R_lr[i] = R_lr_[i];
+            R_rl[i] = R_rl_[i];
+        }
+    }
+};
+
+// Minimum norm least squares solution of A x = b with a column pivoted
+// Householder QR, the same as A\b in Matlab. A is column major and both A
+// and b are overwritten.
+template<typename T, int M, int N>
+inline void solveLeastSquares(T A[M * N], T b[M], T x[N]) {
+    T tau[N], col_norm[N];
+    int jpvt[N];
+
+    for (int j = 0; j < N; j++) {
+        jpvt[j] = j;
+        col_norm[j] = 0;
+        for (int i = 0; i < M; i++)
+            col_norm[j] += A[i + M * j] * A[i + M * j];
+    }
+
+    for (int k = 0; k < N; k++) {
+        int p = k;
+        for (int j = k + 1; j < N; j++)
+            if (col_norm[j] > col_norm[p])
+                p = j;
+        if (p != k) {
+            for (int i = 0; i < M; i++) {
+                T tmp = A[i + M * k];
+                A[i + M * k] = A[i + M * p];
+                A[i + M * p] = tmp;
+            }
+            int tmp_j = jpvt[k];
+            jpvt[k] = jpvt[p];
+            jpvt[p] = tmp_j;
+            col_norm[p] = col_norm[k];
+        }
+
+        T alpha = A[k + M * k];
+        T sigma = 0;
+        for (int i = k + 1; i < M; i++)
+            sigma += A[i + M * k] * A[i + M * k];
+        tau[k] = 0;
+        if (sigma > 0) {
+            T beta = std::sqrt(alpha * alpha + sigma);
+            if (alpha >= 0)
+                beta = -beta;
+            tau[k] = (beta - alpha) / beta;
+            T scale = 1 / (alpha - beta);
+            for (int i = k + 1; i < M; i++)
+                A[i + M * k] *= scale;
+            A[k + M * k] = beta;
+        }
+
+        for (int j = k + 1; j < N; j++) {
+            if (tau[k] != 0) {
+                T w = A[k + M * j];
+                for (int i = k + 1; i < M; i++)
+                    w += A[i + M * k] * A[i + M * j];
+                w *= tau[k];
+                A[k + M * j] -= w;
+                for (int i = k + 1; i < M; i++)
+                    A[i + M * j] -= A[i + M * k] * w;
+            }
+            col_norm[j] = 0;
+            for (int i = k + 1; i < M; i++)
+                col_norm[j] += A[i + M * j] * A[i + M * j];
+        }
+    }
+
+    for (int k = 0; k < N; k++) {
+        if (tau[k] == 0)
+            continue;
+        T w = b[k];
+        for (int i = k + 1; i < M; i++)
+            w += A[i + M * k] * b[i];
+        w *= tau[k];
+        b[k] -= w;
+        for (int i = k + 1; i < M; i++)
+            b[i] -= A[i + M * k] * w;
+    }
+
+    const T tol = (M > N ? M : N) * std::fabs(A[0]) * std::numeric_limits<T>::epsilon();
+    int rank = 0;
+    while (rank < N && std::fabs(A[rank + M * rank]) >= tol)
+        rank++;
+
+    T y[N];
+    for (int k = 0; k < N; k++)
+        y[k] = k < rank ? b[k] : 0;
+    for (int j = rank - 1; j >= 0; j--) {
+        y[j] /= A[j + M * j];
+        for (int i = 0; i < j; i++)
+            y[i] -= y[j] * A[i + M * j];
+    }
+    for (int k = 0; k < N; k++)
+        x[jpvt[k]] = y[k];
+}
+
+// Least squares solution of A x = b for every lane with an unpivoted
+// Householder QR. A[i + M * j][lane] is column major per lane. Lanes where a
+// diagonal element of R falls below the rank tolerance of solveLeastSquares
+// are flagged in rank_deficient and have to be solved again with pivoting.
+template<typename T, int M, int N>
+inline void solveLeastSquaresLanes(T A[M * N][LANES], T b[M][LANES], T x[N][LANES], T rank_deficient[LANES]) {
+    const T tol = (M > N ? M : N) * std::numeric_limits<T>::epsilon();
+    T r_00[LANES];
+
+    for (int k = 0; k < N; k++) {
+        for (int l = 0; l < LANES; l++) {
+            T alpha = A[k + M * k][l];
+            T sigma = 0;
+            for (int i = k + 1; i < M; i++)
+                sigma += A[i + M * k][l] * A[i + M * k][l];
+            T beta = std::sqrt(alpha * alpha + sigma);
+            beta = alpha >= 0 ? -beta : beta;
+            bool reflect = sigma > 0;
+            T safe_beta = reflect ? beta : T(1);
+            T tau = reflect ? (beta - alpha) / safe_beta : T(0);
+            T scale = reflect ? 1 / (alpha - beta) : T(0);
+            for (int i = k + 1; i < M; i++)
+                A[i + M * k][l] *= scale;
+            A[k + M * k][l] = reflect ? beta : alpha;
+
+            for (int j = k + 1; j < N; j++) {
+                T w = A[k + M * j][l];
+                for (int i = k + 1; i < M; i++)
+                    w += A[i + M * k][l] * A[i + M * j][l];
+                w *= tau;
+                A[k + M * j][l] -= w;
+                for (int i = k + 1; i < M; i++)
+                    A[i + M * j][l] -= A[i + M * k][l] * w;
+            }
+
+            T w = b[k][l];
+            for (int i = k + 1; i < M; i++)
+                w += A[i + M * k][l] * b[i][l];
+            w *= tau;
+            b[k][l] -= w;
+            for (int i = k + 1; i < M; i++)
+                b[i][l] -= A[i + M * k][l] * w;
+        }
+    }
+
+    for (int l = 0; l < LANES; l++) {
+        r_00[l] = std::fabs(A[0][l]);
+        rank_deficient[l] = 0;
+    }
+    for (int k = 0; k < N; k++)
+        for (int l = 0; l < LANES; l++)
+            rank_deficient[l] = std::fabs(A[k + M * k][l]) < tol * r_00[l] ? T(1) : rank_deficient[l];
+
+    for (int j = N - 1; j >= 0; j--) {
+        for (int l = 0; l < LANES; l++) {
+            T y = b[j][l];
+            for (int i = j + 1; i < N; i++)
+                y -= A[j + M * i][l] * x[i][l];
+            x[j][l] = y / A[j + M * j][l];
+        }
+    }
+}
+
+// Least squares system of the two rays: d_l * m_l - fp = 0 and
+// d_r * m_r - fp = -r_lr for x = [d_l; d_r; fp], column major.
+template<typename T>
+inline void buildStereoSystem(const StereoRig<T> &rig, const T m_l[3], const T m_r[3], T A[30], T b[6]) {
+    for (int i = 0; i < 30; i++)
+        A[i] = 0;
+    for (int k = 0; k < 3; k++) {
+        A[k] = m_l[k];
+        A[9 + k] = m_r[k];
+        A[6 * (2 + k) + k] = -1;
+        A[6 * (2 + k) + 3 + k] = -1;
+        b[k] = 0;
+        b[3 + k] = -rig.r_lr[k];
+    }
+}
+
+// Solve the lanes flagged in redo with the pivoted QR
+template<typename T>
+inline void solveStereoPivoted(const StereoRig<T> &rig, const T m_l[3][LANES], const T m_r[3][LANES], const T redo[LANES], int num_points, T fp[3][LANES]) {
+    for (int l = 0; l < num_points; l++) {
+        if (redo[l] == 0)
+            continue;
+        T ml[3] = { m_l[0][l], m_l[1][l], m_l[2][l] };
+        T mr[3] = { m_r[0][l], m_r[1][l], m_r[2][l] };
+        T A[30], b[6], x[5];
+        buildStereoSystem(rig, ml, mr, A, b);
+        solveLeastSquares<T, 6, 5>(A, b, x);
+        for (int k = 0; k < 3; k++)
+            fp[k][l] = x[2 + k];
+    }
+}
+
+template<typename T>
+inline void solveStereoQRLanes(const StereoRig<T> &rig, const T m_l[3][LANES], const T m_r[3][LANES], int num_points, T fp[3][LANES]) {
+    T A[30][LANES], b[6][LANES], x[5][LANES];
+    T rank_deficient[LANES];
+
+    for (int l = 0; l < LANES; l++) {
+        T ml[3] = { m_l[0][l], m_l[1][l], m_l[2][l] };
+        T mr[3] = { m_r[0][l], m_r[1][l], m_r[2][l] };
+        T A_l[30], b_l[6];
+        buildStereoSystem(rig, ml, mr, A_l, b_l);
+        for (int i = 0; i < 30; i++)
+            A[i][l] = A_l[i];
+        for (int i = 0; i < 6; i++)
+            b[i][l] = b_l[i];
+    }
+
+    solveLeastSquaresLanes<T, 6, 5>(A, b, x, rank_deficient);
+
+    for (int l = 0; l < LANES; l++)
+        for (int k = 0; k < 3; k++)
+            fp[k][l] = x[2 + k][l];
+
+    solveStereoPivoted(rig, m_l, m_r, rank_deficient, num_points, fp);
+}
+
+// The least squares solution is the midpoint of the shortest segment between
+// the rays. With n = m_l x m_r the ray lengths are
+// d_l = (r_lr x m_r).n / |n|^2 and d_r = (r_lr x m_l).n / |n|^2.
+template<typename T>
+inline void solveStereoMidpointLanes(const StereoRig<T> &rig, const T m_l[3][LANES], const T m_r[3][LANES], int num_points, T fp[3][LANES]) {
+    const T min_n_sq = minParallax<T>() * minParallax<T>();
+    const T *r = rig.r_lr;
+    T parallel[LANES];
+
+    for (int l = 0; l < LANES; l++) {
+        T n[3] = { m_l[1][l] * m_r[2][l] - m_l[2][l] * m_r[1][l], m_l[2][l] * m_r[0][l] - m_l[0][l] * m_r[2][l], m_l[0][l] * m_r[1][l] - m_l[1][l] * m_r[0][l] };
+        T c_r[3] = { r[1] * m_r[2][l] - r[2] * m_r[1][l], r[2] * m_r[0][l] - r[0] * m_r[2][l], r[0] * m_r[1][l] - r[1] * m_r[0][l] };
+        T c_l[3] = { r[1] * m_l[2][l] - r[2] * m_l[1][l], r[2] * m_l[0][l] - r[0] * m_l[2][l], r[0] * m_l[1][l] - r[1] * m_l[0][l] };
+        T n_sq = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+        T d_l = (c_r[0] * n[0] + c_r[1] * n[1] + c_r[2] * n[2]) / n_sq;
+        T d_r = (c_l[0] * n[0] + c_l[1] * n[1] + c_l[2] * n[2]) / n_sq;
+        for (int k = 0; k < 3; k++)
+            fp[k][l] = T(0.5) * (d_l * m_l[k][l] + d_r * m_r[k][l] + r[k]);
+        parallel[l] = n_sq < min_n_sq ? T(1) : T(0);
+    }
+
+    solveStereoPivoted(rig, m_l, m_r, parallel, num_points, fp);
+}
+
+// Triangulate the first num_points lanes of the left and right undistorted
+// pixel coordinates. fp is the point in the left camera frame and m_l the
+// normalized ray of the left measurement. A lane that does not succeed keeps
+// the least squares solution in fp, it is up to the caller to replace it.
+template<typename T>
+inline void triangulateStereoLanes(const StereoRig<T> &rig, Method method, const T x_l[LANES], const T y_l[LANES], const T x_r[LANES], const T y_r[LANES], int num_points, T fp[3][LANES], T m_l[3][LANES], int status[LANES]) {
+    const T reprojection_error_thresh = 5;
+    const T min_depth = T(0.1);
+
+    T m_r[3][LANES];  // right ray rotated into the left frame
+
+    for (int l = 0; l < LANES; l++) {
+        T ml[3] = { (x_l[l] - rig.pp_l[0]) / rig.fc_l[0], (y_l[l] - rig.pp_l[1]) / rig.fc_l[1], 1 };
+        T mr[3] = { (x_r[l] - rig.pp_r[0]) / rig.fc_r[0], (y_r[l] - rig.pp_r[1]) / rig.fc_r[1], 1 };
+        T norm_l = std::sqrt(ml[0] * ml[0] + ml[1] * ml[1] + ml[2] * ml[2]);
+        T norm_r = std::sqrt(mr[0] * mr[0] + mr[1] * mr[1] + mr[2] * mr[2]);
+        for (int k = 0; k < 3; k++) {
+            m_l[k][l] = ml[k] / norm_l;
+            mr[k] /= norm_r;
+        }
+        for (int k = 0; k < 3; k++)
+            m_r[k][l] = rig.R_lr[k] * mr[0] + rig.R_lr[k + 3] * mr[1] + rig.R_lr[k + 6] * mr[2];
+    }
+
+    if (method == QR)
+        solveStereoQRLanes(rig, m_l, m_r, num_points, fp);
+    else
+        solveStereoMidpointLanes(rig, m_l, m_r, num_points, fp);
+
+    for (int l = 0; l < LANES; l++) {
+        T fp_r[3];
+        for (int k = 0; k < 3; k++)
+            fp_r[k] = rig.R_rl[k] * fp[0][l] + rig.R_rl[k + 3] * fp[1][l] + rig.R_rl[k + 6] * fp[2][l] - rig.r_lr[k];
+
+        T e_l[2] = { fp[0][l] / fp[2][l] * rig.fc_l[0] + rig.pp_l[0] - x_l[l], fp[1][l] / fp[2][l] * rig.fc_l[1] + rig.pp_l[1] - y_l[l] };
+        T e_r[2] = { fp_r[0] / fp_r[2] * rig.fc_r[0] + rig.pp_r[0] - x_r[l], fp_r[1] / fp_r[2] * rig.fc_r[1] + rig.pp_r[1] - y_r[l] };
+        T depth_sq = fp[0][l] * fp[0][l] + fp[1][l] * fp[1][l] + fp[2][l] * fp[2][l];
+
+        // cross(m_l, m_r)(2) > 0
+        bool divergent = m_l[2][l] * m_r[0][l] - m_l[0][l] * m_r[2][l] > 0;
+        bool nan = fp[0][l] != fp[0][l] || fp[1][l] != fp[1][l] || fp[2][l] != fp[2][l];
+        bool reprojection = e_l[0] * e_l[0] + e_l[1] * e_l[1] > reprojection_error_thresh * reprojection_error_thresh
+                || e_r[0] * e_r[0] + e_r[1] * e_r[1] > reprojection_error_thresh * reprojection_error_thresh;
+        bool too_close = depth_sq < min_depth * min_depth;
+
+        status[l] = divergent ? DIVERGENT : nan ? NOT_A_NUMBER : reprojection ? REPROJECTION : too_close ? TOO_CLOSE : SUCCESS;
+    }
+}
+
+// Triangulate num_points pairs of interleaved undistorted pixel coordinates.
+// fp and m_l hold three values per point. A partial block is padded with the
+// principal points.
+template<typename T>
+inline void triangulateStereo(const StereoRig<T> &rig, Method method, const T *z_l, const T *z_r, int num_points, T *fp, T *m_l, int *status) {
+    T x_l[LANES], y_l[LANES], x_r[LANES], y_r[LANES];
+    T fp_lanes[3][LANES], m_lanes[3][LANES];
+    int status_lanes[LANES];
+
+    for (int block = 0; block < num_points; block += LANES) {
+        int n = num_points - block < LANES ? num_points - block : LANES;
+
+        for (int i = 0; i < n; i++) {
+            x_l[i] = z_l[2 * (block + i)];
+            y_l[i] = z_l[2 * (block + i) + 1];
+            x_r[i] = z_r[2 * (block + i)];
+            y_r[i] = z_r[2 * (block + i) + 1];
+        }
+        for (int i = n; i < LANES; i++) {
+            x_l[i] = rig.pp_l[0];
+            y_l[i] = rig.pp_l[1];
+            x_r[i] = rig.pp_r[0];
+            y_r[i] = rig.pp_r[1];
+        }
+
+        triangulateStereoLanes(rig, method, x_l, y_l, x_r, y_r, n, fp_lanes, m_lanes, status_lanes);
+
+        for (int i = 0; i < n; i++) {
+            for (int k = 0; k < 3; k++) {
+                fp[3 * (block + i) + k] = fp_lanes[k][i];
+                m_l[3 * (block + i) + k] = m_lanes[k][i];
+            }
+            status[block + i] = status_lanes[i];
+        }
+    }
+}
+
+}  // namespace triangulation
+
+#endif /* INCLUDE_TRIANGULATION_H_ */
@@ -0,0 +1,78 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * UndistortionMap.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef INCLUDE_UNDISTORTIONMAP_H_
+#define INCLUDE_UNDISTORTIONMAP_H_
+
+#include <string>
+#include <vector>
+
+#include "CameraModel.h"
+#include "InterfaceStructs.h"
+#include "Precision.h"
+
+// Lookup table of the undistorted pixel coordinates of one camera. The table
+// is a grid over the sensor resolution with a node every step pixels, points
+// are undistorted by bilinear interpolation between the nodes. Points outside
+// of the sensor are undistorted with the camera model.
+class UndistortionMap {
+    int width_;
+    int height_;
+    int step_;
+    int cols_;
+    int rows_;
+    CameraParameters params_;  // calibration the map was built for
+    std::vector<FloatType> u_;  // undistorted coordinates of node (row, col) at row * cols_ + col
+    std::vector<FloatType> v_;
+
+    void undistortModel(const FloatType *pt_d, int num_points, FloatType *pt_u, camera_model::UndistortionReport<FloatType> &report) const;
+
+public:
+    UndistortionMap();
+    void build(const CameraParameters &params, int width, int height, int step);
+    bool load(const std::string &path);
+    bool save(const std::string &path) const;
+    bool empty() const;
+    int step() const;
+    bool matches(const CameraParameters &params, int width, int height) const;
+    bool matches(const FloatType focal_length[2], const FloatType principal_point[2], const FloatType radial_distortion[3], int distortion_model) const;
+    void undistortPoints(const FloatType *pt_d, int num_points, FloatType *pt_u, camera_model::UndistortionReport<FloatType> &report) const;
+};
+
+#endif /* INCLUDE_UNDISTORTIONMAP_H_ */
@@ -40,14 +40,37 @@
 #ifndef SRC_VIO_H_
 #define SRC_VIO_H_
 
+#include <stdint.h>
+#include <string>
 #include <vector>
 
 #include "Precision.h"
 #include "SLAM_includes.h"
+#include "UndistortionMap.h"
 #include "matlab_consts.h"
 
+// Header of a filter checkpoint. The filter state follows it as laid out in
+// memory by the build that wrote it, so a checkpoint can be mapped and copied
+// back directly, but only restores in a build with the same precision and sizes.
+struct VIOCheckpointHeader {
+    enum {
+        VERSION = 1,
+        BYTE_ORDER_MARK = 0x01020304
+    };
+    char magic[4];  // "DVIO"
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t float_size;
+    uint32_t num_track_features;
+    uint32_t num_anchors;
+    uint32_t state_size;  // bytes of filter state following the header
+    uint32_t reserved;
+};
+
 class VIO {
     bool reset_;
+    bool warm_reset_;
+    RobotState warm_reset_state_;  // estimate the warm reset starts from
     bool params_set_;
     bool is_initialized_;
 
@@ -61,16 +84,31 @@ class VIO {
     VIOMeasurements vio_eas_dummy_;
     RobotState robot_state_dummy_;
 
+    void predict(const VIOMeasurements &meas, double dt, int outputs, RobotState &robotState);
+
 public:
     VIO();
     VIO(DUOParameters duoParam, NoiseParameters noiseParam, VIOParameters vioParam);
     virtual ~VIO();
-    void predict(const VIOMeasurements &meas, double dt);
+    void predict(const VIOMeasurements &meas, double dt);  // computes no outputs
+    void predict(const VIOMeasurements &meas, double dt, RobotState &robotState);  // also returns the propagated state, without the map
     void update(std::vector<int> &update_vect, std::vector<FloatType> &feautres_l, std::vector<FloatType> &feautres_r, RobotState &robotState,
             std::vector<FloatType> &map, std::vector<AnchorPose> &anchor_poses, std::vector<FloatType> &delayedStatus);
+    void update(std::vector<int> &update_vect, std::vector<FloatType> &feautres_l, std::vector<FloatType> &feautres_r, RobotState &robotState,
+            std::vector<FloatType> &map, std::vector<AnchorPose> &anchor_poses, std::vector<FloatType> &delayedStatus, int outputs);  // only writes the SLAMOutputs in outputs
+    void update(std::vector<int> &update_vect, std::vector<FloatType> &feautres_l, std::vector<FloatType> &feautres_r, RobotState &robotState,
+            std::vector<FloatType> &map, std::vector<AnchorPose> &anchor_poses, std::vector<FloatType> &delayedStatus, int outputs,
+            VIOTelemetry &telemetry);  // also returns the telemetry of the update
     void reset();
+    void resetWarm(const RobotState &robotState);  // keeps the IMU biases and the camera-IMU extrinsics of the estimate
     bool getParams(DUOParameters &duoParam, NoiseParameters &noiseParam, VIOParameters &vioParam);
     void setParams(DUOParameters duoParam, NoiseParameters noiseParam, VIOParameters vioParam);
+    void setUndistortionMaps(const UndistortionMap *map_l, const UndistortionMap *map_r);
+    size_t getCheckpointSize() const;
+    void getCheckpoint(std::vector<unsigned char> &checkpoint) const;
+    bool restoreCheckpoint(const void *checkpoint, size_t size);
+    bool saveCheckpoint(const std::string &file_name) const;
+    bool loadCheckpoint(const std::string &file_name);
 };
 
 #endif /* SRC_VIO_H_ */
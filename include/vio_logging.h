@@ -42,9 +42,128 @@
 
 #include <ros/ros.h>
 
-#define LOG_INFO ROS_INFO
-#define LOG_WARN ROS_WARN
-#define LOG_ERROR ROS_ERROR
+#include <boost/atomic.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/thread.hpp>
+
+// The filter logs binary events: the format string identifies the event and
+// is recorded with the numeric arguments in a lock-free queue. A background
+// thread formats and prints them, so logging does not stall the filter. The
+// format must have static storage duration and only numeric conversions.
+// Events are only recorded by the thread that runs the filter.
+namespace vio_logging {
+
+enum Level {
+    INFO,
+    WARN,
+    ERROR
+};
+
+struct LogEvent {
+    enum {
+        MAX_ARGS = 4
+    };
+    const char *format;
+    int level;
+    int num_args;
+    bool is_float[MAX_ARGS];
+    union {
+        long i;
+        double f;
+    } args[MAX_ARGS];
+
+    inline void set(int idx, long arg) {
+        is_float[idx] = false;
+        args[idx].i = arg;
+    }
+
+    inline void set(int idx, int arg) {
+        set(idx, static_cast<long>(arg));
+    }
+
+    inline void set(int idx, double arg) {
+        is_float[idx] = true;
+        args[idx].f = arg;
+    }
+
+    inline void pack() {
+    }
+
+    template<typename T, typename ... Args>
+    inline void pack(T arg, Args ... rest) {
+        set(num_args++, arg);
+        pack(rest...);
+    }
+};
+
+class Logger {
+public:
+    enum {
+        QUEUE_SIZE = 1024
+    };
+
+    static Logger &instance();
+    ~Logger();
+    void start();
+    void stop();  // prints the queued events
+
+    template<typename ... Args>
+    inline void log(Level level, const char *format, Args ... args) {
+        static_assert(sizeof...(Args) <= LogEvent::MAX_ARGS, "too many arguments for a log event");
+        LogEvent event;
+        event.format = format;
+        event.level = level;
+        event.num_args = 0;
+        event.pack(args...);
+        if (!running_.load(boost::memory_order_relaxed))
+            print(event);
+        else if (!queue_.push(event))
+            dropped_.fetch_add(1, boost::memory_order_relaxed);
+    }
+
+private:
+    boost::lockfree::spsc_queue<LogEvent, boost::lockfree::capacity<QUEUE_SIZE> > queue_;
+    boost::atomic<bool> running_;
+    boost::atomic<int> dropped_;
+    boost::thread thread_;
+
+    Logger();
+    void run();
+    void flush();
+    static void print(const LogEvent &event);
+};
+
+// Stands in for the log sites removed at compile time. It is only used in
+// unevaluated sizeof expressions, so the arguments are not computed but the
+// format strings still count as used.
+template<typename ... Args>
+char stripped(const Args &... args);
+
+}  // namespace vio_logging
+
+// Log sites above VIO_LOG_LEVEL (0: errors, 1: warnings, 2: info) are removed
+// at compile time, set it with the build to strip the diagnostic messages.
+#ifndef VIO_LOG_LEVEL
+#define VIO_LOG_LEVEL 2
+#endif
+
+#if VIO_LOG_LEVEL >= 2
+#define LOG_INFO(...) vio_logging::Logger::instance().log(vio_logging::INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void) sizeof(vio_logging::stripped(__VA_ARGS__)))
+#endif
+
+#if VIO_LOG_LEVEL >= 1
+#define LOG_WARN(...) vio_logging::Logger::instance().log(vio_logging::WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void) sizeof(vio_logging::stripped(__VA_ARGS__)))
+#endif
+
+#if VIO_LOG_LEVEL >= 0
+#define LOG_ERROR(...) vio_logging::Logger::instance().log(vio_logging::ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void) sizeof(vio_logging::stripped(__VA_ARGS__)))
+#endif
 
 
 #endif /* INCLUDE_VIO_LOGGING_H_ */
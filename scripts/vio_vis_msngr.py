@@ -61,6 +61,10 @@ class Visualizer(pg.QtCore.QThread):
         self.image_pub = rospy.Publisher("vio_vis/rviz/img", Image, queue_size=1)
         # self.image_cloud_pub = rospy.Publisher("vio_vis/rviz/img_cloud", PointCloud, queue_size=1)
         self.robot_path = Path()
+        self.feature_map = np.zeros(48 * 3)
+        self.full_feature_map = np.zeros(48 * 3)  # map of the last complete message, the deltas refer to it
+        self.full_msg_cnt = None
+        self.request_full_pub = rospy.Publisher("vio_vis/request_full", Empty, queue_size=1)
 
         rospy.Subscriber("vio_vis/vio_vis", vio_vis, self.vis_cb, queue_size=1)
         rospy.Subscriber("vio_vis/reset", Empty, self.clear_cb)
@@ -173,6 +177,7 @@ class Visualizer(pg.QtCore.QThread):
         return
 
     def anchor_poses_cb(self, data):
+        # the anchors are only sent if they moved, the markers of the last ones stay
 
         for i, pose in enumerate(data.poses):
             # print("anchor {}".format(i))
@@ -183,6 +188,22 @@ class Visualizer(pg.QtCore.QThread):
         return
 
     def map_cb(self, feature_map, status_vect):
+        # the map is either complete or a list of (slot, x, y, z) of the points that changed
+        # since the complete message numbered in the last dimension
+        full_msg_cnt = feature_map.layout.dim[-1].size
+        if feature_map.layout.dim[0].label == 'slot':
+            if full_msg_cnt != self.full_msg_cnt:  # missed the complete message
+                self.request_full_pub.publish(Empty())
+                return
+            self.feature_map = self.full_feature_map.copy()
+            for i in range(0, feature_map.layout.dim[0].size):
+                slot = int(feature_map.data[i * 4])
+                self.feature_map[slot * 3:slot * 3 + 3] = feature_map.data[i * 4 + 1:i * 4 + 4]
+        else:
+            self.full_feature_map = np.array(feature_map.data)
+            self.full_msg_cnt = full_msg_cnt
+            self.feature_map = self.full_feature_map.copy()
+
         cloud = PointCloud()
         cloud.header.frame_id = "world"
         r_channel = ChannelFloat32()
@@ -195,9 +216,9 @@ class Visualizer(pg.QtCore.QThread):
         for i in range(0, len(status_vect.data)):
             if status_vect.data[i] > 0:
                 point = Point()
-                point.x = feature_map.data[i * 3 + 0]
-                point.y = feature_map.data[i * 3 + 1]
-                point.z = feature_map.data[i * 3 + 2]
+                point.x = self.feature_map[i * 3 + 0]
+                point.y = self.feature_map[i * 3 + 1]
+                point.z = self.feature_map[i * 3 + 2]
                 cloud.points.append(point)
                 if status_vect.data[i] == 1:
                     r_channel.values.append(0.0)
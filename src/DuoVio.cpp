@@ -41,9 +41,12 @@
 #include <math.h>
 #include <stdio.h>
 #include <time.h>
+#include <algorithm>
+#include <cmath>
 
 #include <cv_bridge/cv_bridge.h>
 #include <geometry_msgs/PoseStamped.h>
+#include <geometry_msgs/Vector3Stamped.h>
 #include <geometry_msgs/Point32.h>
 #include <visualization_msgs/Marker.h>
 #include <std_msgs/Float32.h>
@@ -51,10 +54,17 @@
 
 
 static const int VIO_SENSOR_QUEUE_SIZE = 30;
+static const int VIS_FULL_INTERVAL = 30;  // send a complete visualization message every so many messages
+static const FloatType VIS_POSITION_THRESHOLD = 0.005;  // smallest change of a map point or anchor that is sent
+static const FloatType VIS_ATTITUDE_THRESHOLD = 0.001;
 
-DuoVio::DuoVio() :
-                nh_("~"),
+DuoVio::DuoVio(const ros::NodeHandle &nh, bool standalone) :
+                nh_(nh),
+                dynamic_reconfigure_server(nh_),
                 SLAM_reset_flag(1),
+                warm_reset(false),
+                has_estimate(false),
+                estimate_time_shift(false),
                 cam2body(-0.5, 0.5, -0.5, -0.5),
                 max_clicks_(0),
                 clear_queue_counter(0),
@@ -63,7 +73,19 @@ DuoVio::DuoVio() :
                 auto_subsample(false),
                 dist(0.0),
                 got_device_serial_nr(false),
-                use_dark_current(false) {
+                standalone(standalone),
+                calibration_failed(false),
+                use_dark_current(false),
+                corrected_idx(0),
+                use_undistortion_map(false),
+                undistortion_map_step(2),
+                pipelined(false),
+                pipeline_running(false),
+                vis_running(false),
+                vis_pending(false),
+                vis_msg_cnt(0),
+                vis_full_msg_cnt(0),
+                vis_full(true) {
     // initialize structs
     cameraParams = { {}, {}};
     noiseParams = {};
@@ -75,14 +97,19 @@ DuoVio::DuoVio() :
 
     pose_pub = nh_.advertise<geometry_msgs::Pose>("pose", 1);
     vel_pub = nh_.advertise<geometry_msgs::Vector3>("vel", 1);
+    imu_pose_pub = nh_.advertise<geometry_msgs::PoseStamped>("pose_imu", 10);
+    imu_vel_pub = nh_.advertise<geometry_msgs::Vector3Stamped>("vel_imu", 10);
 
     smoothed_imu_pub = nh_.advertise<sensor_msgs::Imu>("imu_smoothed", 1);  // debug
 
     // visualization topics
     vio_vis_pub = nh_.advertise<ait_ros_messages::vio_vis>("/vio_vis/vio_vis", 1);
     vio_vis_reset_pub = nh_.advertise<std_msgs::Empty>("/vio_vis/reset", 1);
-    ros::Duration(0.5).sleep();  // otherwise the following message might not be received
-    vio_vis_reset_pub.publish(std_msgs::Empty());
+    vis_request_full_sub = nh_.subscribe("/vio_vis/request_full", 1, &DuoVio::visRequestFullCb, this);
+    // otherwise the reset might not be received. A timer does not block the nodelet manager
+    vis_reset_timer = nh_.createTimer(ros::Duration(0.5), &DuoVio::visResetTimerCb, this, true);
+    vis_running = true;
+    vis_thread = boost::thread(&DuoVio::visThread, this);
 
     vio_sensor_processed_pub = nh_.advertise<std_msgs::UInt64>("/vio_sensor/msg_processed", 1);
 
@@ -166,6 +193,33 @@ DuoVio::DuoVio() :
     } else {
         vioParams.full_stereo = tmp_bool;
     }
+    std::string tmp_string;
+    if (!nh_.getParam("vio_triangulation_method", tmp_string)) {
+        ROS_WARN("Failed to load parameter vio_triangulation_method");
+        vioParams.triangulation_method = vioParams.TRIANGULATION_MIDPOINT;
+    } else if (!tmp_string.compare("qr")) {
+        vioParams.triangulation_method = vioParams.TRIANGULATION_QR;
+    } else {
+        vioParams.triangulation_method = vioParams.TRIANGULATION_MIDPOINT;
+    }
+    if (!nh_.getParam("vio_jacobian_reuse_thresh", tmp_scalar)) {
+        ROS_WARN("Failed to load parameter vio_jacobian_reuse_thresh");
+        vioParams.jacobian_reuse_thresh = 0;
+    } else {
+        vioParams.jacobian_reuse_thresh = tmp_scalar;
+    }
+    if (!nh_.getParam("vio_origin_anchor_metric", tmp_string)) {
+        ROS_WARN("Failed to load parameter vio_origin_anchor_metric");
+        vioParams.origin_anchor_metric = vioParams.ANCHOR_METRIC_SPECTRAL;
+    } else if (!tmp_string.compare("trace")) {
+        vioParams.origin_anchor_metric = vioParams.ANCHOR_METRIC_TRACE;
+    } else if (!tmp_string.compare("frobenius")) {
+        vioParams.origin_anchor_metric = vioParams.ANCHOR_METRIC_FROBENIUS;
+    } else if (!tmp_string.compare("power")) {
+        vioParams.origin_anchor_metric = vioParams.ANCHOR_METRIC_POWER;
+    } else {
+        vioParams.origin_anchor_metric = vioParams.ANCHOR_METRIC_SPECTRAL;
+    }
 
     if (!nh_.getParam("cam_FPS", fps))
         ROS_WARN("Failed to load parameter cam_FPS");
@@ -187,6 +241,13 @@ DuoVio::DuoVio() :
         ROS_WARN("Failed to load parameter image_visualization_delay");
     image_visualization_delay = !image_visualization_delay ? 1 : image_visualization_delay;
 
+    if (!nh_.getParam("use_undistortion_map", use_undistortion_map))
+        ROS_WARN("Failed to load parameter use_undistortion_map");
+    if (!nh_.getParam("undistortion_map_step", undistortion_map_step))
+        ROS_WARN("Failed to load parameter undistortion_map_step");
+    if (!nh_.getParam("use_dark_current", use_dark_current))
+        ROS_WARN("Failed to load parameter use_dark_current");
+
     // try to load a custom camera calibration file if the launch parameter was set
     std::string calibration_path;
     if (nh_.getParam("camera_calibration", calibration_path)) {
@@ -204,17 +265,69 @@ DuoVio::DuoVio() :
     update_vec_.assign(matlab_consts::numTrackFeatures, 0);
     map.resize(matlab_consts::numTrackFeatures * 3);
     anchor_poses.resize(matlab_consts::numAnchors);
+    delayed_status.resize(matlab_consts::numTrackFeatures);
 
     // publishers to check timings
     timing_SLAM_pub = nh_.advertise<std_msgs::Float32>("timing_SLAM", 10);
     timing_feature_tracking_pub = nh_.advertise<std_msgs::Float32>("timing_feature_tracking", 10);
     timing_total_pub = nh_.advertise<std_msgs::Float32>("timing_total", 10);
+    timing_preprocessing_pub = nh_.advertise<std_msgs::Float32>("timing_preprocessing", 10);
 
     body_tf.setOrigin(tf::Vector3(0.0, 0.0, 0.0));
 
+    if (!nh_.getParam("pipelined", pipelined))
+        ROS_WARN("Failed to load parameter pipelined");
+    if (!nh_.getParam("warm_reset", warm_reset))
+        ROS_WARN("Failed to load parameter warm_reset");
+    reset_stamp = ros::Time::now();
+    int history_size = 0;
+    if (!nh_.getParam("history_size", history_size))
+        ROS_WARN("Failed to load parameter history_size");
+    if (pipelined && history_size > 0) {
+        ROS_WARN("The state history is not supported in pipelined mode, late messages are dropped");
+        history_size = 0;
+    }
+    history.set_capacity(std::max(history_size, 0));
+    history_max_reintegration_time = 0.02;
+    if (!nh_.getParam("history_max_reintegration_time", history_max_reintegration_time))
+        ROS_WARN("Failed to load parameter history_max_reintegration_time");
+    filter_frame_time = 0;
+    if (!nh_.getParam("estimate_time_shift", estimate_time_shift))
+        ROS_WARN("Failed to load parameter estimate_time_shift");
+    if (estimate_time_shift)
+        time_shift_pub = nh_.advertise<std_msgs::Float32>("time_shift", 10);
+    telemetry_pub = nh_.advertise<duo_vio::VioTelemetry>("telemetry", 10);
+    std::string telemetry_file_name;
+    nh_.getParam("telemetry_file", telemetry_file_name);  // optional
+    telemetry_file = NULL;
+    if (!telemetry_file_name.empty()) {
+        telemetry_file = fopen(telemetry_file_name.c_str(), "wb");
+        if (telemetry_file)
+            ROS_INFO("Writing the filter telemetry to %s", telemetry_file_name.c_str());
+        else
+            ROS_ERROR("Failed to open the telemetry file %s", telemetry_file_name.c_str());
+    }
+    if (pipelined) {
+        ROS_INFO("Pipelined: tracking features and updating the filter on separate threads");
+        tracker_update_vec.assign(matlab_consts::numTrackFeatures, 0);
+        tracker_generation.assign(matlab_consts::numTrackFeatures, 0);
+        for (int i = 0; i < matlab_consts::numTrackFeatures; i++)
+            killed_generation[i] = -1;
+        for (int i = 0; i < PIPELINE_QUEUE_SIZE; i++) {
+            free_queue.push(new PipelineFrame);
+            free_sem.post();
+        }
+        pipeline_running = true;
+        tracking_thread = boost::thread(&DuoVio::trackingThread, this);
+        filter_thread = boost::thread(&DuoVio::filterThread, this);
+    }
 }
 
 DuoVio::~DuoVio() {
+    stopPipeline();
+    stopVis();
+    if (telemetry_file)
+        fclose(telemetry_file);
 
     printf("Longest update duration: %.3f msec, %.3f Hz\n", float(max_clicks_) / CLOCKS_PER_SEC * 1000, CLOCKS_PER_SEC / float(max_clicks_));
 
@@ -238,29 +351,47 @@ DuoVio::~DuoVio() {
     }
 }
 
-void DuoVio::vioSensorMsgCb(const ait_ros_messages::VioSensorMsg& msg) {
-    if (!got_device_serial_nr)
+void DuoVio::stopPipeline() {
+    if (!pipeline_running)
+        return;
+    pipeline_running = false;
+    tracking_sem.post();
+    filter_sem.post();
+    tracking_thread.join();
+    filter_thread.join();
+
+    // the threads only hold a frame while they process it
+    PipelineFrame *frame;
+    while (free_queue.pop(frame))
+        delete frame;
+    while (tracking_queue.pop(frame))
+        delete frame;
+    while (filter_queue.pop(frame))
+        delete frame;
+}
+
+void DuoVio::vioSensorMsgCb(const ait_ros_messages::VioSensorMsgConstPtr &msg_ptr) {
+    const ait_ros_messages::VioSensorMsg &msg = *msg_ptr;
+    if (!got_device_serial_nr || calibration_failed)
         return;
     ros::Time tic_total = ros::Time::now();
 
     bool reset = false;
-    // upon reset, catch up with the sensor messages before resetting SLAM
+    // upon reset, drop the sensor messages that were queued before it and reset SLAM
+    // with the first newer one. The number of dropped messages is bounded by the queue
+    // size in case the sensor time stamps are not synchronized with the ROS clock
     if (SLAM_reset_flag) {
-        if (clear_queue_counter < VIO_SENSOR_QUEUE_SIZE) {
+        if (msg.header.stamp < reset_stamp && clear_queue_counter < VIO_SENSOR_QUEUE_SIZE) {
             clear_queue_counter++;
-            std_msgs::UInt32 id_msg;
-            id_msg.data = msg.header.seq;
+            prev_time_ = msg.header.stamp;
             vio_sensor_processed_pub.publish(msg.seq);
             return;
-        } else {
-            clear_queue_counter = 0;
-            SLAM_reset_flag = false;
-            std_msgs::UInt32 id_msg;
-            id_msg.data = msg.header.seq;
-            vio_sensor_processed_pub.publish(msg.seq);
-            reset = true;
-            vio_vis_reset_pub.publish(std_msgs::Empty());
         }
+        clear_queue_counter = 0;
+        SLAM_reset_flag = false;
+        reset = true;
+        vio_vis_reset_pub.publish(std_msgs::Empty());
+        vis_full = true;
     }
 
     clock_t tic_total_clock = clock();
@@ -272,9 +403,14 @@ void DuoVio::vioSensorMsgCb(const ait_ros_messages::VioSensorMsg& msg) {
     } else {
         dt = (msg.header.stamp - prev_time_).toSec();
         if (dt < 0) {
+            // a late message only brings IMU samples, its image can not be tracked any more
+            if (reintegrateLate(msg)) {
+                ROS_WARN_THROTTLE(1.0, "Late message by %f s, re-integrated its IMU data", -dt);
+                vio_sensor_processed_pub.publish(msg.seq);
+                return;
+            }
             ROS_ERROR("Negative time difference: %f", dt);
-//          dt = 1/fps;
-            prev_time_ = msg.header.stamp;
+            vio_sensor_processed_pub.publish(msg.seq);
             return;
         }
         if (std::abs(dt - 1 / fps) > 10 / fps)
@@ -286,7 +422,28 @@ void DuoVio::vioSensorMsgCb(const ait_ros_messages::VioSensorMsg& msg) {
 
     bool vis_publish = (vio_cnt % vis_publish_delay) == 0;
 
-    update(dt, msg, vis_publish, show_camera_image_, reset);
+    if (pipelined) {
+        // block the intake instead of dropping the frame, the prediction needs all IMU measurements
+        PipelineFrame *frame;
+        free_sem.wait();
+        free_queue.pop(frame);
+        frame->msg = msg_ptr;
+        frame->tic_total = tic_total;
+        frame->dt = dt;
+        frame->vision = (auto_subsample || vio_cnt % vision_subsample == 0) && !msg.left_image.data.empty() && !msg.right_image.data.empty();
+        frame->update_vis = vis_publish;
+        frame->show_image = show_camera_image_;
+        frame->reset = reset;
+        frame->z_all_l.assign(matlab_consts::numTrackFeatures * 2, 0.0);
+        frame->z_all_r.assign(matlab_consts::numTrackFeatures * 2, 0.0);
+        vio_cnt++;
+
+        tracking_queue.push(frame);  // never full, there are only as many frames as it holds
+        tracking_sem.post();
+        return;
+    }
+
+    update(dt, msg_ptr, vis_publish, show_camera_image_, reset);
 
     clock_t toc_total_clock = clock();
 
@@ -330,37 +487,43 @@ void DuoVio::deviceSerialNrCb(const std_msgs::String &msg) {
         YAML::Node YamlNode = YAML::LoadFile(calib_path);
         if (YamlNode.IsNull()) {
             ROS_FATAL("Failed to open camera calibration %s", calib_path.c_str());
-            exit(-1);
+            calibrationFailed();
+            return;
         }
         cameraParams = parseYaml(YamlNode);
         vio.setParams(cameraParams, noiseParams, vioParams);
+        time_shift_estimator.setTimeShift(cameraParams.time_shift);
+        time_shift_estimator.setCamera(cameraParams.CameraParameters1);
     } catch (YAML::BadFile &e) {
         ROS_FATAL("Failed to open camera calibration %s\nException: %s", calib_path.c_str(), e.what());
-        exit(-1);
+        calibrationFailed();
+        return;
     }
 
-    std::string dark_current_l_path = ros::package::getPath("duo3d_ros") + "/calib/" + device_serial_nr + "/" + lense_type + "/" + res.str()
-            + "/dark_current_r.bmp";
-    darkCurrentL = cv::imread(dark_current_l_path, CV_LOAD_IMAGE_GRAYSCALE);
-
-    if (!darkCurrentL.data) {
-        ROS_WARN("Failed to open left dark current image %s!", dark_current_l_path.c_str());
-        use_dark_current = false;
-    } else if (darkCurrentL.rows != resolution_height || darkCurrentL.cols != resolution_width) {
-        ROS_WARN("Left dark current image has the wrong dimensions %s!", dark_current_l_path.c_str());
-        use_dark_current = false;
-    }
+    if (use_undistortion_map)
+        loadUndistortionMaps(ros::package::getPath("duo3d_ros") + "/calib/" + device_serial_nr + "/" + lense_type + "/" + res.str() + "/",
+                resolution_width, resolution_height);
 
     if (use_dark_current) {
-        std::string dark_current_r_path = ros::package::getPath("duo3d_ros") + "/calib/" + device_serial_nr + "/" + lense_type + "/" + res.str()
-                + "/dark_current_r.bmp";
-        darkCurrentR = cv::imread(dark_current_r_path, CV_LOAD_IMAGE_GRAYSCALE);
-        if (!darkCurrentR.data) {
-            ROS_WARN("Failed to open right dark current image %s!", dark_current_r_path.c_str());
+        std::string calib_dir = ros::package::getPath("duo3d_ros") + "/calib/" + device_serial_nr + "/" + lense_type + "/" + res.str() + "/";
+        if (!imageCorrectionL.loadDarkCurrent(calib_dir + "dark_current_l.bmp", resolution_width, resolution_height)) {
+            ROS_WARN("Failed to load left dark current image %s!", (calib_dir + "dark_current_l.bmp").c_str());
             use_dark_current = false;
-        } else if (darkCurrentR.rows != resolution_height || darkCurrentR.cols != resolution_width) {
-            ROS_WARN("Right dark current image has the wrong dimensions %s!", dark_current_r_path.c_str());
+        } else if (!imageCorrectionR.loadDarkCurrent(calib_dir + "dark_current_r.bmp", resolution_width, resolution_height)) {
+            ROS_WARN("Failed to load right dark current image %s!", (calib_dir + "dark_current_r.bmp").c_str());
             use_dark_current = false;
+        } else if (imageCorrectionL.loadFlatField(calib_dir + "flat_field_l.bmp") && imageCorrectionR.loadFlatField(calib_dir + "flat_field_r.bmp")) {
+            ROS_INFO("Correcting vignetting with the flat field images in %s", calib_dir.c_str());
+        } else {
+            imageCorrectionL.clearGain();
+            imageCorrectionR.clearGain();
+        }
+    }
+
+    if (use_dark_current) {
+        for (int i = 0; i < 2; i++) {
+            correctedL[i].create(imageCorrectionL.size(), CV_8UC1);
+            correctedR[i].create(imageCorrectionR.size(), CV_8UC1);
         }
     }
 }
@@ -372,14 +535,56 @@ void DuoVio::loadCustomCameraCalibration(const std::string calib_path) {
         YAML::Node YamlNode = YAML::LoadFile(calib_path);
         if (YamlNode.IsNull()) {
             ROS_FATAL("Failed to open camera calibration %s", calib_path.c_str());
-            exit(-1);
+            calibrationFailed();
+            return;
         }
         cameraParams = parseYaml(YamlNode);
         vio.setParams(cameraParams, noiseParams, vioParams);
+        time_shift_estimator.setTimeShift(cameraParams.time_shift);
+        time_shift_estimator.setCamera(cameraParams.CameraParameters1);
     } catch (YAML::BadFile &e) {
         ROS_FATAL("Failed to open camera calibration %s\nException: %s", calib_path.c_str(), e.what());
+        calibrationFailed();
+        return;
+    }
+
+    if (use_undistortion_map) {
+        int resolution_width;
+        nh_.param<int>("cam_resolution_width", resolution_width, 0);
+        int resolution_height;
+        nh_.param<int>("cam_resolution_height", resolution_height, 0);
+        loadUndistortionMaps(calib_path.substr(0, calib_path.find_last_of('/') + 1), resolution_width, resolution_height);
+    }
+}
+
+void DuoVio::calibrationFailed() {
+    if (standalone)
         exit(-1);
+    ROS_ERROR("No valid camera calibration, not processing the sensor messages");
+    calibration_failed = true;
+}
+
+static void loadUndistortionMap(UndistortionMap &map, const CameraParameters &params, const std::string &path, int width, int height, int step) {
+    if (map.load(path) && map.matches(params, width, height) && map.step() == step) {
+        ROS_INFO("Loaded undistortion map %s", path.c_str());
+        return;
     }
+
+    ROS_INFO("Building undistortion map %s", path.c_str());
+    map.build(params, width, height, step);
+    if (!map.save(path))
+        ROS_WARN("Failed to write undistortion map %s", path.c_str());
+}
+
+void DuoVio::loadUndistortionMaps(const std::string &calib_dir, int width, int height) {
+    // the maps replace the undistortion of the feature observations in the update. They are cached next to the calibration
+    if (width <= 0 || height <= 0) {
+        ROS_WARN("Camera resolution unknown, not using undistortion maps");
+        return;
+    }
+    loadUndistortionMap(undistortionMapL, cameraParams.CameraParameters1, calib_dir + "undistortion_map_l.bin", width, height, undistortion_map_step);
+    loadUndistortionMap(undistortionMapR, cameraParams.CameraParameters2, calib_dir + "undistortion_map_r.bin", width, height, undistortion_map_step);
+    vio.setUndistortionMaps(&undistortionMapL, &undistortionMapR);
 }
 
 void DuoVio::dynamicReconfigureCb(duo_vio::duo_vioConfig &config, uint32_t level) {
@@ -400,6 +605,7 @@ void DuoVio::dynamicReconfigureCb(duo_vio::duo_vioConfig &config, uint32_t level
 void DuoVio::resetCb(const std_msgs::Empty &msg) {
     ROS_WARN("Got reset command");
     SLAM_reset_flag = true;
+    reset_stamp = ros::Time::now();
 
     ROS_INFO("Longest update duration: %.3f msec, %.3f Hz\n", float(max_clicks_)/CLOCKS_PER_SEC, CLOCKS_PER_SEC/float(max_clicks_));
 
@@ -408,30 +614,93 @@ void DuoVio::resetCb(const std_msgs::Empty &msg) {
     dist = 0;
 }
 
-void DuoVio::update(double dt, const ait_ros_messages::VioSensorMsg &msg, bool update_vis, bool show_image, bool reset) {
+void DuoVio::update(double dt, const ait_ros_messages::VioSensorMsgConstPtr &msg_ptr, bool update_vis, bool show_image, bool reset) {
+    const ait_ros_messages::VioSensorMsg &msg = *msg_ptr;
     std::vector<FloatType> z_all_l(matlab_consts::numTrackFeatures * 2, 0.0);
     std::vector<FloatType> z_all_r(matlab_consts::numTrackFeatures * 2, 0.0);
-    std::vector<cv::Point2f> features_l(matlab_consts::numTrackFeatures);
-    std::vector<cv::Point2f> features_r(matlab_consts::numTrackFeatures);
-    std::vector<FloatType> delayedStatus(matlab_consts::numTrackFeatures);
 
-    //*********************************************************************
-    // SLAM prediction
-    //*********************************************************************
     ros::Time tic_SLAM = ros::Time::now();
 
-    VIOMeasurements meas;
-
+    // the history can not go back past a reset
+    HistoryFrame *history_frame = NULL;
     if (reset)
-        vio.reset();
+        history.clear();
+    else if (history.capacity())
+        history_frame = &recordHistoryFrame();
+
+    // the IMU samples after the image are integrated after the update
+    bool vision = (auto_subsample || vio_cnt % vision_subsample == 0) && !msg.left_image.data.empty() && !msg.right_image.data.empty();
+    ros::Time image_stamp = vision ? imageStamp(msg) : ros::Time();
+    std::vector<IMUSample> &imu_samples = history_frame ? history_frame->imu : imu_samples_;
+    int next_imu = predict(dt, msg, reset, imu_samples, image_stamp);
+    if (history_frame)
+        history_frame->image_stamp = image_stamp;
+    if (reset)
+        std::fill(update_vec_.begin(), update_vec_.end(), 0);  // the tracked features are unknown to the new filter
+
+    if (vision) {
+        double duration_feature_tracking;
+        if (!trackFrame(msg_ptr, update_vec_, z_all_l, z_all_r, duration_feature_tracking)) {
+            integrateIMU(imu_samples, next_imu, ros::Time(), true);
+            return;
+        }
+
+        if (estimate_time_shift)
+            estimateTimeShift(image_stamp, update_vec_, z_all_l);
+
+        if (history_frame) {
+            history_frame->vision = true;
+            history_frame->update_vec = update_vec_;
+            history_frame->z_all_l = z_all_l;
+            history_frame->z_all_r = z_all_r;
+        }
+
+        updateFilter(update_vec_, z_all_l, z_all_r, update_vis);
+        integrateIMU(imu_samples, next_imu, ros::Time(), true);
+
+        double duration_SLAM = (ros::Time::now() - tic_SLAM).toSec() - duration_feature_tracking;
+        filter_frame_time += 0.1 * (duration_SLAM - filter_frame_time);
+        std_msgs::Float32 duration_SLAM_msg;
+        duration_SLAM_msg.data = duration_SLAM;
+        timing_SLAM_pub.publish(duration_SLAM_msg);
+        publishTelemetry(image_stamp, duration_SLAM);
+
+        publishVis(msg_ptr, update_vec_, z_all_l, update_vis, show_image);
+    } else {
+        double duration_SLAM = (ros::Time::now() - tic_SLAM).toSec();
+        std_msgs::Float32 duration_SLAM_msg;
+        duration_SLAM_msg.data = duration_SLAM;
+        timing_SLAM_pub.publish(duration_SLAM_msg);
+    }
+    vio_cnt++;
+}
+
+// Predict with the IMU samples of the message, up to the image time if it is
+// set. The samples are copied to imu_samples. Returns the index of the first
+// sample that still has to be integrated with integrateIMU after the update.
+int DuoVio::predict(double dt, const ait_ros_messages::VioSensorMsg &msg, bool reset, std::vector<IMUSample> &imu_samples, const ros::Time &image_stamp) {
+    //*********************************************************************
+    // SLAM prediction
+    //*********************************************************************
+    if (reset) {
+        if (warm_reset && has_estimate)
+            vio.resetWarm(robot_state);
+        else
+            vio.reset();
+        time_shift_estimator.reset();
+    }
 
+    imu_samples.resize(msg.imu.size());
     for (int i = 0; i < msg.imu.size(); i++) {
-        getIMUData(msg.imu[i], meas);  // write the IMU data into the appropriate struct
-        imulp_.put(meas);  // filter the IMU data
-        imulp_.get(meas);
-        vio.predict(meas, dt / msg.imu.size());
+        imu_samples[i].stamp = msg.imu[i].header.stamp;
+        imu_samples[i].fallback_dt = dt / msg.imu.size();
+        getIMUData(msg.imu[i], imu_samples[i].meas);  // write the IMU data into the appropriate struct
     }
 
+    int next = integrateIMU(imu_samples, 0, image_stamp, true);
+
+    VIOMeasurements meas;
+    imulp_.get(meas);
     sensor_msgs::Imu smoothed;
     smoothed.header = msg.header;
     smoothed.linear_acceleration.x = meas.acc[0];
@@ -443,102 +712,450 @@ void DuoVio::update(double dt, const ait_ros_messages::VioSensorMsg &msg, bool u
 
     smoothed_imu_pub.publish(smoothed);
 
-    if ((auto_subsample || vio_cnt % vision_subsample == 0) && !msg.left_image.data.empty() && !msg.right_image.data.empty()) {
-        cv_bridge::CvImagePtr left_image;
-        cv_bridge::CvImagePtr right_image;
-        try {
-            left_image = cv_bridge::toCvCopy(msg.left_image, "mono8");
-            right_image = cv_bridge::toCvCopy(msg.right_image, "mono8");
-        } catch (cv_bridge::Exception& e) {
-            ROS_ERROR("Error while converting ROS image to OpenCV: %s", e.what());
-            return;
+    return next;
+}
+
+// Integrate the IMU samples from index next on, up to the time until if it is
+// set. The interval of the sample that contains until is split, the sample is
+// integrated to until with its filtered measurement and the rest is left to the
+// next call. If until is after the last sample, the last measurement is held.
+// Returns the index of the first sample that is not completely integrated.
+int DuoVio::integrateIMU(const std::vector<IMUSample> &samples, int next, const ros::Time &until, bool publish_imu_pose) {
+    VIOMeasurements meas;
+    bool split = !until.isZero() && !prev_imu_stamp_.isZero();
+    publish_imu_pose = publish_imu_pose && (imu_pose_pub.getNumSubscribers() || imu_vel_pub.getNumSubscribers());
+
+    for (; next < samples.size(); next++) {
+        const IMUSample &sample = samples[next];
+        if (split && !sample.stamp.isZero() && sample.stamp > until) {
+            if (until > prev_imu_stamp_) {
+                IMULowpass imulp = imulp_;  // the sample enters the low-pass filter with the rest of its interval
+                imulp.put(sample.meas);
+                imulp.get(meas);
+                vio.predict(meas, (until - prev_imu_stamp_).toSec(), predicted_state_);
+                prev_imu_stamp_ = until;
+            }
+            return next;
         }
 
-        //*********************************************************************
-        // Point tracking
-        //*********************************************************************
+        imulp_.put(sample.meas);  // filter the IMU data
+        imulp_.get(meas);
+        if (publish_imu_pose || estimate_time_shift)
+            vio.predict(meas, imuDt(sample.stamp, sample.fallback_dt), predicted_state_);
+        else
+            vio.predict(meas, imuDt(sample.stamp, sample.fallback_dt));  // the state is not needed
 
-        ros::Time tic_feature_tracking = ros::Time::now();
+        if (publish_imu_pose)
+            publishIMUPose(predicted_state_, sample.stamp);
+    }
 
-        cv::Mat left, right;
-        if (use_dark_current) {
-            left = left_image->image - darkCurrentL;
-            right = right_image->image - darkCurrentR;
-        } else {
-            left = left_image->image;
-            right = right_image->image;
+    if (split && until > prev_imu_stamp_ && (until - prev_imu_stamp_).toSec() < vision_subsample / fps) {
+        imulp_.get(meas);
+        vio.predict(meas, (until - prev_imu_stamp_).toSec(), predicted_state_);
+        prev_imu_stamp_ = until;
+    }
+
+    return next;
+}
+
+// time the image of the message was taken in the IMU time
+ros::Time DuoVio::imageStamp(const ait_ros_messages::VioSensorMsg &msg) {
+    return msg.header.stamp + ros::Duration(time_shift_estimator.timeShift());
+}
+
+// refine the time shift with the tracked features of the image and the state predicted to it
+void DuoVio::estimateTimeShift(const ros::Time &image_stamp, const std::vector<int> &update_vec, const std::vector<FloatType> &z_all_l) {
+    time_shift_estimator.addFrame(image_stamp.toSec(), predicted_state_, &map[0], &update_vec[0], &z_all_l[0]);
+
+    std_msgs::Float32 time_shift_msg;
+    time_shift_msg.data = time_shift_estimator.timeShift();
+    time_shift_pub.publish(time_shift_msg);
+}
+
+// Time since the last integrated IMU sample. Falls back to the given time
+// difference if the stamps are missing or out of the plausible range.
+double DuoVio::imuDt(const ros::Time &stamp, double fallback_dt) {
+    double dt = fallback_dt;
+    if (!prev_imu_stamp_.isZero() && !stamp.isZero()) {
+        double stamp_dt = (stamp - prev_imu_stamp_).toSec();
+        if (stamp_dt > 0 && stamp_dt < 100 / fps)
+            dt = stamp_dt;
+    }
+    if (stamp > prev_imu_stamp_)
+        prev_imu_stamp_ = stamp;
+    return dt;
+}
+
+// Store the filter state before the next frame, reusing the oldest frame once the history is full.
+HistoryFrame &DuoVio::recordHistoryFrame() {
+    if (history.full())
+        history.rotate(history.begin() + 1);
+    else
+        history.push_back(HistoryFrame());
+
+    HistoryFrame &frame = history.back();
+    frame.start = prev_imu_stamp_;
+    vio.getCheckpoint(frame.checkpoint);
+    frame.imulp = imulp_;
+    frame.imu.clear();
+    frame.image_stamp = ros::Time();
+    frame.vision = false;
+    return frame;
+}
+
+// Merge the IMU samples of a late message into the frames of their time and
+// run the filter again from the first frame that changed. The updates are
+// repeated with the stored tracker output. Returns false if the message is
+// older than the history, or if re-running the frames after it is expected to
+// take longer than history_max_reintegration_time. The callback is blocked
+// for that long at most, give or take the variation of the filter time.
+bool DuoVio::reintegrateLate(const ait_ros_messages::VioSensorMsg &msg) {
+    if (history.empty() || msg.imu.empty() || msg.imu[0].header.stamp <= history.front().start)
+        return false;
+
+    // the frame each sample belongs to, -1 if it is older than the history
+    std::vector<int> frame_idx(msg.imu.size());
+    int first = history.size();
+    for (int i = 0; i < msg.imu.size(); i++) {
+        const ros::Time &stamp = msg.imu[i].header.stamp;
+        int j = history.size() - 1;
+        while (j > 0 && history[j].start >= stamp)
+            j--;
+        frame_idx[i] = stamp <= history[j].start ? -1 : j;
+        if (frame_idx[i] >= 0)
+            first = std::min(first, j);
+    }
+    if (first < history.size() && (history.size() - first) * filter_frame_time > history_max_reintegration_time) {
+        ROS_WARN_THROTTLE(1.0, "Re-integrating a late message would re-run %d frames, dropping it", (int) history.size() - first);
+        return false;
+    }
+
+    first = history.size();
+    for (int i = 0; i < msg.imu.size(); i++) {
+        const ros::Time &stamp = msg.imu[i].header.stamp;
+        int j = frame_idx[i];
+        if (j < 0)
+            continue;
+
+        std::vector<IMUSample> &imu = history[j].imu;
+        std::vector<IMUSample>::iterator it = imu.begin();
+        while (it != imu.end() && it->stamp < stamp)
+            ++it;
+        if (it != imu.end() && it->stamp == stamp)
+            continue;  // already integrated
+
+        IMUSample sample;
+        sample.stamp = stamp;
+        sample.fallback_dt = 1 / fps / msg.imu.size();
+        getIMUData(msg.imu[i], sample.meas);
+        imu.insert(it, sample);
+        first = std::min(first, j);
+    }
+    if (first == history.size())
+        return true;
+
+    HistoryFrame &start_frame = history[first];
+    vio.restoreCheckpoint(&start_frame.checkpoint[0], start_frame.checkpoint.size());
+    imulp_ = start_frame.imulp;
+    prev_imu_stamp_ = start_frame.start;
+
+    for (int j = first; j < history.size(); j++) {
+        HistoryFrame &frame = history[j];
+        if (j > first) {
+            frame.start = prev_imu_stamp_;
+            vio.getCheckpoint(frame.checkpoint);
+            frame.imulp = imulp_;
+        }
+
+        int next_imu = integrateIMU(frame.imu, 0, frame.image_stamp, false);
+        if (frame.vision) {
+            update_vec_ = frame.update_vec;
+            vio.update(update_vec_, frame.z_all_l, frame.z_all_r, robot_state, map, anchor_poses, delayed_status, filterOutputs(false));
         }
+        integrateIMU(frame.imu, next_imu, ros::Time(), false);
+    }
+
+    return true;
+}
+
+void DuoVio::publishIMUPose(const RobotState &state, const ros::Time &stamp) {
+    geometry_msgs::PoseStamped pose;
+    pose.header.stamp = stamp;
+    pose.header.frame_id = "world";
+    pose.pose.position.x = state.pos[0];
+    pose.pose.position.y = state.pos[1];
+    pose.pose.position.z = state.pos[2];
+    pose.pose.orientation.x = state.att[0];
+    pose.pose.orientation.y = state.att[1];
+    pose.pose.orientation.z = state.att[2];
+    pose.pose.orientation.w = state.att[3];
+    imu_pose_pub.publish(pose);
+
+    geometry_msgs::Vector3Stamped vel;
+    vel.header = pose.header;
+    vel.vector.x = state.vel[0];
+    vel.vector.y = state.vel[1];
+    vel.vector.z = state.vel[2];
+    imu_vel_pub.publish(vel);
+}
+
+bool DuoVio::trackFrame(const ait_ros_messages::VioSensorMsgConstPtr &msg, std::vector<int> &update_vec, std::vector<FloatType> &z_all_l, std::vector<FloatType> &z_all_r,
+        double &duration) {
+    std::vector<cv::Point2f> features_l(matlab_consts::numTrackFeatures);
+    std::vector<cv::Point2f> features_r(matlab_consts::numTrackFeatures);
+
+    // wrap the message buffers, mono8 images are not copied. The message is kept
+    // alive until the next frame is tracked, see tracked_msg
+    cv_bridge::CvImageConstPtr left_image;
+    cv_bridge::CvImageConstPtr right_image;
+    try {
+        left_image = cv_bridge::toCvShare(msg->left_image, msg, "mono8");
+        right_image = cv_bridge::toCvShare(msg->right_image, msg, "mono8");
+    } catch (cv_bridge::Exception& e) {
+        ROS_ERROR("Error while converting ROS image to OpenCV: %s", e.what());
+        return false;
+    }
+
+    //*********************************************************************
+    // Point tracking
+    //*********************************************************************
 
-        trackFeatures(left, right, features_l, features_r, update_vec_, 1+vioParams.full_stereo);
+    ros::Time tic_feature_tracking = ros::Time::now();
 
-        for (int i = 0; i < features_l.size(); i++) {
-            z_all_l[2*i + 0] = features_l[i].x;
-            z_all_l[2*i + 1] = features_l[i].y;
+    cv::Mat left, right;
+    if (use_dark_current) {
+        ros::Time tic_preprocessing = ros::Time::now();
+        // the other buffers still hold the previous frame
+        left = correctedL[corrected_idx];
+        right = correctedR[corrected_idx];
+        corrected_idx = 1 - corrected_idx;
+        correctStereo(imageCorrectionL, left_image->image, left, imageCorrectionR, right_image->image, right);
+
+        std_msgs::Float32 duration_preprocessing_msg;
+        duration_preprocessing_msg.data = (ros::Time::now() - tic_preprocessing).toSec();
+        timing_preprocessing_pub.publish(duration_preprocessing_msg);
+    } else {
+        left = left_image->image;
+        right = right_image->image;
+    }
+
+    trackFeatures(left, right, features_l, features_r, update_vec, 1+vioParams.full_stereo);
+    tracked_msg = msg;  // releases the message of the previous frame
+
+    for (int i = 0; i < features_l.size(); i++) {
+        z_all_l[2*i + 0] = features_l[i].x;
+        z_all_l[2*i + 1] = features_l[i].y;
+
+        z_all_r[2*i + 0] = features_r[i].x;
+        z_all_r[2*i + 1] = features_r[i].y;
+    }
 
-            z_all_r[2*i + 0] = features_r[i].x;
-            z_all_r[2*i + 1] = features_r[i].y;
+    duration = (ros::Time::now() - tic_feature_tracking).toSec();
+    std_msgs::Float32 duration_feature_tracking_msg;
+    duration_feature_tracking_msg.data = duration;
+    timing_feature_tracking_pub.publish(duration_feature_tracking_msg);
+    return true;
+}
+
+// The filter outputs needed after an update. The map and the anchors are only
+// built for the visualization, and the map for the time shift estimation.
+int DuoVio::filterOutputs(bool update_vis) const {
+    int outputs = SLAM_OUTPUT_ROBOT_STATE;
+    if (update_vis)
+        outputs |= SLAM_OUTPUT_MAP | SLAM_OUTPUT_ANCHOR_POSES;
+    if (estimate_time_shift)
+        outputs |= SLAM_OUTPUT_MAP;
+    return outputs;
+}
+
+void DuoVio::updateFilter(std::vector<int> &update_vec, std::vector<FloatType> &z_all_l, std::vector<FloatType> &z_all_r, bool update_vis) {
+    //*********************************************************************
+    // SLAM update
+    //*********************************************************************
+    vio.update(update_vec, z_all_l, z_all_r, robot_state, map, anchor_poses, delayed_status, filterOutputs(update_vis), telemetry_);
+    has_estimate = true;
+
+    camera_tf.setOrigin(tf::Vector3(robot_state.pos[0], robot_state.pos[1], robot_state.pos[2]));
+    camera_tf.setRotation(tf::Quaternion(robot_state.att[0], robot_state.att[1], robot_state.att[2], robot_state.att[3]));
+    tf_broadcaster.sendTransform(tf::StampedTransform(camera_tf, ros::Time::now(), "world", "camera"));
+
+    body_tf.setRotation(cam2body);
+    tf_broadcaster.sendTransform(tf::StampedTransform(body_tf, ros::Time::now(), "camera", "body"));
+
+    geometry_msgs::Pose pose;
+    pose.position.x = robot_state.pos[0];
+    pose.position.y = robot_state.pos[1];
+    pose.position.z = robot_state.pos[2];
+    pose.orientation.x = robot_state.att[0];
+    pose.orientation.y = robot_state.att[1];
+    pose.orientation.z = robot_state.att[2];
+    pose.orientation.w = robot_state.att[3];
+    pose_pub.publish(pose);
+
+    geometry_msgs::Vector3 vel;
+    vel.x = robot_state.vel[0];
+    vel.y = robot_state.vel[1];
+    vel.z = robot_state.vel[2];
+    vel_pub.publish(vel);
+}
+
+// Publish the telemetry of the last update and append it to the telemetry file.
+void DuoVio::publishTelemetry(const ros::Time &image_stamp, double duration_SLAM) {
+    if (telemetry_file) {
+        TelemetryRecord record;
+        record.stamp = image_stamp.toSec();
+        record.duration_SLAM = duration_SLAM;
+        record.telemetry = telemetry_;
+        if (fwrite(&record, sizeof(record), 1, telemetry_file) != 1) {
+            ROS_ERROR("Failed to write the telemetry file, closing it");
+            fclose(telemetry_file);
+            telemetry_file = NULL;
         }
+    }
 
-        double duration_feature_tracking = (ros::Time::now() - tic_feature_tracking).toSec();
-        std_msgs::Float32 duration_feature_tracking_msg;
-        duration_feature_tracking_msg.data = duration_feature_tracking;
-        timing_feature_tracking_pub.publish(duration_feature_tracking_msg);
-
-        //*********************************************************************
-        // SLAM update
-        //*********************************************************************
-        vio.update(update_vec_, z_all_l, z_all_r, robot_state, map, anchor_poses, delayedStatus);
-
-        camera_tf.setOrigin(tf::Vector3(robot_state.pos[0], robot_state.pos[1], robot_state.pos[2]));
-        camera_tf.setRotation(tf::Quaternion(robot_state.att[0], robot_state.att[1], robot_state.att[2], robot_state.att[3]));
-        tf_broadcaster.sendTransform(tf::StampedTransform(camera_tf, ros::Time::now(), "world", "camera"));
-
-        body_tf.setRotation(cam2body);
-        tf_broadcaster.sendTransform(tf::StampedTransform(body_tf, ros::Time::now(), "camera", "body"));
-
-        geometry_msgs::Pose pose;
-        pose.position.x = robot_state.pos[0];
-        pose.position.y = robot_state.pos[1];
-        pose.position.z = robot_state.pos[2];
-        pose.orientation.x = robot_state.att[0];
-        pose.orientation.y = robot_state.att[1];
-        pose.orientation.z = robot_state.att[2];
-        pose.orientation.w = robot_state.att[3];
-        pose_pub.publish(pose);
-
-        geometry_msgs::Vector3 vel;
-        vel.x = robot_state.vel[0];
-        vel.y = robot_state.vel[1];
-        vel.z = robot_state.vel[2];
-        vel_pub.publish(vel);
+    if (!telemetry_pub.getNumSubscribers())
+        return;
 
-        double duration_SLAM = (ros::Time::now() - tic_SLAM).toSec() - duration_feature_tracking;
-        std_msgs::Float32 duration_SLAM_msg;
-        duration_SLAM_msg.data = duration_SLAM;
-        timing_SLAM_pub.publish(duration_SLAM_msg);
+    duo_vio::VioTelemetry msg;
+    msg.header.stamp = image_stamp;
+    msg.duration_SLAM = duration_SLAM;
+    msg.ransac_hypotheses = telemetry_.ransac_hypotheses;
+    msg.li_inliers = telemetry_.li_inliers;
+    msg.hi_inliers = telemetry_.hi_inliers;
+    msg.ekf_iterations = telemetry_.ekf_iterations;
+    msg.active_features = telemetry_.active_features;
+    msg.delayed_features = telemetry_.delayed_features;
+    msg.new_features = telemetry_.new_features;
+    msg.anchor_initializations = telemetry_.anchor_initializations;
+    msg.origin_anchor_switch = telemetry_.origin_anchor_switch != 0;
+    msg.innovation_norm = telemetry_.innovation_norm;
+    msg.robot_cov_trace = telemetry_.robot_cov_trace;
+    telemetry_pub.publish(msg);
+}
+
+void DuoVio::publishVis(const ait_ros_messages::VioSensorMsgConstPtr &msg, std::vector<int> &update_vec, std::vector<FloatType> &z_all_l, bool update_vis,
+        bool show_image) {
+    dist += sqrt(
+            (robot_state.pos[0] - last_pos[0]) * (robot_state.pos[0] - last_pos[0])
+                    + (robot_state.pos[1] - last_pos[1]) * (robot_state.pos[1] - last_pos[1])
+                    + (robot_state.pos[2] - last_pos[2]) * (robot_state.pos[2] - last_pos[2]));
 
-        dist += sqrt(
-                (robot_state.pos[0] - last_pos[0]) * (robot_state.pos[0] - last_pos[0])
-                        + (robot_state.pos[1] - last_pos[1]) * (robot_state.pos[1] - last_pos[1])
-                        + (robot_state.pos[2] - last_pos[2]) * (robot_state.pos[2] - last_pos[2]));
+    last_pos[0] = robot_state.pos[0];
+    last_pos[1] = robot_state.pos[1];
+    last_pos[2] = robot_state.pos[2];
 
-        last_pos[0] = robot_state.pos[0];
-        last_pos[1] = robot_state.pos[1];
-        last_pos[2] = robot_state.pos[2];
+    if (update_vis) {
+        show_image = show_image && (display_tracks_cnt % image_visualization_delay == 0);
+        display_tracks_cnt++;
 
-        if (update_vis) {
-            show_image = show_image && (display_tracks_cnt % image_visualization_delay == 0);
-            display_tracks_cnt++;
+        updateVis(robot_state, anchor_poses, map, update_vec, msg, z_all_l, show_image);
+    }
+}
 
-            updateVis(robot_state, anchor_poses, map, update_vec_, msg, z_all_l, show_image);
+void DuoVio::trackingThread() {
+    PipelineFrame *frame;
+    while (true) {
+        tracking_sem.wait();
+        if (!pipeline_running)
+            return;
+        tracking_queue.pop(frame);
+
+        if (frame->vision) {
+            // continue from the last tracked status. The filter only decides about the
+            // features of this frame once it is tracked, new features are kept and the
+            // features the filter has rejected in the meantime are dropped
+            for (int i = 0; i < matlab_consts::numTrackFeatures; i++) {
+                if (tracker_update_vec[i] == 2)
+                    tracker_update_vec[i] = 1;
+                if (tracker_update_vec[i] != 0 && killed_generation[i] == tracker_generation[i])
+                    tracker_update_vec[i] = 0;
+            }
+
+            double duration_feature_tracking;
+            frame->vision = trackFrame(frame->msg, tracker_update_vec, frame->z_all_l, frame->z_all_r, duration_feature_tracking);
+
+            for (int i = 0; i < matlab_consts::numTrackFeatures; i++)
+                if (tracker_update_vec[i] == 2)
+                    tracker_generation[i]++;
+            frame->update_vec = tracker_update_vec;
+            frame->generation = tracker_generation;
         }
-    } else {
-        double duration_SLAM = (ros::Time::now() - tic_SLAM).toSec();
-        std_msgs::Float32 duration_SLAM_msg;
-        duration_SLAM_msg.data = duration_SLAM;
-        timing_SLAM_pub.publish(duration_SLAM_msg);
+
+        filter_queue.push(frame);
+        filter_sem.post();
+    }
+}
+
+void DuoVio::filterThread() {
+    PipelineFrame *frame;
+    bool reset_pending = false;  // the features of the next tracked frame are unknown to the new filter
+    while (true) {
+        filter_sem.wait();
+        if (!pipeline_running)
+            return;
+        filter_queue.pop(frame);
+
+        ros::Time tic_SLAM = ros::Time::now();
+
+        ros::Time image_stamp = frame->vision ? imageStamp(*frame->msg) : ros::Time();
+        int next_imu = predict(frame->dt, *frame->msg, frame->reset, imu_samples_, image_stamp);
+        reset_pending = reset_pending || frame->reset;
+
+        if (frame->vision) {
+            if (reset_pending) {
+                for (int i = 0; i < matlab_consts::numTrackFeatures; i++)
+                    if (frame->update_vec[i] != 0)
+                        killed_generation[i] = frame->generation[i];
+                reset_pending = false;
+            }
+
+            // features that were rejected by an earlier update can still be tracked in this frame
+            for (int i = 0; i < matlab_consts::numTrackFeatures; i++)
+                if (frame->update_vec[i] != 0 && killed_generation[i] == frame->generation[i])
+                    frame->update_vec[i] = 0;
+
+            std::vector<int> tracked_vec = frame->update_vec;
+
+            if (estimate_time_shift)
+                estimateTimeShift(image_stamp, frame->update_vec, frame->z_all_l);
+
+            updateFilter(frame->update_vec, frame->z_all_l, frame->z_all_r, frame->update_vis);
+            integrateIMU(imu_samples_, next_imu, ros::Time(), true);
+
+            for (int i = 0; i < matlab_consts::numTrackFeatures; i++)
+                if (tracked_vec[i] != 0 && frame->update_vec[i] == 0)
+                    killed_generation[i] = frame->generation[i];
+
+            double duration_SLAM = (ros::Time::now() - tic_SLAM).toSec();
+            std_msgs::Float32 duration_SLAM_msg;
+            duration_SLAM_msg.data = duration_SLAM;
+            timing_SLAM_pub.publish(duration_SLAM_msg);
+            publishTelemetry(image_stamp, duration_SLAM);
+
+            publishVis(frame->msg, frame->update_vec, frame->z_all_l, frame->update_vis, frame->show_image);
+        } else {
+            integrateIMU(imu_samples_, next_imu, ros::Time(), true);
+
+            double duration_SLAM = (ros::Time::now() - tic_SLAM).toSec();
+            std_msgs::Float32 duration_SLAM_msg;
+            duration_SLAM_msg.data = duration_SLAM;
+            timing_SLAM_pub.publish(duration_SLAM_msg);
+        }
+
+        vio_sensor_processed_pub.publish(frame->msg->seq);
+
+        double duration_total = (ros::Time::now() - frame->tic_total).toSec();
+        std_msgs::Float32 duration_total_msg;
+        duration_total_msg.data = duration_total;
+        timing_total_pub.publish(duration_total_msg);
+
+        if (duration_total > (PIPELINE_QUEUE_SIZE + 1) * vision_subsample / fps)
+            ROS_WARN_THROTTLE(1.0, "Pipeline latency: %.3f ms", duration_total * 1000);
+
+        frame->msg.reset();  // do not keep the message alive
+        free_queue.push(frame);
+        free_sem.post();
     }
-    vio_cnt++;
 }
 
 void DuoVio::getIMUData(const sensor_msgs::Imu& imu, VIOMeasurements& meas) {
@@ -552,8 +1169,70 @@ void DuoVio::getIMUData(const sensor_msgs::Imu& imu, VIOMeasurements& meas) {
 }
 
 void DuoVio::updateVis(RobotState &robot_state, std::vector<AnchorPose> &anchor_poses, std::vector<FloatType> &map, std::vector<int> &updateVect,
-        const ait_ros_messages::VioSensorMsg &sensor_msg, std::vector<FloatType> &z_l, bool show_image) {
-    ait_ros_messages::vio_vis msg;
+        const ait_ros_messages::VioSensorMsgConstPtr &sensor_msg, std::vector<FloatType> &z_l, bool show_image) {
+    // never wait for the visualization thread, drop the snapshot if it is busy with the mailbox
+    boost::unique_lock<boost::mutex> lock(vis_mutex, boost::try_to_lock);
+    if (!lock.owns_lock())
+        return;
+
+    VisSnapshot &snapshot = vis_snapshot_pending;
+    snapshot.robot_state = robot_state;
+    std::copy(anchor_poses.begin(), anchor_poses.end(), snapshot.anchor_poses);
+    std::copy(map.begin(), map.end(), snapshot.map);
+    std::copy(updateVect.begin(), updateVect.end(), snapshot.update_vec);
+    std::copy(z_l.begin(), z_l.end(), snapshot.z_l);
+    if (show_image)
+        snapshot.sensor_msg = sensor_msg;
+    else
+        snapshot.sensor_msg.reset();
+    vis_pending = true;
+    vis_cond.notify_one();
+}
+
+void DuoVio::visThread() {
+    boost::unique_lock<boost::mutex> lock(vis_mutex);
+    while (true) {
+        while (vis_running && !vis_pending)
+            vis_cond.wait(lock);
+        if (!vis_running)
+            return;
+
+        std::swap(vis_snapshot, vis_snapshot_pending);
+        vis_pending = false;
+        lock.unlock();
+
+        bool full = vis_full.exchange(false) || vis_msg_cnt % VIS_FULL_INTERVAL == 0;
+        publishVisMsg(vis_snapshot, full);
+        vis_msg_cnt++;
+        vis_snapshot.sensor_msg.reset();  // do not keep the message alive
+
+        lock.lock();
+    }
+}
+
+void DuoVio::visResetTimerCb(const ros::TimerEvent &event) {
+    vio_vis_reset_pub.publish(std_msgs::Empty());
+}
+
+// The visualizer missed the complete message the deltas refer to.
+void DuoVio::visRequestFullCb(const std_msgs::Empty &msg) {
+    vis_full = true;
+}
+
+void DuoVio::stopVis() {
+    {
+        boost::lock_guard<boost::mutex> lock(vis_mutex);
+        if (!vis_running)
+            return;
+        vis_running = false;
+    }
+    vis_cond.notify_one();
+    vis_thread.join();
+}
+
+void DuoVio::publishVisMsg(const VisSnapshot &snapshot, bool full) {
+    ait_ros_messages::vio_vis &msg = vis_msg;
+    const RobotState &robot_state = snapshot.robot_state;
 
     msg.robot_pose.position.x = robot_state.pos[0];
     msg.robot_pose.position.y = robot_state.pos[1];
@@ -564,45 +1243,105 @@ void DuoVio::updateVis(RobotState &robot_state, std::vector<AnchorPose> &anchor_
     msg.robot_pose.orientation.z = robot_state.att[2];
     msg.robot_pose.orientation.w = robot_state.att[3];
 
-    for (int i = 0; i < matlab_consts::numAnchors; i++) {
-        geometry_msgs::Pose pose;
-        pose.position.x = anchor_poses[i].pos[0];
-        pose.position.y = anchor_poses[i].pos[1];
-        pose.position.z = anchor_poses[i].pos[2];
-
-        pose.orientation.x = anchor_poses[i].att[0];
-        pose.orientation.y = anchor_poses[i].att[1];
-        pose.orientation.z = anchor_poses[i].att[2];
-        pose.orientation.w = anchor_poses[i].att[3];
+    // the anchors are sent if one of them moved since the last complete message,
+    // otherwise the list is empty
+    bool anchors_moved = full;
+    for (int i = 0; i < matlab_consts::numAnchors && !anchors_moved; i++) {
+        for (int j = 0; j < 3; j++)
+            anchors_moved = anchors_moved || std::abs(snapshot.anchor_poses[i].pos[j] - vis_sent_anchors[i].pos[j]) > VIS_POSITION_THRESHOLD;
+        for (int j = 0; j < 4; j++)
+            anchors_moved = anchors_moved || std::abs(snapshot.anchor_poses[i].att[j] - vis_sent_anchors[i].att[j]) > VIS_ATTITUDE_THRESHOLD;
+    }
 
-        msg.anchor_poses.poses.push_back(pose);
+    msg.anchor_poses.poses.resize(anchors_moved ? matlab_consts::numAnchors : 0);
+    if (anchors_moved) {
+        for (int i = 0; i < matlab_consts::numAnchors; i++) {
+            geometry_msgs::Pose &pose = msg.anchor_poses.poses[i];
+            pose.position.x = snapshot.anchor_poses[i].pos[0];
+            pose.position.y = snapshot.anchor_poses[i].pos[1];
+            pose.position.z = snapshot.anchor_poses[i].pos[2];
+
+            pose.orientation.x = snapshot.anchor_poses[i].att[0];
+            pose.orientation.y = snapshot.anchor_poses[i].att[1];
+            pose.orientation.z = snapshot.anchor_poses[i].att[2];
+            pose.orientation.w = snapshot.anchor_poses[i].att[3];
+
+            if (full)
+                vis_sent_anchors[i] = snapshot.anchor_poses[i];
+        }
     }
 
+    // a complete map has three values per feature. Otherwise the map is a list of
+    // (slot, x, y, z) of the features that moved or changed their status since
+    // the last complete message. The "full" dimension holds the number of that
+    // message, the visualizer asks for a new one if it did not receive it.
+    if (full)
+        vis_full_msg_cnt = vis_msg_cnt;
+    msg.map.layout.dim.resize(full ? 1 : 2);
+    msg.map.data.resize(full ? matlab_consts::numTrackFeatures * 3 : 0);
+    msg.status_vect.data.resize(matlab_consts::numTrackFeatures);
+    msg.feature_tracks.data.resize(matlab_consts::numTrackFeatures * 2);
+
     for (int i = 0; i < matlab_consts::numTrackFeatures; i++) {
-        msg.map.data.push_back(map[i * 3 + 0]);
-        msg.map.data.push_back(map[i * 3 + 1]);
-        msg.map.data.push_back(map[i * 3 + 2]);
-
-        msg.status_vect.data.push_back(updateVect[i]);
-        if (updateVect[i] == 1) {
-            msg.feature_tracks.data.push_back(z_l[i * 2 + 0]);
-            msg.feature_tracks.data.push_back(z_l[i * 2 + 1]);
+        const FloatType *point = snapshot.map + i * 3;
+        FloatType *sent_point = vis_sent_map + i * 3;
+        if (full) {
+            for (int j = 0; j < 3; j++) {
+                msg.map.data[i * 3 + j] = point[j];
+                sent_point[j] = point[j];
+            }
+        } else if (snapshot.update_vec[i] > 0) {
+            bool moved = snapshot.update_vec[i] != vis_sent_status[i];
+            for (int j = 0; j < 3; j++)
+                moved = moved || std::abs(point[j] - sent_point[j]) > VIS_POSITION_THRESHOLD;
+            if (moved) {
+                msg.map.data.push_back(i);
+                for (int j = 0; j < 3; j++)
+                    msg.map.data.push_back(point[j]);
+            }
+        }
+        if (full)
+            vis_sent_status[i] = snapshot.update_vec[i];
+
+        msg.status_vect.data[i] = snapshot.update_vec[i];
+        if (snapshot.update_vec[i] == 1) {
+            msg.feature_tracks.data[i * 2 + 0] = snapshot.z_l[i * 2 + 0];
+            msg.feature_tracks.data[i * 2 + 1] = snapshot.z_l[i * 2 + 1];
         } else {
-            msg.feature_tracks.data.push_back(-100);
-            msg.feature_tracks.data.push_back(-100);
+            msg.feature_tracks.data[i * 2 + 0] = -100;
+            msg.feature_tracks.data[i * 2 + 1] = -100;
         }
     }
 
-    if (show_image)
-        msg.image = sensor_msg.left_image;
-
-    msg.gyro_bias.data.push_back(robot_state.IMU.gyro_bias[0]);
-    msg.gyro_bias.data.push_back(robot_state.IMU.gyro_bias[1]);
-    msg.gyro_bias.data.push_back(robot_state.IMU.gyro_bias[2]);
+    if (!full) {
+        msg.map.layout.dim[0].label = "slot";
+        msg.map.layout.dim[0].size = msg.map.data.size() / 4;
+        msg.map.layout.dim[0].stride = 4;
+    }
+    std_msgs::MultiArrayDimension &full_dim = msg.map.layout.dim.back();
+    full_dim.label = "full";
+    full_dim.size = vis_full_msg_cnt;
+    full_dim.stride = 0;
+
+    if (snapshot.sensor_msg) {
+        const sensor_msgs::Image &image = snapshot.sensor_msg->left_image;
+        msg.image.header = image.header;
+        msg.image.height = image.height;
+        msg.image.width = image.width;
+        msg.image.encoding = image.encoding;
+        msg.image.is_bigendian = image.is_bigendian;
+        msg.image.step = image.step;
+        msg.image.data.assign(image.data.begin(), image.data.end());  // reuses the buffer of the last image
+    } else {
+        msg.image.data.clear();
+    }
 
-    msg.acc_bias.data.push_back(robot_state.IMU.acc_bias[0]);
-    msg.acc_bias.data.push_back(robot_state.IMU.acc_bias[1]);
-    msg.acc_bias.data.push_back(robot_state.IMU.acc_bias[2]);
+    msg.gyro_bias.data.resize(3);
+    msg.acc_bias.data.resize(3);
+    for (int i = 0; i < 3; i++) {
+        msg.gyro_bias.data[i] = robot_state.IMU.gyro_bias[i];
+        msg.acc_bias.data[i] = robot_state.IMU.acc_bias[i];
+    }
 
     vio_vis_pub.publish(msg);
 }
@@ -0,0 +1,209 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * ImageCorrection.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "ImageCorrection.h"
+
+#include <stdint.h>
+
+#include <opencv2/highgui/highgui.hpp>
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static const int STRIPES_PER_IMAGE = 4;
+
+static void subtractRow(const uint8_t *in, const uint8_t *dark, uint8_t *out, int n) {
+    int i = 0;
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+    for (; i + 16 <= n; i += 16)
+        vst1q_u8(out + i, vqsubq_u8(vld1q_u8(in + i), vld1q_u8(dark + i)));
+#elif defined(__SSE2__)
+    for (; i + 16 <= n; i += 16) {
+        __m128i d = _mm_subs_epu8(_mm_loadu_si128((const __m128i *) (in + i)), _mm_loadu_si128((const __m128i *) (dark + i)));
+        _mm_storeu_si128((__m128i *) (out + i), d);
+    }
+#endif
+    for (; i < n; i++)
+        out[i] = in[i] > dark[i] ? in[i] - dark[i] : 0;
+}
+
+static void subtractScaleRow(const uint8_t *in, const uint8_t *dark, const uint16_t *gain, uint8_t *out, int n) {
+    int i = 0;
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t d = vqsubq_u8(vld1q_u8(in + i), vld1q_u8(dark + i));
+        uint16x8_t d_lo = vmovl_u8(vget_low_u8(d));
+        uint16x8_t d_hi = vmovl_u8(vget_high_u8(d));
+        uint16x8_t g_lo = vld1q_u16(gain + i);
+        uint16x8_t g_hi = vld1q_u16(gain + i + 8);
+        uint16x8_t p_lo = vcombine_u16(vqshrn_n_u32(vmull_u16(vget_low_u16(d_lo), vget_low_u16(g_lo)), ImageCorrection::GAIN_SHIFT),
+                vqshrn_n_u32(vmull_u16(vget_high_u16(d_lo), vget_high_u16(g_lo)), ImageCorrection::GAIN_SHIFT));
+        uint16x8_t p_hi = vcombine_u16(vqshrn_n_u32(vmull_u16(vget_low_u16(d_hi), vget_low_u16(g_hi)), ImageCorrection::GAIN_SHIFT),
+                vqshrn_n_u32(vmull_u16(vget_high_u16(d_hi), vget_high_u16(g_hi)), ImageCorrection::GAIN_SHIFT));
+        vst1q_u8(out + i, vcombine_u8(vqmovn_u16(p_lo), vqmovn_u16(p_hi)));
+    }
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        __m128i d = _mm_subs_epu8(_mm_loadu_si128((const __m128i *) (in + i)), _mm_loadu_si128((const __m128i *) (dark + i)));
+        __m128i d_lo = _mm_unpacklo_epi8(d, zero);
+        __m128i d_hi = _mm_unpackhi_epi8(d, zero);
+        __m128i g_lo = _mm_loadu_si128((const __m128i *) (gain + i));
+        __m128i g_hi = _mm_loadu_si128((const __m128i *) (gain + i + 8));
+        // (d * g) >> GAIN_SHIFT from the low and high halves of the 32 bit products
+        __m128i p_lo = _mm_or_si128(_mm_srli_epi16(_mm_mullo_epi16(d_lo, g_lo), ImageCorrection::GAIN_SHIFT),
+                _mm_slli_epi16(_mm_mulhi_epu16(d_lo, g_lo), 16 - ImageCorrection::GAIN_SHIFT));
+        __m128i p_hi = _mm_or_si128(_mm_srli_epi16(_mm_mullo_epi16(d_hi, g_hi), ImageCorrection::GAIN_SHIFT),
+                _mm_slli_epi16(_mm_mulhi_epu16(d_hi, g_hi), 16 - ImageCorrection::GAIN_SHIFT));
+        _mm_storeu_si128((__m128i *) (out + i), _mm_packus_epi16(p_lo, p_hi));
+    }
+#endif
+    for (; i < n; i++) {
+        int d = in[i] > dark[i] ? in[i] - dark[i] : 0;
+        int p = (d * gain[i]) >> ImageCorrection::GAIN_SHIFT;
+        out[i] = p > 255 ? 255 : p;
+    }
+}
+
+ImageCorrection::ImageCorrection() {
+}
+
+bool ImageCorrection::loadDarkCurrent(const std::string &path, int width, int height) {
+    cv::Mat dark = cv::imread(path, CV_LOAD_IMAGE_GRAYSCALE);
+    if (!dark.data || dark.rows != height || dark.cols != width)
+        return false;
+    dark_ = dark;
+    gain_.release();
+    return true;
+}
+
+bool ImageCorrection::loadFlatField(const std::string &path) {
+    cv::Mat flat = cv::imread(path, CV_LOAD_IMAGE_GRAYSCALE);
+    if (empty() || !flat.data || flat.size() != dark_.size())
+        return false;
+
+    // the gain scales every pixel to the mean response of the flat field
+    cv::Mat response;
+    cv::subtract(flat, dark_, response, cv::noArray(), CV_32F);
+    double mean = cv::mean(response)[0];
+    if (mean <= 0)
+        return false;
+
+    gain_.create(dark_.size(), CV_16UC1);
+    for (int row = 0; row < response.rows; row++) {
+        const float *r = response.ptr<float>(row);
+        uint16_t *g = gain_.ptr<uint16_t>(row);
+        for (int col = 0; col < response.cols; col++) {
+            double gain = mean / (r[col] < 1 ? 1 : r[col]) * (1 << GAIN_SHIFT) + 0.5;
+            g[col] = gain > MAX_GAIN ? MAX_GAIN : uint16_t(gain);
+        }
+    }
+    return true;
+}
+
+void ImageCorrection::clearGain() {
+    gain_.release();
+}
+
+bool ImageCorrection::empty() const {
+    return dark_.empty();
+}
+
+bool ImageCorrection::hasGain() const {
+    return !gain_.empty();
+}
+
+cv::Size ImageCorrection::size() const {
+    return dark_.size();
+}
+
+void ImageCorrection::correctRows(const cv::Mat &in, cv::Mat &out, int row_begin, int row_end) const {
+    for (int row = row_begin; row < row_end; row++) {
+        if (hasGain())
+            subtractScaleRow(in.ptr<uint8_t>(row), dark_.ptr<uint8_t>(row), gain_.ptr<uint16_t>(row), out.ptr<uint8_t>(row), in.cols);
+        else
+            subtractRow(in.ptr<uint8_t>(row), dark_.ptr<uint8_t>(row), out.ptr<uint8_t>(row), in.cols);
+    }
+}
+
+void ImageCorrection::correct(const cv::Mat &in, cv::Mat &out) const {
+    CV_Assert(in.type() == CV_8UC1 && in.size() == size());
+    out.create(in.size(), CV_8UC1);
+    correctRows(in, out, 0, in.rows);
+}
+
+class StereoCorrectionBody : public cv::ParallelLoopBody {
+    const ImageCorrection &correction_l_, &correction_r_;
+    const cv::Mat &in_l_, &in_r_;
+    cv::Mat &out_l_, &out_r_;
+
+public:
+    StereoCorrectionBody(const ImageCorrection &correction_l, const cv::Mat &in_l, cv::Mat &out_l, const ImageCorrection &correction_r,
+            const cv::Mat &in_r, cv::Mat &out_r) :
+                    correction_l_(correction_l),
+                    correction_r_(correction_r),
+                    in_l_(in_l),
+                    in_r_(in_r),
+                    out_l_(out_l),
+                    out_r_(out_r) {
+    }
+
+    // stripes [0, STRIPES_PER_IMAGE) are in the left image, the others in the right one
+    void operator()(const cv::Range &range) const {
+        for (int stripe = range.start; stripe < range.end; stripe++) {
+            bool left = stripe < STRIPES_PER_IMAGE;
+            const cv::Mat &in = left ? in_l_ : in_r_;
+            cv::Mat &out = left ? out_l_ : out_r_;
+            int s = stripe % STRIPES_PER_IMAGE;
+            (left ? correction_l_ : correction_r_).correctRows(in, out, in.rows * s / STRIPES_PER_IMAGE, in.rows * (s + 1) / STRIPES_PER_IMAGE);
+        }
+    }
+};
+
+void correctStereo(const ImageCorrection &correction_l, const cv::Mat &in_l, cv::Mat &out_l, const ImageCorrection &correction_r, const cv::Mat &in_r,
+        cv::Mat &out_r) {
+    CV_Assert(in_l.type() == CV_8UC1 && in_l.size() == correction_l.size());
+    CV_Assert(in_r.type() == CV_8UC1 && in_r.size() == correction_r.size());
+    out_l.create(in_l.size(), CV_8UC1);  // no allocation if the buffers are already there
+    out_r.create(in_r.size(), CV_8UC1);
+    cv::parallel_for_(cv::Range(0, 2 * STRIPES_PER_IMAGE), StereoCorrectionBody(correction_l, in_l, out_l, correction_r, in_r, out_r));
+}
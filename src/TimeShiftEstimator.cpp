@@ -0,0 +1,135 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * TimeShiftEstimator.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "TimeShiftEstimator.h"
+
+#include <math.h>
+
+#include "CameraModel.h"
+#include "SmallMatrix.h"
+
+const double TimeShiftEstimator::GAIN = 0.05;
+const double TimeShiftEstimator::MAX_STEP = 0.002;
+const double TimeShiftEstimator::MAX_TIME_SHIFT = 0.05;
+const double TimeShiftEstimator::MAX_RESIDUAL = 10.0;
+const double TimeShiftEstimator::MIN_FLOW = 100.0;
+
+TimeShiftEstimator::TimeShiftEstimator() :
+                time_shift_(0),
+                camera_(),
+                prev_stamp_(0) {
+    reset();
+}
+
+void TimeShiftEstimator::setTimeShift(double time_shift) {
+    time_shift_ = time_shift;
+}
+
+double TimeShiftEstimator::timeShift() const {
+    return time_shift_;
+}
+
+void TimeShiftEstimator::setCamera(const CameraParameters &camera) {
+    camera_ = camera;
+    reset();
+}
+
+void TimeShiftEstimator::reset() {
+    for (int i = 0; i < matlab_consts::numTrackFeatures; i++)
+        prev_valid_[i] = false;
+}
+
+void TimeShiftEstimator::addFrame(double stamp, const RobotState &state, const FloatType *map, const int *update_vec, const FloatType *z_l) {
+    const int N = matlab_consts::numTrackFeatures;
+
+    // the pinhole projection below is compared with the undistorted observations
+    FloatType z_u[N * 2];
+    camera_model::UndistortionReport<FloatType> report;
+    if (camera_.DistortionModel == CameraParameters::ATAN)
+        camera_model::undistortPoints(camera_model::Atan<FloatType>(camera_.FocalLength, camera_.PrincipalPoint, camera_.RadialDistortion), z_l, N, z_u,
+                report);
+    else
+        camera_model::undistortPoints(camera_model::PlumbBob<FloatType>(camera_.FocalLength, camera_.PrincipalPoint, camera_.RadialDistortion), z_l, N,
+                z_u, report);
+
+    // rotation from the world to the camera of the JPL attitude, column major
+    FloatType R_cw[9];
+    small_matrix::rotFromQuat(state.att, R_cw);
+
+    double dt = stamp - prev_stamp_;
+    double rv = 0, vv = 0;
+    int num_features = 0;
+    for (int i = 0; i < N && dt > 0; i++) {
+        const FloatType *p = &map[i * 3];
+        if (update_vec[i] != 1 || !prev_valid_[i] || (p[0] == 0 && p[1] == 0 && p[2] == 0))
+            continue;
+
+        FloatType d[3] = { p[0] - state.pos[0], p[1] - state.pos[1], p[2] - state.pos[2] };
+        FloatType fp[3];
+        for (int j = 0; j < 3; j++)
+            fp[j] = R_cw[j] * d[0] + R_cw[j + 3] * d[1] + R_cw[j + 6] * d[2];
+        if (fp[2] <= 0)
+            continue;
+
+        double r_x = z_u[i * 2] - (camera_.FocalLength[0] * fp[0] / fp[2] + camera_.PrincipalPoint[0]);
+        double r_y = z_u[i * 2 + 1] - (camera_.FocalLength[1] * fp[1] / fp[2] + camera_.PrincipalPoint[1]);
+        if (fabs(r_x) > MAX_RESIDUAL || fabs(r_y) > MAX_RESIDUAL)
+            continue;
+
+        double v_x = (z_u[i * 2] - prev_z_u_[i * 2]) / dt;
+        double v_y = (z_u[i * 2 + 1] - prev_z_u_[i * 2 + 1]) / dt;
+        rv += r_x * v_x + r_y * v_y;
+        vv += v_x * v_x + v_y * v_y;
+        num_features++;
+    }
+
+    // without image motion the residuals do not depend on the time shift
+    if (num_features >= MIN_FEATURES && vv > MIN_FLOW * num_features) {
+        double step = GAIN * rv / vv;
+        step = step > MAX_STEP ? MAX_STEP : step < -MAX_STEP ? -MAX_STEP : step;
+        time_shift_ += step;
+        time_shift_ = time_shift_ > MAX_TIME_SHIFT ? MAX_TIME_SHIFT : time_shift_ < -MAX_TIME_SHIFT ? -MAX_TIME_SHIFT : time_shift_;
+    }
+
+    for (int i = 0; i < N * 2; i++)
+        prev_z_u_[i] = z_u[i];
+    for (int i = 0; i < N; i++)
+        prev_valid_[i] = update_vec[i] != 0;
+    prev_stamp_ = stamp;
+}
@@ -0,0 +1,250 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * UndistortionMap.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "UndistortionMap.h"
+
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include <fstream>
+
+static const char UNDISTORTION_MAP_MAGIC[8] = { 'D', 'U', 'O', 'U', 'D', 'M', 'A', 'P' };
+static const uint32_t UNDISTORTION_MAP_VERSION = 1;
+
+// header of the map files. The maps are only valid for the precision they were built with
+struct UndistortionMapHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t float_size;
+    int32_t width;
+    int32_t height;
+    int32_t step;
+    int32_t distortion_model;
+    FloatType focal_length[2];
+    FloatType principal_point[2];
+    FloatType radial_distortion[3];
+};
+
+UndistortionMap::UndistortionMap() :
+                width_(0),
+                height_(0),
+                step_(0),
+                cols_(0),
+                rows_(0),
+                params_() {
+}
+
+void UndistortionMap::undistortModel(const FloatType *pt_d, int num_points, FloatType *pt_u, camera_model::UndistortionReport<FloatType> &report) const {
+    if (params_.DistortionModel == CameraParameters::ATAN)
+        camera_model::undistortPoints(camera_model::Atan<FloatType>(params_.FocalLength, params_.PrincipalPoint, params_.RadialDistortion), pt_d,
+                num_points, pt_u, report);
+    else
+        camera_model::undistortPoints(camera_model::PlumbBob<FloatType>(params_.FocalLength, params_.PrincipalPoint, params_.RadialDistortion), pt_d,
+                num_points, pt_u, report);
+}
+
+void UndistortionMap::build(const CameraParameters &params, int width, int height, int step) {
+    params_ = params;
+    width_ = width;
+    height_ = height;
+    step_ = step < 1 ? 1 : step;
+    // one node past the last pixel so that every pixel has a cell
+    cols_ = (width_ - 1) / step_ + 2;
+    rows_ = (height_ - 1) / step_ + 2;
+    u_.resize(cols_ * rows_);
+    v_.resize(cols_ * rows_);
+
+    camera_model::UndistortionReport<FloatType> report;
+    std::vector<FloatType> pt_d(2 * cols_), pt_u(2 * cols_);
+    for (int row = 0; row < rows_; row++) {
+        for (int col = 0; col < cols_; col++) {
+            pt_d[2 * col] = col * step_;
+            pt_d[2 * col + 1] = row * step_;
+        }
+        undistortModel(&pt_d[0], cols_, &pt_u[0], report);
+        for (int col = 0; col < cols_; col++) {
+            u_[row * cols_ + col] = pt_u[2 * col];
+            v_[row * cols_ + col] = pt_u[2 * col + 1];
+        }
+    }
+}
+
+bool UndistortionMap::load(const std::string &path) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file)
+        return false;
+
+    UndistortionMapHeader header;
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        return false;
+    if (memcmp(header.magic, UNDISTORTION_MAP_MAGIC, sizeof(header.magic)) || header.version != UNDISTORTION_MAP_VERSION
+            || header.float_size != sizeof(FloatType) || header.step < 1 || header.width < 1 || header.height < 1)
+        return false;
+
+    // the file has to hold exactly the two tables, checked before allocating them
+    int cols = (header.width - 1) / header.step + 2;
+    int rows = (header.height - 1) / header.step + 2;
+    long long payload = 2LL * cols * rows * sizeof(FloatType);
+    std::streamoff start = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff end = file.tellg();
+    if (start < 0 || end < 0 || end - start != payload)
+        return false;
+    file.seekg(start);
+
+    std::vector<FloatType> u(cols * rows), v(cols * rows);
+    if (!file.read(reinterpret_cast<char *>(&u[0]), u.size() * sizeof(FloatType)) || !file.read(reinterpret_cast<char *>(&v[0]), v.size() * sizeof(FloatType)))
+        return false;
+
+    params_ = CameraParameters();
+    params_.DistortionModel = header.distortion_model;
+    memcpy(params_.FocalLength, header.focal_length, sizeof(params_.FocalLength));
+    memcpy(params_.PrincipalPoint, header.principal_point, sizeof(params_.PrincipalPoint));
+    memcpy(params_.RadialDistortion, header.radial_distortion, sizeof(params_.RadialDistortion));
+    width_ = header.width;
+    height_ = header.height;
+    step_ = header.step;
+    cols_ = cols;
+    rows_ = rows;
+    u_.swap(u);
+    v_.swap(v);
+    return true;
+}
+
+bool UndistortionMap::save(const std::string &path) const {
+    if (empty())
+        return false;
+
+    UndistortionMapHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, UNDISTORTION_MAP_MAGIC, sizeof(header.magic));
+    header.version = UNDISTORTION_MAP_VERSION;
+    header.float_size = sizeof(FloatType);
+    header.width = width_;
+    header.height = height_;
+    header.step = step_;
+    header.distortion_model = params_.DistortionModel;
+    memcpy(header.focal_length, params_.FocalLength, sizeof(header.focal_length));
+    memcpy(header.principal_point, params_.PrincipalPoint, sizeof(header.principal_point));
+    memcpy(header.radial_distortion, params_.RadialDistortion, sizeof(header.radial_distortion));
+
+    std::ofstream file(path.c_str(), std::ios::binary);
+    if (!file)
+        return false;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(&u_[0]), u_.size() * sizeof(FloatType));
+    file.write(reinterpret_cast<const char *>(&v_[0]), v_.size() * sizeof(FloatType));
+    return file.good();
+}
+
+bool UndistortionMap::empty() const {
+    return u_.empty();
+}
+
+int UndistortionMap::step() const {
+    return step_;
+}
+
+bool UndistortionMap::matches(const CameraParameters &params, int width, int height) const {
+    return width == width_ && height == height_ && matches(params.FocalLength, params.PrincipalPoint, params.RadialDistortion, params.DistortionModel);
+}
+
+bool UndistortionMap::matches(const FloatType focal_length[2], const FloatType principal_point[2], const FloatType radial_distortion[3],
+        int distortion_model) const {
+    if (empty() || distortion_model != params_.DistortionModel)
+        return false;
+    for (int i = 0; i < 2; i++)
+        if (focal_length[i] != params_.FocalLength[i] || principal_point[i] != params_.PrincipalPoint[i])
+            return false;
+    for (int i = 0; i < 3; i++)
+        if (radial_distortion[i] != params_.RadialDistortion[i])
+            return false;
+    return true;
+}
+
+void UndistortionMap::undistortPoints(const FloatType *pt_d, int num_points, FloatType *pt_u,
+        camera_model::UndistortionReport<FloatType> &report) const {
+    const FloatType inv_step = FloatType(1) / step_;
+    FloatType outside[2 * camera_model::LANES];
+    int outside_idx[camera_model::LANES];
+    int num_outside = 0;
+
+    for (int i = 0; i < num_points; i++) {
+        FloatType x = pt_d[2 * i];
+        FloatType y = pt_d[2 * i + 1];
+
+        if (!(x >= 0 && x <= width_ - 1 && y >= 0 && y <= height_ - 1)) {
+            outside[2 * num_outside] = x;
+            outside[2 * num_outside + 1] = y;
+            outside_idx[num_outside++] = i;
+            if (num_outside == camera_model::LANES) {
+                undistortModel(outside, num_outside, outside, report);
+                for (int j = 0; j < num_outside; j++) {
+                    pt_u[2 * outside_idx[j]] = outside[2 * j];
+                    pt_u[2 * outside_idx[j] + 1] = outside[2 * j + 1];
+                }
+                num_outside = 0;
+            }
+            continue;
+        }
+
+        FloatType gx = x * inv_step;
+        FloatType gy = y * inv_step;
+        int col = (int) gx;
+        int row = (int) gy;
+        FloatType tx = gx - col;
+        FloatType ty = gy - row;
+
+        int idx = row * cols_ + col;
+        FloatType w00 = (1 - tx) * (1 - ty);
+        FloatType w01 = tx * (1 - ty);
+        FloatType w10 = (1 - tx) * ty;
+        FloatType w11 = tx * ty;
+        pt_u[2 * i] = w00 * u_[idx] + w01 * u_[idx + 1] + w10 * u_[idx + cols_] + w11 * u_[idx + cols_ + 1];
+        pt_u[2 * i + 1] = w00 * v_[idx] + w01 * v_[idx + 1] + w10 * v_[idx + cols_] + w11 * v_[idx + cols_ + 1];
+    }
+
+    if (num_outside) {
+        undistortModel(outside, num_outside, outside, report);
+        for (int j = 0; j < num_outside; j++) {
+            pt_u[2 * outside_idx[j]] = outside[2 * j];
+            pt_u[2 * outside_idx[j] + 1] = outside[2 * j + 1];
+        }
+    }
+}
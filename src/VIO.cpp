@@ -38,14 +38,25 @@
  */
 
 #include "VIO.h"
+#include "vio_logging.h"
+#include "SmallMatrix.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 VIO::VIO() :
                 reset_(false),
+                warm_reset_(false),
                 params_set_(false),
                 is_initialized_(true) {
     SLAM_initialize();
+    vio_logging::Logger::instance().start();
     int_dummy_.resize(matlab_consts::numTrackFeatures, 0);
-    float_dummy_.resize(matlab_consts::numTrackFeatures * 2, 0);
+    float_dummy_.resize(matlab_consts::numTrackFeatures * 3, 0);  // large enough for the map
     anchor_poses_dummy_.resize(matlab_consts::numAnchors);
 }
 
@@ -54,32 +65,65 @@ VIO::VIO(DUOParameters duoParam, NoiseParameters noiseParam, VIOParameters vioPa
                 noiseParam_(noiseParam),
                 vioParam_(vioParam_),
                 reset_(false),
+                warm_reset_(false),
                 params_set_(true) {
     if (!is_initialized_) {
         SLAM_initialize();
         is_initialized_ = true;
     }
+    vio_logging::Logger::instance().start();
     int_dummy_.resize(matlab_consts::numTrackFeatures, 0);
-    float_dummy_.resize(matlab_consts::numTrackFeatures * 2, 0);
+    float_dummy_.resize(matlab_consts::numTrackFeatures * 3, 0);  // large enough for the map
     anchor_poses_dummy_.resize(matlab_consts::numAnchors);
 }
 
 VIO::~VIO() {
     SLAM_terminate();
+    vio_logging::Logger::instance().stop();
 }
 
 void VIO::predict(const VIOMeasurements &meas, double dt) {
+    predict(meas, dt, SLAM_OUTPUT_NONE, robot_state_dummy_);
+}
+
+void VIO::predict(const VIOMeasurements &meas, double dt, RobotState &robotState) {
+    predict(meas, dt, SLAM_OUTPUT_ROBOT_STATE, robotState);
+}
+
+void VIO::predict(const VIOMeasurements &meas, double dt, int outputs, RobotState &robotState) {
     if (!params_set_)
         throw "VIO parameters not set yet";
 
-    SLAM(&int_dummy_[0], &float_dummy_[0], &float_dummy_[0], dt, &meas, &duoParam_, &noiseParam_, &vioParam_, false, reset_, &robot_state_dummy_,
-            &float_dummy_[0], &anchor_poses_dummy_[0], &float_dummy_[0]);
+    // the filter is initialized with the IMU state of the camera parameters. A warm
+    // reset replaces the IMU biases and camera-IMU extrinsics by the last estimate,
+    // the attitude is not carried over and is aligned with gravity again
+    const DUOParameters *duoParam = &duoParam_;
+    DUOParameters warmParam;
+    if (reset_ && warm_reset_) {
+        warmParam = duoParam_;
+        for (int i = 0; i < 3; i++) {
+            warmParam.gyro_bias[i] = warm_reset_state_.IMU.gyro_bias[i];
+            warmParam.acc_bias[i] = warm_reset_state_.IMU.acc_bias[i];
+            warmParam.t_ci[i] = warm_reset_state_.IMU.pos[i];
+        }
+        small_matrix::rotFromQuat(warm_reset_state_.IMU.att, warmParam.R_ci);
+        duoParam = &warmParam;
+    }
+
+    SLAM(&int_dummy_[0], &float_dummy_[0], &float_dummy_[0], dt, &meas, duoParam, &noiseParam_, &vioParam_, false, reset_, outputs,
+            &robotState, &float_dummy_[0], &anchor_poses_dummy_[0], &float_dummy_[0]);
     reset_ = false;
+    warm_reset_ = false;
 
 }
 
 void VIO::update(std::vector<int> &update_vect, std::vector<FloatType> &feautres_l, std::vector<FloatType> &feautres_r, RobotState &robotState,
         std::vector<FloatType> &map, std::vector<AnchorPose> &anchor_poses, std::vector<FloatType> &delayedStatus) {
+    update(update_vect, feautres_l, feautres_r, robotState, map, anchor_poses, delayedStatus, SLAM_OUTPUT_ALL);
+}
+
+void VIO::update(std::vector<int> &update_vect, std::vector<FloatType> &feautres_l, std::vector<FloatType> &feautres_r, RobotState &robotState,
+        std::vector<FloatType> &map, std::vector<AnchorPose> &anchor_poses, std::vector<FloatType> &delayedStatus, int outputs) {
 
     if (!params_set_)
         throw "VIO parameters not set yet";
@@ -90,13 +134,26 @@ void VIO::update(std::vector<int> &update_vect, std::vector<FloatType> &feautres
     assert(anchor_poses.size() == matlab_consts::numAnchors);
     assert(delayedStatus.size() == matlab_consts::numTrackFeatures);
 
-    SLAM(&update_vect[0], &feautres_l[0], &feautres_r[0], 0.0, &vio_eas_dummy_, &duoParam_, &noiseParam_, &vioParam_, true, false, &robotState, &map[0],
-            &anchor_poses[0], &delayedStatus[0]);
+    SLAM(&update_vect[0], &feautres_l[0], &feautres_r[0], 0.0, &vio_eas_dummy_, &duoParam_, &noiseParam_, &vioParam_, true, false, outputs, &robotState,
+            &map[0], &anchor_poses[0], &delayedStatus[0]);
+
+}
 
+void VIO::update(std::vector<int> &update_vect, std::vector<FloatType> &feautres_l, std::vector<FloatType> &feautres_r, RobotState &robotState,
+        std::vector<FloatType> &map, std::vector<AnchorPose> &anchor_poses, std::vector<FloatType> &delayedStatus, int outputs, VIOTelemetry &telemetry) {
+    update(update_vect, feautres_l, feautres_r, robotState, map, anchor_poses, delayedStatus, outputs);
+    SLAM_getTelemetry(&telemetry);
 }
 
 void VIO::reset() {
     reset_ = true;
+    warm_reset_ = false;
+}
+
+void VIO::resetWarm(const RobotState &robotState) {
+    reset_ = true;
+    warm_reset_ = true;
+    warm_reset_state_ = robotState;
 }
 
 bool VIO::getParams(DUOParameters &duoParam, NoiseParameters &noiseParam, VIOParameters &vioParam) {
@@ -117,3 +174,80 @@ void VIO::setParams(DUOParameters duoParam, NoiseParameters noiseParam, VIOParam
 
     params_set_ = true;
 }
+
+void VIO::setUndistortionMaps(const UndistortionMap *map_l, const UndistortionMap *map_r) {
+    SLAM_setUndistortionMaps(map_l, map_r);
+}
+
+size_t VIO::getCheckpointSize() const {
+    return sizeof(VIOCheckpointHeader) + SLAM_getStateSize();
+}
+
+void VIO::getCheckpoint(std::vector<unsigned char> &checkpoint) const {
+    checkpoint.resize(getCheckpointSize());
+
+    VIOCheckpointHeader header;
+    memcpy(header.magic, "DVIO", 4);
+    header.version = VIOCheckpointHeader::VERSION;
+    header.byte_order = VIOCheckpointHeader::BYTE_ORDER_MARK;
+    header.float_size = sizeof(FloatType);
+    header.num_track_features = matlab_consts::numTrackFeatures;
+    header.num_anchors = matlab_consts::numAnchors;
+    header.state_size = SLAM_getStateSize();
+    header.reserved = 0;
+    memcpy(&checkpoint[0], &header, sizeof(header));
+
+    SLAM_getState(&checkpoint[sizeof(header)]);
+}
+
+bool VIO::restoreCheckpoint(const void *checkpoint, size_t size) {
+    VIOCheckpointHeader header;
+    if (size < sizeof(header))
+        return false;
+    memcpy(&header, checkpoint, sizeof(header));
+
+    if (memcmp(header.magic, "DVIO", 4) || header.version != VIOCheckpointHeader::VERSION || header.byte_order != VIOCheckpointHeader::BYTE_ORDER_MARK
+            || header.float_size != sizeof(FloatType) || header.num_track_features != (uint32_t) matlab_consts::numTrackFeatures
+            || header.num_anchors != (uint32_t) matlab_consts::numAnchors || header.state_size != (uint32_t) SLAM_getStateSize()
+            || size != getCheckpointSize())
+        return false;
+
+    SLAM_setState(static_cast<const unsigned char *>(checkpoint) + sizeof(header));
+    reset_ = false;  // a pending reset would discard the restored state
+    warm_reset_ = false;
+
+    return true;
+}
+
+bool VIO::saveCheckpoint(const std::string &file_name) const {
+    std::vector<unsigned char> checkpoint;
+    getCheckpoint(checkpoint);
+
+    FILE *file = fopen(file_name.c_str(), "wb");
+    if (!file)
+        return false;
+    bool ok = fwrite(&checkpoint[0], 1, checkpoint.size(), file) == checkpoint.size();
+    return fclose(file) == 0 && ok;
+}
+
+bool VIO::loadCheckpoint(const std::string &file_name) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) || st.st_size < (off_t) sizeof(VIOCheckpointHeader)) {
+        close(fd);
+        return false;
+    }
+
+    void *checkpoint = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (checkpoint == MAP_FAILED)
+        return false;
+
+    bool ok = restoreCheckpoint(checkpoint, st.st_size);
+    munmap(checkpoint, st.st_size);
+
+    return ok;
+}
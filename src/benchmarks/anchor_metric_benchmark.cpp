@@ -0,0 +1,166 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * anchor_metric_benchmark.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+// Compares the cost of an origin anchor switch with the uncertainty measures
+// that can be selected with VIOParameters::origin_anchor_metric, and how often
+// they choose the same anchor as the spectral norm.
+//
+// usage: anchor_metric_benchmark [num_switches]
+//
+// The anchor covariance blocks are synthesized: random correlations scaled to
+// position variances of a few cm^2 and orientation variances of a few 1e-3
+// rad^2, spread over two orders of magnitude between the anchors.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <chrono>
+
+#include "InterfaceStructs.h"
+#include "SLAM.h"
+
+static const int kNumAnchors = 6;
+static const int kRepetitions = 20;
+
+static double uniform() {
+    return rand() / (RAND_MAX + 1.0);
+}
+
+static double gaussian() {
+    return std::sqrt(-2 * std::log(uniform() + 1e-12)) * std::cos(2 * M_PI * uniform());
+}
+
+// P = D * A * A' * D with A random and D the standard deviations of the
+// position and orientation errors
+static void synthesize(FloatType P[36]) {
+    double A[36], sigma[6];
+    double scale = std::pow(100.0, uniform());
+    for (int i = 0; i < 36; i++)
+        A[i] = gaussian() / std::sqrt(6.0);
+    for (int i = 0; i < 3; i++) {
+        sigma[i] = 0.05 * std::sqrt(scale);
+        sigma[i + 3] = 0.02 * std::sqrt(scale);
+    }
+    for (int j = 0; j < 6; j++) {
+        for (int i = 0; i < 6; i++) {
+            double s = 0;
+            for (int k = 0; k < 6; k++)
+                s += A[i + 6 * k] * A[j + 6 * k];
+            P[i + 6 * j] = sigma[i] * sigma[j] * s;
+        }
+        P[j + 6 * j] += 1e-6;
+    }
+}
+
+// what SLAM_upd does when the origin anchor has to be replaced
+static int selectAnchor(const FloatType *P_anchors, int metric) {
+    int best = 0;
+    FloatType best_uncertainty = 0;
+    for (int anchorIdx = 0; anchorIdx < kNumAnchors; anchorIdx++) {
+        FloatType uncertainty = SLAM_anchorUncertainty(&P_anchors[36 * anchorIdx], metric);
+        if (anchorIdx == 0 || uncertainty < best_uncertainty) {
+            best = anchorIdx;
+            best_uncertainty = uncertainty;
+        }
+    }
+    return best;
+}
+
+struct Result {
+    std::vector<int> selection;
+    double ns_per_switch;
+};
+
+static Result run(const std::vector<FloatType> &P_anchors, int metric) {
+    const int num_switches = P_anchors.size() / (36 * kNumAnchors);
+    Result result;
+    result.selection.resize(num_switches);
+
+    double best = 1e9;
+    for (int rep = 0; rep < kRepetitions; rep++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < num_switches; i++)
+            result.selection[i] = selectAnchor(&P_anchors[36 * kNumAnchors * i], metric);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed < best)
+            best = elapsed;
+    }
+    result.ns_per_switch = 1e9 * best / num_switches;
+    return result;
+}
+
+int main(int argc, char *argv[]) {
+    int num_switches = argc > 1 ? atoi(argv[1]) : 10000;
+    if (num_switches <= 0) {
+        fprintf(stderr, "usage: %s [num_switches]\n", argv[0]);
+        return 1;
+    }
+
+    SLAM_initialize();
+
+    std::vector<FloatType> P_anchors(36 * kNumAnchors * num_switches);
+    for (int i = 0; i < kNumAnchors * num_switches; i++)
+        synthesize(&P_anchors[36 * i]);
+
+    const struct {
+        const char *name;
+        int metric;
+    } metrics[] = {
+        { "spectral (SVD)", VIOParameters::ANCHOR_METRIC_SPECTRAL },
+        { "power iteration", VIOParameters::ANCHOR_METRIC_POWER },
+        { "frobenius", VIOParameters::ANCHOR_METRIC_FROBENIUS },
+        { "trace", VIOParameters::ANCHOR_METRIC_TRACE },
+    };
+
+    printf("%d anchor switches with %d anchors\n", num_switches, kNumAnchors);
+    Result reference = run(P_anchors, VIOParameters::ANCHOR_METRIC_SPECTRAL);
+    for (size_t m = 0; m < sizeof(metrics) / sizeof(metrics[0]); m++) {
+        Result result = m == 0 ? reference : run(P_anchors, metrics[m].metric);
+        int num_agree = 0;
+        for (int i = 0; i < num_switches; i++)
+            if (result.selection[i] == reference.selection[i])
+                num_agree++;
+        printf("%-20s %9.1f ns/switch  speedup %5.1fx  same anchor as spectral %.1f%%\n", metrics[m].name, result.ns_per_switch,
+                reference.ns_per_switch / result.ns_per_switch, 100.0 * num_agree / num_switches);
+    }
+
+    SLAM_terminate();
+    return 0;
+}
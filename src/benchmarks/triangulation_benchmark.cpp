@@ -0,0 +1,278 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * triangulation_benchmark.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+// Compares cost and accuracy of the triangulation methods of Triangulation.h.
+//
+// usage: triangulation_benchmark cameraParams.yaml [correspondences.txt]
+//
+// The correspondences file holds one tracked stereo feature per line as
+// distorted pixel coordinates "u_l v_l u_r v_r", they are undistorted with
+// the calibration. Without the file, correspondences of points between 0.2 m
+// and 30 m are synthesized from the calibration with 0.3 px noise.
+// The reference is the per point column pivoted QR in double precision. It
+// does not check the result, the points the double QR lanes reject are not
+// compared.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include <yaml-cpp/yaml.h>
+
+#include "InterfaceStructs.h"
+#include "CameraModel.h"
+#include "Triangulation.h"
+
+// points per call, the maximum number of new features in one update
+static const int kBatchSize = 48;
+static const int kRepetitions = 200;
+
+struct Correspondences {
+    std::vector<double> z_l, z_r;  // undistorted, interleaved
+    std::vector<double> depth;     // ground truth of synthesized points, empty otherwise
+};
+
+static void undistort(const CameraParameters &params, std::vector<double> &z) {
+    double fc[2], pp[2], rd[3];
+    for (int i = 0; i < 2; i++) {
+        fc[i] = params.FocalLength[i];
+        pp[i] = params.PrincipalPoint[i];
+    }
+    for (int i = 0; i < 3; i++)
+        rd[i] = params.RadialDistortion[i];
+
+    std::vector<double> z_u(z.size());
+    camera_model::UndistortionReport<double> report;
+    if (params.DistortionModel == CameraParameters::ATAN)
+        camera_model::undistortPoints(camera_model::Atan<double>(fc, pp, rd), &z[0], z.size() / 2, &z_u[0], report);
+    else
+        camera_model::undistortPoints(camera_model::PlumbBob<double>(fc, pp, rd), &z[0], z.size() / 2, &z_u[0], report);
+    z.swap(z_u);
+}
+
+static bool load(const char *path, const DUOParameters &params, Correspondences &c) {
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return false;
+    double u_l, v_l, u_r, v_r;
+    while (fscanf(file, "%lf %lf %lf %lf", &u_l, &v_l, &u_r, &v_r) == 4) {
+        c.z_l.push_back(u_l);
+        c.z_l.push_back(v_l);
+        c.z_r.push_back(u_r);
+        c.z_r.push_back(v_r);
+    }
+    fclose(file);
+    undistort(params.CameraParameters1, c.z_l);
+    undistort(params.CameraParameters2, c.z_r);
+    return !c.z_l.empty();
+}
+
+static double uniform() {
+    return rand() / (RAND_MAX + 1.0);
+}
+
+static double gaussian() {
+    return std::sqrt(-2 * std::log(uniform() + 1e-12)) * std::cos(2 * M_PI * uniform());
+}
+
+static void synthesize(const DUOParameters &params, int num_points, Correspondences &c) {
+    const CameraParameters &left = params.CameraParameters1;
+    const CameraParameters &right = params.CameraParameters2;
+    const double noise = 0.3;
+
+    while (c.depth.size() < (size_t) num_points) {
+        double u = uniform() * 2 * left.PrincipalPoint[0];
+        double v = uniform() * 2 * left.PrincipalPoint[1];
+        double depth = 0.2 * std::pow(150.0, uniform());
+        double fp[3] = { (u - left.PrincipalPoint[0]) / left.FocalLength[0], (v - left.PrincipalPoint[1]) / left.FocalLength[1], 1 };
+        double scale = depth / std::sqrt(fp[0] * fp[0] + fp[1] * fp[1] + 1);
+        for (int k = 0; k < 3; k++)
+            fp[k] *= scale;
+
+        double fp_r[3];
+        for (int k = 0; k < 3; k++)
+            fp_r[k] = params.R_rl[k] * fp[0] + params.R_rl[k + 3] * fp[1] + params.R_rl[k + 6] * fp[2] - params.r_lr[k];
+        if (fp_r[2] <= 0)
+            continue;
+
+        c.z_l.push_back(u + noise * gaussian());
+        c.z_l.push_back(v + noise * gaussian());
+        c.z_r.push_back(fp_r[0] / fp_r[2] * right.FocalLength[0] + right.PrincipalPoint[0] + noise * gaussian());
+        c.z_r.push_back(fp_r[1] / fp_r[2] * right.FocalLength[1] + right.PrincipalPoint[1] + noise * gaussian());
+        c.depth.push_back(depth);
+    }
+}
+
+template<typename T>
+static triangulation::StereoRig<T> makeRig(const DUOParameters &params) {
+    T fc_l[2], pp_l[2], fc_r[2], pp_r[2], r_lr[3], R_lr[9], R_rl[9];
+    for (int i = 0; i < 2; i++) {
+        fc_l[i] = params.CameraParameters1.FocalLength[i];
+        pp_l[i] = params.CameraParameters1.PrincipalPoint[i];
+        fc_r[i] = params.CameraParameters2.FocalLength[i];
+        pp_r[i] = params.CameraParameters2.PrincipalPoint[i];
+    }
+    for (int i = 0; i < 3; i++)
+        r_lr[i] = params.r_lr[i];
+    for (int i = 0; i < 9; i++) {
+        R_lr[i] = params.R_lr[i];
+        R_rl[i] = params.R_rl[i];
+    }
+    return triangulation::StereoRig<T>(fc_l, pp_l, fc_r, pp_r, r_lr, R_lr, R_rl);
+}
+
+// the solve of the generated initializePoint, one pivoted QR per point
+template<typename T>
+static void triangulatePerPoint(const triangulation::StereoRig<T> &rig, const T *z_l, const T *z_r, int num_points, T *fp) {
+    for (int i = 0; i < num_points; i++) {
+        T m_l[3] = { (z_l[2 * i] - rig.pp_l[0]) / rig.fc_l[0], (z_l[2 * i + 1] - rig.pp_l[1]) / rig.fc_l[1], 1 };
+        T m_r[3] = { (z_r[2 * i] - rig.pp_r[0]) / rig.fc_r[0], (z_r[2 * i + 1] - rig.pp_r[1]) / rig.fc_r[1], 1 };
+        T norm_l = std::sqrt(m_l[0] * m_l[0] + m_l[1] * m_l[1] + 1);
+        T norm_r = std::sqrt(m_r[0] * m_r[0] + m_r[1] * m_r[1] + 1);
+        T m_r_l[3];
+        for (int k = 0; k < 3; k++) {
+            m_l[k] /= norm_l;
+            m_r[k] /= norm_r;
+        }
+        for (int k = 0; k < 3; k++)
+            m_r_l[k] = rig.R_lr[k] * m_r[0] + rig.R_lr[k + 3] * m_r[1] + rig.R_lr[k + 6] * m_r[2];
+
+        T A[30], b[6], x[5];
+        triangulation::buildStereoSystem(rig, m_l, m_r_l, A, b);
+        triangulation::solveLeastSquares<T, 6, 5>(A, b, x);
+        for (int k = 0; k < 3; k++)
+            fp[3 * i + k] = x[2 + k];
+    }
+}
+
+struct Result {
+    std::vector<double> depth;
+    std::vector<int> status;
+    double ns_per_point;
+};
+
+template<typename T>
+static Result run(const DUOParameters &params, const Correspondences &c, int method) {
+    const int num_points = c.z_l.size() / 2;
+    triangulation::StereoRig<T> rig = makeRig<T>(params);
+    std::vector<T> z_l(c.z_l.begin(), c.z_l.end()), z_r(c.z_r.begin(), c.z_r.end());
+    std::vector<T> fp(3 * num_points), m_l(3 * num_points);
+    std::vector<int> status(num_points, triangulation::SUCCESS);
+
+    double best = 1e9;
+    for (int rep = 0; rep < kRepetitions; rep++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < num_points; i += kBatchSize) {
+            int n = num_points - i < kBatchSize ? num_points - i : kBatchSize;
+            if (method < 0)
+                triangulatePerPoint(rig, &z_l[2 * i], &z_r[2 * i], n, &fp[3 * i]);
+            else
+                triangulation::triangulateStereo(rig, (triangulation::Method) method, &z_l[2 * i], &z_r[2 * i], n, &fp[3 * i], &m_l[3 * i], &status[i]);
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed < best)
+            best = elapsed;
+    }
+
+    Result result;
+    result.ns_per_point = 1e9 * best / num_points;
+    result.status = status;
+    for (int i = 0; i < num_points; i++)
+        result.depth.push_back(std::sqrt(double(fp[3 * i] * fp[3 * i] + fp[3 * i + 1] * fp[3 * i + 1] + fp[3 * i + 2] * fp[3 * i + 2])));
+    return result;
+}
+
+static void report(const char *name, const Result &result, const Result &reference, const Correspondences &c) {
+    double sum_diff = 0, max_diff = 0, sum_err = 0;
+    int num_success = 0, num_mismatch = 0;
+    for (size_t i = 0; i < reference.status.size(); i++) {
+        if (result.status[i] != reference.status[i])
+            num_mismatch++;
+        if (reference.status[i] != triangulation::SUCCESS)
+            continue;
+        double diff = std::fabs(result.depth[i] - reference.depth[i]) / reference.depth[i];
+        sum_diff += diff;
+        max_diff = diff > max_diff ? diff : max_diff;
+        if (!c.depth.empty())
+            sum_err += std::fabs(result.depth[i] - c.depth[i]) / c.depth[i];
+        num_success++;
+    }
+    if (num_success == 0)
+        num_success = 1;
+
+    printf("%-28s %8.1f ns/pt  depth vs ref: mean %.2e max %.2e  status mismatches %d", name, result.ns_per_point, sum_diff / num_success, max_diff, num_mismatch);
+    if (!c.depth.empty())
+        printf("  depth vs truth: mean %.2e", sum_err / num_success);
+    printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s cameraParams.yaml [correspondences.txt]\n", argv[0]);
+        return 1;
+    }
+
+    DUOParameters params = parseYaml(YAML::LoadFile(argv[1]));
+
+    Correspondences c;
+    if (argc > 2) {
+        if (!load(argv[2], params, c)) {
+            fprintf(stderr, "Failed to read correspondences from %s\n", argv[2]);
+            return 1;
+        }
+    } else {
+        synthesize(params, 4800, c);
+    }
+    printf("%d correspondences, %d per call, best of %d runs\n", (int) c.z_l.size() / 2, kBatchSize, kRepetitions);
+
+    Result qr_d = run<double>(params, c, triangulation::QR);
+    Result reference = run<double>(params, c, -1);
+    reference.status = qr_d.status;  // the per point solve does not check the result
+    Result per_point_f = run<float>(params, c, -1);
+    per_point_f.status = reference.status;
+
+    report("double pivoted QR per point", reference, reference, c);
+    report("double QR lanes", qr_d, reference, c);
+    report("double midpoint lanes", run<double>(params, c, triangulation::MIDPOINT), reference, c);
+    report("float pivoted QR per point", per_point_f, reference, c);
+    report("float QR lanes", run<float>(params, c, triangulation::QR), reference, c);
+    report("float midpoint lanes", run<float>(params, c, triangulation::MIDPOINT), reference, c);
+    return 0;
+}
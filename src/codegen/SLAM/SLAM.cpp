@@ -13,6 +13,11 @@
 #include "SLAM.h"
 #include <stdio.h>
 #include <vio_logging.h>
+#include "CameraModel.h"
+#include "SmallMatrix.h"
+#include "SortingNetwork.h"
+#include "Triangulation.h"
+#include "UndistortionMap.h"
 
 // Custom Source Code
 //***************************************************************************
@@ -162,6 +167,9 @@ static double P[10404];
 static double map[144];
 static double delayedStatus[48];
 static double debug_level;
+static const UndistortionMap *undistortionMap_l;
+static const UndistortionMap *undistortionMap_r;
+static VIOTelemetry telemetry;
 
 // Function Declarations
 static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
@@ -172,8 +180,8 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
   f_stereoParams_CameraParameters[2], const double stereoParams_r_lr[3], const
   double stereoParams_R_rl[9], double noiseParameters_image_noise, int
   c_VIOParameters_max_ekf_iterati, boolean_T c_VIOParameters_delayed_initial,
-  boolean_T VIOParameters_full_stereo, boolean_T VIOParameters_RANSAC, int
-  updateVect[48]);
+  boolean_T VIOParameters_full_stereo, boolean_T VIOParameters_RANSAC, double
+  c_VIOParameters_jacobian_reuse_, int updateVect[48]);
 static void QuatFromRotJ(const double R[9], double Q[4]);
 static void SLAM_free();
 static void SLAM_init();
@@ -197,12 +205,10 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
                      double z_all_l[96], double z_all_r[96], double
                      noiseParameters_image_noise, double
                      c_noiseParameters_inv_depth_ini, const VIOParameters
-                     b_VIOParameters, double b_map[144], double b_delayedStatus
-                     [48]);
+                     b_VIOParameters, double b_delayedStatus[48]);
 static boolean_T any(const boolean_T x[48]);
 static boolean_T anyActiveAnchorFeatures(const e_struct_T
   anchor_state_feature_states[8]);
-static boolean_T b_any(const boolean_T x[3]);
 static void b_diag(const double v[15], double d[225]);
 static void b_eye(double I[324]);
 static double b_fprintf();
@@ -218,15 +224,9 @@ static void b_getH_R_res(const double xt_robot_state_pos[3], const double
 static void b_log_error();
 static void b_log_info(int varargin_1, int varargin_2, int varargin_3);
 static void b_log_warn();
-static void b_merge(emxArray_int32_T *idx, emxArray_real_T *x, int offset, int
-                    np, int nq, emxArray_int32_T *iwork, emxArray_real_T *xwork);
-static void b_mrdivide(double A_data[], int A_size[2], const double B_data[],
-  const int B_size[2]);
 static double b_norm(const double x[4]);
-static void b_sort(double x[8], int idx[8]);
 static void b_xaxpy(int n, double a, const double x[36], int ix0, double y[6],
                     int iy0);
-static void b_xgeqp3(double A[30], double tau[5], int jpvt[5]);
 static double b_xnrm2(int n, const emxArray_real_T *x, int ix0);
 static boolean_T c_any(const double x[6]);
 static void c_eye(double I[10404]);
@@ -234,19 +234,17 @@ static double c_fprintf(double varargin_1);
 static void c_log_info(int varargin_1, int varargin_2);
 static void c_log_warn(int varargin_1, double varargin_2);
 static double c_norm(const double x[2]);
-static void c_sort(emxArray_real_T *x, emxArray_int32_T *idx);
 static void c_xaxpy(int n, double a, const double x[6], int ix0, double y[36],
                     int iy0);
 static double c_xnrm2(int n, const emxArray_real_T *x, int ix0);
 static void cast(const struct_T x[6], AnchorPose y[6]);
 static void cross(const double a[3], const double b[3], double c[3]);
+static int copyStateSection(unsigned char dst[], const void *src, int n);
 static void d_eye(double I[10404]);
 static double d_fprintf(double varargin_1);
 static void d_log_info(int varargin_1);
 static void d_log_warn(signed char varargin_1);
 static double d_norm(const double x[36]);
-static void d_sort(emxArray_real_T *x, int dim, emxArray_int32_T *idx);
-static double d_xnrm2(int n, const double x[30], int ix0);
 static void diag(const double v[3], double d[9]);
 static int div_s32_floor(int numerator, int denominator);
 static double e_fprintf(double varargin_1);
@@ -258,7 +256,6 @@ static void emxEnsureCapacity(emxArray__common *emxArray, int oldNumel, int
   elementSize);
 static void emxFree_int32_T(emxArray_int32_T **pEmxArray);
 static void emxFree_real_T(emxArray_real_T **pEmxArray);
-static void emxInit_int32_T(emxArray_int32_T **pEmxArray, int b_numDimensions);
 static void emxInit_int32_T1(emxArray_int32_T **pEmxArray, int b_numDimensions);
 static void emxInit_real_T(emxArray_real_T **pEmxArray, int b_numDimensions);
 static void emxInit_real_T1(emxArray_real_T **pEmxArray, int b_numDimensions);
@@ -301,12 +298,6 @@ static double h_fprintf(double varargin_1, double varargin_2, double varargin_3)
 static void h_log_warn(int varargin_1);
 static double i_fprintf(double varargin_1, double varargin_2, double varargin_3);
 static void i_log_warn();
-static void initializePoint(const double z_u_l[2], const double z_u_r[2], const
-  double c_cameraparams_CameraParameters[2], const double
-  d_cameraparams_CameraParameters[2], const double
-  e_cameraparams_CameraParameters[2], const double
-  f_cameraparams_CameraParameters[2], const double cameraparams_r_lr[3], const
-  double cameraparams_R_lr[9], double fp[3], double b_m[6], boolean_T *success);
 static double j_fprintf(double varargin_1);
 static double k_fprintf(double varargin_1);
 static double l_fprintf(int varargin_1);
@@ -315,11 +306,6 @@ static void log_info(int varargin_1, int varargin_2, int varargin_3);
 static void log_warn(int varargin_1, int varargin_2, int varargin_3);
 static double m_fprintf(const char varargin_1_data[], const int varargin_1_size
   [2]);
-static double median(const double x_data[], const int x_size[1]);
-static void merge(int idx[8], double x[8], int offset, int np, int nq, int
-                  iwork[8], double xwork[8]);
-static void merge_block(emxArray_int32_T *idx, emxArray_real_T *x, int offset,
-  int n, int preSortLevel, emxArray_int32_T *iwork, emxArray_real_T *xwork);
 static void mrdivide(emxArray_real_T *A, const emxArray_real_T *B);
 static void multiplyIdx(const double idx_data[], const int idx_size[1], double
   idx_mult_data[], int idx_mult_size[1]);
@@ -356,16 +342,11 @@ static int rankFromQR(const emxArray_real_T *A);
 static void rdivide(const double x[3], double y, double z[3]);
 static double rt_powd_snf(double u0, double u1);
 static double rt_roundd_snf(double u);
-static void sort(double x[8], int idx[8]);
-static void sortIdx(emxArray_real_T *x, emxArray_int32_T *idx);
 static void svd(const double A[36], double U[6]);
 static void undistortPoint(const double pt_d_data[], const int pt_d_size[1], int
   cameraparams_ATAN, const double cameraparams_FocalLength[2], const double
   cameraparams_PrincipalPoint[2], const double cameraparams_RadialDistortion[3],
-  int cameraparams_DistortionModel, double pt_u_data[], int pt_u_size[1]);
-static void undistortPointAtan(const double pt_d_data[], const int pt_d_size[1],
-  const double cameraparams_FocalLength[2], const double
-  cameraparams_PrincipalPoint[2], const double cameraparams_RadialDistortion[3],
+  int cameraparams_DistortionModel, const UndistortionMap *undistortion_map,
   double pt_u_data[], int pt_u_size[1]);
 static void xaxpy(int n, double a, int ix0, double y[36], int iy0);
 static double xdotc(int n, const double x[36], int ix0, const double y[36], int
@@ -374,7 +355,6 @@ static void xgeqp3(emxArray_real_T *A, emxArray_real_T *tau, emxArray_int32_T
                    *jpvt);
 static void xgetrf(int b_m, int n, emxArray_real_T *A, int lda, emxArray_int32_T
                    *ipiv, int *info);
-static double xnrm2(const double x[3]);
 static void xrotg(double *a, double *b, double *c, double *s);
 static void xscal(int n, double a, emxArray_real_T *x, int ix0);
 
@@ -398,6 +378,7 @@ static void xscal(int n, double a, emxArray_real_T *x, int ix0);
 //                boolean_T c_VIOParameters_delayed_initial
 //                boolean_T VIOParameters_full_stereo
 //                boolean_T VIOParameters_RANSAC
+//                double c_VIOParameters_jacobian_reuse_
 //                int updateVect[48]
 // Return Type  : void
 //
@@ -409,9 +390,13 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
   f_stereoParams_CameraParameters[2], const double stereoParams_r_lr[3], const
   double stereoParams_R_rl[9], double noiseParameters_image_noise, int
   c_VIOParameters_max_ekf_iterati, boolean_T c_VIOParameters_delayed_initial,
-  boolean_T VIOParameters_full_stereo, boolean_T VIOParameters_RANSAC, int
-  updateVect[48])
+  boolean_T VIOParameters_full_stereo, boolean_T VIOParameters_RANSAC, double
+  c_VIOParameters_jacobian_reuse_, int updateVect[48])
 {
+  boolean_T reuse_H;
+  boolean_T gated[48];
+  double x_it_prev[102];
+  double dx_norm;
   int residualDim;
   int mahalanobis_thresh;
   double LI_residual_thresh;
@@ -420,6 +405,7 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
   boolean_T delayedFeatures[48];
   int anchorIdx;
   int featureIdx;
+  int feature_cols[13];
   boolean_T LI_inlier_status[48];
   emxArray_real_T *S;
   emxArray_real_T *K;
@@ -510,19 +496,7 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
   emxArray_real_T *c_H;
   emxArray_real_T *c_S;
   emxArray_real_T *d_H;
-  int b_ndbl;
-  int c_ndbl;
-  double f_C_data[24];
   int tmp_data[4];
-  double g_C_data[24];
-  double h_C_data[24];
-  double i_C_data[24];
-  double j_C_data[16];
-  double k_C_data[16];
-  double l_C_data[4];
-  double m_C_data[4];
-  int S_feature_size[2];
-  int y_size[2];
   int b_tmp_data[4];
   double x_it2_data[102];
   double b_x_it2_data;
@@ -536,7 +510,6 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
   emxArray_real_T *h_y;
   double dv27[10404];
   double rejected_ratio;
-  char cv48[66];
   static const char cv49[66] = { '1', '-', 'p', 'o', 'i', 'n', 't', ' ', 'R',
     'A', 'N', 'S', 'A', 'C', ' ', 'r', 'e', 'j', 'e', 'c', 't', 'e', 'd', ' ',
     '%', 'd', '%', '%', ' ', 'o', 'f', ' ', 'a', 'l', 'l', ' ', 'f', 'e', 'a',
@@ -2356,6 +2329,8 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
       hyp_it++;
     }
 
+    telemetry.ransac_hypotheses = hyp_it - 1;
+
     emxFree_real_T(&y);
 
     //  log_info('Found %i LI inliers in %i active features', nnz(LI_inlier_status), nnz(activeFeatures)) 
@@ -2368,6 +2343,7 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
     }
 
     if (n > 3) {
+      telemetry.li_inliers = n;
       emxInit_real_T1(&b_y, 2);
 
       // 'OnePointRANSAC_EKF:131' [r, H] = getH_R_res(xt, z_u_l, z_u_r, LI_inlier_status, stereoParams, VIOParameters); 
@@ -2875,6 +2851,8 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
     //  total state for iteration
     // 'OnePointRANSAC_EKF:183' x_it = zeros(numStates + numAnchors*(6 + numPointsPerAnchor), 1); 
     memset(&x_it[0], 0, 102U * sizeof(double));
+    memset(&x_it_prev[0], 0, 102U * sizeof(double));
+    memset(&gated[0], 0, 48U * sizeof(boolean_T));
 
     //  error state for iteration
     // 'OnePointRANSAC_EKF:184' for it = 1:VIOParameters.max_ekf_iterations
@@ -2898,1920 +2876,463 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
                  e_stereoParams_CameraParameters,
                  f_stereoParams_CameraParameters, stereoParams_r_lr,
                  stereoParams_R_rl, VIOParameters_full_stereo, r, H, ind);
-      i50 = b_H->size[0] * b_H->size[1];
-      b_H->size[0] = H->size[0];
-      b_H->size[1] = 102;
-      emxEnsureCapacity((emxArray__common *)b_H, i50, (int)sizeof(double));
-      ndbl = H->size[0] * H->size[1];
-      for (i50 = 0; i50 < ndbl; i50++) {
-        b_H->data[i50] = H->data[i50];
-      }
 
-      //  the residual is ordered by anchors/features, not like updateVect
-      // 'OnePointRANSAC_EKF:190' P_a = P(1:6, 1:6);
-      // 'OnePointRANSAC_EKF:192' for k = 1:length(HI_ind)
-      for (k = 0; k < ii_size_idx_0; k++) {
-        // 'OnePointRANSAC_EKF:193' anchorIdx = ind(k, 1);
-        anchorIdx = ind->data[k];
-
-        // 'OnePointRANSAC_EKF:194' featureIdx = ind(k, 2);
-        // 'OnePointRANSAC_EKF:195' H_a = H((k-1)*residualDim + (1:residualDim), 1:6); 
-        ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-        b_m = ndbl + 1;
-        cdiff = (ndbl - residualDim) + 1;
-        if (fabs((double)cdiff) < 4.4408920985006262E-16 * (double)residualDim)
-        {
-          ndbl++;
-          b_m = residualDim;
-        } else if (cdiff > 0) {
-          b_m = ndbl;
-        } else {
-          ndbl++;
+      //  Keep the linearization and the gain of the previous iteration if
+      //  the state moved less than the threshold, only the residual changes
+      reuse_H = false;
+      if ((it > 1) && (c_VIOParameters_jacobian_reuse_ > 0.0) && (r->size[0] ==
+           b_H->size[0])) {
+        dx_norm = 0.0;
+        for (k = 0; k < 102; k++) {
+          dx_norm += (x_it[k] - x_it_prev[k]) * (x_it[k] - x_it_prev[k]);
         }
 
-        c_xt[0] = 1.0;
-        if (ndbl > 1) {
-          c_xt[ndbl - 1] = b_m;
-          i50 = ndbl - 1;
-          idx = i50 / 2;
-          cdiff = 1;
-          while (cdiff <= idx - 1) {
-            c_xt[1] = 2.0;
-            c_xt[ndbl - 2] = (double)b_m - 1.0;
-            cdiff = 2;
-          }
+        reuse_H = (sqrt(dx_norm) < c_VIOParameters_jacobian_reuse_);
+      }
 
-          if (idx << 1 == ndbl - 1) {
-            c_xt[idx] = (1.0 + (double)b_m) / 2.0;
-          } else {
-            c_xt[idx] = 1.0 + (double)idx;
-            c_xt[idx + 1] = b_m - idx;
-          }
-        }
+      memcpy(&x_it_prev[0], &x_it[0], 102U * sizeof(double));
+      if (reuse_H) {
+        //  apply the gating of the iteration the linearization comes from
+        for (k = 0; k < ii_size_idx_0; k++) {
+          if (gated[k]) {
+            for (idx = 0; idx < residualDim; idx++) {
+              r->data[k * residualDim + idx] = 0.0;
+            }
 
-        cdiff = (unsigned char)((unsigned int)(unsigned char)k * residualDim);
-        for (i50 = 0; i50 < 6; i50++) {
-          for (i52 = 0; i52 < ndbl; i52++) {
-            H_a_data[i52 + ndbl * i50] = b_H->data[((int)((double)cdiff +
-              c_xt[i52]) + b_H->size[0] * i50) - 1];
+            if (it == c_VIOParameters_max_ekf_iterati) {
+              HI_inlierStatus[hyp_ind_data[k] - 1] = false;
+            }
           }
         }
-
-        // 'OnePointRANSAC_EKF:196' H_b = H((k-1)*residualDim + (1:residualDim), numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
-        b_ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-        b_m = b_ndbl + 1;
-        cdiff = (b_ndbl - residualDim) + 1;
-        if (fabs((double)cdiff) < 4.4408920985006262E-16 * (double)residualDim)
-        {
-          b_ndbl++;
-          b_m = residualDim;
-        } else if (cdiff > 0) {
-          b_m = b_ndbl;
-        } else {
-          b_ndbl++;
-        }
-
-        b_y_data[0] = 1.0;
-        if (b_ndbl > 1) {
-          b_y_data[b_ndbl - 1] = b_m;
-          i50 = b_ndbl - 1;
-          idx = i50 / 2;
-          cdiff = 1;
-          while (cdiff <= idx - 1) {
-            b_y_data[1] = 2.0;
-            b_y_data[b_ndbl - 2] = (double)b_m - 1.0;
-            cdiff = 2;
-          }
-
-          if (idx << 1 == b_ndbl - 1) {
-            b_y_data[idx] = (1.0 + (double)b_m) / 2.0;
+      } else {
+        memset(&gated[0], 0, 48U * sizeof(boolean_T));
+        i50 = b_H->size[0] * b_H->size[1];
+        b_H->size[0] = H->size[0];
+        b_H->size[1] = 102;
+        emxEnsureCapacity((emxArray__common *)b_H, i50, (int)sizeof(double));
+        ndbl = H->size[0] * H->size[1];
+        for (i50 = 0; i50 < ndbl; i50++) {
+          b_H->data[i50] = H->data[i50];
+        }
+
+        //  the residual is ordered by anchors/features, not like updateVect
+        // 'OnePointRANSAC_EKF:190' P_a = P(1:6, 1:6);
+        // 'OnePointRANSAC_EKF:192' for k = 1:length(HI_ind)
+        for (k = 0; k < ii_size_idx_0; k++) {
+          // 'OnePointRANSAC_EKF:193' anchorIdx = ind(k, 1);
+          anchorIdx = ind->data[k];
+
+          // 'OnePointRANSAC_EKF:194' featureIdx = ind(k, 2);
+          featureIdx = ind->data[k + ind->size[0]];
+
+          // 'OnePointRANSAC_EKF:195' H_a = H((k-1)*residualDim + (1:residualDim), 1:6); 
+          // 'OnePointRANSAC_EKF:196' H_b = H((k-1)*residualDim + (1:residualDim), numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
+          // 'OnePointRANSAC_EKF:197' H_c = H((k-1)*residualDim + (1:residualDim), numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx); 
+          // 'OnePointRANSAC_EKF:198' P_b = P(numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6), 1:6); 
+          // 'OnePointRANSAC_EKF:199' P_c = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, 1:6); 
+          // 'OnePointRANSAC_EKF:200' P_d = P_b';
+          // 'OnePointRANSAC_EKF:201' P_e = P(numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6), numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
+          // 'OnePointRANSAC_EKF:202' P_f = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
+          // 'OnePointRANSAC_EKF:203' P_g = P_c';
+          // 'OnePointRANSAC_EKF:204' P_h = P_f';
+          // 'OnePointRANSAC_EKF:205' P_i = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx); 
+          // 'OnePointRANSAC_EKF:206' S_feature = (H_a*P_a + H_b*P_b + H_c*P_c)*H_a' + ... 
+          // 'OnePointRANSAC_EKF:207'                         (H_a*P_d + H_b*P_e + H_c*P_f)*H_b' + ... 
+          // 'OnePointRANSAC_EKF:208'                         (H_a*P_g + H_b*P_h + H_c*P_i)*H_c'; 
+          // 'OnePointRANSAC_EKF:210' size_S = residualDim;
+          // 'OnePointRANSAC_EKF:211' S_feature(1:(size_S+1):size_S^2) = S_feature(1:(size_S+1):size_S^2) + noiseParameters.image_noise; 
+          //  add R to HPH'
+          for (idx = 0; idx < 6; idx++) {
+            feature_cols[idx] = idx;
+            feature_cols[6 + idx] = (anchorIdx - 1) * 14 + (18 + idx);
+          }
+
+          feature_cols[12] = (anchorIdx - 1) * 14 + (23 + featureIdx);
+
+          // 'OnePointRANSAC_EKF:213' if coder.target('MATLAB')
+          // 'OnePointRANSAC_EKF:221' innov = r((k-1)*residualDim + (1:residualDim))' / S_feature * r((k-1)*residualDim + (1:residualDim)); 
+          if (residualDim == 4) {
+            innov = small_matrix::featureMahalanobis<4>(&b_H->data[k << 2],
+              b_H->size[0], b_P, 102, feature_cols, noiseParameters_image_noise,
+              &r->data[k << 2]);
           } else {
-            b_y_data[idx] = 1.0 + (double)idx;
-            b_y_data[idx + 1] = b_m - idx;
-          }
-        }
+            innov = small_matrix::featureMahalanobis<2>(&b_H->data[k << 1],
+              b_H->size[0], b_P, 102, feature_cols, noiseParameters_image_noise,
+              &r->data[k << 1]);
+          }
+
+          // 'OnePointRANSAC_EKF:222' if innov > mahalanobis_thresh
+          if (innov > mahalanobis_thresh) {
+            // 'OnePointRANSAC_EKF:223' r((k-1)*residualDim + (1:residualDim)) = 0; 
+            ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
+            b_m = ndbl + 1;
+            cdiff = (ndbl - residualDim) + 1;
+            if (fabs((double)cdiff) < 4.4408920985006262E-16 * (double)residualDim)
+            {
+              ndbl++;
+              b_m = residualDim;
+            } else if (cdiff > 0) {
+              b_m = ndbl;
+            } else {
+              ndbl++;
+            }
 
-        cdiff = (unsigned char)((unsigned int)(unsigned char)k * residualDim);
-        i51 = ind->data[k] - 1L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
+            c_xt[0] = 1.0;
+            if (ndbl > 1) {
+              c_xt[ndbl - 1] = b_m;
+              i50 = ndbl - 1;
+              idx = i50 / 2;
+              cdiff = 1;
+              while (cdiff <= idx - 1) {
+                c_xt[1] = 2.0;
+                c_xt[ndbl - 2] = (double)b_m - 1.0;
+                cdiff = 2;
+              }
 
-        i51 = (int)i51 * 14L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
+              if (idx << 1 == ndbl - 1) {
+                c_xt[idx] = (1.0 + (double)b_m) / 2.0;
+              } else {
+                c_xt[idx] = 1.0 + (double)idx;
+                c_xt[idx + 1] = b_m - idx;
+              }
+            }
 
-        i51 = 18L + (int)i51;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
+            cdiff = (unsigned char)((unsigned int)(unsigned char)k * residualDim);
+            for (i50 = 0; i50 < ndbl; i50++) {
+              b_tmp_data[i50] = (int)((double)cdiff + c_xt[i50]);
+            }
 
-        i50 = (int)i51;
-        for (i52 = 0; i52 < 6; i52++) {
-          for (b_m = 0; b_m < b_ndbl; b_m++) {
-            i51 = (long)i50 + (1 + i52);
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
+            for (i50 = 0; i50 < ndbl; i50++) {
+              r->data[b_tmp_data[i50] - 1] = 0.0;
+            }
+
+            // 'OnePointRANSAC_EKF:224' H((k-1)*residualDim + (1:residualDim), :) = 0; 
+            ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
+            b_m = ndbl + 1;
+            cdiff = (ndbl - residualDim) + 1;
+            if (fabs((double)cdiff) < 4.4408920985006262E-16 * (double)residualDim)
+            {
+              ndbl++;
+              b_m = residualDim;
+            } else if (cdiff > 0) {
+              b_m = ndbl;
             } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
+              ndbl++;
             }
 
-            H_b_data[b_m + b_ndbl * i52] = b_H->data[((int)((double)cdiff +
-              b_y_data[b_m]) + b_H->size[0] * ((int)i51 - 1)) - 1];
-          }
-        }
+            c_xt[0] = 1.0;
+            if (ndbl > 1) {
+              c_xt[ndbl - 1] = b_m;
+              i50 = ndbl - 1;
+              idx = i50 / 2;
+              cdiff = 1;
+              while (cdiff <= idx - 1) {
+                c_xt[1] = 2.0;
+                c_xt[ndbl - 2] = (double)b_m - 1.0;
+                cdiff = 2;
+              }
 
-        // 'OnePointRANSAC_EKF:197' H_c = H((k-1)*residualDim + (1:residualDim), numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx); 
-        c_ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-        b_m = c_ndbl + 1;
-        cdiff = (c_ndbl - residualDim) + 1;
-        if (fabs((double)cdiff) < 4.4408920985006262E-16 * (double)residualDim)
-        {
-          c_ndbl++;
-          b_m = residualDim;
-        } else if (cdiff > 0) {
-          b_m = c_ndbl;
-        } else {
-          c_ndbl++;
-        }
+              if (idx << 1 == ndbl - 1) {
+                c_xt[idx] = (1.0 + (double)b_m) / 2.0;
+              } else {
+                c_xt[idx] = 1.0 + (double)idx;
+                c_xt[idx + 1] = b_m - idx;
+              }
+            }
 
-        y_data[0] = 1.0;
-        if (c_ndbl > 1) {
-          y_data[c_ndbl - 1] = b_m;
-          i50 = c_ndbl - 1;
-          idx = i50 / 2;
-          cdiff = 1;
-          while (cdiff <= idx - 1) {
-            y_data[1] = 2.0;
-            y_data[c_ndbl - 2] = (double)b_m - 1.0;
-            cdiff = 2;
-          }
+            cdiff = (unsigned char)((unsigned int)(unsigned char)k * residualDim);
+            for (i50 = 0; i50 < ndbl; i50++) {
+              tmp_data[i50] = (int)((double)cdiff + c_xt[i50]);
+            }
 
-          if (idx << 1 == c_ndbl - 1) {
-            y_data[idx] = (1.0 + (double)b_m) / 2.0;
-          } else {
-            y_data[idx] = 1.0 + (double)idx;
-            y_data[idx + 1] = b_m - idx;
-          }
-        }
+            for (i50 = 0; i50 < 102; i50++) {
+              for (i52 = 0; i52 < ndbl; i52++) {
+                b_H->data[(tmp_data[i52] + b_H->size[0] * i50) - 1] = 0.0;
+              }
+            }
 
-        cdiff = (unsigned char)((unsigned int)(unsigned char)k * residualDim);
-        i51 = ind->data[k] - 1L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
+            gated[k] = true;
 
-        i51 = (int)i51 * 14L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
+            // 'OnePointRANSAC_EKF:225' if it == VIOParameters.max_ekf_iterations
+            if (it == c_VIOParameters_max_ekf_iterati) {
+              // 'OnePointRANSAC_EKF:226' HI_inlierStatus(HI_ind(k)) = false;
+              HI_inlierStatus[hyp_ind_data[k] - 1] = false;
 
-        i51 = 18L + (int)i51;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
+              //  only reject the feature if its still bad in last iteration, otherwise just dont use for this update 
+            }
 
-        i51 = (int)i51 + 6L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
+            //                  log_info('rejecting %i', HI_ind(k))
+            // 'OnePointRANSAC_EKF:229' if updateVect(HI_ind(k)) == 2
+            if (updateVect[hyp_ind_data[k] - 1] == 2) {
+              // 'OnePointRANSAC_EKF:230' log_error('inconsistency')
+              b_log_error();
+            }
           }
         }
+      }
 
-        i51 = (long)(int)i51 + ind->data[k + ind->size[0]];
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
+      if (it == c_VIOParameters_max_ekf_iterati) {
+        telemetry.innovation_norm = 0.0;
+        for (k = 0; k < r->size[0]; k++) {
+          telemetry.innovation_norm += r->data[k] * r->data[k];
         }
 
-        i50 = (int)i51;
-        for (i52 = 0; i52 < c_ndbl; i52++) {
-          H_c_data[i52] = b_H->data[((int)((double)cdiff + y_data[i52]) +
-            b_H->size[0] * (i50 - 1)) - 1];
-        }
+        telemetry.innovation_norm = sqrt(telemetry.innovation_norm);
+      }
 
-        // 'OnePointRANSAC_EKF:198' P_b = P(numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6), 1:6); 
-        i51 = ind->data[k] - 1L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
+      if (!reuse_H) {
+        // 'OnePointRANSAC_EKF:235' S = (H*P*H');
+        H_idx_0 = (unsigned int)b_H->size[0];
+        i50 = e_y->size[0] * e_y->size[1];
+        e_y->size[0] = (int)H_idx_0;
+        e_y->size[1] = 102;
+        emxEnsureCapacity((emxArray__common *)e_y, i50, (int)sizeof(double));
+        b_m = b_H->size[0];
+        i50 = e_y->size[0] * e_y->size[1];
+        e_y->size[1] = 102;
+        emxEnsureCapacity((emxArray__common *)e_y, i50, (int)sizeof(double));
+        for (i50 = 0; i50 < 102; i50++) {
+          ndbl = e_y->size[0];
+          for (i52 = 0; i52 < ndbl; i52++) {
+            e_y->data[i52 + e_y->size[0] * i50] = 0.0;
           }
         }
 
-        i51 = (int)i51 * 14L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
+        if (b_H->size[0] == 0) {
         } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
+          idx = b_H->size[0] * 101;
+          cr = 0;
+          while ((b_m > 0) && (cr <= idx)) {
+            i50 = cr + b_m;
+            for (ic = cr; ic + 1 <= i50; ic++) {
+              e_y->data[ic] = 0.0;
+            }
 
-        i51 = 18L + (int)i51;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
+            cr += b_m;
           }
-        }
 
-        i50 = (int)i51;
-        for (i52 = 0; i52 < 6; i52++) {
-          for (b_m = 0; b_m < 6; b_m++) {
-            i51 = (long)i50 + (1 + b_m);
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
+          br = 0;
+          cr = 0;
+          while ((b_m > 0) && (cr <= idx)) {
+            ar = 0;
+            for (ib = br; ib + 1 <= br + 102; ib++) {
+              if (b_P[ib] != 0.0) {
+                ia = ar;
+                i50 = cr + b_m;
+                for (ic = cr; ic + 1 <= i50; ic++) {
+                  ia++;
+                  e_y->data[ic] += b_P[ib] * b_H->data[ia - 1];
+                }
               }
+
+              ar += b_m;
             }
 
-            P_b[b_m + 6 * i52] = b_P[((int)i51 + 102 * i52) - 1];
+            br += 102;
+            cr += b_m;
           }
         }
 
-        // 'OnePointRANSAC_EKF:199' P_c = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, 1:6); 
-        i51 = ind->data[k] - 1L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
+        i50 = c_H->size[0] * c_H->size[1];
+        c_H->size[0] = b_H->size[1];
+        c_H->size[1] = b_H->size[0];
+        emxEnsureCapacity((emxArray__common *)c_H, i50, (int)sizeof(double));
+        ndbl = b_H->size[0];
+        for (i50 = 0; i50 < ndbl; i50++) {
+          idx = b_H->size[1];
+          for (i52 = 0; i52 < idx; i52++) {
+            c_H->data[i52 + c_H->size[0] * i50] = b_H->data[i50 + b_H->size[0] *
+              i52];
           }
         }
 
-        i51 = (int)i51 * 14L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
+        cdiff = b_H->size[0];
+        i50 = K->size[0] * K->size[1];
+        K->size[0] = 102;
+        K->size[1] = cdiff;
+        emxEnsureCapacity((emxArray__common *)K, i50, (int)sizeof(double));
+        for (i50 = 0; i50 < cdiff; i50++) {
+          for (i52 = 0; i52 < 102; i52++) {
+            K->data[i52 + K->size[0] * i50] = c_H->data[i52 + 102 * i50];
           }
         }
 
-        i51 = 18L + (int)i51;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
+        H_idx_0 = (unsigned int)e_y->size[0];
+        unnamed_idx_1 = (unsigned int)K->size[1];
+        i50 = S->size[0] * S->size[1];
+        S->size[0] = (int)H_idx_0;
+        S->size[1] = (int)unnamed_idx_1;
+        emxEnsureCapacity((emxArray__common *)S, i50, (int)sizeof(double));
+        b_m = e_y->size[0];
+        i50 = S->size[0] * S->size[1];
+        emxEnsureCapacity((emxArray__common *)S, i50, (int)sizeof(double));
+        ndbl = S->size[1];
+        for (i50 = 0; i50 < ndbl; i50++) {
+          idx = S->size[0];
+          for (i52 = 0; i52 < idx; i52++) {
+            S->data[i52 + S->size[0] * i50] = 0.0;
           }
         }
 
-        i51 = (int)i51 + 6L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
+        if ((e_y->size[0] == 0) || (K->size[1] == 0)) {
         } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
+          idx = e_y->size[0] * (K->size[1] - 1);
+          cr = 0;
+          while ((b_m > 0) && (cr <= idx)) {
+            i50 = cr + b_m;
+            for (ic = cr; ic + 1 <= i50; ic++) {
+              S->data[ic] = 0.0;
+            }
 
-        i51 = (long)(int)i51 + ind->data[k + ind->size[0]];
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
+            cr += b_m;
           }
-        }
 
-        i50 = (int)i51;
-
-        // 'OnePointRANSAC_EKF:200' P_d = P_b';
-        for (i52 = 0; i52 < 6; i52++) {
-          P_c[i52] = b_P[(i50 + 102 * i52) - 1];
-          for (b_m = 0; b_m < 6; b_m++) {
-            P_d[b_m + 6 * i52] = P_b[i52 + 6 * b_m];
-          }
-        }
+          br = 0;
+          cr = 0;
+          while ((b_m > 0) && (cr <= idx)) {
+            ar = 0;
+            for (ib = br; ib + 1 <= br + 102; ib++) {
+              if (K->data[ib] != 0.0) {
+                ia = ar;
+                i50 = cr + b_m;
+                for (ic = cr; ic + 1 <= i50; ic++) {
+                  ia++;
+                  S->data[ic] += K->data[ib] * e_y->data[ia - 1];
+                }
+              }
 
-        // 'OnePointRANSAC_EKF:201' P_e = P(numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6), numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
-        // 'OnePointRANSAC_EKF:202' P_f = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
-        i51 = ind->data[k] - 1L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
+              ar += b_m;
+            }
 
-        i51 = (int)i51 * 14L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
+            br += 102;
+            cr += b_m;
           }
         }
 
-        i51 = 18L + (int)i51;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
+        // 'OnePointRANSAC_EKF:236' size_S = num_HI_inlierCandidates*residualDim;
+        size_S = (double)n * (double)residualDim;
 
-        i50 = (int)i51;
-        i51 = ind->data[k] - 1L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
+        // 'OnePointRANSAC_EKF:237' S(1:(size_S+1):size_S^2) = S(1:(size_S+1):size_S^2) + noiseParameters.image_noise; 
+        c_P = size_S * size_S;
+        if ((size_S + 1.0 == 0.0) || (((size_S + 1.0 > 0.0) && (1.0 > c_P)) ||
+             ((0.0 > size_S + 1.0) && (c_P > 1.0)))) {
+          i50 = 1;
+          i52 = -1;
         } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
+          i50 = (int)(size_S + 1.0);
+          i52 = (int)c_P - 1;
         }
 
-        i51 = (int)i51 * 14L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
+        c_P = size_S * size_S;
+        if ((size_S + 1.0 == 0.0) || (((size_S + 1.0 > 0.0) && (1.0 > c_P)) ||
+             ((0.0 > size_S + 1.0) && (c_P > 1.0)))) {
+          b_m = 1;
         } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
+          b_m = (int)(size_S + 1.0);
         }
 
-        i51 = 18L + (int)i51;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
+        cdiff = c_S->size[0] * c_S->size[1];
+        c_S->size[0] = 1;
+        c_S->size[1] = div_s32_floor(i52, i50) + 1;
+        emxEnsureCapacity((emxArray__common *)c_S, cdiff, (int)sizeof(double));
+        ndbl = div_s32_floor(i52, i50);
+        for (i52 = 0; i52 <= ndbl; i52++) {
+          c_S->data[c_S->size[0] * i52] = S->data[i50 * i52] +
+            noiseParameters_image_noise;
         }
 
-        i51 = (int)i51 + 6L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
+        ndbl = c_S->size[1];
+        for (i50 = 0; i50 < ndbl; i50++) {
+          S->data[b_m * i50] = c_S->data[c_S->size[0] * i50];
         }
 
-        i51 = (long)(int)i51 + ind->data[k + ind->size[0]];
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
+        //  add R to HPH'
+        // 'OnePointRANSAC_EKF:239' K = (P*H')/S;
+        i50 = d_H->size[0] * d_H->size[1];
+        d_H->size[0] = b_H->size[1];
+        d_H->size[1] = b_H->size[0];
+        emxEnsureCapacity((emxArray__common *)d_H, i50, (int)sizeof(double));
+        ndbl = b_H->size[0];
+        for (i50 = 0; i50 < ndbl; i50++) {
+          idx = b_H->size[1];
+          for (i52 = 0; i52 < idx; i52++) {
+            d_H->data[i52 + d_H->size[0] * i50] = b_H->data[i50 + b_H->size[0] *
+              i52];
           }
         }
 
-        i52 = (int)i51;
-
-        // 'OnePointRANSAC_EKF:203' P_g = P_c';
-        // 'OnePointRANSAC_EKF:204' P_h = P_f';
-        // 'OnePointRANSAC_EKF:205' P_i = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx); 
-        // 'OnePointRANSAC_EKF:206' S_feature = (H_a*P_a + H_b*P_b + H_c*P_c)*H_a' + ... 
-        // 'OnePointRANSAC_EKF:207'                         (H_a*P_d + H_b*P_e + H_c*P_f)*H_b' + ... 
-        // 'OnePointRANSAC_EKF:208'                         (H_a*P_g + H_b*P_h + H_c*P_i)*H_c'; 
-        for (b_m = 0; b_m < 6; b_m++) {
-          i51 = (long)i50 + (1 + b_m);
-          if (i51 > 2147483647L) {
-            i51 = 2147483647L;
-          } else {
-            if (i51 < -2147483648L) {
-              i51 = -2147483648L;
-            }
-          }
-
-          P_f[b_m] = b_P[(i52 + 102 * ((int)i51 - 1)) - 1];
-          for (cdiff = 0; cdiff < ndbl; cdiff++) {
-            f_C_data[cdiff + ndbl * b_m] = 0.0;
+        cdiff = b_H->size[0];
+        i50 = K->size[0] * K->size[1];
+        K->size[0] = 102;
+        K->size[1] = cdiff;
+        emxEnsureCapacity((emxArray__common *)K, i50, (int)sizeof(double));
+        for (i50 = 0; i50 < cdiff; i50++) {
+          for (i52 = 0; i52 < 102; i52++) {
+            K->data[i52 + K->size[0] * i50] = d_H->data[i52 + 102 * i50];
           }
         }
 
-        idx = ndbl * 5;
-        for (cr = 0; cr <= idx; cr += ndbl) {
-          i50 = cr + ndbl;
-          for (ic = cr; ic + 1 <= i50; ic++) {
-            f_C_data[ic] = 0.0;
+        unnamed_idx_1 = (unsigned int)K->size[1];
+        i50 = f_y->size[0] * f_y->size[1];
+        f_y->size[0] = 102;
+        f_y->size[1] = (int)unnamed_idx_1;
+        f_y->size[0] = 102;
+        emxEnsureCapacity((emxArray__common *)f_y, i50, (int)sizeof(double));
+        ndbl = f_y->size[1];
+        for (i50 = 0; i50 < ndbl; i50++) {
+          for (i52 = 0; i52 < 102; i52++) {
+            f_y->data[i52 + f_y->size[0] * i50] = 0.0;
           }
         }
 
-        br = 0;
-        for (cr = 0; cr <= idx; cr += ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            if (b_P[ib % 6 + 102 * (ib / 6)] != 0.0) {
-              ia = ar;
-              i50 = cr + ndbl;
-              for (ic = cr; ic + 1 <= i50; ic++) {
-                ia++;
-                cdiff = (unsigned char)((unsigned int)(unsigned char)k *
-                  residualDim);
-                for (i52 = 0; i52 < ndbl; i52++) {
-                  tmp_data[i52] = (int)((double)cdiff + c_xt[i52]);
+        if (K->size[1] == 0) {
+        } else {
+          idx = 102 * (K->size[1] - 1);
+          for (cr = 0; cr <= idx; cr += 102) {
+            for (ic = cr + 1; ic <= cr + 102; ic++) {
+              f_y->data[ic - 1] = 0.0;
+            }
+          }
+
+          br = 0;
+          for (cr = 0; cr <= idx; cr += 102) {
+            ar = 0;
+            for (ib = br; ib + 1 <= br + 102; ib++) {
+              if (K->data[ib] != 0.0) {
+                ia = ar;
+                for (ic = cr; ic + 1 <= cr + 102; ic++) {
+                  ia++;
+                  f_y->data[ic] += K->data[ib] * b_P[ia - 1];
                 }
-
-                f_C_data[ic] += b_P[ib % 6 + 102 * (ib / 6)] * b_H->data
-                  [(tmp_data[(ia - 1) % ndbl] + b_H->size[0] * ((ia - 1) / ndbl))
-                  - 1];
               }
+
+              ar += 102;
             }
 
-            ar += ndbl;
+            br += 102;
           }
-
-          br += 6;
         }
 
-        for (i50 = 0; i50 < 6; i50++) {
-          for (i52 = 0; i52 < b_ndbl; i52++) {
-            g_C_data[i52 + b_ndbl * i50] = 0.0;
-          }
+        i50 = K->size[0] * K->size[1];
+        K->size[0] = 102;
+        K->size[1] = f_y->size[1];
+        emxEnsureCapacity((emxArray__common *)K, i50, (int)sizeof(double));
+        ndbl = f_y->size[0] * f_y->size[1];
+        for (i50 = 0; i50 < ndbl; i50++) {
+          K->data[i50] = f_y->data[i50];
         }
 
-        idx = b_ndbl * 5;
-        for (cr = 0; cr <= idx; cr += b_ndbl) {
-          i50 = cr + b_ndbl;
-          for (ic = cr; ic + 1 <= i50; ic++) {
-            g_C_data[ic] = 0.0;
-          }
-        }
-
-        br = 0;
-        for (cr = 0; cr <= idx; cr += b_ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            i51 = anchorIdx - 1L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = (int)i51 * 14L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = 18L + (int)i51;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = (long)(int)i51 + (1 + ib % 6);
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            if (b_P[((int)i51 + 102 * (ib / 6)) - 1] != 0.0) {
-              ia = ar;
-              i50 = cr + b_ndbl;
-              for (ic = cr; ic + 1 <= i50; ic++) {
-                ia++;
-                cdiff = (unsigned char)((unsigned int)(unsigned char)k *
-                  residualDim);
-                for (i52 = 0; i52 < b_ndbl; i52++) {
-                  tmp_data[i52] = (int)((double)cdiff + b_y_data[i52]);
-                }
-
-                i51 = ind->data[k] - 1L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = (int)i51 * 14L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = 18L + (int)i51;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i52 = (int)i51;
-                i51 = (long)i52 + (1 + ib % 6);
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i53 = anchorIdx - 1L;
-                if (i53 > 2147483647L) {
-                  i53 = 2147483647L;
-                } else {
-                  if (i53 < -2147483648L) {
-                    i53 = -2147483648L;
-                  }
-                }
-
-                i53 = (int)i53 * 14L;
-                if (i53 > 2147483647L) {
-                  i53 = 2147483647L;
-                } else {
-                  if (i53 < -2147483648L) {
-                    i53 = -2147483648L;
-                  }
-                }
-
-                i53 = 18L + (int)i53;
-                if (i53 > 2147483647L) {
-                  i53 = 2147483647L;
-                } else {
-                  if (i53 < -2147483648L) {
-                    i53 = -2147483648L;
-                  }
-                }
-
-                i53 = (long)(int)i53 + (1 + (ia - 1) / b_ndbl);
-                if (i53 > 2147483647L) {
-                  i53 = 2147483647L;
-                } else {
-                  if (i53 < -2147483648L) {
-                    i53 = -2147483648L;
-                  }
-                }
-
-                g_C_data[ic] += b_P[((int)i51 + 102 * (ib / 6)) - 1] * b_H->
-                  data[(tmp_data[(ia - 1) % b_ndbl] + b_H->size[0] * ((int)i53 -
-                         1)) - 1];
-              }
-            }
-
-            ar += b_ndbl;
-          }
-
-          br += 6;
-        }
-
-        for (i50 = 0; i50 < 6; i50++) {
-          for (i52 = 0; i52 < ndbl; i52++) {
-            h_C_data[i52 + ndbl * i50] = 0.0;
-          }
-        }
-
-        idx = ndbl * 5;
-        for (cr = 0; cr <= idx; cr += ndbl) {
-          i50 = cr + ndbl;
-          for (ic = cr; ic + 1 <= i50; ic++) {
-            h_C_data[ic] = 0.0;
-          }
-        }
-
-        br = 0;
-        for (cr = 0; cr <= idx; cr += ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            if (P_d[ib] != 0.0) {
-              ia = ar;
-              i50 = cr + ndbl;
-              for (ic = cr; ic + 1 <= i50; ic++) {
-                ia++;
-                cdiff = (unsigned char)((unsigned int)(unsigned char)k *
-                  residualDim);
-                for (i52 = 0; i52 < ndbl; i52++) {
-                  tmp_data[i52] = (int)((double)cdiff + c_xt[i52]);
-                }
-
-                h_C_data[ic] += P_d[ib] * b_H->data[(tmp_data[(ia - 1) % ndbl] +
-                  b_H->size[0] * ((ia - 1) / ndbl)) - 1];
-              }
-            }
-
-            ar += ndbl;
-          }
-
-          br += 6;
-        }
-
-        for (i50 = 0; i50 < 6; i50++) {
-          for (i52 = 0; i52 < b_ndbl; i52++) {
-            i_C_data[i52 + b_ndbl * i50] = 0.0;
-          }
-        }
-
-        idx = b_ndbl * 5;
-        for (cr = 0; cr <= idx; cr += b_ndbl) {
-          i50 = cr + b_ndbl;
-          for (ic = cr; ic + 1 <= i50; ic++) {
-            i_C_data[ic] = 0.0;
-          }
-        }
-
-        br = 0;
-        for (cr = 0; cr <= idx; cr += b_ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            i51 = anchorIdx - 1L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = (int)i51 * 14L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = 18L + (int)i51;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = (long)(int)i51 + (1 + ib % 6);
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i53 = anchorIdx - 1L;
-            if (i53 > 2147483647L) {
-              i53 = 2147483647L;
-            } else {
-              if (i53 < -2147483648L) {
-                i53 = -2147483648L;
-              }
-            }
-
-            i53 = (int)i53 * 14L;
-            if (i53 > 2147483647L) {
-              i53 = 2147483647L;
-            } else {
-              if (i53 < -2147483648L) {
-                i53 = -2147483648L;
-              }
-            }
-
-            i53 = 18L + (int)i53;
-            if (i53 > 2147483647L) {
-              i53 = 2147483647L;
-            } else {
-              if (i53 < -2147483648L) {
-                i53 = -2147483648L;
-              }
-            }
-
-            i53 = (long)(int)i53 + (1 + ib / 6);
-            if (i53 > 2147483647L) {
-              i53 = 2147483647L;
-            } else {
-              if (i53 < -2147483648L) {
-                i53 = -2147483648L;
-              }
-            }
-
-            if (b_P[((int)i51 + 102 * ((int)i53 - 1)) - 1] != 0.0) {
-              ia = ar;
-              i50 = cr + b_ndbl;
-              for (ic = cr; ic + 1 <= i50; ic++) {
-                ia++;
-                cdiff = (unsigned char)((unsigned int)(unsigned char)k *
-                  residualDim);
-                for (i52 = 0; i52 < b_ndbl; i52++) {
-                  tmp_data[i52] = (int)((double)cdiff + b_y_data[i52]);
-                }
-
-                i51 = ind->data[k] - 1L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = (int)i51 * 14L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = 18L + (int)i51;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i52 = (int)i51;
-                i51 = ind->data[k] - 1L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = (int)i51 * 14L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = 18L + (int)i51;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                b_m = (int)i51;
-                i51 = (long)i52 + (1 + ib % 6);
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i53 = (long)b_m + (1 + ib / 6);
-                if (i53 > 2147483647L) {
-                  i53 = 2147483647L;
-                } else {
-                  if (i53 < -2147483648L) {
-                    i53 = -2147483648L;
-                  }
-                }
-
-                i54 = anchorIdx - 1L;
-                if (i54 > 2147483647L) {
-                  i54 = 2147483647L;
-                } else {
-                  if (i54 < -2147483648L) {
-                    i54 = -2147483648L;
-                  }
-                }
-
-                i54 = (int)i54 * 14L;
-                if (i54 > 2147483647L) {
-                  i54 = 2147483647L;
-                } else {
-                  if (i54 < -2147483648L) {
-                    i54 = -2147483648L;
-                  }
-                }
-
-                i54 = 18L + (int)i54;
-                if (i54 > 2147483647L) {
-                  i54 = 2147483647L;
-                } else {
-                  if (i54 < -2147483648L) {
-                    i54 = -2147483648L;
-                  }
-                }
-
-                i54 = (long)(int)i54 + (1 + (ia - 1) / b_ndbl);
-                if (i54 > 2147483647L) {
-                  i54 = 2147483647L;
-                } else {
-                  if (i54 < -2147483648L) {
-                    i54 = -2147483648L;
-                  }
-                }
-
-                i_C_data[ic] += b_P[((int)i51 + 102 * ((int)i53 - 1)) - 1] *
-                  b_H->data[(tmp_data[(ia - 1) % b_ndbl] + b_H->size[0] * ((int)
-                  i54 - 1)) - 1];
-              }
-            }
-
-            ar += b_ndbl;
-          }
-
-          br += 6;
-        }
-
-        for (i50 = 0; i50 < c_ndbl; i50++) {
-          for (i52 = 0; i52 < 6; i52++) {
-            a_data[i50 + c_ndbl * i52] = (f_C_data[i50 + ndbl * i52] +
-              g_C_data[i50 + b_ndbl * i52]) + H_c_data[i50] * P_c[i52];
-          }
-        }
-
-        for (i50 = 0; i50 < ndbl; i50++) {
-          for (i52 = 0; i52 < 6; i52++) {
-            b_data[i52 + 6 * i50] = H_a_data[i50 + ndbl * i52];
-          }
-        }
-
-        for (i50 = 0; i50 < ndbl; i50++) {
-          for (i52 = 0; i52 < c_ndbl; i52++) {
-            j_C_data[i52 + c_ndbl * i50] = 0.0;
-          }
-        }
-
-        idx = c_ndbl * (ndbl - 1);
-        for (cr = 0; cr <= idx; cr += c_ndbl) {
-          i50 = cr + c_ndbl;
-          for (ic = cr; ic + 1 <= i50; ic++) {
-            j_C_data[ic] = 0.0;
-          }
-        }
-
-        br = 0;
-        for (cr = 0; cr <= idx; cr += c_ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            if (b_data[ib] != 0.0) {
-              ia = ar;
-              i50 = cr + c_ndbl;
-              for (ic = cr; ic + 1 <= i50; ic++) {
-                ia++;
-                j_C_data[ic] += b_data[ib] * a_data[ia - 1];
-              }
-            }
-
-            ar += c_ndbl;
-          }
-
-          br += 6;
-        }
-
-        for (i50 = 0; i50 < c_ndbl; i50++) {
-          for (i52 = 0; i52 < 6; i52++) {
-            a_data[i50 + c_ndbl * i52] = (h_C_data[i50 + ndbl * i52] +
-              i_C_data[i50 + b_ndbl * i52]) + H_c_data[i50] * P_f[i52];
-          }
-        }
-
-        for (i50 = 0; i50 < b_ndbl; i50++) {
-          for (i52 = 0; i52 < 6; i52++) {
-            b_data[i52 + 6 * i50] = H_b_data[i50 + b_ndbl * i52];
-          }
-        }
-
-        for (i50 = 0; i50 < b_ndbl; i50++) {
-          for (i52 = 0; i52 < c_ndbl; i52++) {
-            k_C_data[i52 + c_ndbl * i50] = 0.0;
-          }
-        }
-
-        idx = c_ndbl * (b_ndbl - 1);
-        for (cr = 0; cr <= idx; cr += c_ndbl) {
-          i50 = cr + c_ndbl;
-          for (ic = cr; ic + 1 <= i50; ic++) {
-            k_C_data[ic] = 0.0;
-          }
-        }
-
-        br = 0;
-        for (cr = 0; cr <= idx; cr += c_ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            if (b_data[ib] != 0.0) {
-              ia = ar;
-              i50 = cr + c_ndbl;
-              for (ic = cr; ic + 1 <= i50; ic++) {
-                ia++;
-                k_C_data[ic] += b_data[ib] * a_data[ia - 1];
-              }
-            }
-
-            ar += c_ndbl;
-          }
-
-          br += 6;
-        }
-
-        for (i50 = 0; i50 < ndbl; i50++) {
-          l_C_data[i50] = 0.0;
-        }
-
-        cr = 0;
-        while (cr <= 0) {
-          for (ic = 1; ic <= ndbl; ic++) {
-            l_C_data[ic - 1] = 0.0;
-          }
-
-          cr = ndbl;
-        }
-
-        br = 6;
-        cr = 0;
-        while (cr <= 0) {
-          ar = 0;
-          for (ib = br - 5; ib <= br; ib++) {
-            i51 = ind->data[k] - 1L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = (int)i51 * 14L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = 18L + (int)i51;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = (int)i51 + 6L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = (long)(int)i51 + ind->data[k + ind->size[0]];
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i50 = (int)i51;
-            if (b_P[(i50 + 102 * (ib - 1)) - 1] != 0.0) {
-              ia = ar;
-              for (ic = 0; ic + 1 <= ndbl; ic++) {
-                ia++;
-                cdiff = (unsigned char)((unsigned int)(unsigned char)k *
-                  residualDim);
-                for (i50 = 0; i50 < ndbl; i50++) {
-                  tmp_data[i50] = (int)((double)cdiff + c_xt[i50]);
-                }
-
-                i51 = ind->data[k] - 1L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = (int)i51 * 14L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = 18L + (int)i51;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = (int)i51 + 6L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = (long)(int)i51 + ind->data[k + ind->size[0]];
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i50 = (int)i51;
-                l_C_data[ic] += b_P[(i50 + 102 * (ib - 1)) - 1] * b_H->data
-                  [(tmp_data[(ia - 1) % ndbl] + b_H->size[0] * ((ia - 1) / ndbl))
-                  - 1];
-              }
-            }
-
-            ar += ndbl;
-          }
-
-          br += 6;
-          cr = ndbl;
-        }
-
-        for (i50 = 0; i50 < b_ndbl; i50++) {
-          m_C_data[i50] = 0.0;
-        }
-
-        cr = 0;
-        while (cr <= 0) {
-          for (ic = 1; ic <= b_ndbl; ic++) {
-            m_C_data[ic - 1] = 0.0;
-          }
-
-          cr = b_ndbl;
-        }
-
-        br = 6;
-        cr = 0;
-        while (cr <= 0) {
-          ar = 0;
-          for (ib = br - 5; ib <= br; ib++) {
-            i51 = ind->data[k] - 1L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = (int)i51 * 14L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = 18L + (int)i51;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i50 = (int)i51;
-            i51 = ind->data[k] - 1L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = (int)i51 * 14L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = 18L + (int)i51;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = (int)i51 + 6L;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i51 = (long)(int)i51 + ind->data[k + ind->size[0]];
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            i52 = (int)i51;
-            i51 = (long)i50 + ib;
-            if (i51 > 2147483647L) {
-              i51 = 2147483647L;
-            } else {
-              if (i51 < -2147483648L) {
-                i51 = -2147483648L;
-              }
-            }
-
-            if (b_P[(i52 + 102 * ((int)i51 - 1)) - 1] != 0.0) {
-              ia = ar;
-              for (ic = 0; ic + 1 <= b_ndbl; ic++) {
-                ia++;
-                cdiff = (unsigned char)((unsigned int)(unsigned char)k *
-                  residualDim);
-                for (i50 = 0; i50 < b_ndbl; i50++) {
-                  tmp_data[i50] = (int)((double)cdiff + b_y_data[i50]);
-                }
-
-                i51 = ind->data[k] - 1L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = (int)i51 * 14L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = 18L + (int)i51;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i50 = (int)i51;
-                i51 = ind->data[k] - 1L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = (int)i51 * 14L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = 18L + (int)i51;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = (int)i51 + 6L;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i51 = (long)(int)i51 + ind->data[k + ind->size[0]];
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i52 = (int)i51;
-                i51 = (long)i50 + ib;
-                if (i51 > 2147483647L) {
-                  i51 = 2147483647L;
-                } else {
-                  if (i51 < -2147483648L) {
-                    i51 = -2147483648L;
-                  }
-                }
-
-                i53 = anchorIdx - 1L;
-                if (i53 > 2147483647L) {
-                  i53 = 2147483647L;
-                } else {
-                  if (i53 < -2147483648L) {
-                    i53 = -2147483648L;
-                  }
-                }
-
-                i53 = (int)i53 * 14L;
-                if (i53 > 2147483647L) {
-                  i53 = 2147483647L;
-                } else {
-                  if (i53 < -2147483648L) {
-                    i53 = -2147483648L;
-                  }
-                }
-
-                i53 = 18L + (int)i53;
-                if (i53 > 2147483647L) {
-                  i53 = 2147483647L;
-                } else {
-                  if (i53 < -2147483648L) {
-                    i53 = -2147483648L;
-                  }
-                }
-
-                i53 = (long)(int)i53 + (1 + (ia - 1) / b_ndbl);
-                if (i53 > 2147483647L) {
-                  i53 = 2147483647L;
-                } else {
-                  if (i53 < -2147483648L) {
-                    i53 = -2147483648L;
-                  }
-                }
-
-                m_C_data[ic] += b_P[(i52 + 102 * ((int)i51 - 1)) - 1] *
-                  b_H->data[(tmp_data[(ia - 1) % b_ndbl] + b_H->size[0] * ((int)
-                  i53 - 1)) - 1];
-              }
-            }
-
-            ar += b_ndbl;
-          }
-
-          br += 6;
-          cr = b_ndbl;
-        }
-
-        i51 = ind->data[k] - 1L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
-
-        i51 = (int)i51 * 14L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
-
-        i51 = 18L + (int)i51;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
-
-        i51 = (int)i51 + 6L;
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
-
-        i51 = (long)(int)i51 + ind->data[k + ind->size[0]];
-        if (i51 > 2147483647L) {
-          i51 = 2147483647L;
-        } else {
-          if (i51 < -2147483648L) {
-            i51 = -2147483648L;
-          }
-        }
-
-        i53 = ind->data[k] - 1L;
-        if (i53 > 2147483647L) {
-          i53 = 2147483647L;
-        } else {
-          if (i53 < -2147483648L) {
-            i53 = -2147483648L;
-          }
-        }
-
-        i53 = (int)i53 * 14L;
-        if (i53 > 2147483647L) {
-          i53 = 2147483647L;
-        } else {
-          if (i53 < -2147483648L) {
-            i53 = -2147483648L;
-          }
-        }
-
-        i53 = 18L + (int)i53;
-        if (i53 > 2147483647L) {
-          i53 = 2147483647L;
-        } else {
-          if (i53 < -2147483648L) {
-            i53 = -2147483648L;
-          }
-        }
-
-        i53 = (int)i53 + 6L;
-        if (i53 > 2147483647L) {
-          i53 = 2147483647L;
-        } else {
-          if (i53 < -2147483648L) {
-            i53 = -2147483648L;
-          }
-        }
-
-        i53 = (long)(int)i53 + ind->data[k + ind->size[0]];
-        if (i53 > 2147483647L) {
-          i53 = 2147483647L;
-        } else {
-          if (i53 < -2147483648L) {
-            i53 = -2147483648L;
-          }
-        }
-
-        c_P = b_P[((int)i51 + 102 * ((int)i53 - 1)) - 1];
-        for (i50 = 0; i50 < ndbl; i50++) {
-          c_xt[i50] = (l_C_data[i50] + m_C_data[i50]) + H_c_data[i50] * c_P;
-        }
-
-        S_feature_size[0] = ndbl;
-        S_feature_size[1] = c_ndbl;
-        for (i50 = 0; i50 < ndbl; i50++) {
-          for (i52 = 0; i52 < c_ndbl; i52++) {
-            S_feature_data[i50 + ndbl * i52] = (j_C_data[i50 + c_ndbl * i52] +
-              k_C_data[i50 + c_ndbl * i52]) + c_xt[i50] * H_c_data[i52];
-          }
-        }
-
-        // 'OnePointRANSAC_EKF:210' size_S = residualDim;
-        // 'OnePointRANSAC_EKF:211' S_feature(1:(size_S+1):size_S^2) = S_feature(1:(size_S+1):size_S^2) + noiseParameters.image_noise; 
-        i50 = residualDim * residualDim - 1;
-        i52 = residualDim + 1;
-        ndbl = div_s32_floor(i50, i52);
-        for (b_m = 0; b_m <= ndbl; b_m++) {
-          b_S_feature_data[b_m] = S_feature_data[i52 * b_m] +
-            noiseParameters_image_noise;
-        }
-
-        ndbl = div_s32_floor(i50, i52) + 1;
-        for (i50 = 0; i50 < ndbl; i50++) {
-          S_feature_data[(residualDim + 1) * i50] = b_S_feature_data[i50];
-        }
-
-        //  add R to HPH'
-        // 'OnePointRANSAC_EKF:213' if coder.target('MATLAB')
-        // 'OnePointRANSAC_EKF:221' innov = r((k-1)*residualDim + (1:residualDim))' / S_feature * r((k-1)*residualDim + (1:residualDim)); 
-        ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-        b_m = ndbl + 1;
-        cdiff = (ndbl - residualDim) + 1;
-        if (fabs((double)cdiff) < 4.4408920985006262E-16 * (double)residualDim)
-        {
-          ndbl++;
-          b_m = residualDim;
-        } else if (cdiff > 0) {
-          b_m = ndbl;
-        } else {
-          ndbl++;
-        }
-
-        c_xt[0] = 1.0;
-        if (ndbl > 1) {
-          c_xt[ndbl - 1] = b_m;
-          i50 = ndbl - 1;
-          idx = i50 / 2;
-          cdiff = 1;
-          while (cdiff <= idx - 1) {
-            c_xt[1] = 2.0;
-            c_xt[ndbl - 2] = (double)b_m - 1.0;
-            cdiff = 2;
-          }
-
-          if (idx << 1 == ndbl - 1) {
-            c_xt[idx] = (1.0 + (double)b_m) / 2.0;
-          } else {
-            c_xt[idx] = 1.0 + (double)idx;
-            c_xt[idx + 1] = b_m - idx;
-          }
-        }
-
-        b_ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-        b_m = b_ndbl + 1;
-        cdiff = (b_ndbl - residualDim) + 1;
-        if (fabs((double)cdiff) < 4.4408920985006262E-16 * (double)residualDim)
-        {
-          b_ndbl++;
-          b_m = residualDim;
-        } else if (cdiff > 0) {
-          b_m = b_ndbl;
-        } else {
-          b_ndbl++;
-        }
-
-        b_y_data[0] = 1.0;
-        if (b_ndbl > 1) {
-          b_y_data[b_ndbl - 1] = b_m;
-          i50 = b_ndbl - 1;
-          idx = i50 / 2;
-          cdiff = 1;
-          while (cdiff <= idx - 1) {
-            b_y_data[1] = 2.0;
-            b_y_data[b_ndbl - 2] = (double)b_m - 1.0;
-            cdiff = 2;
-          }
-
-          if (idx << 1 == b_ndbl - 1) {
-            b_y_data[idx] = (1.0 + (double)b_m) / 2.0;
-          } else {
-            b_y_data[idx] = 1.0 + (double)idx;
-            b_y_data[idx + 1] = b_m - idx;
-          }
-        }
-
-        y_size[0] = 1;
-        y_size[1] = ndbl;
-        cdiff = (unsigned char)((unsigned int)(unsigned char)k * residualDim);
-        for (i50 = 0; i50 < ndbl; i50++) {
-          y_data[i50] = r->data[(int)((double)cdiff + c_xt[i50]) - 1];
-        }
-
-        b_mrdivide(y_data, y_size, S_feature_data, S_feature_size);
-        cdiff = (unsigned char)((unsigned int)(unsigned char)k * residualDim);
-        for (i50 = 0; i50 < b_ndbl; i50++) {
-          H_c_data[i50] = r->data[(int)((double)cdiff + b_y_data[i50]) - 1];
-        }
-
-        if ((y_size[1] == 1) || (b_ndbl == 1)) {
-          c_P = 0.0;
-          for (i50 = 0; i50 < y_size[1]; i50++) {
-            c_P += y_data[y_size[0] * i50] * H_c_data[i50];
-          }
-
-          innov = c_P;
-        } else {
-          c_P = 0.0;
-          for (i50 = 0; i50 < y_size[1]; i50++) {
-            c_P += y_data[y_size[0] * i50] * H_c_data[i50];
-          }
-
-          innov = c_P;
-        }
-
-        // 'OnePointRANSAC_EKF:222' if innov > mahalanobis_thresh
-        if (innov > mahalanobis_thresh) {
-          // 'OnePointRANSAC_EKF:223' r((k-1)*residualDim + (1:residualDim)) = 0; 
-          ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-          b_m = ndbl + 1;
-          cdiff = (ndbl - residualDim) + 1;
-          if (fabs((double)cdiff) < 4.4408920985006262E-16 * (double)residualDim)
-          {
-            ndbl++;
-            b_m = residualDim;
-          } else if (cdiff > 0) {
-            b_m = ndbl;
-          } else {
-            ndbl++;
-          }
-
-          c_xt[0] = 1.0;
-          if (ndbl > 1) {
-            c_xt[ndbl - 1] = b_m;
-            i50 = ndbl - 1;
-            idx = i50 / 2;
-            cdiff = 1;
-            while (cdiff <= idx - 1) {
-              c_xt[1] = 2.0;
-              c_xt[ndbl - 2] = (double)b_m - 1.0;
-              cdiff = 2;
-            }
-
-            if (idx << 1 == ndbl - 1) {
-              c_xt[idx] = (1.0 + (double)b_m) / 2.0;
-            } else {
-              c_xt[idx] = 1.0 + (double)idx;
-              c_xt[idx + 1] = b_m - idx;
-            }
-          }
-
-          cdiff = (unsigned char)((unsigned int)(unsigned char)k * residualDim);
-          for (i50 = 0; i50 < ndbl; i50++) {
-            b_tmp_data[i50] = (int)((double)cdiff + c_xt[i50]);
-          }
-
-          for (i50 = 0; i50 < ndbl; i50++) {
-            r->data[b_tmp_data[i50] - 1] = 0.0;
-          }
-
-          // 'OnePointRANSAC_EKF:224' H((k-1)*residualDim + (1:residualDim), :) = 0; 
-          ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-          b_m = ndbl + 1;
-          cdiff = (ndbl - residualDim) + 1;
-          if (fabs((double)cdiff) < 4.4408920985006262E-16 * (double)residualDim)
-          {
-            ndbl++;
-            b_m = residualDim;
-          } else if (cdiff > 0) {
-            b_m = ndbl;
-          } else {
-            ndbl++;
-          }
-
-          c_xt[0] = 1.0;
-          if (ndbl > 1) {
-            c_xt[ndbl - 1] = b_m;
-            i50 = ndbl - 1;
-            idx = i50 / 2;
-            cdiff = 1;
-            while (cdiff <= idx - 1) {
-              c_xt[1] = 2.0;
-              c_xt[ndbl - 2] = (double)b_m - 1.0;
-              cdiff = 2;
-            }
-
-            if (idx << 1 == ndbl - 1) {
-              c_xt[idx] = (1.0 + (double)b_m) / 2.0;
-            } else {
-              c_xt[idx] = 1.0 + (double)idx;
-              c_xt[idx + 1] = b_m - idx;
-            }
-          }
-
-          cdiff = (unsigned char)((unsigned int)(unsigned char)k * residualDim);
-          for (i50 = 0; i50 < ndbl; i50++) {
-            tmp_data[i50] = (int)((double)cdiff + c_xt[i50]);
-          }
-
-          for (i50 = 0; i50 < 102; i50++) {
-            for (i52 = 0; i52 < ndbl; i52++) {
-              b_H->data[(tmp_data[i52] + b_H->size[0] * i50) - 1] = 0.0;
-            }
-          }
-
-          // 'OnePointRANSAC_EKF:225' if it == VIOParameters.max_ekf_iterations
-          if (it == c_VIOParameters_max_ekf_iterati) {
-            // 'OnePointRANSAC_EKF:226' HI_inlierStatus(HI_ind(k)) = false;
-            HI_inlierStatus[hyp_ind_data[k] - 1] = false;
-
-            //  only reject the feature if its still bad in last iteration, otherwise just dont use for this update 
-          }
-
-          //                  log_info('rejecting %i', HI_ind(k))
-          // 'OnePointRANSAC_EKF:229' if updateVect(HI_ind(k)) == 2
-          if (updateVect[hyp_ind_data[k] - 1] == 2) {
-            // 'OnePointRANSAC_EKF:230' log_error('inconsistency')
-            b_log_error();
-          }
-        }
-      }
-
-      // 'OnePointRANSAC_EKF:235' S = (H*P*H');
-      H_idx_0 = (unsigned int)b_H->size[0];
-      i50 = e_y->size[0] * e_y->size[1];
-      e_y->size[0] = (int)H_idx_0;
-      e_y->size[1] = 102;
-      emxEnsureCapacity((emxArray__common *)e_y, i50, (int)sizeof(double));
-      b_m = b_H->size[0];
-      i50 = e_y->size[0] * e_y->size[1];
-      e_y->size[1] = 102;
-      emxEnsureCapacity((emxArray__common *)e_y, i50, (int)sizeof(double));
-      for (i50 = 0; i50 < 102; i50++) {
-        ndbl = e_y->size[0];
-        for (i52 = 0; i52 < ndbl; i52++) {
-          e_y->data[i52 + e_y->size[0] * i50] = 0.0;
-        }
-      }
-
-      if (b_H->size[0] == 0) {
-      } else {
-        idx = b_H->size[0] * 101;
-        cr = 0;
-        while ((b_m > 0) && (cr <= idx)) {
-          i50 = cr + b_m;
-          for (ic = cr; ic + 1 <= i50; ic++) {
-            e_y->data[ic] = 0.0;
-          }
-
-          cr += b_m;
-        }
-
-        br = 0;
-        cr = 0;
-        while ((b_m > 0) && (cr <= idx)) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 102; ib++) {
-            if (b_P[ib] != 0.0) {
-              ia = ar;
-              i50 = cr + b_m;
-              for (ic = cr; ic + 1 <= i50; ic++) {
-                ia++;
-                e_y->data[ic] += b_P[ib] * b_H->data[ia - 1];
-              }
-            }
-
-            ar += b_m;
-          }
-
-          br += 102;
-          cr += b_m;
-        }
-      }
-
-      i50 = c_H->size[0] * c_H->size[1];
-      c_H->size[0] = b_H->size[1];
-      c_H->size[1] = b_H->size[0];
-      emxEnsureCapacity((emxArray__common *)c_H, i50, (int)sizeof(double));
-      ndbl = b_H->size[0];
-      for (i50 = 0; i50 < ndbl; i50++) {
-        idx = b_H->size[1];
-        for (i52 = 0; i52 < idx; i52++) {
-          c_H->data[i52 + c_H->size[0] * i50] = b_H->data[i50 + b_H->size[0] *
-            i52];
-        }
-      }
-
-      cdiff = b_H->size[0];
-      i50 = K->size[0] * K->size[1];
-      K->size[0] = 102;
-      K->size[1] = cdiff;
-      emxEnsureCapacity((emxArray__common *)K, i50, (int)sizeof(double));
-      for (i50 = 0; i50 < cdiff; i50++) {
-        for (i52 = 0; i52 < 102; i52++) {
-          K->data[i52 + K->size[0] * i50] = c_H->data[i52 + 102 * i50];
-        }
-      }
-
-      H_idx_0 = (unsigned int)e_y->size[0];
-      unnamed_idx_1 = (unsigned int)K->size[1];
-      i50 = S->size[0] * S->size[1];
-      S->size[0] = (int)H_idx_0;
-      S->size[1] = (int)unnamed_idx_1;
-      emxEnsureCapacity((emxArray__common *)S, i50, (int)sizeof(double));
-      b_m = e_y->size[0];
-      i50 = S->size[0] * S->size[1];
-      emxEnsureCapacity((emxArray__common *)S, i50, (int)sizeof(double));
-      ndbl = S->size[1];
-      for (i50 = 0; i50 < ndbl; i50++) {
-        idx = S->size[0];
-        for (i52 = 0; i52 < idx; i52++) {
-          S->data[i52 + S->size[0] * i50] = 0.0;
-        }
-      }
-
-      if ((e_y->size[0] == 0) || (K->size[1] == 0)) {
-      } else {
-        idx = e_y->size[0] * (K->size[1] - 1);
-        cr = 0;
-        while ((b_m > 0) && (cr <= idx)) {
-          i50 = cr + b_m;
-          for (ic = cr; ic + 1 <= i50; ic++) {
-            S->data[ic] = 0.0;
-          }
-
-          cr += b_m;
-        }
-
-        br = 0;
-        cr = 0;
-        while ((b_m > 0) && (cr <= idx)) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 102; ib++) {
-            if (K->data[ib] != 0.0) {
-              ia = ar;
-              i50 = cr + b_m;
-              for (ic = cr; ic + 1 <= i50; ic++) {
-                ia++;
-                S->data[ic] += K->data[ib] * e_y->data[ia - 1];
-              }
-            }
-
-            ar += b_m;
-          }
-
-          br += 102;
-          cr += b_m;
-        }
-      }
-
-      // 'OnePointRANSAC_EKF:236' size_S = num_HI_inlierCandidates*residualDim;
-      size_S = (double)n * (double)residualDim;
-
-      // 'OnePointRANSAC_EKF:237' S(1:(size_S+1):size_S^2) = S(1:(size_S+1):size_S^2) + noiseParameters.image_noise; 
-      c_P = size_S * size_S;
-      if ((size_S + 1.0 == 0.0) || (((size_S + 1.0 > 0.0) && (1.0 > c_P)) ||
-           ((0.0 > size_S + 1.0) && (c_P > 1.0)))) {
-        i50 = 1;
-        i52 = -1;
-      } else {
-        i50 = (int)(size_S + 1.0);
-        i52 = (int)c_P - 1;
-      }
-
-      c_P = size_S * size_S;
-      if ((size_S + 1.0 == 0.0) || (((size_S + 1.0 > 0.0) && (1.0 > c_P)) ||
-           ((0.0 > size_S + 1.0) && (c_P > 1.0)))) {
-        b_m = 1;
-      } else {
-        b_m = (int)(size_S + 1.0);
-      }
-
-      cdiff = c_S->size[0] * c_S->size[1];
-      c_S->size[0] = 1;
-      c_S->size[1] = div_s32_floor(i52, i50) + 1;
-      emxEnsureCapacity((emxArray__common *)c_S, cdiff, (int)sizeof(double));
-      ndbl = div_s32_floor(i52, i50);
-      for (i52 = 0; i52 <= ndbl; i52++) {
-        c_S->data[c_S->size[0] * i52] = S->data[i50 * i52] +
-          noiseParameters_image_noise;
-      }
-
-      ndbl = c_S->size[1];
-      for (i50 = 0; i50 < ndbl; i50++) {
-        S->data[b_m * i50] = c_S->data[c_S->size[0] * i50];
-      }
-
-      //  add R to HPH'
-      // 'OnePointRANSAC_EKF:239' K = (P*H')/S;
-      i50 = d_H->size[0] * d_H->size[1];
-      d_H->size[0] = b_H->size[1];
-      d_H->size[1] = b_H->size[0];
-      emxEnsureCapacity((emxArray__common *)d_H, i50, (int)sizeof(double));
-      ndbl = b_H->size[0];
-      for (i50 = 0; i50 < ndbl; i50++) {
-        idx = b_H->size[1];
-        for (i52 = 0; i52 < idx; i52++) {
-          d_H->data[i52 + d_H->size[0] * i50] = b_H->data[i50 + b_H->size[0] *
-            i52];
-        }
-      }
-
-      cdiff = b_H->size[0];
-      i50 = K->size[0] * K->size[1];
-      K->size[0] = 102;
-      K->size[1] = cdiff;
-      emxEnsureCapacity((emxArray__common *)K, i50, (int)sizeof(double));
-      for (i50 = 0; i50 < cdiff; i50++) {
-        for (i52 = 0; i52 < 102; i52++) {
-          K->data[i52 + K->size[0] * i50] = d_H->data[i52 + 102 * i50];
-        }
-      }
-
-      unnamed_idx_1 = (unsigned int)K->size[1];
-      i50 = f_y->size[0] * f_y->size[1];
-      f_y->size[0] = 102;
-      f_y->size[1] = (int)unnamed_idx_1;
-      f_y->size[0] = 102;
-      emxEnsureCapacity((emxArray__common *)f_y, i50, (int)sizeof(double));
-      ndbl = f_y->size[1];
-      for (i50 = 0; i50 < ndbl; i50++) {
-        for (i52 = 0; i52 < 102; i52++) {
-          f_y->data[i52 + f_y->size[0] * i50] = 0.0;
-        }
-      }
-
-      if (K->size[1] == 0) {
-      } else {
-        idx = 102 * (K->size[1] - 1);
-        for (cr = 0; cr <= idx; cr += 102) {
-          for (ic = cr + 1; ic <= cr + 102; ic++) {
-            f_y->data[ic - 1] = 0.0;
-          }
-        }
-
-        br = 0;
-        for (cr = 0; cr <= idx; cr += 102) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 102; ib++) {
-            if (K->data[ib] != 0.0) {
-              ia = ar;
-              for (ic = cr; ic + 1 <= cr + 102; ic++) {
-                ia++;
-                f_y->data[ic] += K->data[ib] * b_P[ia - 1];
-              }
-            }
-
-            ar += 102;
-          }
-
-          br += 102;
+        mrdivide(K, S);
+        i50 = b_K->size[0] * b_K->size[1];
+        b_K->size[0] = 102;
+        b_K->size[1] = K->size[1];
+        emxEnsureCapacity((emxArray__common *)b_K, i50, (int)sizeof(double));
+        ndbl = K->size[0] * K->size[1];
+        for (i50 = 0; i50 < ndbl; i50++) {
+          b_K->data[i50] = K->data[i50];
         }
       }
 
-      i50 = K->size[0] * K->size[1];
-      K->size[0] = 102;
-      K->size[1] = f_y->size[1];
-      emxEnsureCapacity((emxArray__common *)K, i50, (int)sizeof(double));
-      ndbl = f_y->size[0] * f_y->size[1];
-      for (i50 = 0; i50 < ndbl; i50++) {
-        K->data[i50] = f_y->data[i50];
-      }
-
-      mrdivide(K, S);
-      i50 = b_K->size[0] * b_K->size[1];
-      b_K->size[0] = 102;
-      b_K->size[1] = K->size[1];
-      emxEnsureCapacity((emxArray__common *)b_K, i50, (int)sizeof(double));
-      ndbl = K->size[0] * K->size[1];
-      for (i50 = 0; i50 < ndbl; i50++) {
-        b_K->data[i50] = K->data[i50];
-      }
-
       // 'OnePointRANSAC_EKF:241' x_it2 = K*(r + H * x_it);
       H_idx_0 = (unsigned int)b_H->size[0];
       i50 = C->size[0];
@@ -5031,6 +3552,13 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
     emxFree_real_T(&e_y);
     emxFree_real_T(&C);
 
+    telemetry.ekf_iterations = it - 1;
+    for (k = 0; k < 48; k++) {
+      if (HI_inlierStatus[k]) {
+        telemetry.hi_inliers++;
+      }
+    }
+
     // 'OnePointRANSAC_EKF:285' xt = xt_it;
     *b_xt = xt_it;
 
@@ -5514,7 +4042,6 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
     // 'log_error:8' elseif ~coder.target('MEX')
     // 'log_error:9' coder.cinclude('<vio_logging.h>')
     // 'log_error:10' coder.ceval('LOG_ERROR', [str, 0], varargin{:});
-    memcpy(&cv48[0], &cv49[0], 66U * sizeof(char));
     c_P = rt_roundd_snf(100.0 - rejected_ratio * 100.0);
     if (c_P < 2.147483648E+9) {
       i50 = (int)c_P;
@@ -5522,7 +4049,7 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, double b_P[10404], const double
       i50 = MAX_int32_T;
     }
 
-    LOG_ERROR(cv48, i50);
+    LOG_ERROR(cv49, i50);
 
     // 'OnePointRANSAC_EKF:322' gryro_bias_cov = P(10:12, 10:12);
     // 'OnePointRANSAC_EKF:323' acc_bias_cov = P(13:15, 13:15);
@@ -6419,7 +4946,6 @@ static void SLAM_pred_euler(double P_apo[10404], g_struct_T *x, double dt,
 //                double noiseParameters_image_noise
 //                double c_noiseParameters_inv_depth_ini
 //                const VIOParameters b_VIOParameters
-//                double b_map[144]
 //                double b_delayedStatus[48]
 // Return Type  : void
 //
@@ -6439,8 +4965,7 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
                      double z_all_l[96], double z_all_r[96], double
                      noiseParameters_image_noise, double
                      c_noiseParameters_inv_depth_ini, const VIOParameters
-                     b_VIOParameters, double b_map[144], double b_delayedStatus
-                     [48])
+                     b_VIOParameters, double b_delayedStatus[48])
 {
   boolean_T x[48];
   int i;
@@ -6470,24 +4995,24 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
   double uncertainties[8];
   signed char active_feature[8];
   int iidx[8];
-  emxArray_real_T *qualities;
-  emxArray_real_T *anchorInd;
-  emxArray_real_T *featureInd;
-  emxArray_int32_T *b_iidx;
+  double qualities_data[48];
+  int qualities_size[1];
+  double anchorInd_data[48];
+  int anchorInd_size[1];
+  double featureInd_data[48];
+  int featureInd_size[1];
+  int b_iidx_data[48];
   double new_m_data[288];
   boolean_T triangulation_success_data[48];
-  double z_curr_l[2];
-  double z_curr_r[2];
   boolean_T success;
-  double b_m[6];
+  double new_z_l[96];
+  double new_z_r[96];
+  double new_fp[144];
+  double new_m_l[144];
+  int new_status[48];
   double new_origin_pos_rel[3];
   double m_l[3];
-  boolean_T bv0[3];
   signed char i48;
-  double h_u_r[2];
-  double h_u_l[2];
-  double b_h_u_l[2];
-  boolean_T guard1 = false;
   double mtmp;
   int k;
   int trueCount;
@@ -6496,7 +5021,8 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
   signed char b_triangulated_status_ind_data[48];
   int c_triangulated_status_ind_size_;
   double untriangulated_depths_data[48];
-  emxArray_real_T *untriangulated_idx;
+  double untriangulated_idx_data[48];
+  int untriangulated_idx_size[1];
   int tmp_data[48];
   signed char untriangulated_status_ind_data[48];
   double b_new_m_data[144];
@@ -6516,7 +5042,6 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
   boolean_T exitg5;
   double b_uncertainties[48];
   boolean_T has_active_features;
-  int uncertainties_size[1];
   double median_uncertainty;
   double totalNumActiveFeatues;
   double numDelayedFeatures;
@@ -6530,7 +5055,6 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
   double b_has_active_features[6];
   double c_uncertainties[6];
   boolean_T exitg1;
-  char cv46[111];
   static const char cv47[111] = { 'P', 'i', 'c', 'k', 'e', 'd', ' ', 'a', 'n',
     ' ', 'a', 'n', 'c', 'h', 'o', 'r', ' ', 'w', 'i', 't', 'h', ' ', 'n', 'o',
     ' ', 'a', 'c', 't', 'i', 'v', 'e', ' ', 'f', 'e', 'a', 't', 'u', 'r', 'e',
@@ -6607,7 +5131,8 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
                  d_cameraParams_CameraParameters,
                  e_cameraParams_CameraParameters,
                  f_cameraParams_CameraParameters,
-                 g_cameraParams_CameraParameters, status_ind_data, ii_size);
+                 g_cameraParams_CameraParameters, undistortionMap_l,
+                 status_ind_data, ii_size);
   loop_ub = ii_size[0];
   for (i47 = 0; i47 < loop_ub; i47++) {
     z_all_l[(int)ind_l2_data[i47] - 1] = status_ind_data[i47];
@@ -6670,7 +5195,8 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
                    i_cameraParams_CameraParameters,
                    j_cameraParams_CameraParameters,
                    k_cameraParams_CameraParameters,
-                   l_cameraParams_CameraParameters, status_ind_data, ii_size);
+                   l_cameraParams_CameraParameters, undistortionMap_r,
+                   status_ind_data, ii_size);
     idx = ii_size[0];
     for (i47 = 0; i47 < idx; i47++) {
       z_all_r[(int)ind_l2_data[i47] - 1] = status_ind_data[i47];
@@ -6691,7 +5217,8 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
                    i_cameraParams_CameraParameters,
                    j_cameraParams_CameraParameters,
                    k_cameraParams_CameraParameters,
-                   l_cameraParams_CameraParameters, status_ind_data, ii_size);
+                   l_cameraParams_CameraParameters, undistortionMap_r,
+                   status_ind_data, ii_size);
     idx = ii_size[0];
     for (i47 = 0; i47 < idx; i47++) {
       z_all_r[(int)ind_l2_data[i47] - 1] = status_ind_data[i47];
@@ -6788,7 +5315,7 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
       }
 
       // 'SLAM_upd:61' [~, sortIdx] = sort(uncertainties, 'ascend');
-      sort(uncertainties, iidx);
+      sorting_network::sort<8>(uncertainties, iidx);
       for (i = 0; i < 8; i++) {
         uncertainties[i] = iidx[i];
       }
@@ -6842,7 +5369,7 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
                        b_VIOParameters.max_ekf_iterations,
                        b_VIOParameters.delayed_initialization,
                        b_VIOParameters.full_stereo, b_VIOParameters.RANSAC,
-                       updateVect);
+                       b_VIOParameters.jacobian_reuse_thresh, updateVect);
   } else {
     // 'SLAM_upd:75' else
     // 'SLAM_upd:76' P_apo = P_apr;
@@ -6850,10 +5377,6 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
 
   // % Initialize new anchors/features
   // 'SLAM_upd:80' if length(ind_r) >= minFeatureThreshold
-  emxInit_real_T(&qualities, 1);
-  emxInit_real_T(&anchorInd, 1);
-  emxInit_real_T(&featureInd, 1);
-  emxInit_int32_T(&b_iidx, 1);
   if (ii_size_idx_0 >= 4) {
     //  try to triangulate all new features
     // 'SLAM_upd:82' new_depths = zeros(length(ind_r), 1);
@@ -6872,113 +5395,57 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
       triangulation_success_data[i47] = false;
     }
 
-    // 'SLAM_upd:86' for i = 1:length(ind_r)
-    for (i = 0; i < loop_ub; i++) {
-      // 'SLAM_upd:87' z_curr_l = z_all_l((ind_r(i)-1)*2 + (1:2));
-      idx = ((int)ind_r_data[i] - 1) * 2;
-
-      // 'SLAM_upd:88' z_curr_r = z_all_r((ind_r(i)-1)*2 + (1:2));
-      ixstart = ((int)ind_r_data[i] - 1) * 2;
-      for (i47 = 0; i47 < 2; i47++) {
-        z_curr_l[i47] = z_all_l[idx + i47];
-        z_curr_r[i47] = z_all_r[ixstart + i47];
+    //  triangulate the new features together, the checks of SLAM_upd:93-117
+    //  are done for all points in triangulateStereo
+    if (!b_VIOParameters.mono) {
+      for (i = 0; i < loop_ub; i++) {
+        // 'SLAM_upd:87' z_curr_l = z_all_l((ind_r(i)-1)*2 + (1:2));
+        // 'SLAM_upd:88' z_curr_r = z_all_r((ind_r(i)-1)*2 + (1:2));
+        idx = ((int)ind_r_data[i] - 1) * 2;
+        for (i47 = 0; i47 < 2; i47++) {
+          new_z_l[i47 + 2 * i] = z_all_l[idx + i47];
+          new_z_r[i47 + 2 * i] = z_all_r[idx + i47];
+        }
       }
 
+      triangulation::triangulateStereo(triangulation::StereoRig<double>
+        (d_cameraParams_CameraParameters, e_cameraParams_CameraParameters,
+         i_cameraParams_CameraParameters, j_cameraParams_CameraParameters,
+         cameraParams_r_lr, cameraParams_R_lr, cameraParams_R_rl),
+        (triangulation::Method)b_VIOParameters.triangulation_method, new_z_l,
+        new_z_r, loop_ub, new_fp, new_m_l, new_status);
+    }
+
+    // 'SLAM_upd:86' for i = 1:length(ind_r)
+    for (i = 0; i < loop_ub; i++) {
       // 'SLAM_upd:89' if ~VIOParameters.mono
       if (!b_VIOParameters.mono) {
         // 'SLAM_upd:90' [ fp, m, success ] = initializePoint(z_curr_l, z_curr_r, cameraParams); 
-        initializePoint(z_curr_l, z_curr_r, d_cameraParams_CameraParameters,
-                        e_cameraParams_CameraParameters,
-                        i_cameraParams_CameraParameters,
-                        j_cameraParams_CameraParameters, cameraParams_r_lr,
-                        cameraParams_R_lr, new_origin_pos_rel, b_m, &success);
-
         // 'SLAM_upd:91' m_l = m(:,1);
         for (i47 = 0; i47 < 3; i47++) {
-          m_l[i47] = b_m[i47];
+          new_origin_pos_rel[i47] = new_fp[i47 + 3 * i];
+          m_l[i47] = new_m_l[i47 + 3 * i];
         }
 
         // 'SLAM_upd:93' if success
-        if (success) {
-          //  perform further checks
-          // 'SLAM_upd:94' if any(isnan(fp))
-          for (idx = 0; idx < 3; idx++) {
-            bv0[idx] = rtIsNaN(new_origin_pos_rel[idx]);
+        success = (new_status[i] == triangulation::SUCCESS);
+        if (new_status[i] == triangulation::NOT_A_NUMBER) {
+          // 'SLAM_upd:95' log_warn('Bad triangulation (nan) for point %d', int8(ind_r(i))); 
+          i47 = (int)rt_roundd_snf(ind_r_data[i]);
+          i48 = (signed char)i47;
+          d_log_warn(i48);
+        } else {
+          if (new_status[i] == triangulation::TOO_CLOSE) {
+            //  feature triangulated very close
+            // 'SLAM_upd:109' log_warn('Feature %i is triangulated very close. Depth: %f', int32(ind_r(i)), norm(fp)); 
+            e_log_warn((int)ind_r_data[i], norm(new_origin_pos_rel));
           }
+        }
 
-          if (b_any(bv0)) {
-            // 'SLAM_upd:95' log_warn('Bad triangulation (nan) for point %d', int8(ind_r(i))); 
-            i47 = (int)rt_roundd_snf(ind_r_data[i]);
-            i48 = (signed char)i47;
-            d_log_warn(i48);
-
-            // 'SLAM_upd:96' fp = m_l;
-            for (i47 = 0; i47 < 3; i47++) {
-              new_origin_pos_rel[i47] = b_m[i47];
-            }
-
-            // 'SLAM_upd:97' success = false;
-            success = false;
-          } else {
-            // 'SLAM_upd:98' else
-            //  check reprojection error
-            // 'SLAM_upd:100' [h_u_l, h_u_r] = predictMeasurementStereo(fp, cameraParams); 
-            predictMeasurementStereo(new_origin_pos_rel,
-              d_cameraParams_CameraParameters, e_cameraParams_CameraParameters,
-              i_cameraParams_CameraParameters, j_cameraParams_CameraParameters,
-              cameraParams_r_lr, cameraParams_R_rl, h_u_l, h_u_r);
-
-            // 'SLAM_upd:102' reprojection_error_thresh = 5;
-            // 'SLAM_upd:103' if norm(h_u_l - z_curr_l) > reprojection_error_thresh || norm(h_u_r - z_curr_r) > reprojection_error_thresh 
-            for (idx = 0; idx < 2; idx++) {
-              b_h_u_l[idx] = h_u_l[idx] - z_curr_l[idx];
-            }
-
-            guard1 = false;
-            if (c_norm(b_h_u_l) > 5.0) {
-              guard1 = true;
-            } else {
-              for (idx = 0; idx < 2; idx++) {
-                b_h_u_l[idx] = h_u_r[idx] - z_curr_r[idx];
-              }
-
-              if (c_norm(b_h_u_l) > 5.0) {
-                guard1 = true;
-              } else {
-                // 'SLAM_upd:107' else
-                // 'SLAM_upd:108' if norm(fp) < 0.1
-                if (norm(new_origin_pos_rel) < 0.1) {
-                  //  feature triangulated very close
-                  // 'SLAM_upd:109' log_warn('Feature %i is triangulated very close. Depth: %f', int32(ind_r(i)), norm(fp)); 
-                  e_log_warn((int)ind_r_data[i], norm(new_origin_pos_rel));
-
-                  // 'SLAM_upd:110' fp = m_l;
-                  for (i47 = 0; i47 < 3; i47++) {
-                    new_origin_pos_rel[i47] = b_m[i47];
-                  }
-
-                  // 'SLAM_upd:111' success = false;
-                  success = false;
-                }
-              }
-            }
-
-            if (guard1) {
-              //                          log_info('Bad triangulation (reprojection error) for point %d', int8(ind_r(i))); 
-              // 'SLAM_upd:105' fp = m_l;
-              for (i47 = 0; i47 < 3; i47++) {
-                new_origin_pos_rel[i47] = b_m[i47];
-              }
-
-              // 'SLAM_upd:106' success = false;
-              success = false;
-            }
-          }
-        } else {
-          // 'SLAM_upd:115' else
-          // 'SLAM_upd:116' fp = m_l;
+        if (!success) {
+          // 'SLAM_upd:96' fp = m_l;
           for (i47 = 0; i47 < 3; i47++) {
-            new_origin_pos_rel[i47] = b_m[i47];
+            new_origin_pos_rel[i47] = m_l[i47];
           }
         }
       } else {
@@ -7045,20 +5512,16 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
     }
 
     // 'SLAM_upd:133' [triangulated_depths, triangulated_idx] = sort(triangulated_depths, 'ascend'); 
-    i47 = qualities->size[0];
-    qualities->size[0] = trueCount;
-    emxEnsureCapacity((emxArray__common *)qualities, i47, (int)sizeof(double));
+    qualities_size[0] = trueCount;
     for (i47 = 0; i47 < trueCount; i47++) {
-      qualities->data[i47] = triangulated_depths_data[i47];
+      qualities_data[i47] = triangulated_depths_data[i47];
     }
 
-    c_sort(qualities, b_iidx);
-    i47 = anchorInd->size[0];
-    anchorInd->size[0] = b_iidx->size[0];
-    emxEnsureCapacity((emxArray__common *)anchorInd, i47, (int)sizeof(double));
-    idx = b_iidx->size[0];
+    sorting_network::sort(qualities_data, b_iidx_data, qualities_size[0]);
+    anchorInd_size[0] = qualities_size[0];
+    idx = qualities_size[0];
     for (i47 = 0; i47 < idx; i47++) {
-      anchorInd->data[i47] = b_iidx->data[i47];
+      anchorInd_data[i47] = b_iidx_data[i47];
     }
 
     // 'SLAM_upd:134' triangulated_m = new_m(:, triangulation_success);
@@ -7090,11 +5553,11 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
     }
 
     // 'SLAM_upd:137' triangulated_status_ind = triangulated_status_ind(triangulated_idx); 
-    c_triangulated_status_ind_size_ = anchorInd->size[0];
-    idx = anchorInd->size[0];
+    c_triangulated_status_ind_size_ = anchorInd_size[0];
+    idx = anchorInd_size[0];
     for (i47 = 0; i47 < idx; i47++) {
       b_triangulated_status_ind_data[i47] = triangulated_status_ind_data[(int)
-        anchorInd->data[i47] - 1];
+        anchorInd_data[i47] - 1];
     }
 
     for (i47 = 0; i47 < c_triangulated_status_ind_size_; i47++) {
@@ -7119,22 +5582,16 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
     }
 
     // 'SLAM_upd:140' [untriangulated_depths, untriangulated_idx] = sort(untriangulated_depths, 'ascend'); 
-    i47 = featureInd->size[0];
-    featureInd->size[0] = k;
-    emxEnsureCapacity((emxArray__common *)featureInd, i47, (int)sizeof(double));
+    featureInd_size[0] = k;
     for (i47 = 0; i47 < k; i47++) {
-      featureInd->data[i47] = untriangulated_depths_data[i47];
+      featureInd_data[i47] = untriangulated_depths_data[i47];
     }
 
-    emxInit_real_T(&untriangulated_idx, 1);
-    c_sort(featureInd, b_iidx);
-    i47 = untriangulated_idx->size[0];
-    untriangulated_idx->size[0] = b_iidx->size[0];
-    emxEnsureCapacity((emxArray__common *)untriangulated_idx, i47, (int)sizeof
-                      (double));
-    idx = b_iidx->size[0];
+    sorting_network::sort(featureInd_data, b_iidx_data, featureInd_size[0]);
+    untriangulated_idx_size[0] = featureInd_size[0];
+    idx = featureInd_size[0];
     for (i47 = 0; i47 < idx; i47++) {
-      untriangulated_idx->data[i47] = b_iidx->data[i47];
+      untriangulated_idx_data[i47] = b_iidx_data[i47];
     }
 
     // 'SLAM_upd:141' untriangulated_m = new_m(:, ~triangulation_success);
@@ -7166,11 +5623,11 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
     }
 
     // 'SLAM_upd:144' untriangulated_status_ind = untriangulated_status_ind(untriangulated_idx); 
-    idx = untriangulated_idx->size[0];
-    loop_ub = untriangulated_idx->size[0];
+    idx = untriangulated_idx_size[0];
+    loop_ub = untriangulated_idx_size[0];
     for (i47 = 0; i47 < loop_ub; i47++) {
       b_triangulated_status_ind_data[i47] = untriangulated_status_ind_data[(int)
-        untriangulated_idx->data[i47] - 1];
+        untriangulated_idx_data[i47] - 1];
     }
 
     for (i47 = 0; i47 < idx; i47++) {
@@ -7178,15 +5635,15 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
     }
 
     // 'SLAM_upd:146' new_depths = [triangulated_depths; untriangulated_depths]; 
-    ind_l2_size[0] = qualities->size[0] + featureInd->size[0];
-    loop_ub = qualities->size[0];
+    ind_l2_size[0] = qualities_size[0] + featureInd_size[0];
+    loop_ub = qualities_size[0];
     for (i47 = 0; i47 < loop_ub; i47++) {
-      ind_l2_data[i47] = qualities->data[i47];
+      ind_l2_data[i47] = qualities_data[i47];
     }
 
-    loop_ub = featureInd->size[0];
+    loop_ub = featureInd_size[0];
     for (i47 = 0; i47 < loop_ub; i47++) {
-      ind_l2_data[i47 + qualities->size[0]] = featureInd->data[i47];
+      ind_l2_data[i47 + qualities_size[0]] = featureInd_data[i47];
     }
 
     // 'SLAM_upd:147' new_m = [triangulated_m, untriangulated_m];
@@ -7202,24 +5659,22 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
       }
     }
 
-    loop_ub = anchorInd->size[0];
+    loop_ub = anchorInd_size[0];
     for (i47 = 0; i47 < loop_ub; i47++) {
       for (i = 0; i < 3; i++) {
-        new_m_data[i + 3 * i47] = b_new_m_data[i + 3 * ((int)anchorInd->data[i47]
+        new_m_data[i + 3 * i47] = b_new_m_data[i + 3 * ((int)anchorInd_data[i47]
           - 1)];
       }
     }
 
-    loop_ub = untriangulated_idx->size[0];
+    loop_ub = untriangulated_idx_size[0];
     for (i47 = 0; i47 < loop_ub; i47++) {
       for (i = 0; i < 3; i++) {
-        new_m_data[i + 3 * (i47 + anchorInd->size[0])] = c_new_m_data[i + 3 *
-          ((int)untriangulated_idx->data[i47] - 1)];
+        new_m_data[i + 3 * (i47 + anchorInd_size[0])] = c_new_m_data[i + 3 *
+          ((int)untriangulated_idx_data[i47] - 1)];
       }
     }
 
-    emxFree_real_T(&untriangulated_idx);
-
     // 'SLAM_upd:148' status_ind = [triangulated_status_ind; untriangulated_status_ind]; 
     for (i47 = 0; i47 < c_triangulated_status_ind_size_; i47++) {
       status_ind_data[i47] = triangulated_status_ind_data[i47];
@@ -7257,6 +5712,8 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
         if (getNumValidFeatures(b_xt->anchor_states[anchorIdx].feature_states) <
             4.0) {
           //  anchor needs to be initialized
+          telemetry.anchor_initializations++;
+
           //  free up updateVect
           // 'SLAM_upd:164' for featureIdx = 1:numPointsPerAnchor
           for (featureIdx = 0; featureIdx < 8; featureIdx++) {
@@ -7713,6 +6170,7 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
             //                  log_info('Inserting feature %d as feature %i on anchor %i', int32(status_ind(new_feature_idx)), int32(featureIdx), int32(anchorIdx)) 
             // 'SLAM_upd:235' updateVect(status_ind(new_feature_idx)) = int32(1); 
             updateVect[(int)status_ind_data[new_feature_idx] - 1] = 1;
+            telemetry.new_features++;
 
             // 'SLAM_upd:237' new_feature_idx = new_feature_idx + 1;
             new_feature_idx++;
@@ -7803,12 +6261,11 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
         }
       }
 
-      uncertainties_size[0] = trueCount;
       for (i47 = 0; i47 < trueCount; i47++) {
         b_ii_data[i47] = b_uncertainties[ii_data[i47] - 1];
       }
 
-      median_uncertainty = median(b_ii_data, uncertainties_size);
+      median_uncertainty = sorting_network::median(b_ii_data, trueCount);
 
       //  because coder does not support nanflag
       //  check if a delayed initialization feature has converged
@@ -7865,31 +6322,25 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
       numDelayedFeatures = getTotalNumDelayedFeatures(b_xt->anchor_states);
 
       // 'SLAM_upd:293' qualities = zeros(numDelayedFeatures, 1);
-      i47 = qualities->size[0];
-      qualities->size[0] = (int)numDelayedFeatures;
-      emxEnsureCapacity((emxArray__common *)qualities, i47, (int)sizeof(double));
+      qualities_size[0] = (int)numDelayedFeatures;
       loop_ub = (int)numDelayedFeatures;
       for (i47 = 0; i47 < loop_ub; i47++) {
-        qualities->data[i47] = 0.0;
+        qualities_data[i47] = 0.0;
       }
 
       //  quality measures of each delayed feature
       // 'SLAM_upd:294' anchorInd = qualities;
-      i47 = anchorInd->size[0];
-      anchorInd->size[0] = (int)numDelayedFeatures;
-      emxEnsureCapacity((emxArray__common *)anchorInd, i47, (int)sizeof(double));
+      anchorInd_size[0] = (int)numDelayedFeatures;
       loop_ub = (int)numDelayedFeatures;
       for (i47 = 0; i47 < loop_ub; i47++) {
-        anchorInd->data[i47] = 0.0;
+        anchorInd_data[i47] = 0.0;
       }
 
       // 'SLAM_upd:295' featureInd = qualities;
-      i47 = featureInd->size[0];
-      featureInd->size[0] = (int)numDelayedFeatures;
-      emxEnsureCapacity((emxArray__common *)featureInd, i47, (int)sizeof(double));
+      featureInd_size[0] = (int)numDelayedFeatures;
       loop_ub = (int)numDelayedFeatures;
       for (i47 = 0; i47 < loop_ub; i47++) {
-        featureInd->data[i47] = 0.0;
+        featureInd_data[i47] = 0.0;
       }
 
       // 'SLAM_upd:297' delayedIdx = 1;
@@ -7905,16 +6356,16 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
             // 'SLAM_upd:301' rho_unc = P_apo(xt.anchor_states(anchorIdx).feature_states(featureIdx).P_idx, xt.anchor_states(anchorIdx).feature_states(featureIdx).P_idx); 
             // 'SLAM_upd:303' quality = rho_unc/noiseParameters.inv_depth_initial_unc; 
             // 'SLAM_upd:305' qualities(delayedIdx) = quality;
-            qualities->data[(int)delayedIdx - 1] = P_apr[(b_xt->
+            qualities_data[(int)delayedIdx - 1] = P_apr[(b_xt->
               anchor_states[anchorIdx].feature_states[featureIdx].P_idx + 102 *
               (b_xt->anchor_states[anchorIdx].feature_states[featureIdx].P_idx -
                1)) - 1] / c_noiseParameters_inv_depth_ini;
 
             // 'SLAM_upd:306' anchorInd(delayedIdx) = anchorIdx;
-            anchorInd->data[(int)delayedIdx - 1] = (double)anchorIdx + 1.0;
+            anchorInd_data[(int)delayedIdx - 1] = (double)anchorIdx + 1.0;
 
             // 'SLAM_upd:307' featureInd(delayedIdx) = featureIdx;
-            featureInd->data[(int)delayedIdx - 1] = (double)featureIdx + 1.0;
+            featureInd_data[(int)delayedIdx - 1] = (double)featureIdx + 1.0;
 
             // 'SLAM_upd:309' delayedIdx = delayedIdx + 1;
             delayedIdx++;
@@ -7923,13 +6374,10 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
       }
 
       // 'SLAM_upd:314' [~, sortInd] = sort(qualities, 'ascend');
-      c_sort(qualities, b_iidx);
-      i47 = qualities->size[0];
-      qualities->size[0] = b_iidx->size[0];
-      emxEnsureCapacity((emxArray__common *)qualities, i47, (int)sizeof(double));
-      loop_ub = b_iidx->size[0];
+      sorting_network::sort(qualities_data, b_iidx_data, qualities_size[0]);
+      loop_ub = qualities_size[0];
       for (i47 = 0; i47 < loop_ub; i47++) {
-        qualities->data[i47] = b_iidx->data[i47];
+        qualities_data[i47] = b_iidx_data[i47];
       }
 
       // 'SLAM_upd:314' ~
@@ -7938,42 +6386,42 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
 
       // 'SLAM_upd:318' for i = 1:length(sortInd)
       i = 0;
-      while ((i <= qualities->size[0] - 1) && (!(numActivatedFeatures > ceilf
+      while ((i <= qualities_size[0] - 1) && (!(numActivatedFeatures > ceilf
                (19.2F - (float)totalNumActiveFeatues))) &&
              (!(numActivatedFeatures > numDelayedFeatures))) {
         // 'SLAM_upd:319' if numActivatedFeatures > ceil(minActiveFeatureRatio*single(numTrackFeatures) - totalNumActiveFeatues) || numActivatedFeatures > numDelayedFeatures 
         // 'SLAM_upd:322' if xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).inverse_depth < 0 
-        if (b_xt->anchor_states[(int)anchorInd->data[(int)qualities->data[i] - 1]
-            - 1].feature_states[(int)featureInd->data[(int)qualities->data[i] -
+        if (b_xt->anchor_states[(int)anchorInd_data[(int)qualities_data[i] - 1]
+            - 1].feature_states[(int)featureInd_data[(int)qualities_data[i] -
             1] - 1].inverse_depth < 0.0) {
           // 'SLAM_upd:323' xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).status = int32(0); 
-          b_xt->anchor_states[(int)anchorInd->data[(int)qualities->data[i] - 1]
-            - 1].feature_states[(int)featureInd->data[(int)qualities->data[i] -
+          b_xt->anchor_states[(int)anchorInd_data[(int)qualities_data[i] - 1]
+            - 1].feature_states[(int)featureInd_data[(int)qualities_data[i] -
             1] - 1].status = 0;
 
           // 'SLAM_upd:324' updateVect(xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).status_idx) = int32(0); 
-          updateVect[b_xt->anchor_states[(int)anchorInd->data[(int)
-            qualities->data[i] - 1] - 1].feature_states[(int)featureInd->data
-            [(int)qualities->data[i] - 1] - 1].status_idx - 1] = 0;
+          updateVect[b_xt->anchor_states[(int)anchorInd_data[(int)
+            qualities_data[i] - 1] - 1].feature_states[(int)featureInd_data
+            [(int)qualities_data[i] - 1] - 1].status_idx - 1] = 0;
 
           // 'SLAM_upd:325' log_warn('Trying to force insert feature %i behind its anchor', xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).status_idx) 
-          h_log_warn(b_xt->anchor_states[(int)anchorInd->data[(int)
-                     qualities->data[i] - 1] - 1].feature_states[(int)
-                     featureInd->data[(int)qualities->data[i] - 1] - 1].
+          h_log_warn(b_xt->anchor_states[(int)anchorInd_data[(int)
+                     qualities_data[i] - 1] - 1].feature_states[(int)
+                     featureInd_data[(int)qualities_data[i] - 1] - 1].
                      status_idx);
         } else {
           // 'SLAM_upd:326' else
           // 'SLAM_upd:327' xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).status = int32(1); 
-          b_xt->anchor_states[(int)anchorInd->data[(int)qualities->data[i] - 1]
-            - 1].feature_states[(int)featureInd->data[(int)qualities->data[i] -
+          b_xt->anchor_states[(int)anchorInd_data[(int)qualities_data[i] - 1]
+            - 1].feature_states[(int)featureInd_data[(int)qualities_data[i] -
             1] - 1].status = 1;
 
           // 'SLAM_upd:328' log_info('Forcing activation of feature %i (%i on anchor %i)', xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).status_idx, featureInd(sortInd(i)), anchorInd(sortInd(i))); 
-          f_log_info(b_xt->anchor_states[(int)anchorInd->data[(int)
-                     qualities->data[i] - 1] - 1].feature_states[(int)
-                     featureInd->data[(int)qualities->data[i] - 1] - 1].
-                     status_idx, featureInd->data[(int)qualities->data[i] - 1],
-                     anchorInd->data[(int)qualities->data[i] - 1]);
+          f_log_info(b_xt->anchor_states[(int)anchorInd_data[(int)
+                     qualities_data[i] - 1] - 1].feature_states[(int)
+                     featureInd_data[(int)qualities_data[i] - 1] - 1].
+                     status_idx, featureInd_data[(int)qualities_data[i] - 1],
+                     anchorInd_data[(int)qualities_data[i] - 1]);
 
           // 'SLAM_upd:329' numActivatedFeatures = numActivatedFeatures + 1;
           numActivatedFeatures++;
@@ -7984,11 +6432,6 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
     }
   }
 
-  emxFree_int32_T(&b_iidx);
-  emxFree_real_T(&featureInd);
-  emxFree_real_T(&anchorInd);
-  emxFree_real_T(&qualities);
-
   //  check if new features need to be requested
   // 'SLAM_upd:336' request_new_features = false;
   request_new_features = false;
@@ -8113,7 +6556,8 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
           }
         }
 
-        c_uncertainties[anchorIdx] = d_norm(b_P_apr);
+        c_uncertainties[anchorIdx] = SLAM_anchorUncertainty(b_P_apr,
+          b_VIOParameters.origin_anchor_metric);
 
         // 'SLAM_upd:386' has_active_features(anchorIdx) = 1;
         b_has_active_features[anchorIdx] = 1.0;
@@ -8178,12 +6622,12 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
         // 'log_error:8' elseif ~coder.target('MEX')
         // 'log_error:9' coder.cinclude('<vio_logging.h>')
         // 'log_error:10' coder.ceval('LOG_ERROR', [str, 0], varargin{:});
-        memcpy(&cv46[0], &cv47[0], 111U * sizeof(char));
-        LOG_ERROR(cv46, b_xt->origin.anchor_idx);
+        LOG_ERROR(cv47, b_xt->origin.anchor_idx);
       } else {
         // 'SLAM_upd:398' else
         // 'SLAM_upd:399' log_info('Setting anchor %i as origin', int32(xt.origin.anchor_idx)) 
         g_log_info(b_xt->origin.anchor_idx);
+        telemetry.origin_anchor_switch = 1;
 
         // 'SLAM_upd:401' new_origin_pos_rel = xt.anchor_states(xt.origin.anchor_idx).pos; 
         //  in old origin frame
@@ -8853,10 +7297,7 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
   }
 
   // % aposteriori measurement prediction
-  // 'SLAM_upd:444' [map] = getMap(xt);
-  getMap(b_xt->origin.pos, b_xt->origin.att, b_xt->anchor_states, b_map);
-
-  //  get map for output
+  //  the map for the output is built by SLAM if it is requested
   // 'SLAM_upd:446' delayedStatus = zeros(size(updateVect));
   memset(&b_delayedStatus[0], 0, 48U * sizeof(double));
 
@@ -8875,6 +7316,24 @@ static void SLAM_upd(double P_apr[10404], g_struct_T *b_xt, int
       }
     }
   }
+
+  for (anchorIdx = 0; anchorIdx < 6; anchorIdx++) {
+    for (featureIdx = 0; featureIdx < 8; featureIdx++) {
+      if (b_xt->anchor_states[anchorIdx].feature_states[featureIdx].status == 1)
+      {
+        telemetry.active_features++;
+      } else {
+        if (b_xt->anchor_states[anchorIdx].feature_states[featureIdx].status ==
+            2) {
+          telemetry.delayed_features++;
+        }
+      }
+    }
+  }
+
+  for (i = 0; i < 18; i++) {
+    telemetry.robot_cov_trace += P_apr[103 * i];
+  }
 }
 
 //
@@ -8932,30 +7391,6 @@ static boolean_T anyActiveAnchorFeatures(const e_struct_T
   return ret;
 }
 
-//
-// Arguments    : const boolean_T x[3]
-// Return Type  : boolean_T
-//
-static boolean_T b_any(const boolean_T x[3])
-{
-  boolean_T y;
-  int k;
-  boolean_T exitg1;
-  y = false;
-  k = 0;
-  exitg1 = false;
-  while ((!exitg1) && (k < 3)) {
-    if (!!x[k]) {
-      y = true;
-      exitg1 = true;
-    } else {
-      k++;
-    }
-  }
-
-  return y;
-}
-
 //
 // Arguments    : const double v[15]
 //                double d[225]
@@ -10504,8 +8939,6 @@ static void b_getH_R_res(const double xt_robot_state_pos[3], const double
 //
 static void b_log_error()
 {
-  char cv20[14];
-  int i24;
   static const char cv21[14] = { 'i', 'n', 'c', 'o', 'n', 's', 'i', 's', 't',
     'e', 'n', 'c', 'y', '\x00' };
 
@@ -10513,11 +8946,7 @@ static void b_log_error()
   // 'log_error:8' elseif ~coder.target('MEX')
   // 'log_error:9' coder.cinclude('<vio_logging.h>')
   // 'log_error:10' coder.ceval('LOG_ERROR', [str, 0], varargin{:});
-  for (i24 = 0; i24 < 14; i24++) {
-    cv20[i24] = cv21[i24];
-  }
-
-  LOG_ERROR(cv20);
+  LOG_ERROR(cv21);
 }
 
 //
@@ -10531,259 +8960,45 @@ static void b_log_error()
 //
 static void b_log_info(int varargin_1, int varargin_2, int varargin_3)
 {
-  char cv14[44];
-  int i16;
-  static const char cv15[44] = { 'F', 'i', 'x', 'i', 'n', 'g', ' ', 'f', 'e',
-    'a', 't', 'u', 'r', 'e', ' ', '%', 'i', ' ', '(', 'f', 'e', 'a', 't', 'u',
-    'r', 'e', ' ', '%', 'i', ' ', 'o', 'n', ' ', 'a', 'n', 'c', 'h', 'o', 'r',
-    ' ', '%', 'i', ')', '\x00' };
-
-  //  debug_level == 0: print errors, == 1: print warnings, == 2: print info
-  // 'log_info:7' if coder.target('MATLAB')
-  // 'log_info:11' elseif ~coder.target('MEX')
-  // 'log_info:12' coder.cinclude('<vio_logging.h>')
-  // 'log_info:13' if debug_level >= 2
-  if (debug_level >= 2.0) {
-    // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i16 = 0; i16 < 44; i16++) {
-      cv14[i16] = cv15[i16];
-    }
-
-    LOG_INFO(cv14, varargin_1, varargin_2, varargin_3);
-  }
-}
-
-//
-// log_warn Print to console in Matlab
-//  in C++, vio_logging.h needs to be created to define what LOG_WARN does,
-//  e.g. redefine ROS_WARN
-// Arguments    : void
-// Return Type  : void
-//
-static void b_log_warn()
-{
-  char cv18[44];
-  int i23;
-  static const char cv19[44] = { '1', '-', 'P', 'o', 'i', 'n', 't', ' ', 'R',
-    'A', 'N', 'S', 'A', 'C', ' ', 'd', 'i', 'd', 'n', 't', ' ', 'f', 'i', 'n',
-    'd', ' ', 'e', 'n', 'o', 'u', 'g', 'h', ' ', 'L', 'I', ' ', 'i', 'n', 'l',
-    'i', 'e', 'r', 's', '\x00' };
-
-  //  debug_level == 0: print errors, == 1: print warnings, == 2: print info
-  // 'log_warn:8' if coder.target('MATLAB')
-  // 'log_warn:12' elseif ~coder.target('MEX')
-  // 'log_warn:13' coder.cinclude('<vio_logging.h>')
-  // 'log_warn:14' if debug_level >= 2
-  if (debug_level >= 2.0) {
-    // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i23 = 0; i23 < 44; i23++) {
-      cv18[i23] = cv19[i23];
-    }
-
-    LOG_WARN(cv18);
-  }
-}
-
-//
-// Arguments    : emxArray_int32_T *idx
-//                emxArray_real_T *x
-//                int offset
-//                int np
-//                int nq
-//                emxArray_int32_T *iwork
-//                emxArray_real_T *xwork
-// Return Type  : void
-//
-static void b_merge(emxArray_int32_T *idx, emxArray_real_T *x, int offset, int
-                    np, int nq, emxArray_int32_T *iwork, emxArray_real_T *xwork)
-{
-  int n;
-  int qend;
-  int p;
-  int iout;
-  int exitg1;
-  if (nq == 0) {
-  } else {
-    n = np + nq;
-    for (qend = 0; qend + 1 <= n; qend++) {
-      iwork->data[qend] = idx->data[offset + qend];
-      xwork->data[qend] = x->data[offset + qend];
-    }
-
-    p = 0;
-    n = np;
-    qend = np + nq;
-    iout = offset - 1;
-    do {
-      exitg1 = 0;
-      iout++;
-      if (xwork->data[p] <= xwork->data[n]) {
-        idx->data[iout] = iwork->data[p];
-        x->data[iout] = xwork->data[p];
-        if (p + 1 < np) {
-          p++;
-        } else {
-          exitg1 = 1;
-        }
-      } else {
-        idx->data[iout] = iwork->data[n];
-        x->data[iout] = xwork->data[n];
-        if (n + 1 < qend) {
-          n++;
-        } else {
-          n = (iout - p) + 1;
-          while (p + 1 <= np) {
-            idx->data[n + p] = iwork->data[p];
-            x->data[n + p] = xwork->data[p];
-            p++;
-          }
+  static const char cv15[44] = { 'F', 'i', 'x', 'i', 'n', 'g', ' ', 'f', 'e',
+    'a', 't', 'u', 'r', 'e', ' ', '%', 'i', ' ', '(', 'f', 'e', 'a', 't', 'u',
+    'r', 'e', ' ', '%', 'i', ' ', 'o', 'n', ' ', 'a', 'n', 'c', 'h', 'o', 'r',
+    ' ', '%', 'i', ')', '\x00' };
 
-          exitg1 = 1;
-        }
-      }
-    } while (exitg1 == 0);
+  //  debug_level == 0: print errors, == 1: print warnings, == 2: print info
+  // 'log_info:7' if coder.target('MATLAB')
+  // 'log_info:11' elseif ~coder.target('MEX')
+  // 'log_info:12' coder.cinclude('<vio_logging.h>')
+  // 'log_info:13' if debug_level >= 2
+  if (debug_level >= 2.0) {
+    // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
+    LOG_INFO(cv15, varargin_1, varargin_2, varargin_3);
   }
 }
 
 //
-// Arguments    : double A_data[]
-//                int A_size[2]
-//                const double B_data[]
-//                const int B_size[2]
+// log_warn Print to console in Matlab
+//  in C++, vio_logging.h needs to be created to define what LOG_WARN does,
+//  e.g. redefine ROS_WARN
+// Arguments    : void
 // Return Type  : void
 //
-static void b_mrdivide(double A_data[], int A_size[2], const double B_data[],
-  const int B_size[2])
+static void b_log_warn()
 {
-  emxArray_real_T *A;
-  emxArray_int32_T *jpvt;
-  int rankR;
-  int mn;
-  int i;
-  int pj;
-  int j;
-  int b_m;
-  double wj;
-  emxArray_real_T *tau;
-  signed char unnamed_idx_0;
-  double Y_data[4];
-  double b_B_data[4];
-  emxInit_real_T1(&A, 2);
-  emxInit_int32_T1(&jpvt, 2);
-  if (B_size[0] == B_size[1]) {
-    rankR = B_size[1];
-    mn = A->size[0] * A->size[1];
-    A->size[0] = B_size[0];
-    A->size[1] = B_size[1];
-    emxEnsureCapacity((emxArray__common *)A, mn, (int)sizeof(double));
-    i = B_size[0] * B_size[1];
-    for (mn = 0; mn < i; mn++) {
-      A->data[mn] = B_data[mn];
-    }
-
-    xgetrf(B_size[1], B_size[1], A, B_size[1], jpvt, &pj);
-    for (j = 0; j + 1 <= rankR; j++) {
-      pj = rankR * j;
-      for (b_m = 0; b_m + 1 <= j; b_m++) {
-        if (A->data[b_m + pj] != 0.0) {
-          A_data[j] -= A->data[b_m + pj] * A_data[b_m];
-        }
-      }
-
-      wj = A->data[j + pj];
-      A_data[j] *= 1.0 / wj;
-    }
-
-    for (j = B_size[1]; j > 0; j--) {
-      pj = rankR * (j - 1);
-      for (b_m = j; b_m + 1 <= rankR; b_m++) {
-        if (A->data[b_m + pj] != 0.0) {
-          A_data[j - 1] -= A->data[b_m + pj] * A_data[b_m];
-        }
-      }
-    }
-
-    for (pj = B_size[1] - 2; pj + 1 > 0; pj--) {
-      if (jpvt->data[pj] != pj + 1) {
-        wj = A_data[A_size[0] * pj];
-        A_data[A_size[0] * pj] = A_data[A_size[0] * (jpvt->data[pj] - 1)];
-        A_data[A_size[0] * (jpvt->data[pj] - 1)] = wj;
-      }
-    }
-  } else {
-    mn = A->size[0] * A->size[1];
-    A->size[0] = B_size[1];
-    A->size[1] = B_size[0];
-    emxEnsureCapacity((emxArray__common *)A, mn, (int)sizeof(double));
-    i = B_size[0];
-    for (mn = 0; mn < i; mn++) {
-      pj = B_size[1];
-      for (b_m = 0; b_m < pj; b_m++) {
-        A->data[b_m + A->size[0] * mn] = B_data[mn + B_size[0] * b_m];
-      }
-    }
-
-    emxInit_real_T(&tau, 1);
-    xgeqp3(A, tau, jpvt);
-    rankR = rankFromQR(A);
-    unnamed_idx_0 = (signed char)A->size[1];
-    i = unnamed_idx_0;
-    for (mn = 0; mn < i; mn++) {
-      Y_data[mn] = 0.0;
-    }
-
-    i = A_size[1];
-    for (mn = 0; mn < i; mn++) {
-      b_B_data[mn] = A_data[A_size[0] * mn];
-    }
-
-    b_m = A->size[0];
-    pj = A->size[0];
-    mn = A->size[1];
-    if (pj <= mn) {
-      mn = pj;
-    }
-
-    for (j = 0; j + 1 <= mn; j++) {
-      if (tau->data[j] != 0.0) {
-        wj = b_B_data[j];
-        for (i = j + 1; i + 1 <= b_m; i++) {
-          wj += A->data[i + A->size[0] * j] * b_B_data[i];
-        }
-
-        wj *= tau->data[j];
-        if (wj != 0.0) {
-          b_B_data[j] -= wj;
-          for (i = j + 1; i + 1 <= b_m; i++) {
-            b_B_data[i] -= A->data[i + A->size[0] * j] * wj;
-          }
-        }
-      }
-    }
-
-    emxFree_real_T(&tau);
-    for (i = 0; i + 1 <= rankR; i++) {
-      Y_data[jpvt->data[i] - 1] = b_B_data[i];
-    }
-
-    for (j = rankR - 1; j + 1 > 0; j--) {
-      pj = jpvt->data[j];
-      Y_data[jpvt->data[j] - 1] /= A->data[j + A->size[0] * j];
-      for (i = 0; i + 1 <= j; i++) {
-        Y_data[jpvt->data[i] - 1] -= Y_data[pj - 1] * A->data[i + A->size[0] * j];
-      }
-    }
+  static const char cv19[44] = { '1', '-', 'P', 'o', 'i', 'n', 't', ' ', 'R',
+    'A', 'N', 'S', 'A', 'C', ' ', 'd', 'i', 'd', 'n', 't', ' ', 'f', 'i', 'n',
+    'd', ' ', 'e', 'n', 'o', 'u', 'g', 'h', ' ', 'L', 'I', ' ', 'i', 'n', 'l',
+    'i', 'e', 'r', 's', '\x00' };
 
-    A_size[0] = 1;
-    A_size[1] = unnamed_idx_0;
-    i = unnamed_idx_0;
-    for (mn = 0; mn < i; mn++) {
-      A_data[A_size[0] * mn] = Y_data[mn];
-    }
+  //  debug_level == 0: print errors, == 1: print warnings, == 2: print info
+  // 'log_warn:8' if coder.target('MATLAB')
+  // 'log_warn:12' elseif ~coder.target('MEX')
+  // 'log_warn:13' coder.cinclude('<vio_logging.h>')
+  // 'log_warn:14' if debug_level >= 2
+  if (debug_level >= 2.0) {
+    // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
+    LOG_WARN(cv19);
   }
-
-  emxFree_int32_T(&jpvt);
-  emxFree_real_T(&A);
 }
 
 //
@@ -10814,207 +9029,6 @@ static double b_norm(const double x[4])
   return scale * sqrt(y);
 }
 
-//
-// Arguments    : double x[8]
-//                int idx[8]
-// Return Type  : void
-//
-static void b_sort(double x[8], int idx[8])
-{
-  int b_m;
-  double x4[4];
-  signed char idx4[4];
-  double xwork[8];
-  int nNaNs;
-  int ib;
-  int k;
-  int bLen;
-  int nPairs;
-  int i4;
-  signed char perm[4];
-  int iwork[8];
-  for (b_m = 0; b_m < 8; b_m++) {
-    idx[b_m] = 0;
-  }
-
-  for (b_m = 0; b_m < 4; b_m++) {
-    x4[b_m] = 0.0;
-    idx4[b_m] = 0;
-  }
-
-  memset(&xwork[0], 0, sizeof(double) << 3);
-  nNaNs = -7;
-  ib = 0;
-  for (k = 0; k < 8; k++) {
-    if (rtIsNaN(x[k])) {
-      idx[-nNaNs] = k + 1;
-      xwork[-nNaNs] = x[k];
-      nNaNs++;
-    } else {
-      ib++;
-      idx4[ib - 1] = (signed char)(k + 1);
-      x4[ib - 1] = x[k];
-      if (ib == 4) {
-        ib = (k - nNaNs) - 10;
-        if (x4[0] <= x4[1]) {
-          b_m = 1;
-          bLen = 2;
-        } else {
-          b_m = 2;
-          bLen = 1;
-        }
-
-        if (x4[2] <= x4[3]) {
-          nPairs = 3;
-          i4 = 4;
-        } else {
-          nPairs = 4;
-          i4 = 3;
-        }
-
-        if (x4[b_m - 1] <= x4[nPairs - 1]) {
-          if (x4[bLen - 1] <= x4[nPairs - 1]) {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)bLen;
-            perm[2] = (signed char)nPairs;
-            perm[3] = (signed char)i4;
-          } else if (x4[bLen - 1] <= x4[i4 - 1]) {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)nPairs;
-            perm[2] = (signed char)bLen;
-            perm[3] = (signed char)i4;
-          } else {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)nPairs;
-            perm[2] = (signed char)i4;
-            perm[3] = (signed char)bLen;
-          }
-        } else if (x4[b_m - 1] <= x4[i4 - 1]) {
-          if (x4[bLen - 1] <= x4[i4 - 1]) {
-            perm[0] = (signed char)nPairs;
-            perm[1] = (signed char)b_m;
-            perm[2] = (signed char)bLen;
-            perm[3] = (signed char)i4;
-          } else {
-            perm[0] = (signed char)nPairs;
-            perm[1] = (signed char)b_m;
-            perm[2] = (signed char)i4;
-            perm[3] = (signed char)bLen;
-          }
-        } else {
-          perm[0] = (signed char)nPairs;
-          perm[1] = (signed char)i4;
-          perm[2] = (signed char)b_m;
-          perm[3] = (signed char)bLen;
-        }
-
-        idx[ib] = idx4[perm[0] - 1];
-        idx[ib + 1] = idx4[perm[1] - 1];
-        idx[ib + 2] = idx4[perm[2] - 1];
-        idx[ib + 3] = idx4[perm[3] - 1];
-        x[ib] = x4[perm[0] - 1];
-        x[ib + 1] = x4[perm[1] - 1];
-        x[ib + 2] = x4[perm[2] - 1];
-        x[ib + 3] = x4[perm[3] - 1];
-        ib = 0;
-      }
-    }
-  }
-
-  if (ib > 0) {
-    for (b_m = 0; b_m < 4; b_m++) {
-      perm[b_m] = 0;
-    }
-
-    if (ib == 1) {
-      perm[0] = 1;
-    } else if (ib == 2) {
-      if (x4[0] <= x4[1]) {
-        perm[0] = 1;
-        perm[1] = 2;
-      } else {
-        perm[0] = 2;
-        perm[1] = 1;
-      }
-    } else if (x4[0] <= x4[1]) {
-      if (x4[1] <= x4[2]) {
-        perm[0] = 1;
-        perm[1] = 2;
-        perm[2] = 3;
-      } else if (x4[0] <= x4[2]) {
-        perm[0] = 1;
-        perm[1] = 3;
-        perm[2] = 2;
-      } else {
-        perm[0] = 3;
-        perm[1] = 1;
-        perm[2] = 2;
-      }
-    } else if (x4[0] <= x4[2]) {
-      perm[0] = 2;
-      perm[1] = 1;
-      perm[2] = 3;
-    } else if (x4[1] <= x4[2]) {
-      perm[0] = 2;
-      perm[1] = 3;
-      perm[2] = 1;
-    } else {
-      perm[0] = 3;
-      perm[1] = 2;
-      perm[2] = 1;
-    }
-
-    for (k = 1; k <= ib; k++) {
-      idx[(k - nNaNs) - ib] = idx4[perm[k - 1] - 1];
-      x[(k - nNaNs) - ib] = x4[perm[k - 1] - 1];
-    }
-  }
-
-  b_m = (nNaNs + 7) >> 1;
-  for (k = 1; k <= b_m; k++) {
-    ib = idx[k - nNaNs];
-    idx[k - nNaNs] = idx[8 - k];
-    idx[8 - k] = ib;
-    x[k - nNaNs] = xwork[8 - k];
-    x[8 - k] = xwork[k - nNaNs];
-  }
-
-  if (((nNaNs + 7) & 1) != 0) {
-    x[(b_m - nNaNs) + 1] = xwork[(b_m - nNaNs) + 1];
-  }
-
-  if (1 - nNaNs > 1) {
-    for (b_m = 0; b_m < 8; b_m++) {
-      iwork[b_m] = 0;
-    }
-
-    nPairs = (1 - nNaNs) >> 2;
-    bLen = 4;
-    while (nPairs > 1) {
-      if ((nPairs & 1) != 0) {
-        nPairs--;
-        ib = bLen * nPairs;
-        b_m = 1 - (nNaNs + ib);
-        if (b_m > bLen) {
-          merge(idx, x, ib, bLen, b_m - bLen, iwork, xwork);
-        }
-      }
-
-      ib = bLen << 1;
-      nPairs >>= 1;
-      for (k = 1; k <= nPairs; k++) {
-        merge(idx, x, (k - 1) * ib, bLen, bLen, iwork, xwork);
-      }
-
-      bLen = ib;
-    }
-
-    if (1 - nNaNs > bLen) {
-      merge(idx, x, 0, bLen, 1 - (nNaNs + bLen), iwork, xwork);
-    }
-  }
-}
-
 //
 // Arguments    : int n
 //                double a
@@ -11042,277 +9056,6 @@ static void b_xaxpy(int n, double a, const double x[36], int ix0, double y[6],
   }
 }
 
-//
-// Arguments    : double A[30]
-//                double tau[5]
-//                int jpvt[5]
-// Return Type  : void
-//
-static void b_xgeqp3(double A[30], double tau[5], int jpvt[5])
-{
-  double vn1[5];
-  double vn2[5];
-  int k;
-  int iy;
-  double work[5];
-  double smax;
-  double temp2;
-  int itemp;
-  double absxk;
-  double t;
-  int i;
-  int i_i;
-  int ix;
-  int pvt;
-  int i61;
-  int i_ip1;
-  int lastv;
-  int lastc;
-  boolean_T exitg2;
-  int exitg1;
-  k = 1;
-  for (iy = 0; iy < 5; iy++) {
-    jpvt[iy] = 1 + iy;
-    work[iy] = 0.0;
-    smax = 0.0;
-    temp2 = 2.2250738585072014E-308;
-    for (itemp = k; itemp <= k + 5; itemp++) {
-      absxk = fabs(A[itemp - 1]);
-      if (absxk > temp2) {
-        t = temp2 / absxk;
-        smax = 1.0 + smax * t * t;
-        temp2 = absxk;
-      } else {
-        t = absxk / temp2;
-        smax += t * t;
-      }
-    }
-
-    smax = temp2 * sqrt(smax);
-    vn1[iy] = smax;
-    vn2[iy] = vn1[iy];
-    k += 6;
-  }
-
-  for (i = 0; i < 5; i++) {
-    i_i = i + i * 6;
-    itemp = 0;
-    if (5 - i > 1) {
-      ix = i;
-      smax = vn1[i];
-      for (k = 1; k + 1 <= 5 - i; k++) {
-        ix++;
-        if (vn1[ix] > smax) {
-          itemp = k;
-          smax = vn1[ix];
-        }
-      }
-    }
-
-    pvt = i + itemp;
-    if (pvt + 1 != i + 1) {
-      ix = 6 * pvt;
-      iy = 6 * i;
-      for (k = 0; k < 6; k++) {
-        smax = A[ix];
-        A[ix] = A[iy];
-        A[iy] = smax;
-        ix++;
-        iy++;
-      }
-
-      itemp = jpvt[pvt];
-      jpvt[pvt] = jpvt[i];
-      jpvt[i] = itemp;
-      vn1[pvt] = vn1[i];
-      vn2[pvt] = vn2[i];
-    }
-
-    absxk = A[i_i];
-    temp2 = 0.0;
-    smax = d_xnrm2(5 - i, A, i_i + 2);
-    if (smax != 0.0) {
-      smax = hypot(A[i_i], smax);
-      if (A[i_i] >= 0.0) {
-        smax = -smax;
-      }
-
-      if (fabs(smax) < 1.0020841800044864E-292) {
-        itemp = 0;
-        do {
-          itemp++;
-          i61 = i_i - i;
-          for (k = i_i + 1; k + 1 <= i61 + 6; k++) {
-            A[k] *= 9.9792015476736E+291;
-          }
-
-          smax *= 9.9792015476736E+291;
-          absxk *= 9.9792015476736E+291;
-        } while (!(fabs(smax) >= 1.0020841800044864E-292));
-
-        smax = hypot(absxk, d_xnrm2(5 - i, A, i_i + 2));
-        if (absxk >= 0.0) {
-          smax = -smax;
-        }
-
-        temp2 = (smax - absxk) / smax;
-        absxk = 1.0 / (absxk - smax);
-        i61 = i_i - i;
-        for (k = i_i + 1; k + 1 <= i61 + 6; k++) {
-          A[k] *= absxk;
-        }
-
-        for (k = 1; k <= itemp; k++) {
-          smax *= 1.0020841800044864E-292;
-        }
-
-        absxk = smax;
-      } else {
-        temp2 = (smax - A[i_i]) / smax;
-        absxk = 1.0 / (A[i_i] - smax);
-        i61 = i_i - i;
-        for (k = i_i + 1; k + 1 <= i61 + 6; k++) {
-          A[k] *= absxk;
-        }
-
-        absxk = smax;
-      }
-    }
-
-    tau[i] = temp2;
-    A[i_i] = absxk;
-    if (i + 1 < 5) {
-      absxk = A[i_i];
-      A[i_i] = 1.0;
-      i_ip1 = (i + (i + 1) * 6) + 1;
-      if (tau[i] != 0.0) {
-        lastv = 6 - i;
-        itemp = i_i - i;
-        while ((lastv > 0) && (A[itemp + 5] == 0.0)) {
-          lastv--;
-          itemp--;
-        }
-
-        lastc = 4 - i;
-        exitg2 = false;
-        while ((!exitg2) && (lastc > 0)) {
-          itemp = i_ip1 + (lastc - 1) * 6;
-          k = itemp;
-          do {
-            exitg1 = 0;
-            if (k <= (itemp + lastv) - 1) {
-              if (A[k - 1] != 0.0) {
-                exitg1 = 1;
-              } else {
-                k++;
-              }
-            } else {
-              lastc--;
-              exitg1 = 2;
-            }
-          } while (exitg1 == 0);
-
-          if (exitg1 == 1) {
-            exitg2 = true;
-          }
-        }
-      } else {
-        lastv = 0;
-        lastc = 0;
-      }
-
-      if (lastv > 0) {
-        if (lastc == 0) {
-        } else {
-          for (iy = 1; iy <= lastc; iy++) {
-            work[iy - 1] = 0.0;
-          }
-
-          iy = 0;
-          i61 = i_ip1 + 6 * (lastc - 1);
-          for (itemp = i_ip1; itemp <= i61; itemp += 6) {
-            ix = i_i;
-            smax = 0.0;
-            pvt = (itemp + lastv) - 1;
-            for (k = itemp; k <= pvt; k++) {
-              smax += A[k - 1] * A[ix];
-              ix++;
-            }
-
-            work[iy] += smax;
-            iy++;
-          }
-        }
-
-        if (-tau[i] == 0.0) {
-        } else {
-          itemp = i_ip1 - 1;
-          pvt = 0;
-          for (iy = 1; iy <= lastc; iy++) {
-            if (work[pvt] != 0.0) {
-              smax = work[pvt] * -tau[i];
-              ix = i_i;
-              i61 = lastv + itemp;
-              for (k = itemp; k + 1 <= i61; k++) {
-                A[k] += A[ix] * smax;
-                ix++;
-              }
-            }
-
-            pvt++;
-            itemp += 6;
-          }
-        }
-      }
-
-      A[i_i] = absxk;
-    }
-
-    for (iy = i + 1; iy + 1 < 6; iy++) {
-      itemp = (i + 6 * iy) + 1;
-      if (vn1[iy] != 0.0) {
-        smax = fabs(A[i + 6 * iy]) / vn1[iy];
-        smax = 1.0 - smax * smax;
-        if (smax < 0.0) {
-          smax = 0.0;
-        }
-
-        temp2 = vn1[iy] / vn2[iy];
-        temp2 = smax * (temp2 * temp2);
-        if (temp2 <= 1.4901161193847656E-8) {
-          smax = 0.0;
-          if (5 - i == 1) {
-            smax = fabs(A[itemp]);
-          } else {
-            temp2 = 2.2250738585072014E-308;
-            pvt = (itemp - i) + 5;
-            while (itemp + 1 <= pvt) {
-              absxk = fabs(A[itemp]);
-              if (absxk > temp2) {
-                t = temp2 / absxk;
-                smax = 1.0 + smax * t * t;
-                temp2 = absxk;
-              } else {
-                t = absxk / temp2;
-                smax += t * t;
-              }
-
-              itemp++;
-            }
-
-            smax = temp2 * sqrt(smax);
-          }
-
-          vn1[iy] = smax;
-          vn2[iy] = vn1[iy];
-        } else {
-          vn1[iy] *= sqrt(smax);
-        }
-      }
-    }
-  }
-}
-
 //
 // Arguments    : int n
 //                const emxArray_real_T *x
@@ -11431,8 +9174,6 @@ static double c_fprintf(double varargin_1)
 //
 static void c_log_info(int varargin_1, int varargin_2)
 {
-  char cv28[44];
-  int i29;
   static const char cv29[44] = { 'S', 'u', 'c', 'c', 'e', 's', 's', 'f', 'u',
     'l', 'l', 'y', ' ', 't', 'r', 'i', 'a', 'n', 'g', 'u', 'l', 'a', 't', 'e',
     'd', ' ', '%', 'd', ' ', 'o', 'f', ' ', '%', 'd', ' ', 'f', 'e', 'a', 't',
@@ -11445,11 +9186,7 @@ static void c_log_info(int varargin_1, int varargin_2)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i29 = 0; i29 < 44; i29++) {
-      cv28[i29] = cv29[i29];
-    }
-
-    LOG_INFO(cv28, varargin_1, varargin_2);
+    LOG_INFO(cv29, varargin_1, varargin_2);
   }
 }
 
@@ -11463,8 +9200,6 @@ static void c_log_info(int varargin_1, int varargin_2)
 //
 static void c_log_warn(int varargin_1, double varargin_2)
 {
-  char cv22[36];
-  int i25;
   static const char cv23[36] = { 'F', 'e', 'a', 't', 'u', 'r', 'e', ' ', '%',
     'i', ' ', 'i', 's', ' ', 'v', 'e', 'r', 'y', ' ', 'c', 'l', 'o', 's', 'e',
     '.', ' ', 'D', 'e', 'p', 't', 'h', ':', ' ', '%', 'f', '\x00' };
@@ -11476,11 +9211,7 @@ static void c_log_warn(int varargin_1, double varargin_2)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i25 = 0; i25 < 36; i25++) {
-      cv22[i25] = cv23[i25];
-    }
-
-    LOG_WARN(cv22, varargin_1, varargin_2);
+    LOG_WARN(cv23, varargin_1, varargin_2);
   }
 }
 
@@ -11512,22 +9243,6 @@ static double c_norm(const double x[2])
   return scale * sqrt(y);
 }
 
-//
-// Arguments    : emxArray_real_T *x
-//                emxArray_int32_T *idx
-// Return Type  : void
-//
-static void c_sort(emxArray_real_T *x, emxArray_int32_T *idx)
-{
-  int dim;
-  dim = 2;
-  if (x->size[0] != 1) {
-    dim = 1;
-  }
-
-  d_sort(x, dim, idx);
-}
-
 //
 // Arguments    : int n
 //                double a
@@ -11674,8 +9389,6 @@ static double d_fprintf(double varargin_1)
 //
 static void d_log_info(int varargin_1)
 {
-  char cv30[52];
-  int i30;
   static const char cv31[52] = { 'I', 'n', 'i', 't', 'i', 'a', 'l', 'i', 'z',
     'i', 'n', 'g', ' ', 'a', 'n', 'c', 'h', 'o', 'r', ' ', '%', 'i', ',', ' ',
     'w', 'h', 'i', 'c', 'h', ' ', 'w', 'a', 's', ' ', 't', 'h', 'e', ' ', 'o',
@@ -11687,12 +9400,8 @@ static void d_log_info(int varargin_1)
   // 'log_info:12' coder.cinclude('<vio_logging.h>')
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0) {
-    // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i30 = 0; i30 < 52; i30++) {
-      cv30[i30] = cv31[i30];
-    }
-
-    LOG_INFO(cv30, varargin_1);
+    // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
+    LOG_INFO(cv31, varargin_1);
   }
 }
 
@@ -11705,8 +9414,6 @@ static void d_log_info(int varargin_1)
 //
 static void d_log_warn(signed char varargin_1)
 {
-  char cv24[37];
-  int i27;
   static const char cv25[37] = { 'B', 'a', 'd', ' ', 't', 'r', 'i', 'a', 'n',
     'g', 'u', 'l', 'a', 't', 'i', 'o', 'n', ' ', '(', 'n', 'a', 'n', ')', ' ',
     'f', 'o', 'r', ' ', 'p', 'o', 'i', 'n', 't', ' ', '%', 'd', '\x00' };
@@ -11718,11 +9425,7 @@ static void d_log_warn(signed char varargin_1)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i27 = 0; i27 < 37; i27++) {
-      cv24[i27] = cv25[i27];
-    }
-
-    LOG_WARN(cv24, varargin_1);
+    LOG_WARN(cv25, varargin_1);
   }
 }
 
@@ -11762,99 +9465,6 @@ static double d_norm(const double x[36])
   return y;
 }
 
-//
-// Arguments    : emxArray_real_T *x
-//                int dim
-//                emxArray_int32_T *idx
-// Return Type  : void
-//
-static void d_sort(emxArray_real_T *x, int dim, emxArray_int32_T *idx)
-{
-  int i62;
-  emxArray_real_T *vwork;
-  int vstride;
-  int x_idx_0;
-  int j;
-  emxArray_int32_T *iidx;
-  if (dim <= 1) {
-    i62 = x->size[0];
-  } else {
-    i62 = 1;
-  }
-
-  emxInit_real_T(&vwork, 1);
-  vstride = vwork->size[0];
-  vwork->size[0] = i62;
-  emxEnsureCapacity((emxArray__common *)vwork, vstride, (int)sizeof(double));
-  x_idx_0 = x->size[0];
-  vstride = idx->size[0];
-  idx->size[0] = x_idx_0;
-  emxEnsureCapacity((emxArray__common *)idx, vstride, (int)sizeof(int));
-  vstride = 1;
-  x_idx_0 = 1;
-  while (x_idx_0 <= dim - 1) {
-    vstride *= x->size[0];
-    x_idx_0 = 2;
-  }
-
-  j = 0;
-  emxInit_int32_T(&iidx, 1);
-  while (j + 1 <= vstride) {
-    for (x_idx_0 = 0; x_idx_0 + 1 <= i62; x_idx_0++) {
-      vwork->data[x_idx_0] = x->data[j + x_idx_0 * vstride];
-    }
-
-    sortIdx(vwork, iidx);
-    for (x_idx_0 = 0; x_idx_0 + 1 <= i62; x_idx_0++) {
-      x->data[j + x_idx_0 * vstride] = vwork->data[x_idx_0];
-      idx->data[j + x_idx_0 * vstride] = iidx->data[x_idx_0];
-    }
-
-    j++;
-  }
-
-  emxFree_int32_T(&iidx);
-  emxFree_real_T(&vwork);
-}
-
-//
-// Arguments    : int n
-//                const double x[30]
-//                int ix0
-// Return Type  : double
-//
-static double d_xnrm2(int n, const double x[30], int ix0)
-{
-  double y;
-  double scale;
-  int kend;
-  int k;
-  double absxk;
-  double t;
-  y = 0.0;
-  if (n == 1) {
-    y = fabs(x[ix0 - 1]);
-  } else {
-    scale = 2.2250738585072014E-308;
-    kend = (ix0 + n) - 1;
-    for (k = ix0; k <= kend; k++) {
-      absxk = fabs(x[k - 1]);
-      if (absxk > scale) {
-        t = scale / absxk;
-        y = 1.0 + y * t * t;
-        scale = absxk;
-      } else {
-        t = absxk / scale;
-        y += t * t;
-      }
-    }
-
-    y = scale * sqrt(y);
-  }
-
-  return y;
-}
-
 //
 // Arguments    : const double v[3]
 //                double d[9]
@@ -11953,8 +9563,6 @@ static double e_fprintf(double varargin_1)
 //
 static void e_log_info(int varargin_1)
 {
-  char cv32[45];
-  int i31;
   static const char cv33[45] = { 'F', 'e', 'a', 't', 'u', 'r', 'e', ' ', '%',
     'd', ' ', 'i', 's', ' ', 't', 'o', 'o', ' ', 'f', 'a', 'r', ' ', 'a', 'w',
     'a', 'y', ' ', 't', 'o', ' ', 't', 'r', 'i', 'a', 'n', 'g', 'u', 'l', 'a',
@@ -11967,11 +9575,7 @@ static void e_log_info(int varargin_1)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i31 = 0; i31 < 45; i31++) {
-      cv32[i31] = cv33[i31];
-    }
-
-    LOG_INFO(cv32, varargin_1);
+    LOG_INFO(cv33, varargin_1);
   }
 }
 
@@ -11985,8 +9589,6 @@ static void e_log_info(int varargin_1)
 //
 static void e_log_warn(int varargin_1, double varargin_2)
 {
-  char cv26[49];
-  int i28;
   static const char cv27[49] = { 'F', 'e', 'a', 't', 'u', 'r', 'e', ' ', '%',
     'i', ' ', 'i', 's', ' ', 't', 'r', 'i', 'a', 'n', 'g', 'u', 'l', 'a', 't',
     'e', 'd', ' ', 'v', 'e', 'r', 'y', ' ', 'c', 'l', 'o', 's', 'e', '.', ' ',
@@ -11999,11 +9601,7 @@ static void e_log_warn(int varargin_1, double varargin_2)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i28 = 0; i28 < 49; i28++) {
-      cv26[i28] = cv27[i28];
-    }
-
-    LOG_WARN(cv26, varargin_1, varargin_2);
+    LOG_WARN(cv27, varargin_1, varargin_2);
   }
 }
 
@@ -12144,27 +9742,6 @@ static void emxFree_real_T(emxArray_real_T **pEmxArray)
   }
 }
 
-//
-// Arguments    : emxArray_int32_T **pEmxArray
-//                int b_numDimensions
-// Return Type  : void
-//
-static void emxInit_int32_T(emxArray_int32_T **pEmxArray, int b_numDimensions)
-{
-  emxArray_int32_T *emxArray;
-  int i;
-  *pEmxArray = (emxArray_int32_T *)malloc(sizeof(emxArray_int32_T));
-  emxArray = *pEmxArray;
-  emxArray->data = (int *)NULL;
-  emxArray->numDimensions = b_numDimensions;
-  emxArray->size = (int *)malloc((unsigned int)(sizeof(int) * b_numDimensions));
-  emxArray->allocatedSize = 0;
-  emxArray->canFreeData = true;
-  for (i = 0; i < b_numDimensions; i++) {
-    emxArray->size[i] = 0;
-  }
-}
-
 //
 // Arguments    : emxArray_int32_T **pEmxArray
 //                int b_numDimensions
@@ -12277,8 +9854,6 @@ static double f_fprintf(double varargin_1)
 //
 static void f_log_info(int varargin_1, double varargin_2, double varargin_3)
 {
-  char cv40[51];
-  int i35;
   static const char cv41[51] = { 'F', 'o', 'r', 'c', 'i', 'n', 'g', ' ', 'a',
     'c', 't', 'i', 'v', 'a', 't', 'i', 'o', 'n', ' ', 'o', 'f', ' ', 'f', 'e',
     'a', 't', 'u', 'r', 'e', ' ', '%', 'i', ' ', '(', '%', 'i', ' ', 'o', 'n',
@@ -12291,11 +9866,7 @@ static void f_log_info(int varargin_1, double varargin_2, double varargin_3)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i35 = 0; i35 < 51; i35++) {
-      cv40[i35] = cv41[i35];
-    }
-
-    LOG_INFO(cv40, varargin_1, varargin_2, varargin_3);
+    LOG_INFO(cv41, varargin_1, varargin_2, varargin_3);
   }
 }
 
@@ -12308,8 +9879,6 @@ static void f_log_info(int varargin_1, double varargin_2, double varargin_3)
 //
 static void f_log_warn(double varargin_1)
 {
-  char cv34[62];
-  int i32;
   static const char cv35[62] = { 'G', 'o', 't', ' ', '%', 'd', ' ', 'n', 'e',
     'w', ' ', 'f', 'e', 'a', 'u', 't', 'u', 'r', 'e', 's', ' ', 'b', 'u', 't',
     ' ', 'n', 'o', 't', ' ', 'e', 'n', 'o', 'u', 'g', 'h', ' ', 'f', 'o', 'r',
@@ -12323,11 +9892,7 @@ static void f_log_warn(double varargin_1)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i32 = 0; i32 < 62; i32++) {
-      cv34[i32] = cv35[i32];
-    }
-
-    LOG_WARN(cv34, varargin_1, 4);
+    LOG_WARN(cv35, varargin_1, 4);
   }
 }
 
@@ -12408,8 +9973,6 @@ static double g_fprintf(double varargin_1)
 //
 static void g_log_info(int varargin_1)
 {
-  char cv44[28];
-  int i37;
   static const char cv45[28] = { 'S', 'e', 't', 't', 'i', 'n', 'g', ' ', 'a',
     'n', 'c', 'h', 'o', 'r', ' ', '%', 'i', ' ', 'a', 's', ' ', 'o', 'r', 'i',
     'g', 'i', 'n', '\x00' };
@@ -12421,11 +9984,7 @@ static void g_log_info(int varargin_1)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i37 = 0; i37 < 28; i37++) {
-      cv44[i37] = cv45[i37];
-    }
-
-    LOG_INFO(cv44, varargin_1);
+    LOG_INFO(cv45, varargin_1);
   }
 }
 
@@ -12440,8 +9999,6 @@ static void g_log_info(int varargin_1)
 //
 static void g_log_warn(int varargin_1, int varargin_2, int varargin_3)
 {
-  char cv36[57];
-  int i33;
   static const char cv37[57] = { 'F', 'e', 'a', 't', 'u', 'r', 'e', ' ', '%',
     'i', ' ', '(', '%', 'i', ' ', 'o', 'n', ' ', 'a', 'n', 'c', 'h', 'o', 'r',
     ' ', '%', 'i', ')', ' ', 'c', 'o', 'n', 'v', 'e', 'r', 'g', 'e', 'd', ' ',
@@ -12455,11 +10012,7 @@ static void g_log_warn(int varargin_1, int varargin_2, int varargin_3)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i33 = 0; i33 < 57; i33++) {
-      cv36[i33] = cv37[i33];
-    }
-
-    LOG_WARN(cv36, varargin_1, varargin_2, varargin_3);
+    LOG_WARN(cv37, varargin_1, varargin_2, varargin_3);
   }
 }
 
@@ -14742,8 +12295,6 @@ static double h_fprintf(double varargin_1, double varargin_2, double varargin_3)
 //
 static void h_log_warn(int varargin_1)
 {
-  char cv38[52];
-  int i34;
   static const char cv39[52] = { 'T', 'r', 'y', 'i', 'n', 'g', ' ', 't', 'o',
     ' ', 'f', 'o', 'r', 'c', 'e', ' ', 'i', 'n', 's', 'e', 'r', 't', ' ', 'f',
     'e', 'a', 't', 'u', 'r', 'e', ' ', '%', 'i', ' ', 'b', 'e', 'h', 'i', 'n',
@@ -14756,11 +12307,7 @@ static void h_log_warn(int varargin_1)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i34 = 0; i34 < 52; i34++) {
-      cv38[i34] = cv39[i34];
-    }
-
-    LOG_WARN(cv38, varargin_1);
+    LOG_WARN(cv39, varargin_1);
   }
 }
 
@@ -14801,8 +12348,6 @@ static double i_fprintf(double varargin_1, double varargin_2, double varargin_3)
 //
 static void i_log_warn()
 {
-  char cv42[54];
-  int i36;
   static const char cv43[54] = { 'C', 'a', 'n', '\'', 't', ' ', 'f', 'i', 'x',
     ' ', 'a', 'n', ' ', 'a', 'n', 'c', 'h', 'o', 'r', ' ', 'b', 'e', 'c', 'a',
     'u', 's', 'e', ' ', 'n', 'o', 'n', 'e', ' ', 'h', 'a', 'v', 'e', ' ', 'a',
@@ -14816,248 +12361,7 @@ static void i_log_warn()
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i36 = 0; i36 < 54; i36++) {
-      cv42[i36] = cv43[i36];
-    }
-
-    LOG_WARN(cv42);
-  }
-}
-
-//
-// INITIALIZEPOINT Initialize a feature point from undistorted measurements
-//
-//  INPUT ARGUMENTS:
-//  - cameraparams: The camera parameter struct
-//  - z_l: The undistorted measurement of the feature in the left camera
-//  - z_r: The undistorted measurement of the feature in the right camera
-//
-//  OUTPUT ARGUMENTS:
-//  - fp: The feature point in the camera frame
-//  - m:  The ray in the left and right camera frame to the feature
-// Arguments    : const double z_u_l[2]
-//                const double z_u_r[2]
-//                const double c_cameraparams_CameraParameters[2]
-//                const double d_cameraparams_CameraParameters[2]
-//                const double e_cameraparams_CameraParameters[2]
-//                const double f_cameraparams_CameraParameters[2]
-//                const double cameraparams_r_lr[3]
-//                const double cameraparams_R_lr[9]
-//                double fp[3]
-//                double b_m[6]
-//                boolean_T *success
-// Return Type  : void
-//
-static void initializePoint(const double z_u_l[2], const double z_u_r[2], const
-  double c_cameraparams_CameraParameters[2], const double
-  d_cameraparams_CameraParameters[2], const double
-  e_cameraparams_CameraParameters[2], const double
-  f_cameraparams_CameraParameters[2], const double cameraparams_r_lr[3], const
-  double cameraparams_R_lr[9], double fp[3], double b_m[6], boolean_T *success)
-{
-  double ml[3];
-  double mr[3];
-  double tol;
-  double B;
-  double b_pos[6];
-  int k;
-  int i26;
-  static const signed char iv0[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
-
-  double rot[18];
-  double A[30];
-  double b[6];
-  int anchorIdx;
-  int rankR;
-  double b_rot[9];
-  signed char I[9];
-  int j;
-  int jpvt[5];
-  double tau[5];
-  double x[5];
-
-  // 'initializePoint:13' fx_l = cameraparams.CameraParameters1.FocalLength(1);
-  // 'initializePoint:14' fy_l = cameraparams.CameraParameters1.FocalLength(2);
-  // 'initializePoint:15' Cx_l = cameraparams.CameraParameters1.PrincipalPoint(1); 
-  // 'initializePoint:16' Cy_l = cameraparams.CameraParameters1.PrincipalPoint(2); 
-  // 'initializePoint:18' fx_r = cameraparams.CameraParameters2.FocalLength(1);
-  // 'initializePoint:19' fy_r = cameraparams.CameraParameters2.FocalLength(2);
-  // 'initializePoint:20' Cx_r = cameraparams.CameraParameters2.PrincipalPoint(1); 
-  // 'initializePoint:21' Cy_r = cameraparams.CameraParameters2.PrincipalPoint(2); 
-  // 'initializePoint:23' pos = [zeros(3,1), cameraparams.r_lr];
-  // 'initializePoint:24' rot = [eye(3), cameraparams.R_lr'];
-  // 'initializePoint:26' z_n_l = [(z_u_l(1) - Cx_l)/fx_l; (z_u_l(2) - Cy_l)/fy_l]; 
-  // 'initializePoint:27' z_n_r = [(z_u_r(1) - Cx_r)/fx_r; (z_u_r(2) - Cy_r)/fy_r]; 
-  // 'initializePoint:29' ml = [z_n_l; 1];
-  ml[0] = (z_u_l[0] - d_cameraparams_CameraParameters[0]) /
-    c_cameraparams_CameraParameters[0];
-  ml[1] = (z_u_l[1] - d_cameraparams_CameraParameters[1]) /
-    c_cameraparams_CameraParameters[1];
-  ml[2] = 1.0;
-
-  // 'initializePoint:30' mr = [z_n_r; 1];
-  mr[0] = (z_u_r[0] - f_cameraparams_CameraParameters[0]) /
-    e_cameraparams_CameraParameters[0];
-  mr[1] = (z_u_r[1] - f_cameraparams_CameraParameters[1]) /
-    e_cameraparams_CameraParameters[1];
-  mr[2] = 1.0;
-
-  // 'initializePoint:31' m = [ml/norm(ml),mr/norm(mr)];
-  tol = norm(ml);
-  B = norm(mr);
-  for (k = 0; k < 3; k++) {
-    b_pos[k] = 0.0;
-    b_pos[3 + k] = cameraparams_r_lr[k];
-    for (i26 = 0; i26 < 3; i26++) {
-      rot[i26 + 3 * k] = iv0[i26 + 3 * k];
-      rot[i26 + 3 * (k + 3)] = cameraparams_R_lr[k + 3 * i26];
-    }
-
-    b_m[k] = ml[k] / tol;
-    b_m[3 + k] = mr[k] / B;
-  }
-
-  //  normalized rays in left frame
-  // 'initializePoint:34' ml_n_l = m(:,1);
-  // 'initializePoint:35' mr_n_r = cameraparams.R_lr * m(:,2);
-  for (k = 0; k < 3; k++) {
-    ml[k] = 0.0;
-    for (i26 = 0; i26 < 3; i26++) {
-      ml[k] += cameraparams_R_lr[k + 3 * i26] * b_m[3 + i26];
-    }
-  }
-
-  // 'initializePoint:36' cross_prod = cross(ml_n_l, mr_n_r);
-  // 'initializePoint:37' if cross_prod(2) > 0
-  if (b_m[2] * ml[0] - b_m[0] * ml[2] > 0.0) {
-    // 'initializePoint:38' success = false;
-    *success = false;
-
-    // 'initializePoint:39' fp = m(:,1);
-    for (k = 0; k < 3; k++) {
-      fp[k] = b_m[k];
-    }
-  } else {
-    // 'initializePoint:42' success = true;
-    *success = true;
-
-    // 'initializePoint:44' [ fp ] = triangulatePoint( pos, rot, m );
-    // triangulatePoint Triangulate a point from several measurements
-    //    Calculate the world position of a point given measurements of it from
-    //    different positions. The solution minimizes the least squares error
-    //
-    //  INPUTS:
-    //  pos: a 3 x n matrix containing the positions of the cameras
-    //  rot: a 4 x n matrix containing the JPL quaternions of the cameras
-    //  m: a 3 x n matrix containing the unit vectors pointing towards the
-    //      feature in the camera frame
-    //  where n is the number of poses
-    //
-    //  OUTPUTS:
-    //  pf: the feature position in world coordinates
-    //  condition: the condition number of the least squares problem. High
-    //      numbers mean a badly conditiond problem and a bad result
-    // 'triangulatePoint:18' numAnchors = size(pos, 2);
-    // 'triangulatePoint:20' A = zeros(3*numAnchors, numAnchors + 3);
-    memset(&A[0], 0, 30U * sizeof(double));
-
-    // 'triangulatePoint:21' b = zeros(3*numAnchors, 1);
-    for (k = 0; k < 6; k++) {
-      b[k] = 0.0;
-    }
-
-    // 'triangulatePoint:23' for anchorIdx = 1:numAnchors
-    for (anchorIdx = 0; anchorIdx < 2; anchorIdx++) {
-      // 'triangulatePoint:24' currentAnchorPos = pos(:,anchorIdx);
-      // 'triangulatePoint:25' currentAnchorRot = rot(:, (anchorIdx-1)*3 + (1:3)); 
-      // 'triangulatePoint:26' currentM = m(:,anchorIdx);
-      // 'triangulatePoint:28' A((anchorIdx-1)*3 + (1:3), anchorIdx) = currentAnchorRot'*currentM; 
-      rankR = anchorIdx * 3;
-      for (k = 0; k < 3; k++) {
-        for (i26 = 0; i26 < 3; i26++) {
-          b_rot[i26 + 3 * k] = rot[k + 3 * (i26 + rankR)];
-        }
-      }
-
-      rankR = anchorIdx * 3;
-      for (k = 0; k < 3; k++) {
-        A[(k + rankR) + 6 * anchorIdx] = 0.0;
-        for (i26 = 0; i26 < 3; i26++) {
-          A[(k + rankR) + 6 * anchorIdx] += b_rot[k + 3 * i26] * b_m[i26 + 3 *
-            anchorIdx];
-        }
-      }
-
-      // 'triangulatePoint:29' A((anchorIdx-1)*3 + (1:3), end - 3 + (1:3)) = -eye(3); 
-      for (k = 0; k < 9; k++) {
-        I[k] = 0;
-      }
-
-      for (k = 0; k < 3; k++) {
-        I[k + 3 * k] = 1;
-      }
-
-      rankR = anchorIdx * 3;
-
-      // 'triangulatePoint:31' b((anchorIdx-1)*3 + (1:3)) = - currentAnchorPos;
-      j = anchorIdx * 3;
-      for (k = 0; k < 3; k++) {
-        for (i26 = 0; i26 < 3; i26++) {
-          A[(i26 + rankR) + 6 * (2 + k)] = -(double)I[i26 + 3 * k];
-        }
-
-        b[k + j] = -b_pos[k + 3 * anchorIdx];
-      }
-    }
-
-    //  condition = cond(A);
-    // 'triangulatePoint:35' x = A\b;
-    b_xgeqp3(A, tau, jpvt);
-    rankR = 0;
-    tol = 6.0 * fabs(A[0]) * 2.2204460492503131E-16;
-    while ((rankR < 5) && (fabs(A[rankR + 6 * rankR]) >= tol)) {
-      rankR++;
-    }
-
-    for (j = 0; j < 5; j++) {
-      x[j] = 0.0;
-      if (tau[j] != 0.0) {
-        tol = b[j];
-        for (k = j + 1; k + 1 < 7; k++) {
-          tol += A[k + 6 * j] * b[k];
-        }
-
-        tol *= tau[j];
-        if (tol != 0.0) {
-          b[j] -= tol;
-          for (k = j + 1; k + 1 < 7; k++) {
-            b[k] -= A[k + 6 * j] * tol;
-          }
-        }
-      }
-    }
-
-    for (k = 0; k + 1 <= rankR; k++) {
-      x[jpvt[k] - 1] = b[k];
-    }
-
-    for (j = rankR - 1; j + 1 > 0; j--) {
-      x[jpvt[j] - 1] /= A[j + 6 * j];
-      for (k = 0; k + 1 <= j; k++) {
-        x[jpvt[k] - 1] -= x[jpvt[j] - 1] * A[k + 6 * j];
-      }
-    }
-
-    // 'triangulatePoint:36' pf = x(end-2:end);
-    for (k = 0; k < 3; k++) {
-      fp[k] = x[k + 2];
-    }
-
-    //  is this better?
-    //  A = [cameraparams.R_rl * ml, -mr];
-    //  b = cameraparams.r_lr;
-    //  x = A\b;
-    //  fp = ml*x(1);
+    LOG_WARN(cv43);
   }
 }
 
@@ -15147,8 +12451,6 @@ static double l_fprintf(int varargin_1)
 //
 static void log_error()
 {
-  char cv12[27];
-  int i15;
   static const char cv13[27] = { 'p', 'i', 'c', 'k', 'e', 'd', ' ', 'a', 'n',
     ' ', 'i', 'n', 'a', 'c', 't', 'i', 'v', 'e', ' ', 'f', 'e', 'a', 't', 'u',
     'r', 'e', '\x00' };
@@ -15157,11 +12459,7 @@ static void log_error()
   // 'log_error:8' elseif ~coder.target('MEX')
   // 'log_error:9' coder.cinclude('<vio_logging.h>')
   // 'log_error:10' coder.ceval('LOG_ERROR', [str, 0], varargin{:});
-  for (i15 = 0; i15 < 27; i15++) {
-    cv12[i15] = cv13[i15];
-  }
-
-  LOG_ERROR(cv12);
+  LOG_ERROR(cv13);
 }
 
 //
@@ -15175,8 +12473,6 @@ static void log_error()
 //
 static void log_info(int varargin_1, int varargin_2, int varargin_3)
 {
-  char cv10[54];
-  int i14;
   static const char cv11[54] = { 'F', 'i', 'x', 'e', 'd', ' ', 'f', 'e', 'a',
     't', 'u', 'r', 'e', ' ', '%', 'i', ' ', '(', '%', 'i', ' ', 'o', 'n', ' ',
     'a', 'n', 'c', 'h', 'o', 'r', ' ', '%', 'i', ')', ' ', 'i', 's', ' ', 'n',
@@ -15190,11 +12486,7 @@ static void log_info(int varargin_1, int varargin_2, int varargin_3)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i14 = 0; i14 < 54; i14++) {
-      cv10[i14] = cv11[i14];
-    }
-
-    LOG_INFO(cv10, varargin_1, varargin_2, varargin_3);
+    LOG_INFO(cv11, varargin_1, varargin_2, varargin_3);
   }
 }
 
@@ -15209,8 +12501,6 @@ static void log_info(int varargin_1, int varargin_2, int varargin_3)
 //
 static void log_warn(int varargin_1, int varargin_2, int varargin_3)
 {
-  char cv16[54];
-  int i22;
   static const char cv17[54] = { 'F', 'e', 'a', 't', 'u', 'r', 'e', ' ', '%',
     'i', ' ', '(', '%', 'i', ' ', 'o', 'n', ' ', '%', 'i', ')', ' ', 'i', 's',
     ' ', 'b', 'e', 'h', 'i', 'n', 'd', ' ', 'i', 't', 's', ' ', 'a', 'n', 'c',
@@ -15224,11 +12514,7 @@ static void log_warn(int varargin_1, int varargin_2, int varargin_3)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i22 = 0; i22 < 54; i22++) {
-      cv16[i22] = cv17[i22];
-    }
-
-    LOG_WARN(cv16, varargin_1, varargin_2, varargin_3);
+    LOG_WARN(cv17, varargin_1, varargin_2, varargin_3);
   }
 }
 
@@ -15268,252 +12554,6 @@ static double m_fprintf(const char varargin_1_data[], const int varargin_1_size
   return nbytesint;
 }
 
-//
-// Arguments    : const double x_data[]
-//                const int x_size[1]
-// Return Type  : double
-//
-static double median(const double x_data[], const int x_size[1])
-{
-  double y;
-  int k;
-  int midm1;
-  int i;
-  int idx_data[48];
-  emxArray_int32_T *iwork;
-  int n;
-  int iwork_data[48];
-  boolean_T p;
-  int i2;
-  int j;
-  int pEnd;
-  int b_p;
-  int q;
-  int qEnd;
-  int kEnd;
-  if (x_size[0] == 0) {
-    y = rtNaN;
-  } else {
-    k = x_size[0];
-    midm1 = k / 2;
-    i = (signed char)x_size[0];
-    for (k = 0; k < i; k++) {
-      idx_data[k] = 0;
-    }
-
-    emxInit_int32_T(&iwork, 1);
-    n = x_size[0] + 1;
-    k = iwork->size[0];
-    iwork->size[0] = (signed char)x_size[0];
-    emxEnsureCapacity((emxArray__common *)iwork, k, (int)sizeof(int));
-    i = iwork->size[0];
-    for (k = 0; k < i; k++) {
-      iwork_data[k] = iwork->data[k];
-    }
-
-    emxFree_int32_T(&iwork);
-    for (k = 1; k <= n - 2; k += 2) {
-      if ((x_data[k - 1] <= x_data[k]) || rtIsNaN(x_data[k])) {
-        p = true;
-      } else {
-        p = false;
-      }
-
-      if (p) {
-        idx_data[k - 1] = k;
-        idx_data[k] = k + 1;
-      } else {
-        idx_data[k - 1] = k + 1;
-        idx_data[k] = k;
-      }
-    }
-
-    if ((x_size[0] & 1) != 0) {
-      idx_data[x_size[0] - 1] = x_size[0];
-    }
-
-    i = 2;
-    while (i < n - 1) {
-      i2 = i << 1;
-      j = 1;
-      for (pEnd = 1 + i; pEnd < n; pEnd = qEnd + i) {
-        b_p = j;
-        q = pEnd - 1;
-        qEnd = j + i2;
-        if (qEnd > n) {
-          qEnd = n;
-        }
-
-        k = 0;
-        kEnd = qEnd - j;
-        while (k + 1 <= kEnd) {
-          if ((x_data[idx_data[b_p - 1] - 1] <= x_data[idx_data[q] - 1]) ||
-              rtIsNaN(x_data[idx_data[q] - 1])) {
-            p = true;
-          } else {
-            p = false;
-          }
-
-          if (p) {
-            iwork_data[k] = idx_data[b_p - 1];
-            b_p++;
-            if (b_p == pEnd) {
-              while (q + 1 < qEnd) {
-                k++;
-                iwork_data[k] = idx_data[q];
-                q++;
-              }
-            }
-          } else {
-            iwork_data[k] = idx_data[q];
-            q++;
-            if (q + 1 == qEnd) {
-              while (b_p < pEnd) {
-                k++;
-                iwork_data[k] = idx_data[b_p - 1];
-                b_p++;
-              }
-            }
-          }
-
-          k++;
-        }
-
-        for (k = 0; k + 1 <= kEnd; k++) {
-          idx_data[(j + k) - 1] = iwork_data[k];
-        }
-
-        j = qEnd;
-      }
-
-      i = i2;
-    }
-
-    if (rtIsNaN(x_data[idx_data[(signed char)x_size[0] - 1] - 1])) {
-      y = x_data[idx_data[(signed char)x_size[0] - 1] - 1];
-    } else if (midm1 << 1 == x_size[0]) {
-      if (((x_data[idx_data[midm1 - 1] - 1] < 0.0) && (x_data[idx_data[midm1] -
-            1] >= 0.0)) || rtIsInf(x_data[idx_data[midm1 - 1] - 1]) || rtIsInf
-          (x_data[idx_data[midm1] - 1])) {
-        y = (x_data[idx_data[midm1 - 1] - 1] + x_data[idx_data[midm1] - 1]) /
-          2.0;
-      } else {
-        y = x_data[idx_data[midm1 - 1] - 1] + (x_data[idx_data[midm1] - 1] -
-          x_data[idx_data[midm1 - 1] - 1]) / 2.0;
-      }
-    } else {
-      y = x_data[idx_data[midm1] - 1];
-    }
-  }
-
-  return y;
-}
-
-//
-// Arguments    : int idx[8]
-//                double x[8]
-//                int offset
-//                int np
-//                int nq
-//                int iwork[8]
-//                double xwork[8]
-// Return Type  : void
-//
-static void merge(int idx[8], double x[8], int offset, int np, int nq, int
-                  iwork[8], double xwork[8])
-{
-  int n;
-  int qend;
-  int p;
-  int iout;
-  int exitg1;
-  if (nq == 0) {
-  } else {
-    n = np + nq;
-    for (qend = 0; qend + 1 <= n; qend++) {
-      iwork[qend] = idx[offset + qend];
-      xwork[qend] = x[offset + qend];
-    }
-
-    p = 0;
-    n = np;
-    qend = np + nq;
-    iout = offset - 1;
-    do {
-      exitg1 = 0;
-      iout++;
-      if (xwork[p] <= xwork[n]) {
-        idx[iout] = iwork[p];
-        x[iout] = xwork[p];
-        if (p + 1 < np) {
-          p++;
-        } else {
-          exitg1 = 1;
-        }
-      } else {
-        idx[iout] = iwork[n];
-        x[iout] = xwork[n];
-        if (n + 1 < qend) {
-          n++;
-        } else {
-          n = (iout - p) + 1;
-          while (p + 1 <= np) {
-            idx[n + p] = iwork[p];
-            x[n + p] = xwork[p];
-            p++;
-          }
-
-          exitg1 = 1;
-        }
-      }
-    } while (exitg1 == 0);
-  }
-}
-
-//
-// Arguments    : emxArray_int32_T *idx
-//                emxArray_real_T *x
-//                int offset
-//                int n
-//                int preSortLevel
-//                emxArray_int32_T *iwork
-//                emxArray_real_T *xwork
-// Return Type  : void
-//
-static void merge_block(emxArray_int32_T *idx, emxArray_real_T *x, int offset,
-  int n, int preSortLevel, emxArray_int32_T *iwork, emxArray_real_T *xwork)
-{
-  int nPairs;
-  int bLen;
-  int tailOffset;
-  int nTail;
-  nPairs = n >> preSortLevel;
-  bLen = 1 << preSortLevel;
-  while (nPairs > 1) {
-    if ((nPairs & 1) != 0) {
-      nPairs--;
-      tailOffset = bLen * nPairs;
-      nTail = n - tailOffset;
-      if (nTail > bLen) {
-        b_merge(idx, x, offset + tailOffset, bLen, nTail - bLen, iwork, xwork);
-      }
-    }
-
-    tailOffset = bLen << 1;
-    nPairs >>= 1;
-    for (nTail = 1; nTail <= nPairs; nTail++) {
-      b_merge(idx, x, offset + (nTail - 1) * tailOffset, bLen, bLen, iwork,
-              xwork);
-    }
-
-    bLen = tailOffset;
-  }
-
-  if (n > bLen) {
-    b_merge(idx, x, offset, bLen, n - bLen, iwork, xwork);
-  }
-}
-
 //
 // Arguments    : emxArray_real_T *A
 //                const emxArray_real_T *B
@@ -16030,12 +13070,10 @@ static void printParams(double c_noiseParameters_process_noise, double
   c_VIOParameters_delayed_initial, boolean_T VIOParameters_mono, boolean_T
   VIOParameters_full_stereo, boolean_T VIOParameters_RANSAC)
 {
-  char cv0[18];
   int i3;
   static const char cv1[18] = { 'N', 'o', 'i', 's', 'e', ' ', 'p', 'a', 'r', 'a',
     'm', 'e', 't', 'e', 'r', 's', ':', '\x00' };
 
-  char cv2[15];
   static const char cv3[15] = { 'V', 'I', 'O', ' ', 'p', 'a', 'r', 'a', 'm', 'e',
     't', 'e', 'r', 's', '\x00' };
 
@@ -16059,11 +13097,7 @@ static void printParams(double c_noiseParameters_process_noise, double
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i3 = 0; i3 < 18; i3++) {
-      cv0[i3] = cv1[i3];
-    }
-
-    LOG_INFO(cv0);
+    LOG_INFO(cv1);
   }
 
   // 'SLAM:134' fprintf('\tqv: %f\n', noiseParameters.process_noise.qv);
@@ -16109,11 +13143,7 @@ static void printParams(double c_noiseParameters_process_noise, double
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i3 = 0; i3 < 15; i3++) {
-      cv2[i3] = cv3[i3];
-    }
-
-    LOG_INFO(cv2);
+    LOG_INFO(cv3);
   }
 
   // 'SLAM:146' fprintf('\tmax_ekf_iterations: %d\n', int32(VIOParameters.max_ekf_iterations)); 
@@ -16312,10 +13342,7 @@ static void quatPlusThetaJ(const double dtheta[3], double dq[4])
 //
 static void quatmultJ(const double q[4], const double p[4], double qp[4])
 {
-  double b_p[16];
-  double b_q[4];
   int i9;
-  int i10;
   double B;
 
   // 'quatmultJ:2' if coder.target('MATLAB')
@@ -16331,32 +13358,7 @@ static void quatmultJ(const double q[4], const double p[4], double qp[4])
   // 'quatmultJ:20'     p3,p4,-p1,p2;
   // 'quatmultJ:21'     -p2,p1,p4,p3;
   // 'quatmultJ:22'     -p1,-p2,-p3,p4]*[q1;q2;q3;q4];
-  b_p[0] = p[3];
-  b_p[4] = -p[2];
-  b_p[8] = p[1];
-  b_p[12] = p[0];
-  b_p[1] = p[2];
-  b_p[5] = p[3];
-  b_p[9] = -p[0];
-  b_p[13] = p[1];
-  b_p[2] = -p[1];
-  b_p[6] = p[0];
-  b_p[10] = p[3];
-  b_p[14] = p[2];
-  b_p[3] = -p[0];
-  b_p[7] = -p[1];
-  b_p[11] = -p[2];
-  b_p[15] = p[3];
-  b_q[0] = q[0];
-  b_q[1] = q[1];
-  b_q[2] = q[2];
-  b_q[3] = q[3];
-  for (i9 = 0; i9 < 4; i9++) {
-    qp[i9] = 0.0;
-    for (i10 = 0; i10 < 4; i10++) {
-      qp[i9] += b_p[i9 + (i10 << 2)] * b_q[i10];
-    }
-  }
+  small_matrix::quatMult(q, p, qp);
 
   // 'quatmultJ:23' qp = qp/norm(qp);
   B = b_norm(qp);
@@ -16481,312 +13483,6 @@ static double rt_roundd_snf(double u)
   return y;
 }
 
-//
-// Arguments    : double x[8]
-//                int idx[8]
-// Return Type  : void
-//
-static void sort(double x[8], int idx[8])
-{
-  b_sort(x, idx);
-}
-
-//
-// Arguments    : emxArray_real_T *x
-//                emxArray_int32_T *idx
-// Return Type  : void
-//
-static void sortIdx(emxArray_real_T *x, emxArray_int32_T *idx)
-{
-  emxArray_real_T *b_x;
-  int ib;
-  int wOffset;
-  int b_m;
-  int n;
-  double x4[4];
-  int idx4[4];
-  emxArray_int32_T *iwork;
-  emxArray_real_T *xwork;
-  int nNaNs;
-  int k;
-  int i3;
-  int i4;
-  signed char perm[4];
-  int nNonNaN;
-  int nBlocks;
-  int b_iwork[256];
-  double b_xwork[256];
-  int bLen2;
-  int nPairs;
-  int exitg1;
-  emxInit_real_T(&b_x, 1);
-  ib = x->size[0];
-  wOffset = b_x->size[0];
-  b_x->size[0] = x->size[0];
-  emxEnsureCapacity((emxArray__common *)b_x, wOffset, (int)sizeof(double));
-  b_m = x->size[0];
-  for (wOffset = 0; wOffset < b_m; wOffset++) {
-    b_x->data[wOffset] = x->data[wOffset];
-  }
-
-  wOffset = idx->size[0];
-  idx->size[0] = ib;
-  emxEnsureCapacity((emxArray__common *)idx, wOffset, (int)sizeof(int));
-  for (wOffset = 0; wOffset < ib; wOffset++) {
-    idx->data[wOffset] = 0;
-  }
-
-  n = x->size[0];
-  for (b_m = 0; b_m < 4; b_m++) {
-    x4[b_m] = 0.0;
-    idx4[b_m] = 0;
-  }
-
-  emxInit_int32_T(&iwork, 1);
-  wOffset = iwork->size[0];
-  iwork->size[0] = ib;
-  emxEnsureCapacity((emxArray__common *)iwork, wOffset, (int)sizeof(int));
-  b_m = iwork->size[0];
-  wOffset = iwork->size[0];
-  iwork->size[0] = b_m;
-  emxEnsureCapacity((emxArray__common *)iwork, wOffset, (int)sizeof(int));
-  for (wOffset = 0; wOffset < b_m; wOffset++) {
-    iwork->data[wOffset] = 0;
-  }
-
-  emxInit_real_T(&xwork, 1);
-  b_m = x->size[0];
-  wOffset = xwork->size[0];
-  xwork->size[0] = b_m;
-  emxEnsureCapacity((emxArray__common *)xwork, wOffset, (int)sizeof(double));
-  b_m = xwork->size[0];
-  wOffset = xwork->size[0];
-  xwork->size[0] = b_m;
-  emxEnsureCapacity((emxArray__common *)xwork, wOffset, (int)sizeof(double));
-  for (wOffset = 0; wOffset < b_m; wOffset++) {
-    xwork->data[wOffset] = 0.0;
-  }
-
-  nNaNs = 1;
-  ib = 0;
-  for (k = 0; k + 1 <= n; k++) {
-    if (rtIsNaN(b_x->data[k])) {
-      idx->data[n - nNaNs] = k + 1;
-      xwork->data[n - nNaNs] = b_x->data[k];
-      nNaNs++;
-    } else {
-      ib++;
-      idx4[ib - 1] = k + 1;
-      x4[ib - 1] = b_x->data[k];
-      if (ib == 4) {
-        ib = k - nNaNs;
-        if (x4[0] <= x4[1]) {
-          b_m = 1;
-          wOffset = 2;
-        } else {
-          b_m = 2;
-          wOffset = 1;
-        }
-
-        if (x4[2] <= x4[3]) {
-          i3 = 3;
-          i4 = 4;
-        } else {
-          i3 = 4;
-          i4 = 3;
-        }
-
-        if (x4[b_m - 1] <= x4[i3 - 1]) {
-          if (x4[wOffset - 1] <= x4[i3 - 1]) {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)wOffset;
-            perm[2] = (signed char)i3;
-            perm[3] = (signed char)i4;
-          } else if (x4[wOffset - 1] <= x4[i4 - 1]) {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)i3;
-            perm[2] = (signed char)wOffset;
-            perm[3] = (signed char)i4;
-          } else {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)i3;
-            perm[2] = (signed char)i4;
-            perm[3] = (signed char)wOffset;
-          }
-        } else if (x4[b_m - 1] <= x4[i4 - 1]) {
-          if (x4[wOffset - 1] <= x4[i4 - 1]) {
-            perm[0] = (signed char)i3;
-            perm[1] = (signed char)b_m;
-            perm[2] = (signed char)wOffset;
-            perm[3] = (signed char)i4;
-          } else {
-            perm[0] = (signed char)i3;
-            perm[1] = (signed char)b_m;
-            perm[2] = (signed char)i4;
-            perm[3] = (signed char)wOffset;
-          }
-        } else {
-          perm[0] = (signed char)i3;
-          perm[1] = (signed char)i4;
-          perm[2] = (signed char)b_m;
-          perm[3] = (signed char)wOffset;
-        }
-
-        idx->data[ib - 2] = idx4[perm[0] - 1];
-        idx->data[ib - 1] = idx4[perm[1] - 1];
-        idx->data[ib] = idx4[perm[2] - 1];
-        idx->data[ib + 1] = idx4[perm[3] - 1];
-        b_x->data[ib - 2] = x4[perm[0] - 1];
-        b_x->data[ib - 1] = x4[perm[1] - 1];
-        b_x->data[ib] = x4[perm[2] - 1];
-        b_x->data[ib + 1] = x4[perm[3] - 1];
-        ib = 0;
-      }
-    }
-  }
-
-  wOffset = x->size[0] - nNaNs;
-  if (ib > 0) {
-    for (b_m = 0; b_m < 4; b_m++) {
-      perm[b_m] = 0;
-    }
-
-    if (ib == 1) {
-      perm[0] = 1;
-    } else if (ib == 2) {
-      if (x4[0] <= x4[1]) {
-        perm[0] = 1;
-        perm[1] = 2;
-      } else {
-        perm[0] = 2;
-        perm[1] = 1;
-      }
-    } else if (x4[0] <= x4[1]) {
-      if (x4[1] <= x4[2]) {
-        perm[0] = 1;
-        perm[1] = 2;
-        perm[2] = 3;
-      } else if (x4[0] <= x4[2]) {
-        perm[0] = 1;
-        perm[1] = 3;
-        perm[2] = 2;
-      } else {
-        perm[0] = 3;
-        perm[1] = 1;
-        perm[2] = 2;
-      }
-    } else if (x4[0] <= x4[2]) {
-      perm[0] = 2;
-      perm[1] = 1;
-      perm[2] = 3;
-    } else if (x4[1] <= x4[2]) {
-      perm[0] = 2;
-      perm[1] = 3;
-      perm[2] = 1;
-    } else {
-      perm[0] = 3;
-      perm[1] = 2;
-      perm[2] = 1;
-    }
-
-    for (k = 1; k <= ib; k++) {
-      idx->data[(wOffset - ib) + k] = idx4[perm[k - 1] - 1];
-      b_x->data[(wOffset - ib) + k] = x4[perm[k - 1] - 1];
-    }
-  }
-
-  b_m = (nNaNs - 1) >> 1;
-  for (k = 1; k <= b_m; k++) {
-    ib = idx->data[wOffset + k];
-    idx->data[wOffset + k] = idx->data[n - k];
-    idx->data[n - k] = ib;
-    b_x->data[wOffset + k] = xwork->data[n - k];
-    b_x->data[n - k] = xwork->data[wOffset + k];
-  }
-
-  if (((nNaNs - 1) & 1) != 0) {
-    b_x->data[(wOffset + b_m) + 1] = xwork->data[(wOffset + b_m) + 1];
-  }
-
-  nNonNaN = (x->size[0] - nNaNs) + 1;
-  b_m = 2;
-  if (nNonNaN > 1) {
-    if (x->size[0] >= 256) {
-      nBlocks = nNonNaN >> 8;
-      if (nBlocks > 0) {
-        for (i3 = 1; i3 <= nBlocks; i3++) {
-          i4 = ((i3 - 1) << 8) - 1;
-          for (nNaNs = 0; nNaNs < 6; nNaNs++) {
-            n = 1 << (nNaNs + 2);
-            bLen2 = n << 1;
-            nPairs = 256 >> (nNaNs + 3);
-            for (k = 1; k <= nPairs; k++) {
-              b_m = i4 + (k - 1) * bLen2;
-              for (ib = 1; ib <= bLen2; ib++) {
-                b_iwork[ib - 1] = idx->data[b_m + ib];
-                b_xwork[ib - 1] = b_x->data[b_m + ib];
-              }
-
-              wOffset = 0;
-              ib = n;
-              do {
-                exitg1 = 0;
-                b_m++;
-                if (b_xwork[wOffset] <= b_xwork[ib]) {
-                  idx->data[b_m] = b_iwork[wOffset];
-                  b_x->data[b_m] = b_xwork[wOffset];
-                  if (wOffset + 1 < n) {
-                    wOffset++;
-                  } else {
-                    exitg1 = 1;
-                  }
-                } else {
-                  idx->data[b_m] = b_iwork[ib];
-                  b_x->data[b_m] = b_xwork[ib];
-                  if (ib + 1 < bLen2) {
-                    ib++;
-                  } else {
-                    ib = b_m - wOffset;
-                    while (wOffset + 1 <= n) {
-                      idx->data[(ib + wOffset) + 1] = b_iwork[wOffset];
-                      b_x->data[(ib + wOffset) + 1] = b_xwork[wOffset];
-                      wOffset++;
-                    }
-
-                    exitg1 = 1;
-                  }
-                }
-              } while (exitg1 == 0);
-            }
-          }
-        }
-
-        b_m = nBlocks << 8;
-        ib = nNonNaN - b_m;
-        if (ib > 0) {
-          merge_block(idx, b_x, b_m, ib, 2, iwork, xwork);
-        }
-
-        b_m = 8;
-      }
-    }
-
-    merge_block(idx, b_x, 0, nNonNaN, b_m, iwork, xwork);
-  }
-
-  emxFree_real_T(&xwork);
-  emxFree_int32_T(&iwork);
-  wOffset = x->size[0];
-  x->size[0] = b_x->size[0];
-  emxEnsureCapacity((emxArray__common *)x, wOffset, (int)sizeof(double));
-  b_m = b_x->size[0];
-  for (wOffset = 0; wOffset < b_m; wOffset++) {
-    x->data[wOffset] = b_x->data[wOffset];
-  }
-
-  emxFree_real_T(&b_x);
-}
-
 //
 // Arguments    : const double A[36]
 //                double U[6]
@@ -17124,7 +13820,9 @@ static void svd(const double A[36], double U[6])
 // the calibration cameraparams
 //    Undistort a point or set of points from one camera. Depending on the
 //    camera model used to calibrate the camera, the appropriate undistortion
-//    is applied
+//    is applied. The model is dispatched once for all points, the per point
+//    math is the camera_model instantiation of that model. If a lookup
+//    table built for this calibration is registered, it replaces the model.
 // Arguments    : const double pt_d_data[]
 //                const int pt_d_size[1]
 //                int cameraparams_ATAN
@@ -17132,6 +13830,7 @@ static void svd(const double A[36], double U[6])
 //                const double cameraparams_PrincipalPoint[2]
 //                const double cameraparams_RadialDistortion[3]
 //                int cameraparams_DistortionModel
+//                const UndistortionMap *undistortion_map
 //                double pt_u_data[]
 //                int pt_u_size[1]
 // Return Type  : void
@@ -17139,369 +13838,55 @@ static void svd(const double A[36], double U[6])
 static void undistortPoint(const double pt_d_data[], const int pt_d_size[1], int
   cameraparams_ATAN, const double cameraparams_FocalLength[2], const double
   cameraparams_PrincipalPoint[2], const double cameraparams_RadialDistortion[3],
-  int cameraparams_DistortionModel, double pt_u_data[], int pt_u_size[1])
+  int cameraparams_DistortionModel, const UndistortionMap *undistortion_map,
+  double pt_u_data[], int pt_u_size[1])
 {
-  int loop_ub;
-  int i12;
-  double fx;
-  double fy;
-  double Cx;
-  double Cy;
-  double k1;
-  double k2;
-  double k3;
-  double d1;
-  int i;
-  double pt_d_n[2];
-  double r_d_sq;
-  double r_u_sq;
-  int b_i;
-  int c_i;
-  boolean_T exitg1;
-  double a;
-  double b_a;
-  double c_a;
-  double diff;
-  char cv6[48];
+  camera_model::UndistortionReport<double> report;
   static const char cv7[48] = { 'P', 'i', 'x', 'e', 'l', ' ', 'r', 'a', 'd', 'i',
     'u', 's', ' ', 'i', 'n', 'v', 'e', 'r', 's', 'i', 'o', 'n', ':', ' ', 'R',
     'e', 'a', 'c', 'h', 'e', 'd', ' ', 'i', 't', 'e', 'r', 'a', 't', 'i', 'o',
     'n', ' ', 'l', 'i', 'm', 'i', 't', '\x00' };
 
-  char cv8[52];
   static const char cv9[52] = { 'n', 'e', 'g', 'a', 't', 'i', 'v', 'e', ' ', 'u',
     'n', 'd', 'i', 's', 't', 'o', 'r', 't', 'e', 'd', ' ', 'r', 'a', 'd', 'i',
     'u', 's', '.', ' ', 'r', 'd', '_', 's', 'q', ' ', '=', ' ', '%', 'f', ',',
     ' ', 'r', 'u', '_', 's', 'q', ' ', '=', ' ', '%', 'f', '\x00' };
 
-  double coeff;
+  pt_u_size[0] = pt_d_size[0];
 
-  // 'undistortPoint:8' if cameraparams.DistortionModel == cameraparams.ATAN
-  if (cameraparams_DistortionModel == cameraparams_ATAN) {
+  if ((undistortion_map != NULL) && undistortion_map->matches
+      (cameraparams_FocalLength, cameraparams_PrincipalPoint,
+       cameraparams_RadialDistortion, cameraparams_DistortionModel)) {
+    undistortion_map->undistortPoints(pt_d_data, pt_d_size[0] / 2, pt_u_data,
+      report);
+  } else if (cameraparams_DistortionModel == cameraparams_ATAN) {
+    // 'undistortPoint:8' if cameraparams.DistortionModel == cameraparams.ATAN
     // 'undistortPoint:9' pt_u = undistortPointAtan(pt_d, cameraparams);
-    undistortPointAtan(pt_d_data, pt_d_size, cameraparams_FocalLength,
-                       cameraparams_PrincipalPoint,
-                       cameraparams_RadialDistortion, pt_u_data, pt_u_size);
+    camera_model::undistortPoints(camera_model::Atan<double>
+      (cameraparams_FocalLength, cameraparams_PrincipalPoint,
+       cameraparams_RadialDistortion), pt_d_data, pt_d_size[0] / 2, pt_u_data,
+      report);
   } else {
     // 'undistortPoint:10' else
     // 'undistortPoint:11' pt_u = undistortPointPB(pt_d, cameraparams);
-    // % Plumb Bob
-    // 'undistortPoint:58' if mod(length(pt_d), 2)
-    // 'undistortPoint:62' pt_u = pt_d;
-    pt_u_size[0] = pt_d_size[0];
-    loop_ub = pt_d_size[0];
-    for (i12 = 0; i12 < loop_ub; i12++) {
-      pt_u_data[i12] = pt_d_data[i12];
-    }
-
-    // 'undistortPoint:64' fx = cameraParameters.FocalLength(1);
-    fx = cameraparams_FocalLength[0];
-
-    // 'undistortPoint:65' fy = cameraParameters.FocalLength(2);
-    fy = cameraparams_FocalLength[1];
-
-    // 'undistortPoint:66' Cx = cameraParameters.PrincipalPoint(1);
-    Cx = cameraparams_PrincipalPoint[0];
-
-    // 'undistortPoint:67' Cy = cameraParameters.PrincipalPoint(2);
-    Cy = cameraparams_PrincipalPoint[1];
-
-    // 'undistortPoint:68' k1 = cameraParameters.RadialDistortion(1);
-    k1 = cameraparams_RadialDistortion[0];
-
-    // 'undistortPoint:69' k2 = cameraParameters.RadialDistortion(2);
-    k2 = cameraparams_RadialDistortion[1];
-
-    // 'undistortPoint:70' k3 = cameraParameters.RadialDistortion(3);
-    k3 = cameraparams_RadialDistortion[2];
-
-    // 'undistortPoint:72' for i = 1:length(pt_d)/2
-    d1 = (double)pt_d_size[0] / 2.0;
-    for (i = 0; i < (int)d1; i++) {
-      // 'undistortPoint:74' pt_d_n = [(pt_d((i-1)*2 + 1)-Cx)/fx;
-      // 'undistortPoint:75'     (pt_d((i-1)*2 + 2)-Cy)/fy];
-      pt_d_n[0] = (pt_d_data[i << 1] - Cx) / fx;
-      pt_d_n[1] = (pt_d_data[(i << 1) + 1] - Cy) / fy;
-
-      // 'undistortPoint:77' r_d_sq = pt_d_n(1)^2 + pt_d_n(2)^2;
-      r_d_sq = pt_d_n[0] * pt_d_n[0] + pt_d_n[1] * pt_d_n[1];
-
-      // 'undistortPoint:78' r_u_sq = get_r_u(k1, k2, k3, r_d_sq);
-      // get_r_u Get undistorted radius from distorted radius
-      //    Get the pixel radius of the undistorted pixels from a distorted pixel 
-      //    radius and distortion parameters
-      // 'get_r_u:5' x = rd_sq;
-      r_u_sq = r_d_sq;
-
-      // 'get_r_u:6' thresh = 1e-6;
-      // 'get_r_u:8' for i = 1:100
-      b_i = 1;
-      c_i = 0;
-      exitg1 = false;
-      while ((!exitg1) && (c_i < 100)) {
-        b_i = c_i + 1;
-
-        // 'get_r_u:9' f_x = x * (1 + k1*x + k2*x^2 + k3*x^3)^2 - rd_sq;
-        a = ((1.0 + k1 * r_u_sq) + k2 * (r_u_sq * r_u_sq)) + k3 * rt_powd_snf
-          (r_u_sq, 3.0);
-
-        // 'get_r_u:10' f_prime_x = (1 + k1*x + k2*x^2 + k3*x^3)^2 + 2*x*(1 + k1*x + k2*x^2 + k3*x^3)^2*(k1 + 2*k2*x + 2*k3*x^2); 
-        b_a = ((1.0 + k1 * r_u_sq) + k2 * (r_u_sq * r_u_sq)) + k3 * rt_powd_snf
-          (r_u_sq, 3.0);
-        c_a = ((1.0 + k1 * r_u_sq) + k2 * (r_u_sq * r_u_sq)) + k3 * rt_powd_snf
-          (r_u_sq, 3.0);
-
-        // 'get_r_u:13' diff = f_x / f_prime_x;
-        diff = (r_u_sq * (a * a) - r_d_sq) / (b_a * b_a + 2.0 * r_u_sq * (c_a *
-          c_a) * ((k1 + 2.0 * k2 * r_u_sq) + 2.0 * k3 * (r_u_sq * r_u_sq)));
-
-        // 'get_r_u:14' x = x - diff;
-        r_u_sq -= diff;
-
-        // 'get_r_u:15' if diff < thresh && diff > -thresh
-        if ((diff < 1.0E-6) && (diff > -1.0E-6)) {
-          exitg1 = true;
-        } else {
-          c_i++;
-        }
-      }
-
-      // 'get_r_u:20' if i == 100
-      if ((b_i == 100) && (debug_level >= 2.0)) {
-        // 'get_r_u:21' log_warn('Pixel radius inversion: Reached iteration limit') 
-        // log_warn Print to console in Matlab
-        //  in C++, vio_logging.h needs to be created to define what LOG_WARN does, 
-        //  e.g. redefine ROS_WARN
-        //  debug_level == 0: print errors, == 1: print warnings, == 2: print info 
-        // 'log_warn:8' if coder.target('MATLAB')
-        // 'log_warn:12' elseif ~coder.target('MEX')
-        // 'log_warn:13' coder.cinclude('<vio_logging.h>')
-        // 'log_warn:14' if debug_level >= 2
-        // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-        for (i12 = 0; i12 < 48; i12++) {
-          cv6[i12] = cv7[i12];
-        }
-
-        LOG_WARN(cv6);
-      }
-
-      // 'get_r_u:24' if x < 0
-      if ((r_u_sq < 0.0) && (debug_level >= 2.0)) {
-        // 'get_r_u:25' log_warn('negative undistorted radius. rd_sq = %f, ru_sq = %f', rd_sq, x); 
-        // log_warn Print to console in Matlab
-        //  in C++, vio_logging.h needs to be created to define what LOG_WARN does, 
-        //  e.g. redefine ROS_WARN
-        //  debug_level == 0: print errors, == 1: print warnings, == 2: print info 
-        // 'log_warn:8' if coder.target('MATLAB')
-        // 'log_warn:12' elseif ~coder.target('MEX')
-        // 'log_warn:13' coder.cinclude('<vio_logging.h>')
-        // 'log_warn:14' if debug_level >= 2
-        // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-        for (i12 = 0; i12 < 52; i12++) {
-          cv8[i12] = cv9[i12];
-        }
-
-        LOG_WARN(cv8, r_d_sq, r_u_sq);
-      }
-
-      // 'undistortPoint:80' coeff = (1 + k1*r_u_sq + k2*r_u_sq^2 + k3*r_u_sq^3); 
-      coeff = ((1.0 + k1 * r_u_sq) + k2 * (r_u_sq * r_u_sq)) + k3 * rt_powd_snf
-        (r_u_sq, 3.0);
-
-      // 'undistortPoint:82' pt_u_n = pt_d_n / coeff;
-      for (i12 = 0; i12 < 2; i12++) {
-        pt_d_n[i12] /= coeff;
-      }
-
-      // 'undistortPoint:84' pt_u((i-1)*2 + (1:2)) = [pt_u_n(1)*fx + Cx; pt_u_n(2)*fy + Cy]; 
-      b_i = i << 1;
-      pt_u_data[b_i] = pt_d_n[0] * fx + Cx;
-      pt_u_data[1 + b_i] = pt_d_n[1] * fy + Cy;
-    }
-  }
-}
-
-//
-// Arguments    : const double pt_d_data[]
-//                const int pt_d_size[1]
-//                const double cameraparams_FocalLength[2]
-//                const double cameraparams_PrincipalPoint[2]
-//                const double cameraparams_RadialDistortion[3]
-//                double pt_u_data[]
-//                int pt_u_size[1]
-// Return Type  : void
-//
-static void undistortPointAtan(const double pt_d_data[], const int pt_d_size[1],
-  const double cameraparams_FocalLength[2], const double
-  cameraparams_PrincipalPoint[2], const double cameraparams_RadialDistortion[3],
-  double pt_u_data[], int pt_u_size[1])
-{
-  int rankR;
-  int i13;
-  double fx;
-  double fy;
-  double Cx;
-  double Cy;
-  double d2;
-  int i;
-  double pt_d_n[2];
-  double r_d;
-  double x[3];
-  double b_x[3];
-  double A[3];
-  double xnorm;
-  double atmp;
-  double tau;
-  int knt;
-  double r_u;
-
-  // % Atan
-  // 'undistortPoint:20' if mod(length(pt_d), 2)
-  // 'undistortPoint:24' pt_u = pt_d;
-  pt_u_size[0] = pt_d_size[0];
-  rankR = pt_d_size[0];
-  for (i13 = 0; i13 < rankR; i13++) {
-    pt_u_data[i13] = pt_d_data[i13];
+    camera_model::undistortPoints(camera_model::PlumbBob<double>
+      (cameraparams_FocalLength, cameraparams_PrincipalPoint,
+       cameraparams_RadialDistortion), pt_d_data, pt_d_size[0] / 2, pt_u_data,
+      report);
   }
 
-  // 'undistortPoint:26' fx = cameraparams.FocalLength(1);
-  fx = cameraparams_FocalLength[0];
-
-  // 'undistortPoint:27' fy = cameraparams.FocalLength(2);
-  fy = cameraparams_FocalLength[1];
-
-  // 'undistortPoint:28' Cx = cameraparams.PrincipalPoint(1);
-  Cx = cameraparams_PrincipalPoint[0];
-
-  // 'undistortPoint:29' Cy = cameraparams.PrincipalPoint(2);
-  Cy = cameraparams_PrincipalPoint[1];
-
-  // 'undistortPoint:30' w  = cameraparams.RadialDistortion;
-  // 'undistortPoint:32' for i = 1:length(pt_d)/2
-  d2 = (double)pt_d_size[0] / 2.0;
-  for (i = 0; i < (int)d2; i++) {
-    // 'undistortPoint:34' pt_d_n = [(pt_d((i-1)*2 + 1)-Cx)/fx;
-    // 'undistortPoint:35'     (pt_d((i-1)*2 + 2)-Cy)/fy];
-    pt_d_n[0] = (pt_d_data[i << 1] - Cx) / fx;
-    pt_d_n[1] = (pt_d_data[(i << 1) + 1] - Cy) / fy;
-
-    // 'undistortPoint:37' r_d = sqrt(pt_d_n(1)^2 + pt_d_n(2)^2);
-    r_d = sqrt(pt_d_n[0] * pt_d_n[0] + pt_d_n[1] * pt_d_n[1]);
-
-    // 'undistortPoint:39' if r_d > 0.001
-    if (r_d > 0.001) {
-      // 'undistortPoint:40' r_u = tan(r_d * w)/(2*tan(w/2));
-      for (rankR = 0; rankR < 3; rankR++) {
-        xnorm = 2.0 * tan(cameraparams_RadialDistortion[rankR] / 2.0);
-        A[rankR] = xnorm;
-        x[rankR] = tan(r_d * cameraparams_RadialDistortion[rankR]);
-        b_x[rankR] = xnorm;
-      }
-
-      atmp = b_x[0];
-      tau = 0.0;
-      xnorm = xnrm2(b_x);
-      if (xnorm != 0.0) {
-        xnorm = hypot(b_x[0], xnorm);
-        if (b_x[0] >= 0.0) {
-          xnorm = -xnorm;
-        }
-
-        if (fabs(xnorm) < 1.0020841800044864E-292) {
-          knt = 0;
-          do {
-            knt++;
-            for (rankR = 0; rankR < 2; rankR++) {
-              A[rankR + 1] *= 9.9792015476736E+291;
-            }
-
-            xnorm *= 9.9792015476736E+291;
-            atmp *= 9.9792015476736E+291;
-          } while (!(fabs(xnorm) >= 1.0020841800044864E-292));
-
-          xnorm = hypot(atmp, xnrm2(A));
-          if (atmp >= 0.0) {
-            xnorm = -xnorm;
-          }
-
-          tau = (xnorm - atmp) / xnorm;
-          atmp = 1.0 / (atmp - xnorm);
-          for (rankR = 0; rankR < 2; rankR++) {
-            A[rankR + 1] *= atmp;
-          }
-
-          for (rankR = 1; rankR <= knt; rankR++) {
-            xnorm *= 1.0020841800044864E-292;
-          }
-
-          atmp = xnorm;
-        } else {
-          tau = (xnorm - b_x[0]) / xnorm;
-          atmp = 1.0 / (b_x[0] - xnorm);
-          for (rankR = 0; rankR < 2; rankR++) {
-            A[rankR + 1] *= atmp;
-          }
-
-          atmp = xnorm;
-        }
-      }
-
-      A[0] = atmp;
-      rankR = 0;
-      xnorm = 3.0 * fabs(atmp) * 2.2204460492503131E-16;
-      while ((rankR < 1) && (fabs(atmp) >= xnorm)) {
-        rankR = 1;
-      }
+  // 'get_r_u:20' if i == 100
+  if ((report.iteration_limit > 0) && (debug_level >= 2.0)) {
+    // 'get_r_u:21' log_warn('Pixel radius inversion: Reached iteration limit') 
 
-      r_u = 0.0;
-      for (i13 = 0; i13 < 3; i13++) {
-        b_x[i13] = x[i13];
-      }
-
-      if (tau != 0.0) {
-        xnorm = x[0];
-        for (knt = 0; knt < 2; knt++) {
-          xnorm += A[knt + 1] * x[knt + 1];
-        }
-
-        xnorm *= tau;
-        if (xnorm != 0.0) {
-          b_x[0] = x[0] - xnorm;
-          for (knt = 0; knt < 2; knt++) {
-            b_x[knt + 1] -= A[knt + 1] * xnorm;
-          }
-        }
-      }
-
-      knt = 1;
-      while (knt <= rankR) {
-        r_u = b_x[0];
-        knt = 2;
-      }
-
-      while (rankR > 0) {
-        r_u /= atmp;
-        rankR = 0;
-      }
+    LOG_WARN(cv7);
+  }
 
-      // 'undistortPoint:42' pt_u_n = pt_d_n*r_u/r_d;
-      for (i13 = 0; i13 < 2; i13++) {
-        pt_d_n[i13] = pt_d_n[i13] * r_u / r_d;
-      }
+  // 'get_r_u:24' if x < 0
+  if ((report.negative_radius > 0) && (debug_level >= 2.0)) {
+    // 'get_r_u:25' log_warn('negative undistorted radius. rd_sq = %f, ru_sq = %f', rd_sq, x); 
 
-      // 'undistortPoint:43' pt_u((i-1)*2 + (1:2)) = [pt_u_n(1)*fx + Cx; pt_u_n(2)*fy + Cy]; 
-      knt = i << 1;
-      pt_u_data[knt] = pt_d_n[0] * fx + Cx;
-      pt_u_data[1 + knt] = pt_d_n[1] * fy + Cy;
-    } else {
-      // 'undistortPoint:45' else
-      // 'undistortPoint:46' pt_u((i-1)*2 + (1:2)) = pt_d((i-1)*2 + (1:2));
-      knt = i << 1;
-      rankR = i << 1;
-      for (i13 = 0; i13 < 2; i13++) {
-        pt_u_data[i13 + rankR] = pt_d_data[i13 + knt];
-      }
-    }
+    LOG_WARN(cv9, report.rd_sq, report.ru_sq);
   }
 }
 
@@ -17977,34 +14362,6 @@ static void xgetrf(int b_m, int n, emxArray_real_T *A, int lda, emxArray_int32_T
   *info = b_info;
 }
 
-//
-// Arguments    : const double x[3]
-// Return Type  : double
-//
-static double xnrm2(const double x[3])
-{
-  double y;
-  double scale;
-  int k;
-  double absxk;
-  double t;
-  y = 0.0;
-  scale = 2.2250738585072014E-308;
-  for (k = 0; k < 2; k++) {
-    absxk = fabs(x[k + 1]);
-    if (absxk > scale) {
-      t = scale / absxk;
-      y = 1.0 + y * t * t;
-      scale = absxk;
-    } else {
-      t = absxk / scale;
-      y += t * t;
-    }
-  }
-
-  return scale * sqrt(y);
-}
-
 //
 // Arguments    : double *a
 //                double *b
@@ -18091,6 +14448,7 @@ static void xscal(int n, double a, emxArray_real_T *x, int ix0)
 //                const VIOParameters *b_VIOParameters
 //                boolean_T vision
 //                boolean_T reset
+//                int outputs
 //                RobotState *xt_out
 //                double map_out[144]
 //                AnchorPose anchor_poses_out[6]
@@ -18101,8 +14459,8 @@ void SLAM(int updateVect[48], const double z_all_l[96], const double z_all_r[96]
           double dt, const VIOMeasurements *measurements, const DUOParameters
           *cameraParameters, const NoiseParameters *noiseParameters, const
           VIOParameters *b_VIOParameters, boolean_T vision, boolean_T reset,
-          RobotState *xt_out, double map_out[144], AnchorPose anchor_poses_out[6],
-          double delayedStatus_out[48])
+          int outputs, RobotState *xt_out, double map_out[144], AnchorPose
+          anchor_poses_out[6], double delayedStatus_out[48])
 {
   int i;
   static const signed char iv1[4] = { 0, 0, 0, 1 };
@@ -18196,6 +14554,11 @@ void SLAM(int updateVect[48], const double z_all_l[96], const double z_all_r[96]
   // 'SLAM:22' assert ( all ( size (dt) == [1] ) )
   // 'SLAM:23' assert(isa(vision,'logical'));
   // 'SLAM:24' assert(isa(reset,'logical'));
+  //  the telemetry describes the last vision update
+  if (vision) {
+    memset(&telemetry, 0, sizeof(VIOTelemetry));
+  }
+
   // 'SLAM:28' if isempty(initialized) || reset
   if ((!initialized_not_empty) || reset) {
     // 'SLAM:29' initialized = [];
@@ -18472,45 +14835,55 @@ void SLAM(int updateVect[48], const double z_all_l[96], const double z_all_r[96]
                cameraParameters->r_lr, cameraParameters->R_lr,
                cameraParameters->R_rl, updateVect, b_z_all_l, b_z_all_r,
                noiseParameters->image_noise,
-               noiseParameters->inv_depth_initial_unc, *b_VIOParameters, map,
+               noiseParameters->inv_depth_initial_unc, *b_VIOParameters,
                delayedStatus);
     }
   }
 
-  // 'SLAM:109' map_out = map;
-  memcpy(&map_out[0], &map[0], 144U * sizeof(double));
+  //  only the requested outputs are computed, the others are left as they are
+  if ((outputs & SLAM_OUTPUT_ROBOT_STATE) != 0) {
+    // 'SLAM:110' xt_out = getWorldState(xt);
+    getWorldState(xt.robot_state.IMU.pos, xt.robot_state.IMU.att,
+                  xt.robot_state.IMU.gyro_bias, xt.robot_state.IMU.acc_bias,
+                  xt.robot_state.pos, xt.robot_state.att, xt.robot_state.vel,
+                  xt.origin.pos, xt.origin.att, b_y_n_b, t0_att, t0_vel,
+                  t0_IMU_gyro_bias, t0_IMU_acc_bias, t0_IMU_pos, t0_IMU_att);
+    for (i = 0; i < 3; i++) {
+      xt_out->pos[i] = b_y_n_b[i];
+    }
 
-  // 'SLAM:110' xt_out = getWorldState(xt);
-  getWorldState(xt.robot_state.IMU.pos, xt.robot_state.IMU.att,
-                xt.robot_state.IMU.gyro_bias, xt.robot_state.IMU.acc_bias,
-                xt.robot_state.pos, xt.robot_state.att, xt.robot_state.vel,
-                xt.origin.pos, xt.origin.att, b_y_n_b, t0_att, t0_vel,
-                t0_IMU_gyro_bias, t0_IMU_acc_bias, t0_IMU_pos, t0_IMU_att);
-  for (i = 0; i < 3; i++) {
-    xt_out->pos[i] = b_y_n_b[i];
-  }
+    for (i = 0; i < 4; i++) {
+      xt_out->att[i] = t0_att[i];
+    }
 
-  for (i = 0; i < 4; i++) {
-    xt_out->att[i] = t0_att[i];
-  }
+    for (i = 0; i < 3; i++) {
+      xt_out->vel[i] = t0_vel[i];
+      xt_out->IMU.gyro_bias[i] = t0_IMU_gyro_bias[i];
+      xt_out->IMU.acc_bias[i] = t0_IMU_acc_bias[i];
+      xt_out->IMU.pos[i] = t0_IMU_pos[i];
+    }
 
-  for (i = 0; i < 3; i++) {
-    xt_out->vel[i] = t0_vel[i];
-    xt_out->IMU.gyro_bias[i] = t0_IMU_gyro_bias[i];
-    xt_out->IMU.acc_bias[i] = t0_IMU_acc_bias[i];
-    xt_out->IMU.pos[i] = t0_IMU_pos[i];
+    for (i = 0; i < 4; i++) {
+      xt_out->IMU.att[i] = t0_IMU_att[i];
+    }
   }
 
-  for (i = 0; i < 4; i++) {
-    xt_out->IMU.att[i] = t0_IMU_att[i];
+  if ((outputs & SLAM_OUTPUT_MAP) != 0) {
+    // 'SLAM:109' map_out = map;
+    getMap(xt.origin.pos, xt.origin.att, xt.anchor_states, map);
+    memcpy(&map_out[0], &map[0], 144U * sizeof(double));
   }
 
-  // 'SLAM:111' anchor_poses_out = getAnchorPoses(xt);
-  getAnchorPoses(xt.origin.pos, xt.origin.att, xt.anchor_states, rv1);
-  cast(rv1, anchor_poses_out);
+  if ((outputs & SLAM_OUTPUT_ANCHOR_POSES) != 0) {
+    // 'SLAM:111' anchor_poses_out = getAnchorPoses(xt);
+    getAnchorPoses(xt.origin.pos, xt.origin.att, xt.anchor_states, rv1);
+    cast(rv1, anchor_poses_out);
+  }
 
-  // 'SLAM:112' delayedStatus_out = delayedStatus;
-  memcpy(&delayedStatus_out[0], &delayedStatus[0], 48U * sizeof(double));
+  if ((outputs & SLAM_OUTPUT_DELAYED_STATUS) != 0) {
+    // 'SLAM:112' delayedStatus_out = delayedStatus;
+    memcpy(&delayedStatus_out[0], &delayedStatus[0], 48U * sizeof(double));
+  }
 
   //  output
   //  coder.cstructname(xt_out, 'RobotState');
@@ -18525,6 +14898,135 @@ void SLAM(int updateVect[48], const double z_all_l[96], const double z_all_r[96]
   // 'SLAM:126' assert ( all ( size (delayedStatus_out) == [numTrackFeatures 1] ) ) 
 }
 
+//
+// SLAM_setUndistortionMaps Register lookup tables that replace the
+// undistortion of the left and right camera. A map is only used while it
+// matches the calibration in the cameraParameters, NULL disables it.
+// Arguments    : const UndistortionMap *map_l
+//                const UndistortionMap *map_r
+// Return Type  : void
+//
+void SLAM_setUndistortionMaps(const UndistortionMap *map_l, const
+  UndistortionMap *map_r)
+{
+  undistortionMap_l = map_l;
+  undistortionMap_r = map_r;
+}
+
+//
+// Arguments    : unsigned char dst[]
+//                const void *src
+//                int n
+// Return Type  : int
+//
+static int copyStateSection(unsigned char dst[], const void *src, int n)
+{
+  int padded;
+
+  // sections are 8 byte aligned so the state can be used in place when mapped
+  padded = (n + 7) & ~7;
+  memcpy(&dst[0], src, (unsigned int)n);
+  memset(&dst[n], 0, (unsigned int)(padded - n));
+  return padded;
+}
+
+//
+// SLAM_anchorUncertainty Scalar uncertainty of the covariance block of an
+// anchor pose, the origin anchor is chosen as the anchor that minimizes it.
+// metric selects one of the VIOParameters::ANCHOR_METRIC measures, the
+// spectral norm is the default. The power iteration approximates it without
+// the SVD.
+// Arguments    : const double P_anchor[36]
+//                int metric
+// Return Type  : double
+//
+double SLAM_anchorUncertainty(const double P_anchor[36], int metric)
+{
+  double y;
+  switch (metric) {
+   case VIOParameters::ANCHOR_METRIC_TRACE:
+    y = small_matrix::trace<6>(P_anchor);
+    break;
+
+   case VIOParameters::ANCHOR_METRIC_FROBENIUS:
+    y = small_matrix::frobeniusNorm<6>(P_anchor);
+    break;
+
+   case VIOParameters::ANCHOR_METRIC_POWER:
+    y = small_matrix::spectralNormPower<6>(P_anchor, 8);
+    break;
+
+   default:
+    y = d_norm(P_anchor);
+    break;
+  }
+
+  return y;
+}
+
+//
+// SLAM_getStateSize Size in bytes of the persistent filter state written by
+// SLAM_getState: the initialization flag, xt, P, map and delayedStatus.
+// Arguments    : void
+// Return Type  : int
+//
+int SLAM_getStateSize()
+{
+  return (int)(8 + ((sizeof(xt) + 7) & ~7) + ((sizeof(P) + 7) & ~7) + ((sizeof
+    (map) + 7) & ~7) + ((sizeof(delayedStatus) + 7) & ~7));
+}
+
+//
+// SLAM_getTelemetry Copy the telemetry of the last vision update.
+// Arguments    : VIOTelemetry *telemetry_out
+// Return Type  : void
+//
+void SLAM_getTelemetry(VIOTelemetry *telemetry_out)
+{
+  *telemetry_out = telemetry;
+}
+
+//
+// SLAM_getState Copy the persistent filter state into state, which must hold
+// SLAM_getStateSize() bytes.
+// Arguments    : unsigned char state[]
+// Return Type  : void
+//
+void SLAM_getState(unsigned char state[])
+{
+  int offset;
+  memset(&state[0], 0, 8U);
+  state[0] = (unsigned char)initialized_not_empty;
+  offset = 8;
+  offset += copyStateSection(&state[offset], &xt, (int)sizeof(xt));
+  offset += copyStateSection(&state[offset], P, (int)sizeof(P));
+  offset += copyStateSection(&state[offset], map, (int)sizeof(map));
+  copyStateSection(&state[offset], delayedStatus, (int)sizeof(delayedStatus));
+}
+
+//
+// SLAM_setState Replace the persistent filter state with one written by
+// SLAM_getState of the same build.
+// Arguments    : const unsigned char state[]
+// Return Type  : void
+//
+void SLAM_setState(const unsigned char state[])
+{
+  int offset;
+  initialized_not_empty = (state[0] != 0);
+  initialized.size[0] = (int)initialized_not_empty;
+  initialized.size[1] = (int)initialized_not_empty;
+  initialized.data[0] = 1.0;
+  offset = 8;
+  memcpy(&xt, &state[offset], sizeof(xt));
+  offset += (sizeof(xt) + 7) & ~7;
+  memcpy(P, &state[offset], sizeof(P));
+  offset += (sizeof(P) + 7) & ~7;
+  memcpy(map, &state[offset], sizeof(map));
+  offset += (sizeof(map) + 7) & ~7;
+  memcpy(delayedStatus, &state[offset], sizeof(delayedStatus));
+}
+
 //
 // Arguments    : void
 // Return Type  : void
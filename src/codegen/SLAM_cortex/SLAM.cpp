@@ -13,6 +13,11 @@
 #include "SLAM.h"
 #include <stdio.h>
 #include <vio_logging.h>
+#include "CameraModel.h"
+#include "SmallMatrix.h"
+#include "SortingNetwork.h"
+#include "Triangulation.h"
+#include "UndistortionMap.h"
 
 // Custom Source Code
 //***************************************************************************
@@ -162,6 +167,9 @@ static float P[10404];
 static float map[144];
 static float delayedStatus[48];
 static float debug_level;
+static const UndistortionMap *undistortionMap_l;
+static const UndistortionMap *undistortionMap_r;
+static VIOTelemetry telemetry;
 
 // Function Declarations
 static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
@@ -171,8 +179,8 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
   f_stereoParams_CameraParameters[2], const float stereoParams_r_lr[3], const
   float stereoParams_R_rl[9], float noiseParameters_image_noise, int
   c_VIOParameters_max_ekf_iterati, boolean_T c_VIOParameters_delayed_initial,
-  boolean_T VIOParameters_full_stereo, boolean_T VIOParameters_RANSAC, int
-  updateVect[48]);
+  boolean_T VIOParameters_full_stereo, boolean_T VIOParameters_RANSAC, float
+  c_VIOParameters_jacobian_reuse_, int updateVect[48]);
 static void SLAM_free();
 static void SLAM_init();
 static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
@@ -191,11 +199,10 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
                      z_all_l[96], float z_all_r[96], float
                      noiseParameters_image_noise, float
                      c_noiseParameters_inv_depth_ini, const VIOParameters
-                     b_VIOParameters, float b_map[144], float b_delayedStatus[48]);
+                     b_VIOParameters, float b_delayedStatus[48]);
 static boolean_T any(const boolean_T x[48]);
 static boolean_T anyActiveAnchorFeatures(const e_struct_T
   anchor_state_feature_states[8]);
-static boolean_T b_any(const boolean_T x[3]);
 static double b_fprintf();
 static void b_getH_R_res(const float xt_robot_state_pos[3], const float
   xt_robot_state_att[4], const f_struct_T xt_anchor_states[6], const float
@@ -209,32 +216,25 @@ static void b_getH_R_res(const float xt_robot_state_pos[3], const float
 static void b_log_error();
 static void b_log_info(int varargin_1, int varargin_2, int varargin_3);
 static void b_log_warn();
-static void b_merge(emxArray_int32_T *idx, emxArray_real32_T *x, int offset, int
-                    np, int nq, emxArray_int32_T *iwork, emxArray_real32_T
-                    *xwork);
 static float b_norm(const float x[4]);
-static void b_sort(float x[8], int idx[8]);
 static void b_xaxpy(int n, float a, const float x[36], int ix0, float y[6], int
                     iy0);
-static void b_xgeqp3(float A[30], float tau[5], int jpvt[5]);
 static float b_xnrm2(int n, const emxArray_real32_T *x, int ix0);
 static boolean_T c_any(const float x[6]);
 static double c_fprintf(float varargin_1);
 static void c_log_info(int varargin_1, int varargin_2);
 static void c_log_warn(int varargin_1, float varargin_2);
 static float c_norm(const float x[2]);
-static void c_sort(emxArray_real32_T *x, emxArray_int32_T *idx);
 static void c_xaxpy(int n, float a, const float x[6], int ix0, float y[36], int
                     iy0);
 static float c_xnrm2(int n, const emxArray_real32_T *x, int ix0);
 static void cast(const struct_T x[6], AnchorPose y[6]);
 static void cross(const float a[3], const float b[3], float c[3]);
+static int copyStateSection(unsigned char dst[], const void *src, int n);
 static double d_fprintf(float varargin_1);
 static void d_log_info(int varargin_1);
 static void d_log_warn(signed char varargin_1);
 static float d_norm(const float x[36]);
-static void d_sort(emxArray_real32_T *x, int dim, emxArray_int32_T *idx);
-static float d_xnrm2(int n, const float x[30], int ix0);
 static void diag(const float v[3], float d[9]);
 static int div_s32_floor(int numerator, int denominator);
 static double e_fprintf(float varargin_1);
@@ -246,7 +246,6 @@ static void emxEnsureCapacity(emxArray__common *emxArray, int oldNumel, int
   elementSize);
 static void emxFree_int32_T(emxArray_int32_T **pEmxArray);
 static void emxFree_real32_T(emxArray_real32_T **pEmxArray);
-static void emxInit_int32_T(emxArray_int32_T **pEmxArray, int b_numDimensions);
 static void emxInit_int32_T1(emxArray_int32_T **pEmxArray, int b_numDimensions);
 static void emxInit_real32_T(emxArray_real32_T **pEmxArray, int b_numDimensions);
 static void emxInit_real32_T1(emxArray_real32_T **pEmxArray, int b_numDimensions);
@@ -288,12 +287,6 @@ static double h_fprintf(float varargin_1, float varargin_2, float varargin_3);
 static void h_log_warn(int varargin_1);
 static double i_fprintf(float varargin_1, float varargin_2, float varargin_3);
 static void i_log_warn();
-static void initializePoint(const float z_u_l[2], const float z_u_r[2], const
-  float c_cameraparams_CameraParameters[2], const float
-  d_cameraparams_CameraParameters[2], const float
-  e_cameraparams_CameraParameters[2], const float
-  f_cameraparams_CameraParameters[2], const float cameraparams_r_lr[3], const
-  float cameraparams_R_lr[9], float fp[3], float b_m[6], boolean_T *success);
 static double j_fprintf(float varargin_1);
 static double k_fprintf(float varargin_1);
 static double l_fprintf(int varargin_1);
@@ -302,11 +295,6 @@ static void log_info(int varargin_1, int varargin_2, int varargin_3);
 static void log_warn(int varargin_1, int varargin_2, int varargin_3);
 static double m_fprintf(const char varargin_1_data[], const int varargin_1_size
   [2]);
-static float median(const float x_data[], const int x_size[1]);
-static void merge(int idx[8], float x[8], int offset, int np, int nq, int iwork
-                  [8], float xwork[8]);
-static void merge_block(emxArray_int32_T *idx, emxArray_real32_T *x, int offset,
-  int n, int preSortLevel, emxArray_int32_T *iwork, emxArray_real32_T *xwork);
 static int mul_s32_s32_s32_sat(int a, int b);
 static void mul_wide_s32(int in0, int in1, unsigned int *ptrOutBitsHi, unsigned
   int *ptrOutBitsLo);
@@ -339,20 +327,18 @@ static double q_fprintf(const char varargin_1_data[], const int varargin_1_size
 static void quatmultJ(const float q[4], const float p[4], float qp[4]);
 static int rankFromQR(const emxArray_real32_T *A);
 static void rdivide(const float x[3], float y, float z[3]);
-static void sort(float x[8], int idx[8]);
-static void sortIdx(emxArray_real32_T *x, emxArray_int32_T *idx);
 static void svd(const float A[36], float U[6]);
 static void undistortPoint(const float pt_d_data[], const int pt_d_size[1], int
   cameraparams_ATAN, const float cameraparams_FocalLength[2], const float
   cameraparams_PrincipalPoint[2], const float cameraparams_RadialDistortion[3],
-  int cameraparams_DistortionModel, float pt_u_data[], int pt_u_size[1]);
+  int cameraparams_DistortionModel, const UndistortionMap *undistortion_map,
+  float pt_u_data[], int pt_u_size[1]);
 static void xaxpy(int n, float a, int ix0, float y[36], int iy0);
 static float xdotc(int n, const float x[36], int ix0, const float y[36], int iy0);
 static void xgeqp3(emxArray_real32_T *A, emxArray_real32_T *tau,
                    emxArray_int32_T *jpvt);
 static void xgetrf(int b_m, int n, emxArray_real32_T *A, int lda,
                    emxArray_int32_T *ipiv, int *info);
-static float xnrm2(const float x[3]);
 static void xrotg(float *a, float *b, float *c, float *s);
 static void xscal(int n, float a, emxArray_real32_T *x, int ix0);
 
@@ -376,6 +362,7 @@ static void xscal(int n, float a, emxArray_real32_T *x, int ix0);
 //                boolean_T c_VIOParameters_delayed_initial
 //                boolean_T VIOParameters_full_stereo
 //                boolean_T VIOParameters_RANSAC
+//                float c_VIOParameters_jacobian_reuse_
 //                int updateVect[48]
 // Return Type  : void
 //
@@ -386,9 +373,13 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
   f_stereoParams_CameraParameters[2], const float stereoParams_r_lr[3], const
   float stereoParams_R_rl[9], float noiseParameters_image_noise, int
   c_VIOParameters_max_ekf_iterati, boolean_T c_VIOParameters_delayed_initial,
-  boolean_T VIOParameters_full_stereo, boolean_T VIOParameters_RANSAC, int
-  updateVect[48])
+  boolean_T VIOParameters_full_stereo, boolean_T VIOParameters_RANSAC, float
+  c_VIOParameters_jacobian_reuse_, int updateVect[48])
 {
+  boolean_T reuse_H;
+  boolean_T gated[48];
+  float x_it_prev[102];
+  float dx_norm;
   int residualDim;
   int mahalanobis_thresh;
   float LI_residual_thresh;
@@ -397,6 +388,7 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
   boolean_T delayedFeatures[48];
   int anchorIdx;
   int featureIdx;
+  int feature_cols[13];
   boolean_T LI_inlier_status[48];
   emxArray_real32_T *S;
   emxArray_real32_T *K;
@@ -917,20 +909,7 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
   emxArray_real32_T *c_S;
   emxArray_real32_T *d_H;
   int b_ndbl;
-  float i_c_data[4];
-  int c_ndbl;
-  float j_c_data[4];
-  int d_ndbl;
-  float k_c_data[24];
   int tmp_data[4];
-  float l_c_data[24];
-  float m_c_data[16];
-  float n_c_data[24];
-  float o_c_data[24];
-  float p_c_data[16];
-  float q_c_data[4];
-  float r_c_data[4];
-  float b_S_feature_data[6];
   int b_tmp_data[4];
   float x_it2_data[102];
   float b_x_it2_data;
@@ -941,7 +920,6 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
   emxArray_real32_T *o_c;
   float fv38[10404];
   float rejected_ratio;
-  char cv48[66];
   static const char cv49[66] = { '1', '-', 'p', 'o', 'i', 'n', 't', ' ', 'R',
     'A', 'N', 'S', 'A', 'C', ' ', 'r', 'e', 'j', 'e', 'c', 't', 'e', 'd', ' ',
     '%', 'd', '%', '%', ' ', 'o', 'f', ' ', 'a', 'l', 'l', ' ', 'f', 'e', 'a',
@@ -2459,6 +2437,8 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
       hyp_it++;
     }
 
+    telemetry.ransac_hypotheses = hyp_it - 1;
+
     emxFree_real32_T(&c_c);
     emxFree_real32_T(&b_c);
 
@@ -2472,6 +2452,7 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
     }
 
     if (n > 3.0F) {
+      telemetry.li_inliers = n;
       emxInit_real32_T1(&i_c, 2);
 
       // 'OnePointRANSAC_EKF:131' [r, H] = getH_R_res(xt, z_u_l, z_u_r, LI_inlier_status, stereoParams, VIOParameters); 
@@ -3226,6 +3207,8 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
     //  total state for iteration
     // 'OnePointRANSAC_EKF:183' x_it = zeros(numStates + numAnchors*(6 + numPointsPerAnchor), 1); 
     memset(&x_it[0], 0, 102U * sizeof(float));
+    memset(&x_it_prev[0], 0, 102U * sizeof(float));
+    memset(&gated[0], 0, 48U * sizeof(boolean_T));
 
     //  error state for iteration
     // 'OnePointRANSAC_EKF:184' for it = 1:VIOParameters.max_ekf_iterations
@@ -3249,1609 +3232,616 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
                  e_stereoParams_CameraParameters,
                  f_stereoParams_CameraParameters, stereoParams_r_lr,
                  stereoParams_R_rl, VIOParameters_full_stereo, r, H, ind);
-      i35 = b_H->size[0] * b_H->size[1];
-      b_H->size[0] = H->size[0];
-      b_H->size[1] = 102;
-      emxEnsureCapacity((emxArray__common *)b_H, i35, (int)sizeof(float));
-      loop_ub = H->size[0] * H->size[1];
-      for (i35 = 0; i35 < loop_ub; i35++) {
-        b_H->data[i35] = H->data[i35];
-      }
-
-      //  the residual is ordered by anchors/features, not like updateVect
-      // 'OnePointRANSAC_EKF:190' P_a = P(1:6, 1:6);
-      // 'OnePointRANSAC_EKF:192' for k = 1:length(HI_ind)
-      for (k = 0; k < out->size[0]; k++) {
-        // 'OnePointRANSAC_EKF:193' anchorIdx = ind(k, 1);
-        // 'OnePointRANSAC_EKF:194' featureIdx = ind(k, 2);
-        featureIdx = ind->data[k + ind->size[0]];
-
-        // 'OnePointRANSAC_EKF:195' H_a = H((k-1)*residualDim + (1:residualDim), 1:6); 
-        f_c = k * residualDim;
-        b_ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-        ar = b_ndbl + 1;
-        idx = (b_ndbl - residualDim) + 1;
-        if (fabs((double)idx) < 2.38418579E-7F * (float)residualDim) {
-          b_ndbl++;
-          ar = residualDim;
-        } else if (idx > 0) {
-          ar = b_ndbl;
-        } else {
-          b_ndbl++;
-        }
-
-        c_xt[0] = 1.0F;
-        if (b_ndbl > 1) {
-          c_xt[b_ndbl - 1] = (float)ar;
-          i35 = b_ndbl - 1;
-          idx = i35 / 2;
-          mn = 1;
-          while (mn <= idx - 1) {
-            c_xt[1] = 2.0F;
-            c_xt[b_ndbl - 2] = (float)ar - 1.0F;
-            mn = 2;
-          }
-
-          if (idx << 1 == b_ndbl - 1) {
-            c_xt[idx] = (1.0F + (float)ar) / 2.0F;
-          } else {
-            c_xt[idx] = 1.0F + (float)idx;
-            c_xt[idx + 1] = (float)(ar - idx);
-          }
-        }
-
-        for (i35 = 0; i35 < b_ndbl; i35++) {
-          i_c_data[i35] = (float)f_c + c_xt[i35];
-        }
-
-        for (i35 = 0; i35 < 6; i35++) {
-          for (i36 = 0; i36 < b_ndbl; i36++) {
-            H_a_data[i36 + b_ndbl * i35] = b_H->data[((int)((float)f_c +
-              c_xt[i36]) + b_H->size[0] * i35) - 1];
-          }
-        }
-
-        // 'OnePointRANSAC_EKF:196' H_b = H((k-1)*residualDim + (1:residualDim), numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
-        f_c = k * residualDim;
-        c_ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-        ar = c_ndbl + 1;
-        idx = (c_ndbl - residualDim) + 1;
-        if (fabs((double)idx) < 2.38418579E-7F * (float)residualDim) {
-          c_ndbl++;
-          ar = residualDim;
-        } else if (idx > 0) {
-          ar = c_ndbl;
-        } else {
-          c_ndbl++;
-        }
-
-        vec_data[0] = 1.0F;
-        if (c_ndbl > 1) {
-          vec_data[c_ndbl - 1] = (float)ar;
-          i35 = c_ndbl - 1;
-          idx = i35 / 2;
-          mn = 1;
-          while (mn <= idx - 1) {
-            vec_data[1] = 2.0F;
-            vec_data[c_ndbl - 2] = (float)ar - 1.0F;
-            mn = 2;
-          }
-
-          if (idx << 1 == c_ndbl - 1) {
-            vec_data[idx] = (1.0F + (float)ar) / 2.0F;
-          } else {
-            vec_data[idx] = 1.0F + (float)idx;
-            vec_data[idx + 1] = (float)(ar - idx);
-          }
-        }
 
-        for (i35 = 0; i35 < c_ndbl; i35++) {
-          j_c_data[i35] = (float)f_c + vec_data[i35];
-        }
-
-        idx = ind->data[k];
-        qY = idx - 1;
-        if ((idx < 0) && (qY >= 0)) {
-          qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(qY, 14);
-        qY = 18 + ndbl;
-        if ((ndbl > 0) && (qY <= 0)) {
-          qY = MAX_int32_T;
+      //  Keep the linearization and the gain of the previous iteration if
+      //  the state moved less than the threshold, only the residual changes
+      reuse_H = false;
+      if ((it > 1) && (c_VIOParameters_jacobian_reuse_ > 0.0F) && (r->size[0] ==
+           b_H->size[0])) {
+        dx_norm = 0.0F;
+        for (k = 0; k < 102; k++) {
+          dx_norm += (x_it[k] - x_it_prev[k]) * (x_it[k] - x_it_prev[k]);
         }
 
-        for (i35 = 0; i35 < 6; i35++) {
-          ndbl = 1 + i35;
-          b_qY = qY + ndbl;
-          if ((qY > 0) && (b_qY <= 0)) {
-            b_qY = MAX_int32_T;
-          }
-
-          d_c[i35] = b_qY;
-        }
+        reuse_H = (sqrtf(dx_norm) < c_VIOParameters_jacobian_reuse_);
+      }
 
-        for (i35 = 0; i35 < 6; i35++) {
-          for (i36 = 0; i36 < c_ndbl; i36++) {
-            ndbl = 1 + i35;
-            b_qY = qY + ndbl;
-            if ((qY > 0) && (b_qY <= 0)) {
-              b_qY = MAX_int32_T;
+      memcpy(&x_it_prev[0], &x_it[0], 102U * sizeof(float));
+      if (reuse_H) {
+        //  apply the gating of the iteration the linearization comes from
+        for (k = 0; k < out->size[0]; k++) {
+          if (gated[k]) {
+            for (idx = 0; idx < residualDim; idx++) {
+              r->data[k * residualDim + idx] = 0.0F;
             }
 
-            H_b_data[i36 + c_ndbl * i35] = b_H->data[((int)((float)f_c +
-              vec_data[i36]) + b_H->size[0] * (b_qY - 1)) - 1];
+            if (it == c_VIOParameters_max_ekf_iterati) {
+              HI_inlierStatus[(int)out->data[k] - 1] = false;
+            }
           }
         }
-
-        // 'OnePointRANSAC_EKF:197' H_c = H((k-1)*residualDim + (1:residualDim), numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx); 
-        f_c = k * residualDim;
-        d_ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-        ar = d_ndbl + 1;
-        idx = (d_ndbl - residualDim) + 1;
-        if (fabs((double)idx) < 2.38418579E-7F * (float)residualDim) {
-          d_ndbl++;
-          ar = residualDim;
-        } else if (idx > 0) {
-          ar = d_ndbl;
-        } else {
-          d_ndbl++;
-        }
-
-        c_xt[0] = 1.0F;
-        if (d_ndbl > 1) {
-          c_xt[d_ndbl - 1] = (float)ar;
-          i35 = d_ndbl - 1;
-          idx = i35 / 2;
-          mn = 1;
-          while (mn <= idx - 1) {
-            c_xt[1] = 2.0F;
-            c_xt[d_ndbl - 2] = (float)ar - 1.0F;
-            mn = 2;
-          }
-
-          if (idx << 1 == d_ndbl - 1) {
-            c_xt[idx] = (1.0F + (float)ar) / 2.0F;
+      } else {
+        memset(&gated[0], 0, 48U * sizeof(boolean_T));
+        i35 = b_H->size[0] * b_H->size[1];
+        b_H->size[0] = H->size[0];
+        b_H->size[1] = 102;
+        emxEnsureCapacity((emxArray__common *)b_H, i35, (int)sizeof(float));
+        loop_ub = H->size[0] * H->size[1];
+        for (i35 = 0; i35 < loop_ub; i35++) {
+          b_H->data[i35] = H->data[i35];
+        }
+
+        //  the residual is ordered by anchors/features, not like updateVect
+        // 'OnePointRANSAC_EKF:190' P_a = P(1:6, 1:6);
+        // 'OnePointRANSAC_EKF:192' for k = 1:length(HI_ind)
+        for (k = 0; k < out->size[0]; k++) {
+          // 'OnePointRANSAC_EKF:193' anchorIdx = ind(k, 1);
+          anchorIdx = ind->data[k];
+
+          // 'OnePointRANSAC_EKF:194' featureIdx = ind(k, 2);
+          featureIdx = ind->data[k + ind->size[0]];
+
+          // 'OnePointRANSAC_EKF:195' H_a = H((k-1)*residualDim + (1:residualDim), 1:6); 
+          // 'OnePointRANSAC_EKF:196' H_b = H((k-1)*residualDim + (1:residualDim), numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
+          // 'OnePointRANSAC_EKF:197' H_c = H((k-1)*residualDim + (1:residualDim), numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx); 
+          // 'OnePointRANSAC_EKF:198' P_b = P(numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6), 1:6); 
+          // 'OnePointRANSAC_EKF:199' P_c = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, 1:6); 
+          // 'OnePointRANSAC_EKF:200' P_d = P_b';
+          // 'OnePointRANSAC_EKF:201' P_e = P(numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6), numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
+          // 'OnePointRANSAC_EKF:202' P_f = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
+          // 'OnePointRANSAC_EKF:203' P_g = P_c';
+          // 'OnePointRANSAC_EKF:204' P_h = P_f';
+          // 'OnePointRANSAC_EKF:205' P_i = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx); 
+          // 'OnePointRANSAC_EKF:206' S_feature = (H_a*P_a + H_b*P_b + H_c*P_c)*H_a' + ... 
+          // 'OnePointRANSAC_EKF:207'                         (H_a*P_d + H_b*P_e + H_c*P_f)*H_b' + ... 
+          // 'OnePointRANSAC_EKF:208'                         (H_a*P_g + H_b*P_h + H_c*P_i)*H_c'; 
+          // 'OnePointRANSAC_EKF:210' size_S = residualDim;
+          // 'OnePointRANSAC_EKF:211' S_feature(1:(size_S+1):size_S^2) = S_feature(1:(size_S+1):size_S^2) + noiseParameters.image_noise; 
+          //  add R to HPH'
+          for (idx = 0; idx < 6; idx++) {
+            feature_cols[idx] = idx;
+            feature_cols[6 + idx] = (anchorIdx - 1) * 14 + (18 + idx);
+          }
+
+          feature_cols[12] = (anchorIdx - 1) * 14 + (23 + featureIdx);
+
+          // 'OnePointRANSAC_EKF:213' if coder.target('MATLAB')
+          // 'OnePointRANSAC_EKF:221' innov = r((k-1)*residualDim + (1:residualDim))' / S_feature * r((k-1)*residualDim + (1:residualDim)); 
+          if (residualDim == 4) {
+            innov = small_matrix::featureMahalanobis<4>(&b_H->data[k << 2],
+              b_H->size[0], b_P, 102, feature_cols, noiseParameters_image_noise,
+              &r->data[k << 2]);
           } else {
-            c_xt[idx] = 1.0F + (float)idx;
-            c_xt[idx + 1] = (float)(ar - idx);
-          }
-        }
-
-        idx = ind->data[k];
-        qY = idx - 1;
-        if ((idx < 0) && (qY >= 0)) {
-          qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(qY, 14);
-        qY = 18 + ndbl;
-        if ((ndbl > 0) && (qY <= 0)) {
-          qY = MAX_int32_T;
-        }
-
-        b_qY = qY + 6;
-        if ((qY > 0) && (b_qY <= 0)) {
-          b_qY = MAX_int32_T;
-        }
-
-        ndbl = ind->data[k + ind->size[0]];
-        qY = b_qY + ndbl;
-        if ((b_qY < 0) && ((ndbl < 0) && (qY >= 0))) {
-          qY = MIN_int32_T;
-        } else {
-          if ((b_qY > 0) && ((ndbl > 0) && (qY <= 0))) {
-            qY = MAX_int32_T;
-          }
-        }
-
-        for (i35 = 0; i35 < d_ndbl; i35++) {
-          H_c_data[i35] = b_H->data[((int)((float)f_c + c_xt[i35]) + b_H->size[0]
-            * (qY - 1)) - 1];
-        }
-
-        // 'OnePointRANSAC_EKF:198' P_b = P(numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6), 1:6); 
-        idx = ind->data[k];
-        qY = idx - 1;
-        if ((idx < 0) && (qY >= 0)) {
-          qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(qY, 14);
-        qY = 18 + ndbl;
-        if ((ndbl > 0) && (qY <= 0)) {
-          qY = MAX_int32_T;
-        }
-
-        for (i35 = 0; i35 < 6; i35++) {
-          ndbl = 1 + i35;
-          b_qY = qY + ndbl;
-          if ((qY > 0) && (b_qY <= 0)) {
-            b_qY = MAX_int32_T;
-          }
+            innov = small_matrix::featureMahalanobis<2>(&b_H->data[k << 1],
+              b_H->size[0], b_P, 102, feature_cols, noiseParameters_image_noise,
+              &r->data[k << 1]);
+          }
+
+          // 'OnePointRANSAC_EKF:222' if innov > mahalanobis_thresh
+          if (innov > mahalanobis_thresh) {
+            // 'OnePointRANSAC_EKF:223' r((k-1)*residualDim + (1:residualDim)) = 0; 
+            f_c = k * residualDim;
+            b_ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
+            ar = b_ndbl + 1;
+            idx = (b_ndbl - residualDim) + 1;
+            if (fabs((double)idx) < 2.38418579E-7F * (float)residualDim) {
+              b_ndbl++;
+              ar = residualDim;
+            } else if (idx > 0) {
+              ar = b_ndbl;
+            } else {
+              b_ndbl++;
+            }
+
+            c_xt[0] = 1.0F;
+            if (b_ndbl > 1) {
+              c_xt[b_ndbl - 1] = (float)ar;
+              i35 = b_ndbl - 1;
+              idx = i35 / 2;
+              mn = 1;
+              while (mn <= idx - 1) {
+                c_xt[1] = 2.0F;
+                c_xt[b_ndbl - 2] = (float)ar - 1.0F;
+                mn = 2;
+              }
 
-          e_c[i35] = b_qY;
-          for (i36 = 0; i36 < 6; i36++) {
-            ndbl = 1 + i36;
-            b_qY = qY + ndbl;
-            if ((qY > 0) && (b_qY <= 0)) {
-              b_qY = MAX_int32_T;
+              if (idx << 1 == b_ndbl - 1) {
+                c_xt[idx] = (1.0F + (float)ar) / 2.0F;
+              } else {
+                c_xt[idx] = 1.0F + (float)idx;
+                c_xt[idx + 1] = (float)(ar - idx);
+              }
             }
 
-            P_b[i36 + 6 * i35] = b_P[(b_qY + 102 * i35) - 1];
-          }
-        }
-
-        // 'OnePointRANSAC_EKF:199' P_c = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, 1:6); 
-        idx = ind->data[k];
-        b_qY = idx - 1;
-        if ((idx < 0) && (b_qY >= 0)) {
-          b_qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(b_qY, 14);
-        b_qY = 18 + ndbl;
-        if ((ndbl > 0) && (b_qY <= 0)) {
-          b_qY = MAX_int32_T;
-        }
-
-        c_qY = b_qY + 6;
-        if ((b_qY > 0) && (c_qY <= 0)) {
-          c_qY = MAX_int32_T;
-        }
-
-        ndbl = ind->data[k + ind->size[0]];
-        b_qY = c_qY + ndbl;
-        if ((c_qY < 0) && ((ndbl < 0) && (b_qY >= 0))) {
-          b_qY = MIN_int32_T;
-        } else {
-          if ((c_qY > 0) && ((ndbl > 0) && (b_qY <= 0))) {
-            b_qY = MAX_int32_T;
-          }
-        }
-
-        f_c = b_qY - 1;
-
-        // 'OnePointRANSAC_EKF:200' P_d = P_b';
-        for (i35 = 0; i35 < 6; i35++) {
-          for (i36 = 0; i36 < 6; i36++) {
-            P_d[i36 + 6 * i35] = P_b[i35 + 6 * i36];
-          }
-        }
-
-        // 'OnePointRANSAC_EKF:201' P_e = P(numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6), numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
-        idx = ind->data[k];
-        b_qY = idx - 1;
-        if ((idx < 0) && (b_qY >= 0)) {
-          b_qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(b_qY, 14);
-        b_qY = 18 + ndbl;
-        if ((ndbl > 0) && (b_qY <= 0)) {
-          b_qY = MAX_int32_T;
-        }
-
-        for (i35 = 0; i35 < 6; i35++) {
-          ndbl = 1 + i35;
-          d_qY = b_qY + ndbl;
-          if ((b_qY > 0) && (d_qY <= 0)) {
-            d_qY = MAX_int32_T;
-          }
-
-          g_c[i35] = d_qY;
-        }
-
-        idx = ind->data[k];
-        d_qY = idx - 1;
-        if ((idx < 0) && (d_qY >= 0)) {
-          d_qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(d_qY, 14);
-        d_qY = 18 + ndbl;
-        if ((ndbl > 0) && (d_qY <= 0)) {
-          d_qY = MAX_int32_T;
-        }
-
-        for (i35 = 0; i35 < 6; i35++) {
-          ndbl = 1 + i35;
-          e_qY = d_qY + ndbl;
-          if ((d_qY > 0) && (e_qY <= 0)) {
-            e_qY = MAX_int32_T;
-          }
-
-          h_c[i35] = e_qY;
-        }
-
-        // 'OnePointRANSAC_EKF:202' P_f = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, numStates + (anchorIdx-1)*numStatesPerAnchor + int32(1:6)); 
-        idx = ind->data[k];
-        e_qY = idx - 1;
-        if ((idx < 0) && (e_qY >= 0)) {
-          e_qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(e_qY, 14);
-        e_qY = 18 + ndbl;
-        if ((ndbl > 0) && (e_qY <= 0)) {
-          e_qY = MAX_int32_T;
-        }
-
-        idx = ind->data[k];
-        f_qY = idx - 1;
-        if ((idx < 0) && (f_qY >= 0)) {
-          f_qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(f_qY, 14);
-        f_qY = 18 + ndbl;
-        if ((ndbl > 0) && (f_qY <= 0)) {
-          f_qY = MAX_int32_T;
-        }
-
-        g_qY = f_qY + 6;
-        if ((f_qY > 0) && (g_qY <= 0)) {
-          g_qY = MAX_int32_T;
-        }
-
-        idx = ind->data[k];
-        f_qY = idx - 1;
-        if ((idx < 0) && (f_qY >= 0)) {
-          f_qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(f_qY, 14);
-        f_qY = 18 + ndbl;
-        if ((ndbl > 0) && (f_qY <= 0)) {
-          f_qY = MAX_int32_T;
-        }
-
-        idx = ind->data[k];
-        h_qY = idx - 1;
-        if ((idx < 0) && (h_qY >= 0)) {
-          h_qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(h_qY, 14);
-        h_qY = 18 + ndbl;
-        if ((ndbl > 0) && (h_qY <= 0)) {
-          h_qY = MAX_int32_T;
-        }
-
-        i_qY = h_qY + 6;
-        if ((h_qY > 0) && (i_qY <= 0)) {
-          i_qY = MAX_int32_T;
-        }
-
-        ndbl = ind->data[k + ind->size[0]];
-        h_qY = i_qY + ndbl;
-        if ((i_qY < 0) && ((ndbl < 0) && (h_qY >= 0))) {
-          h_qY = MIN_int32_T;
-        } else {
-          if ((i_qY > 0) && ((ndbl > 0) && (h_qY <= 0))) {
-            h_qY = MAX_int32_T;
-          }
-        }
-
-        for (i35 = 0; i35 < 6; i35++) {
-          ndbl = 1 + i35;
-          i_qY = f_qY + ndbl;
-          if ((f_qY > 0) && (i_qY <= 0)) {
-            i_qY = MAX_int32_T;
-          }
-
-          P_f[i35] = b_P[(h_qY + 102 * (i_qY - 1)) - 1];
-        }
-
-        // 'OnePointRANSAC_EKF:203' P_g = P_c';
-        // 'OnePointRANSAC_EKF:204' P_h = P_f';
-        // 'OnePointRANSAC_EKF:205' P_i = P(numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx, numStates + (anchorIdx-1)*numStatesPerAnchor + 6 + featureIdx); 
-        idx = ind->data[k];
-        h_qY = idx - 1;
-        if ((idx < 0) && (h_qY >= 0)) {
-          h_qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(h_qY, 14);
-        h_qY = 18 + ndbl;
-        if ((ndbl > 0) && (h_qY <= 0)) {
-          h_qY = MAX_int32_T;
-        }
-
-        i_qY = h_qY + 6;
-        if ((h_qY > 0) && (i_qY <= 0)) {
-          i_qY = MAX_int32_T;
-        }
-
-        ndbl = ind->data[k + ind->size[0]];
-        h_qY = i_qY + ndbl;
-        if ((i_qY < 0) && ((ndbl < 0) && (h_qY >= 0))) {
-          h_qY = MIN_int32_T;
-        } else {
-          if ((i_qY > 0) && ((ndbl > 0) && (h_qY <= 0))) {
-            h_qY = MAX_int32_T;
-          }
-        }
-
-        idx = ind->data[k];
-        i_qY = idx - 1;
-        if ((idx < 0) && (i_qY >= 0)) {
-          i_qY = MIN_int32_T;
-        }
-
-        ndbl = mul_s32_s32_s32_sat(i_qY, 14);
-        i_qY = 18 + ndbl;
-        if ((ndbl > 0) && (i_qY <= 0)) {
-          i_qY = MAX_int32_T;
-        }
-
-        idx = i_qY + 6;
-        if ((i_qY > 0) && (idx <= 0)) {
-          idx = MAX_int32_T;
-        }
-
-        ndbl = ind->data[k + ind->size[0]];
-        i_qY = idx + ndbl;
-        if ((idx < 0) && ((ndbl < 0) && (i_qY >= 0))) {
-          i_qY = MIN_int32_T;
-        } else {
-          if ((idx > 0) && ((ndbl > 0) && (i_qY <= 0))) {
-            i_qY = MAX_int32_T;
-          }
-        }
-
-        // 'OnePointRANSAC_EKF:206' S_feature = (H_a*P_a + H_b*P_b + H_c*P_c)*H_a' + ... 
-        // 'OnePointRANSAC_EKF:207'                         (H_a*P_d + H_b*P_e + H_c*P_f)*H_b' + ... 
-        // 'OnePointRANSAC_EKF:208'                         (H_a*P_g + H_b*P_h + H_c*P_i)*H_c'; 
-        for (i35 = 0; i35 < 6; i35++) {
-          for (i36 = 0; i36 < b_ndbl; i36++) {
-            k_c_data[i36 + b_ndbl * i35] = 0.0F;
-          }
-        }
+            for (i35 = 0; i35 < b_ndbl; i35++) {
+              b_tmp_data[i35] = (int)((float)f_c + c_xt[i35]);
+            }
 
-        b_m = b_ndbl * 5;
-        for (mn = 0; mn <= b_m; mn += b_ndbl) {
-          i35 = mn + b_ndbl;
-          for (ic = mn; ic + 1 <= i35; ic++) {
-            k_c_data[ic] = 0.0F;
-          }
-        }
+            for (i35 = 0; i35 < b_ndbl; i35++) {
+              r->data[b_tmp_data[i35] - 1] = 0.0F;
+            }
 
-        br = 0;
-        for (mn = 0; mn <= b_m; mn += b_ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            if (b_P[ib % 6 + 102 * (ib / 6)] != 0.0F) {
-              ia = ar;
-              i35 = mn + b_ndbl;
-              for (ic = mn; ic + 1 <= i35; ic++) {
-                ia++;
-                for (i36 = 0; i36 < b_ndbl; i36++) {
-                  tmp_data[i36] = (int)i_c_data[i36];
-                }
+            // 'OnePointRANSAC_EKF:224' H((k-1)*residualDim + (1:residualDim), :) = 0; 
+            f_c = k * residualDim;
+            b_ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
+            ar = b_ndbl + 1;
+            idx = (b_ndbl - residualDim) + 1;
+            if (fabs((double)idx) < 2.38418579E-7F * (float)residualDim) {
+              b_ndbl++;
+              ar = residualDim;
+            } else if (idx > 0) {
+              ar = b_ndbl;
+            } else {
+              b_ndbl++;
+            }
+
+            c_xt[0] = 1.0F;
+            if (b_ndbl > 1) {
+              c_xt[b_ndbl - 1] = (float)ar;
+              i35 = b_ndbl - 1;
+              idx = i35 / 2;
+              mn = 1;
+              while (mn <= idx - 1) {
+                c_xt[1] = 2.0F;
+                c_xt[b_ndbl - 2] = (float)ar - 1.0F;
+                mn = 2;
+              }
 
-                k_c_data[ic] += b_P[ib % 6 + 102 * (ib / 6)] * b_H->data
-                  [(tmp_data[(ia - 1) % b_ndbl] + b_H->size[0] * ((ia - 1) /
-                     b_ndbl)) - 1];
+              if (idx << 1 == b_ndbl - 1) {
+                c_xt[idx] = (1.0F + (float)ar) / 2.0F;
+              } else {
+                c_xt[idx] = 1.0F + (float)idx;
+                c_xt[idx + 1] = (float)(ar - idx);
               }
             }
 
-            ar += b_ndbl;
-          }
-
-          br += 6;
-        }
-
-        for (i35 = 0; i35 < 6; i35++) {
-          for (i36 = 0; i36 < c_ndbl; i36++) {
-            l_c_data[i36 + c_ndbl * i35] = 0.0F;
-          }
-        }
-
-        b_m = c_ndbl * 5;
-        for (mn = 0; mn <= b_m; mn += c_ndbl) {
-          i35 = mn + c_ndbl;
-          for (ic = mn; ic + 1 <= i35; ic++) {
-            l_c_data[ic] = 0.0F;
-          }
-        }
-
-        br = 0;
-        for (mn = 0; mn <= b_m; mn += c_ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            if (b_P[(e_c[ib % 6] + 102 * (ib / 6)) - 1] != 0.0F) {
-              ia = ar;
-              i35 = mn + c_ndbl;
-              for (ic = mn; ic + 1 <= i35; ic++) {
-                ia++;
-                for (i36 = 0; i36 < c_ndbl; i36++) {
-                  tmp_data[i36] = (int)j_c_data[i36];
-                }
-
-                ndbl = 1 + ib % 6;
-                idx = qY + ndbl;
-                if ((qY < 0) && ((ndbl < 0) && (idx >= 0))) {
-                  idx = MIN_int32_T;
-                } else {
-                  if ((qY > 0) && ((ndbl > 0) && (idx <= 0))) {
-                    idx = MAX_int32_T;
-                  }
-                }
+            for (i35 = 0; i35 < b_ndbl; i35++) {
+              tmp_data[i35] = (int)((float)f_c + c_xt[i35]);
+            }
 
-                l_c_data[ic] += b_P[(idx + 102 * (ib / 6)) - 1] * b_H->data
-                  [(tmp_data[(ia - 1) % c_ndbl] + b_H->size[0] * (d_c[(ia - 1) /
-                     c_ndbl] - 1)) - 1];
+            for (i35 = 0; i35 < 102; i35++) {
+              for (i36 = 0; i36 < b_ndbl; i36++) {
+                b_H->data[(tmp_data[i36] + b_H->size[0] * i35) - 1] = 0.0F;
               }
             }
 
-            ar += c_ndbl;
-          }
-
-          br += 6;
-        }
+            gated[k] = true;
 
-        for (i35 = 0; i35 < d_ndbl; i35++) {
-          for (i36 = 0; i36 < 6; i36++) {
-            c_data[i35 + d_ndbl * i36] = (k_c_data[i35 + b_ndbl * i36] +
-              l_c_data[i35 + c_ndbl * i36]) + H_c_data[i35] * b_P[f_c + 102 *
-              i36];
-          }
-        }
+            // 'OnePointRANSAC_EKF:225' if it == VIOParameters.max_ekf_iterations
+            if (it == c_VIOParameters_max_ekf_iterati) {
+              // 'OnePointRANSAC_EKF:226' HI_inlierStatus(HI_ind(k)) = false;
+              HI_inlierStatus[(int)out->data[k] - 1] = false;
 
-        for (i35 = 0; i35 < b_ndbl; i35++) {
-          for (i36 = 0; i36 < 6; i36++) {
-            b_data[i36 + 6 * i35] = H_a_data[i35 + b_ndbl * i36];
-          }
-        }
+              //  only reject the feature if its still bad in last iteration, otherwise just dont use for this update 
+            }
 
-        for (i35 = 0; i35 < b_ndbl; i35++) {
-          for (i36 = 0; i36 < d_ndbl; i36++) {
-            m_c_data[i36 + d_ndbl * i35] = 0.0F;
+            //                  log_info('rejecting %i', HI_ind(k))
+            // 'OnePointRANSAC_EKF:229' if updateVect(HI_ind(k)) == 2
+            if (updateVect[(int)out->data[k] - 1] == 2) {
+              // 'OnePointRANSAC_EKF:230' log_error('inconsistency')
+              b_log_error();
+            }
           }
         }
+      }
 
-        b_m = d_ndbl * (b_ndbl - 1);
-        for (mn = 0; mn <= b_m; mn += d_ndbl) {
-          i35 = mn + d_ndbl;
-          for (ic = mn; ic + 1 <= i35; ic++) {
-            m_c_data[ic] = 0.0F;
-          }
+      if (it == c_VIOParameters_max_ekf_iterati) {
+        telemetry.innovation_norm = 0.0F;
+        for (k = 0; k < r->size[0]; k++) {
+          telemetry.innovation_norm += r->data[k] * r->data[k];
         }
 
-        br = 0;
-        for (mn = 0; mn <= b_m; mn += d_ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            if (b_data[ib] != 0.0F) {
-              ia = ar;
-              i35 = mn + d_ndbl;
-              for (ic = mn; ic + 1 <= i35; ic++) {
-                ia++;
-                m_c_data[ic] += b_data[ib] * c_data[ia - 1];
-              }
-            }
+        telemetry.innovation_norm = sqrtf(telemetry.innovation_norm);
+      }
 
-            ar += d_ndbl;
+      if (!reuse_H) {
+        // 'OnePointRANSAC_EKF:235' S = (H*P*H');
+        H_idx_0 = (unsigned int)b_H->size[0];
+        i35 = k_c->size[0] * k_c->size[1];
+        k_c->size[0] = (int)H_idx_0;
+        k_c->size[1] = 102;
+        emxEnsureCapacity((emxArray__common *)k_c, i35, (int)sizeof(float));
+        b_m = b_H->size[0];
+        i35 = k_c->size[0] * k_c->size[1];
+        k_c->size[1] = 102;
+        emxEnsureCapacity((emxArray__common *)k_c, i35, (int)sizeof(float));
+        for (i35 = 0; i35 < 102; i35++) {
+          loop_ub = k_c->size[0];
+          for (i36 = 0; i36 < loop_ub; i36++) {
+            k_c->data[i36 + k_c->size[0] * i35] = 0.0F;
           }
-
-          br += 6;
         }
 
-        for (i35 = 0; i35 < 6; i35++) {
-          for (i36 = 0; i36 < b_ndbl; i36++) {
-            n_c_data[i36 + b_ndbl * i35] = 0.0F;
-          }
-        }
+        if (b_H->size[0] == 0) {
+        } else {
+          f_c = b_H->size[0] * 101;
+          mn = 0;
+          while ((b_m > 0) && (mn <= f_c)) {
+            i35 = mn + b_m;
+            for (ic = mn; ic + 1 <= i35; ic++) {
+              k_c->data[ic] = 0.0F;
+            }
 
-        b_m = b_ndbl * 5;
-        for (mn = 0; mn <= b_m; mn += b_ndbl) {
-          i35 = mn + b_ndbl;
-          for (ic = mn; ic + 1 <= i35; ic++) {
-            n_c_data[ic] = 0.0F;
+            mn += b_m;
           }
-        }
 
-        br = 0;
-        for (mn = 0; mn <= b_m; mn += b_ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            if (P_d[ib] != 0.0F) {
-              ia = ar;
-              i35 = mn + b_ndbl;
-              for (ic = mn; ic + 1 <= i35; ic++) {
-                ia++;
-                for (i36 = 0; i36 < b_ndbl; i36++) {
-                  tmp_data[i36] = (int)i_c_data[i36];
+          br = 0;
+          mn = 0;
+          while ((b_m > 0) && (mn <= f_c)) {
+            ar = 0;
+            for (ib = br; ib + 1 <= br + 102; ib++) {
+              if (b_P[ib] != 0.0F) {
+                ia = ar;
+                i35 = mn + b_m;
+                for (ic = mn; ic + 1 <= i35; ic++) {
+                  ia++;
+                  k_c->data[ic] += b_P[ib] * b_H->data[ia - 1];
                 }
-
-                n_c_data[ic] += P_d[ib] * b_H->data[(tmp_data[(ia - 1) % b_ndbl]
-                  + b_H->size[0] * ((ia - 1) / b_ndbl)) - 1];
               }
+
+              ar += b_m;
             }
 
-            ar += b_ndbl;
+            br += 102;
+            mn += b_m;
           }
-
-          br += 6;
         }
 
-        for (i35 = 0; i35 < 6; i35++) {
-          for (i36 = 0; i36 < c_ndbl; i36++) {
-            o_c_data[i36 + c_ndbl * i35] = 0.0F;
-          }
-        }
-
-        b_m = c_ndbl * 5;
-        for (mn = 0; mn <= b_m; mn += c_ndbl) {
-          i35 = mn + c_ndbl;
-          for (ic = mn; ic + 1 <= i35; ic++) {
-            o_c_data[ic] = 0.0F;
-          }
-        }
-
-        br = 0;
-        for (mn = 0; mn <= b_m; mn += c_ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            if (b_P[(g_c[ib % 6] + 102 * (h_c[ib / 6] - 1)) - 1] != 0.0F) {
-              ia = ar;
-              i35 = mn + c_ndbl;
-              for (ic = mn; ic + 1 <= i35; ic++) {
-                ia++;
-                for (i36 = 0; i36 < c_ndbl; i36++) {
-                  tmp_data[i36] = (int)j_c_data[i36];
-                }
-
-                ndbl = 1 + ib % 6;
-                qY = b_qY + ndbl;
-                if ((b_qY < 0) && ((ndbl < 0) && (qY >= 0))) {
-                  qY = MIN_int32_T;
-                } else {
-                  if ((b_qY > 0) && ((ndbl > 0) && (qY <= 0))) {
-                    qY = MAX_int32_T;
-                  }
-                }
-
-                ndbl = 1 + ib / 6;
-                idx = d_qY + ndbl;
-                if ((d_qY < 0) && ((ndbl < 0) && (idx >= 0))) {
-                  idx = MIN_int32_T;
-                } else {
-                  if ((d_qY > 0) && ((ndbl > 0) && (idx <= 0))) {
-                    idx = MAX_int32_T;
-                  }
-                }
-
-                o_c_data[ic] += b_P[(qY + 102 * (idx - 1)) - 1] * b_H->data
-                  [(tmp_data[(ia - 1) % c_ndbl] + b_H->size[0] * (d_c[(ia - 1) /
-                     c_ndbl] - 1)) - 1];
-              }
-            }
-
-            ar += c_ndbl;
-          }
-
-          br += 6;
-        }
-
-        for (i35 = 0; i35 < d_ndbl; i35++) {
-          for (i36 = 0; i36 < 6; i36++) {
-            c_data[i35 + d_ndbl * i36] = (n_c_data[i35 + b_ndbl * i36] +
-              o_c_data[i35 + c_ndbl * i36]) + H_c_data[i35] * P_f[i36];
-          }
-        }
-
-        for (i35 = 0; i35 < c_ndbl; i35++) {
-          for (i36 = 0; i36 < 6; i36++) {
-            b_data[i36 + 6 * i35] = H_b_data[i35 + c_ndbl * i36];
-          }
-        }
-
-        for (i35 = 0; i35 < c_ndbl; i35++) {
-          for (i36 = 0; i36 < d_ndbl; i36++) {
-            p_c_data[i36 + d_ndbl * i35] = 0.0F;
-          }
-        }
-
-        b_m = d_ndbl * (c_ndbl - 1);
-        for (mn = 0; mn <= b_m; mn += d_ndbl) {
-          i35 = mn + d_ndbl;
-          for (ic = mn; ic + 1 <= i35; ic++) {
-            p_c_data[ic] = 0.0F;
-          }
-        }
-
-        br = 0;
-        for (mn = 0; mn <= b_m; mn += d_ndbl) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 6; ib++) {
-            if (b_data[ib] != 0.0F) {
-              ia = ar;
-              i35 = mn + d_ndbl;
-              for (ic = mn; ic + 1 <= i35; ic++) {
-                ia++;
-                p_c_data[ic] += b_data[ib] * c_data[ia - 1];
-              }
-            }
-
-            ar += d_ndbl;
-          }
-
-          br += 6;
-        }
-
-        for (i35 = 0; i35 < b_ndbl; i35++) {
-          q_c_data[i35] = 0.0F;
-        }
-
-        mn = 0;
-        while (mn <= 0) {
-          for (ic = 1; ic <= b_ndbl; ic++) {
-            q_c_data[ic - 1] = 0.0F;
-          }
-
-          mn = b_ndbl;
-        }
-
-        br = 6;
-        mn = 0;
-        while (mn <= 0) {
-          ar = 0;
-          for (ib = br - 5; ib <= br; ib++) {
-            ndbl = featureIdx;
-            qY = c_qY + ndbl;
-            if ((c_qY < 0) && ((ndbl < 0) && (qY >= 0))) {
-              qY = MIN_int32_T;
-            } else {
-              if ((c_qY > 0) && ((ndbl > 0) && (qY <= 0))) {
-                qY = MAX_int32_T;
-              }
-            }
-
-            if (b_P[(qY + 102 * (ib - 1)) - 1] != 0.0F) {
-              ia = ar;
-              for (ic = 0; ic + 1 <= b_ndbl; ic++) {
-                ia++;
-                for (i35 = 0; i35 < b_ndbl; i35++) {
-                  tmp_data[i35] = (int)i_c_data[i35];
-                }
-
-                q_c_data[ic] += b_P[f_c + 102 * (ib - 1)] * b_H->data[(tmp_data
-                  [(ia - 1) % b_ndbl] + b_H->size[0] * ((ia - 1) / b_ndbl)) - 1];
-              }
-            }
-
-            ar += b_ndbl;
-          }
-
-          br += 6;
-          mn = b_ndbl;
-        }
-
-        for (i35 = 0; i35 < c_ndbl; i35++) {
-          r_c_data[i35] = 0.0F;
-        }
-
-        mn = 0;
-        while (mn <= 0) {
-          for (ic = 1; ic <= c_ndbl; ic++) {
-            r_c_data[ic - 1] = 0.0F;
-          }
-
-          mn = c_ndbl;
-        }
-
-        br = 6;
-        mn = 0;
-        while (mn <= 0) {
-          ar = 0;
-          for (ib = br - 5; ib <= br; ib++) {
-            ndbl = featureIdx;
-            qY = g_qY + ndbl;
-            if ((g_qY < 0) && ((ndbl < 0) && (qY >= 0))) {
-              qY = MIN_int32_T;
-            } else {
-              if ((g_qY > 0) && ((ndbl > 0) && (qY <= 0))) {
-                qY = MAX_int32_T;
-              }
-            }
-
-            ndbl = iv12[ib - 1];
-            b_qY = f_qY + ndbl;
-            if ((f_qY > 0) && (b_qY <= 0)) {
-              b_qY = MAX_int32_T;
-            }
-
-            if (b_P[(qY + 102 * (b_qY - 1)) - 1] != 0.0F) {
-              ia = ar;
-              for (ic = 0; ic + 1 <= c_ndbl; ic++) {
-                ia++;
-                for (i35 = 0; i35 < c_ndbl; i35++) {
-                  tmp_data[i35] = (int)j_c_data[i35];
-                }
-
-                qY = e_qY + 6;
-                if ((e_qY > 0) && (qY <= 0)) {
-                  qY = MAX_int32_T;
-                }
-
-                ndbl = ind->data[k + ind->size[0]];
-                b_qY = qY + ndbl;
-                if ((qY < 0) && ((ndbl < 0) && (b_qY >= 0))) {
-                  b_qY = MIN_int32_T;
-                } else {
-                  if ((qY > 0) && ((ndbl > 0) && (b_qY <= 0))) {
-                    b_qY = MAX_int32_T;
-                  }
-                }
-
-                qY = f_qY + ib;
-                if ((f_qY < 0) && ((ib < 0) && (qY >= 0))) {
-                  qY = MIN_int32_T;
-                } else {
-                  if ((f_qY > 0) && ((ib > 0) && (qY <= 0))) {
-                    qY = MAX_int32_T;
-                  }
-                }
-
-                r_c_data[ic] += b_P[(b_qY + 102 * (qY - 1)) - 1] * b_H->data
-                  [(tmp_data[(ia - 1) % c_ndbl] + b_H->size[0] * (d_c[(ia - 1) /
-                     c_ndbl] - 1)) - 1];
-              }
-            }
-
-            ar += c_ndbl;
-          }
-
-          br += 6;
-          mn = c_ndbl;
-        }
-
-        wj = b_P[(h_qY + 102 * (i_qY - 1)) - 1];
-        for (i35 = 0; i35 < b_ndbl; i35++) {
-          vec_data[i35] = (q_c_data[i35] + r_c_data[i35]) + H_c_data[i35] * wj;
-        }
-
-        for (i35 = 0; i35 < b_ndbl; i35++) {
-          for (i36 = 0; i36 < d_ndbl; i36++) {
-            S_feature_data[i35 + b_ndbl * i36] = (m_c_data[i35 + d_ndbl * i36] +
-              p_c_data[i35 + d_ndbl * i36]) + vec_data[i35] * H_c_data[i36];
-          }
-        }
-
-        // 'OnePointRANSAC_EKF:210' size_S = residualDim;
-        // 'OnePointRANSAC_EKF:211' S_feature(1:(size_S+1):size_S^2) = S_feature(1:(size_S+1):size_S^2) + noiseParameters.image_noise; 
-        i35 = residualDim * residualDim - 1;
-        i36 = residualDim + 1;
-        loop_ub = div_s32_floor(i35, i36);
-        for (ar = 0; ar <= loop_ub; ar++) {
-          b_S_feature_data[ar] = S_feature_data[i36 * ar] +
-            noiseParameters_image_noise;
-        }
-
-        loop_ub = div_s32_floor(i35, i36) + 1;
+        i35 = c_H->size[0] * c_H->size[1];
+        c_H->size[0] = b_H->size[1];
+        c_H->size[1] = b_H->size[0];
+        emxEnsureCapacity((emxArray__common *)c_H, i35, (int)sizeof(float));
+        loop_ub = b_H->size[0];
         for (i35 = 0; i35 < loop_ub; i35++) {
-          S_feature_data[(residualDim + 1) * i35] = b_S_feature_data[i35];
-        }
-
-        //  add R to HPH'
-        // 'OnePointRANSAC_EKF:213' if coder.target('MATLAB')
-        // 'OnePointRANSAC_EKF:221' innov = r((k-1)*residualDim + (1:residualDim))' / S_feature * r((k-1)*residualDim + (1:residualDim)); 
-        f_c = k * residualDim;
-        c_ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-        ar = c_ndbl + 1;
-        idx = (c_ndbl - residualDim) + 1;
-        if (fabs((double)idx) < 2.38418579E-7F * (float)residualDim) {
-          c_ndbl++;
-          ar = residualDim;
-        } else if (idx > 0) {
-          ar = c_ndbl;
-        } else {
-          c_ndbl++;
-        }
-
-        c_xt[0] = 1.0F;
-        if (c_ndbl > 1) {
-          c_xt[c_ndbl - 1] = (float)ar;
-          i35 = c_ndbl - 1;
-          idx = i35 / 2;
-          mn = 1;
-          while (mn <= idx - 1) {
-            c_xt[1] = 2.0F;
-            c_xt[c_ndbl - 2] = (float)ar - 1.0F;
-            mn = 2;
-          }
-
-          if (idx << 1 == c_ndbl - 1) {
-            c_xt[idx] = (1.0F + (float)ar) / 2.0F;
-          } else {
-            c_xt[idx] = 1.0F + (float)idx;
-            c_xt[idx + 1] = (float)(ar - idx);
-          }
-        }
-
-        for (i35 = 0; i35 < c_ndbl; i35++) {
-          c_xt[i35] += (float)f_c;
-        }
-
-        f_c = k * residualDim;
-        ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-        ar = ndbl + 1;
-        idx = (ndbl - residualDim) + 1;
-        if (fabs((double)idx) < 2.38418579E-7F * (float)residualDim) {
-          ndbl++;
-          ar = residualDim;
-        } else if (idx > 0) {
-          ar = ndbl;
-        } else {
-          ndbl++;
-        }
-
-        vec_data[0] = 1.0F;
-        if (ndbl > 1) {
-          vec_data[ndbl - 1] = (float)ar;
-          i35 = ndbl - 1;
-          idx = i35 / 2;
-          mn = 1;
-          while (mn <= idx - 1) {
-            vec_data[1] = 2.0F;
-            vec_data[ndbl - 2] = (float)ar - 1.0F;
-            mn = 2;
-          }
-
-          if (idx << 1 == ndbl - 1) {
-            vec_data[idx] = (1.0F + (float)ar) / 2.0F;
-          } else {
-            vec_data[idx] = 1.0F + (float)idx;
-            vec_data[idx + 1] = (float)(ar - idx);
-          }
-        }
-
-        for (i35 = 0; i35 < ndbl; i35++) {
-          vec_data[i35] += (float)f_c;
-        }
-
-        if (b_ndbl == d_ndbl) {
-          i35 = A->size[0] * A->size[1];
-          A->size[0] = b_ndbl;
-          A->size[1] = d_ndbl;
-          emxEnsureCapacity((emxArray__common *)A, i35, (int)sizeof(float));
-          loop_ub = b_ndbl * d_ndbl;
-          for (i35 = 0; i35 < loop_ub; i35++) {
-            A->data[i35] = S_feature_data[i35];
-          }
-
-          xgetrf(d_ndbl, d_ndbl, A, d_ndbl, jpvt, &idx);
-          ia = c_ndbl;
-          for (i35 = 0; i35 < c_ndbl; i35++) {
-            i_c_data[i35] = r->data[(int)c_xt[i35] - 1];
-          }
-
-          for (ib = 0; ib + 1 <= d_ndbl; ib++) {
-            br = d_ndbl * ib;
-            for (mn = 0; mn + 1 <= ib; mn++) {
-              if (A->data[mn + br] != 0.0F) {
-                i_c_data[ib] -= A->data[mn + br] * i_c_data[mn];
-              }
-            }
-
-            wj = A->data[ib + br];
-            i_c_data[ib] *= 1.0F / wj;
-          }
-
-          for (ib = d_ndbl; ib > 0; ib--) {
-            br = d_ndbl * (ib - 1);
-            for (mn = ib; mn + 1 <= d_ndbl; mn++) {
-              if (A->data[mn + br] != 0.0F) {
-                i_c_data[ib - 1] -= A->data[mn + br] * i_c_data[mn];
-              }
-            }
-          }
-
-          for (ar = d_ndbl - 2; ar + 1 > 0; ar--) {
-            if (jpvt->data[ar] != ar + 1) {
-              wj = i_c_data[ar];
-              i_c_data[ar] = i_c_data[jpvt->data[ar] - 1];
-              i_c_data[jpvt->data[ar] - 1] = wj;
-            }
-          }
-        } else {
-          i35 = A->size[0] * A->size[1];
-          A->size[0] = d_ndbl;
-          A->size[1] = b_ndbl;
-          emxEnsureCapacity((emxArray__common *)A, i35, (int)sizeof(float));
-          for (i35 = 0; i35 < b_ndbl; i35++) {
-            for (i36 = 0; i36 < d_ndbl; i36++) {
-              A->data[i36 + A->size[0] * i35] = S_feature_data[i35 + b_ndbl *
-                i36];
-            }
-          }
-
-          xgeqp3(A, tau, jpvt);
-          ar = rankFromQR(A);
-          ia = A->size[1];
-          for (i35 = 0; i35 < ia; i35++) {
-            H_c_data[i35] = 0.0F;
-          }
-
-          for (i35 = 0; i35 < c_ndbl; i35++) {
-            B_data[i35] = r->data[(int)c_xt[i35] - 1];
-          }
-
-          b_m = A->size[0];
-          idx = A->size[0];
-          mn = A->size[1];
-          if (idx <= mn) {
-            mn = idx;
-          }
-
-          for (ib = 0; ib + 1 <= mn; ib++) {
-            if (tau->data[ib] != 0.0F) {
-              wj = B_data[ib];
-              for (ic = ib + 1; ic + 1 <= b_m; ic++) {
-                wj += A->data[ic + A->size[0] * ib] * B_data[ic];
-              }
-
-              wj *= tau->data[ib];
-              if (wj != 0.0F) {
-                B_data[ib] -= wj;
-                for (ic = ib + 1; ic + 1 <= b_m; ic++) {
-                  B_data[ic] -= A->data[ic + A->size[0] * ib] * wj;
-                }
-              }
-            }
-          }
-
-          for (ic = 0; ic + 1 <= ar; ic++) {
-            H_c_data[jpvt->data[ic] - 1] = B_data[ic];
-          }
-
-          for (ib = ar - 1; ib + 1 > 0; ib--) {
-            idx = jpvt->data[ib];
-            H_c_data[jpvt->data[ib] - 1] /= A->data[ib + A->size[0] * ib];
-            for (ic = 0; ic + 1 <= ib; ic++) {
-              H_c_data[jpvt->data[ic] - 1] -= H_c_data[idx - 1] * A->data[ic +
-                A->size[0] * ib];
-            }
-          }
-
-          for (i35 = 0; i35 < ia; i35++) {
-            i_c_data[i35] = H_c_data[i35];
-          }
-        }
-
-        for (i35 = 0; i35 < ndbl; i35++) {
-          H_c_data[i35] = r->data[(int)vec_data[i35] - 1];
-        }
-
-        if ((ia == 1) || (ndbl == 1)) {
-          wj = 0.0F;
-          for (i35 = 0; i35 < ia; i35++) {
-            wj += i_c_data[i35] * H_c_data[i35];
-          }
-
-          innov = wj;
-        } else {
-          wj = 0.0F;
-          for (i35 = 0; i35 < ia; i35++) {
-            wj += i_c_data[i35] * H_c_data[i35];
-          }
-
-          innov = wj;
-        }
-
-        // 'OnePointRANSAC_EKF:222' if innov > mahalanobis_thresh
-        if (innov > mahalanobis_thresh) {
-          // 'OnePointRANSAC_EKF:223' r((k-1)*residualDim + (1:residualDim)) = 0; 
-          f_c = k * residualDim;
-          b_ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-          ar = b_ndbl + 1;
-          idx = (b_ndbl - residualDim) + 1;
-          if (fabs((double)idx) < 2.38418579E-7F * (float)residualDim) {
-            b_ndbl++;
-            ar = residualDim;
-          } else if (idx > 0) {
-            ar = b_ndbl;
-          } else {
-            b_ndbl++;
-          }
-
-          c_xt[0] = 1.0F;
-          if (b_ndbl > 1) {
-            c_xt[b_ndbl - 1] = (float)ar;
-            i35 = b_ndbl - 1;
-            idx = i35 / 2;
-            mn = 1;
-            while (mn <= idx - 1) {
-              c_xt[1] = 2.0F;
-              c_xt[b_ndbl - 2] = (float)ar - 1.0F;
-              mn = 2;
-            }
-
-            if (idx << 1 == b_ndbl - 1) {
-              c_xt[idx] = (1.0F + (float)ar) / 2.0F;
-            } else {
-              c_xt[idx] = 1.0F + (float)idx;
-              c_xt[idx + 1] = (float)(ar - idx);
-            }
-          }
-
-          for (i35 = 0; i35 < b_ndbl; i35++) {
-            b_tmp_data[i35] = (int)((float)f_c + c_xt[i35]);
-          }
-
-          for (i35 = 0; i35 < b_ndbl; i35++) {
-            r->data[b_tmp_data[i35] - 1] = 0.0F;
-          }
-
-          // 'OnePointRANSAC_EKF:224' H((k-1)*residualDim + (1:residualDim), :) = 0; 
-          f_c = k * residualDim;
-          b_ndbl = (int)floor(((double)residualDim - 1.0) + 0.5);
-          ar = b_ndbl + 1;
-          idx = (b_ndbl - residualDim) + 1;
-          if (fabs((double)idx) < 2.38418579E-7F * (float)residualDim) {
-            b_ndbl++;
-            ar = residualDim;
-          } else if (idx > 0) {
-            ar = b_ndbl;
-          } else {
-            b_ndbl++;
-          }
-
-          c_xt[0] = 1.0F;
-          if (b_ndbl > 1) {
-            c_xt[b_ndbl - 1] = (float)ar;
-            i35 = b_ndbl - 1;
-            idx = i35 / 2;
-            mn = 1;
-            while (mn <= idx - 1) {
-              c_xt[1] = 2.0F;
-              c_xt[b_ndbl - 2] = (float)ar - 1.0F;
-              mn = 2;
-            }
-
-            if (idx << 1 == b_ndbl - 1) {
-              c_xt[idx] = (1.0F + (float)ar) / 2.0F;
-            } else {
-              c_xt[idx] = 1.0F + (float)idx;
-              c_xt[idx + 1] = (float)(ar - idx);
-            }
-          }
-
-          for (i35 = 0; i35 < b_ndbl; i35++) {
-            tmp_data[i35] = (int)((float)f_c + c_xt[i35]);
-          }
-
-          for (i35 = 0; i35 < 102; i35++) {
-            for (i36 = 0; i36 < b_ndbl; i36++) {
-              b_H->data[(tmp_data[i36] + b_H->size[0] * i35) - 1] = 0.0F;
-            }
-          }
-
-          // 'OnePointRANSAC_EKF:225' if it == VIOParameters.max_ekf_iterations
-          if (it == c_VIOParameters_max_ekf_iterati) {
-            // 'OnePointRANSAC_EKF:226' HI_inlierStatus(HI_ind(k)) = false;
-            HI_inlierStatus[(int)out->data[k] - 1] = false;
-
-            //  only reject the feature if its still bad in last iteration, otherwise just dont use for this update 
-          }
-
-          //                  log_info('rejecting %i', HI_ind(k))
-          // 'OnePointRANSAC_EKF:229' if updateVect(HI_ind(k)) == 2
-          if (updateVect[(int)out->data[k] - 1] == 2) {
-            // 'OnePointRANSAC_EKF:230' log_error('inconsistency')
-            b_log_error();
-          }
-        }
-      }
-
-      // 'OnePointRANSAC_EKF:235' S = (H*P*H');
-      H_idx_0 = (unsigned int)b_H->size[0];
-      i35 = k_c->size[0] * k_c->size[1];
-      k_c->size[0] = (int)H_idx_0;
-      k_c->size[1] = 102;
-      emxEnsureCapacity((emxArray__common *)k_c, i35, (int)sizeof(float));
-      b_m = b_H->size[0];
-      i35 = k_c->size[0] * k_c->size[1];
-      k_c->size[1] = 102;
-      emxEnsureCapacity((emxArray__common *)k_c, i35, (int)sizeof(float));
-      for (i35 = 0; i35 < 102; i35++) {
-        loop_ub = k_c->size[0];
-        for (i36 = 0; i36 < loop_ub; i36++) {
-          k_c->data[i36 + k_c->size[0] * i35] = 0.0F;
-        }
-      }
-
-      if (b_H->size[0] == 0) {
-      } else {
-        f_c = b_H->size[0] * 101;
-        mn = 0;
-        while ((b_m > 0) && (mn <= f_c)) {
-          i35 = mn + b_m;
-          for (ic = mn; ic + 1 <= i35; ic++) {
-            k_c->data[ic] = 0.0F;
-          }
-
-          mn += b_m;
-        }
-
-        br = 0;
-        mn = 0;
-        while ((b_m > 0) && (mn <= f_c)) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 102; ib++) {
-            if (b_P[ib] != 0.0F) {
-              ia = ar;
-              i35 = mn + b_m;
-              for (ic = mn; ic + 1 <= i35; ic++) {
-                ia++;
-                k_c->data[ic] += b_P[ib] * b_H->data[ia - 1];
-              }
-            }
-
-            ar += b_m;
-          }
-
-          br += 102;
-          mn += b_m;
-        }
-      }
-
-      i35 = c_H->size[0] * c_H->size[1];
-      c_H->size[0] = b_H->size[1];
-      c_H->size[1] = b_H->size[0];
-      emxEnsureCapacity((emxArray__common *)c_H, i35, (int)sizeof(float));
-      loop_ub = b_H->size[0];
-      for (i35 = 0; i35 < loop_ub; i35++) {
-        br = b_H->size[1];
-        for (i36 = 0; i36 < br; i36++) {
-          c_H->data[i36 + c_H->size[0] * i35] = b_H->data[i35 + b_H->size[0] *
-            i36];
-        }
-      }
-
-      mn = b_H->size[0];
-      i35 = K->size[0] * K->size[1];
-      K->size[0] = 102;
-      K->size[1] = mn;
-      emxEnsureCapacity((emxArray__common *)K, i35, (int)sizeof(float));
-      for (i35 = 0; i35 < mn; i35++) {
-        for (i36 = 0; i36 < 102; i36++) {
-          K->data[i36 + K->size[0] * i35] = c_H->data[i36 + 102 * i35];
-        }
-      }
-
-      H_idx_0 = (unsigned int)k_c->size[0];
-      unnamed_idx_1 = (unsigned int)K->size[1];
-      i35 = S->size[0] * S->size[1];
-      S->size[0] = (int)H_idx_0;
-      S->size[1] = (int)unnamed_idx_1;
-      emxEnsureCapacity((emxArray__common *)S, i35, (int)sizeof(float));
-      b_m = k_c->size[0];
-      i35 = S->size[0] * S->size[1];
-      emxEnsureCapacity((emxArray__common *)S, i35, (int)sizeof(float));
-      loop_ub = S->size[1];
-      for (i35 = 0; i35 < loop_ub; i35++) {
-        br = S->size[0];
-        for (i36 = 0; i36 < br; i36++) {
-          S->data[i36 + S->size[0] * i35] = 0.0F;
-        }
-      }
-
-      if ((k_c->size[0] == 0) || (K->size[1] == 0)) {
-      } else {
-        f_c = k_c->size[0] * (K->size[1] - 1);
-        mn = 0;
-        while ((b_m > 0) && (mn <= f_c)) {
-          i35 = mn + b_m;
-          for (ic = mn; ic + 1 <= i35; ic++) {
-            S->data[ic] = 0.0F;
-          }
-
-          mn += b_m;
-        }
-
-        br = 0;
-        mn = 0;
-        while ((b_m > 0) && (mn <= f_c)) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 102; ib++) {
-            if (K->data[ib] != 0.0F) {
-              ia = ar;
-              i35 = mn + b_m;
-              for (ic = mn; ic + 1 <= i35; ic++) {
-                ia++;
-                S->data[ic] += K->data[ib] * k_c->data[ia - 1];
-              }
-            }
-
-            ar += b_m;
-          }
-
-          br += 102;
-          mn += b_m;
-        }
-      }
-
-      // 'OnePointRANSAC_EKF:236' size_S = num_HI_inlierCandidates*residualDim;
-      size_S = (float)n * (float)residualDim;
-
-      // 'OnePointRANSAC_EKF:237' S(1:(size_S+1):size_S^2) = S(1:(size_S+1):size_S^2) + noiseParameters.image_noise; 
-      wj = size_S * size_S;
-      if ((size_S + 1.0F == 0.0F) || (((size_S + 1.0F > 0.0F) && (1.0F > wj)) ||
-           ((0.0F > size_S + 1.0F) && (wj > 1.0F)))) {
-        i35 = 1;
-        i36 = -1;
-      } else {
-        i35 = (int)(size_S + 1.0F);
-        i36 = (int)wj - 1;
-      }
-
-      wj = size_S * size_S;
-      if ((size_S + 1.0F == 0.0F) || (((size_S + 1.0F > 0.0F) && (1.0F > wj)) ||
-           ((0.0F > size_S + 1.0F) && (wj > 1.0F)))) {
-        ar = 1;
-      } else {
-        ar = (int)(size_S + 1.0F);
-      }
-
-      mn = c_S->size[0] * c_S->size[1];
-      c_S->size[0] = 1;
-      c_S->size[1] = div_s32_floor(i36, i35) + 1;
-      emxEnsureCapacity((emxArray__common *)c_S, mn, (int)sizeof(float));
-      loop_ub = div_s32_floor(i36, i35);
-      for (i36 = 0; i36 <= loop_ub; i36++) {
-        c_S->data[c_S->size[0] * i36] = S->data[i35 * i36] +
-          noiseParameters_image_noise;
-      }
-
-      loop_ub = c_S->size[1];
-      for (i35 = 0; i35 < loop_ub; i35++) {
-        S->data[ar * i35] = c_S->data[c_S->size[0] * i35];
-      }
-
-      //  add R to HPH'
-      // 'OnePointRANSAC_EKF:239' K = (P*H')/S;
-      i35 = d_H->size[0] * d_H->size[1];
-      d_H->size[0] = b_H->size[1];
-      d_H->size[1] = b_H->size[0];
-      emxEnsureCapacity((emxArray__common *)d_H, i35, (int)sizeof(float));
-      loop_ub = b_H->size[0];
-      for (i35 = 0; i35 < loop_ub; i35++) {
-        br = b_H->size[1];
-        for (i36 = 0; i36 < br; i36++) {
-          d_H->data[i36 + d_H->size[0] * i35] = b_H->data[i35 + b_H->size[0] *
-            i36];
+          br = b_H->size[1];
+          for (i36 = 0; i36 < br; i36++) {
+            c_H->data[i36 + c_H->size[0] * i35] = b_H->data[i35 + b_H->size[0] *
+              i36];
+          }
         }
-      }
 
-      mn = b_H->size[0];
-      i35 = K->size[0] * K->size[1];
-      K->size[0] = 102;
-      K->size[1] = mn;
-      emxEnsureCapacity((emxArray__common *)K, i35, (int)sizeof(float));
-      for (i35 = 0; i35 < mn; i35++) {
-        for (i36 = 0; i36 < 102; i36++) {
-          K->data[i36 + K->size[0] * i35] = d_H->data[i36 + 102 * i35];
+        mn = b_H->size[0];
+        i35 = K->size[0] * K->size[1];
+        K->size[0] = 102;
+        K->size[1] = mn;
+        emxEnsureCapacity((emxArray__common *)K, i35, (int)sizeof(float));
+        for (i35 = 0; i35 < mn; i35++) {
+          for (i36 = 0; i36 < 102; i36++) {
+            K->data[i36 + K->size[0] * i35] = c_H->data[i36 + 102 * i35];
+          }
         }
-      }
 
-      unnamed_idx_1 = (unsigned int)K->size[1];
-      i35 = l_c->size[0] * l_c->size[1];
-      l_c->size[0] = 102;
-      l_c->size[1] = (int)unnamed_idx_1;
-      l_c->size[0] = 102;
-      emxEnsureCapacity((emxArray__common *)l_c, i35, (int)sizeof(float));
-      loop_ub = l_c->size[1];
-      for (i35 = 0; i35 < loop_ub; i35++) {
-        for (i36 = 0; i36 < 102; i36++) {
-          l_c->data[i36 + l_c->size[0] * i35] = 0.0F;
+        H_idx_0 = (unsigned int)k_c->size[0];
+        unnamed_idx_1 = (unsigned int)K->size[1];
+        i35 = S->size[0] * S->size[1];
+        S->size[0] = (int)H_idx_0;
+        S->size[1] = (int)unnamed_idx_1;
+        emxEnsureCapacity((emxArray__common *)S, i35, (int)sizeof(float));
+        b_m = k_c->size[0];
+        i35 = S->size[0] * S->size[1];
+        emxEnsureCapacity((emxArray__common *)S, i35, (int)sizeof(float));
+        loop_ub = S->size[1];
+        for (i35 = 0; i35 < loop_ub; i35++) {
+          br = S->size[0];
+          for (i36 = 0; i36 < br; i36++) {
+            S->data[i36 + S->size[0] * i35] = 0.0F;
+          }
         }
-      }
 
-      if (K->size[1] == 0) {
-      } else {
-        f_c = 102 * (K->size[1] - 1);
-        for (mn = 0; mn <= f_c; mn += 102) {
-          for (ic = mn + 1; ic <= mn + 102; ic++) {
-            l_c->data[ic - 1] = 0.0F;
+        if ((k_c->size[0] == 0) || (K->size[1] == 0)) {
+        } else {
+          f_c = k_c->size[0] * (K->size[1] - 1);
+          mn = 0;
+          while ((b_m > 0) && (mn <= f_c)) {
+            i35 = mn + b_m;
+            for (ic = mn; ic + 1 <= i35; ic++) {
+              S->data[ic] = 0.0F;
+            }
+
+            mn += b_m;
           }
-        }
 
-        br = 0;
-        for (mn = 0; mn <= f_c; mn += 102) {
-          ar = 0;
-          for (ib = br; ib + 1 <= br + 102; ib++) {
-            if (K->data[ib] != 0.0F) {
-              ia = ar;
-              for (ic = mn; ic + 1 <= mn + 102; ic++) {
-                ia++;
-                l_c->data[ic] += K->data[ib] * b_P[ia - 1];
+          br = 0;
+          mn = 0;
+          while ((b_m > 0) && (mn <= f_c)) {
+            ar = 0;
+            for (ib = br; ib + 1 <= br + 102; ib++) {
+              if (K->data[ib] != 0.0F) {
+                ia = ar;
+                i35 = mn + b_m;
+                for (ic = mn; ic + 1 <= i35; ic++) {
+                  ia++;
+                  S->data[ic] += K->data[ib] * k_c->data[ia - 1];
+                }
               }
+
+              ar += b_m;
             }
 
-            ar += 102;
+            br += 102;
+            mn += b_m;
           }
+        }
 
-          br += 102;
+        // 'OnePointRANSAC_EKF:236' size_S = num_HI_inlierCandidates*residualDim;
+        size_S = (float)n * (float)residualDim;
+
+        // 'OnePointRANSAC_EKF:237' S(1:(size_S+1):size_S^2) = S(1:(size_S+1):size_S^2) + noiseParameters.image_noise; 
+        wj = size_S * size_S;
+        if ((size_S + 1.0F == 0.0F) || (((size_S + 1.0F > 0.0F) && (1.0F > wj)) ||
+             ((0.0F > size_S + 1.0F) && (wj > 1.0F)))) {
+          i35 = 1;
+          i36 = -1;
+        } else {
+          i35 = (int)(size_S + 1.0F);
+          i36 = (int)wj - 1;
         }
-      }
 
-      if ((l_c->size[1] == 0) || ((S->size[0] == 0) || (S->size[1] == 0))) {
-        unnamed_idx_1 = (unsigned int)S->size[0];
-        i35 = c->size[0] * c->size[1];
-        c->size[0] = 102;
-        c->size[1] = (int)unnamed_idx_1;
-        emxEnsureCapacity((emxArray__common *)c, i35, (int)sizeof(float));
-        loop_ub = 102 * (int)unnamed_idx_1;
-        for (i35 = 0; i35 < loop_ub; i35++) {
-          c->data[i35] = 0.0F;
+        wj = size_S * size_S;
+        if ((size_S + 1.0F == 0.0F) || (((size_S + 1.0F > 0.0F) && (1.0F > wj)) ||
+             ((0.0F > size_S + 1.0F) && (wj > 1.0F)))) {
+          ar = 1;
+        } else {
+          ar = (int)(size_S + 1.0F);
         }
-      } else if (S->size[0] == S->size[1]) {
-        ar = S->size[1];
-        i35 = A->size[0] * A->size[1];
-        A->size[0] = S->size[0];
-        A->size[1] = S->size[1];
-        emxEnsureCapacity((emxArray__common *)A, i35, (int)sizeof(float));
-        loop_ub = S->size[0] * S->size[1];
+
+        mn = c_S->size[0] * c_S->size[1];
+        c_S->size[0] = 1;
+        c_S->size[1] = div_s32_floor(i36, i35) + 1;
+        emxEnsureCapacity((emxArray__common *)c_S, mn, (int)sizeof(float));
+        loop_ub = div_s32_floor(i36, i35);
+        for (i36 = 0; i36 <= loop_ub; i36++) {
+          c_S->data[c_S->size[0] * i36] = S->data[i35 * i36] +
+            noiseParameters_image_noise;
+        }
+
+        loop_ub = c_S->size[1];
         for (i35 = 0; i35 < loop_ub; i35++) {
-          A->data[i35] = S->data[i35];
+          S->data[ar * i35] = c_S->data[c_S->size[0] * i35];
         }
 
-        xgetrf(S->size[1], S->size[1], A, S->size[1], jpvt, &idx);
-        i35 = c->size[0] * c->size[1];
-        c->size[0] = 102;
-        c->size[1] = l_c->size[1];
-        emxEnsureCapacity((emxArray__common *)c, i35, (int)sizeof(float));
-        loop_ub = l_c->size[0] * l_c->size[1];
+        //  add R to HPH'
+        // 'OnePointRANSAC_EKF:239' K = (P*H')/S;
+        i35 = d_H->size[0] * d_H->size[1];
+        d_H->size[0] = b_H->size[1];
+        d_H->size[1] = b_H->size[0];
+        emxEnsureCapacity((emxArray__common *)d_H, i35, (int)sizeof(float));
+        loop_ub = b_H->size[0];
         for (i35 = 0; i35 < loop_ub; i35++) {
-          c->data[i35] = l_c->data[i35];
+          br = b_H->size[1];
+          for (i36 = 0; i36 < br; i36++) {
+            d_H->data[i36 + d_H->size[0] * i35] = b_H->data[i35 + b_H->size[0] *
+              i36];
+          }
         }
 
-        for (ib = 0; ib + 1 <= ar; ib++) {
-          idx = 102 * ib;
-          br = ar * ib;
-          for (k = 1; k <= ib; k++) {
-            mn = 102 * (k - 1);
-            if (A->data[(k + br) - 1] != 0.0F) {
-              for (ic = 0; ic < 102; ic++) {
-                c->data[ic + idx] -= A->data[(k + br) - 1] * c->data[ic + mn];
-              }
-            }
+        mn = b_H->size[0];
+        i35 = K->size[0] * K->size[1];
+        K->size[0] = 102;
+        K->size[1] = mn;
+        emxEnsureCapacity((emxArray__common *)K, i35, (int)sizeof(float));
+        for (i35 = 0; i35 < mn; i35++) {
+          for (i36 = 0; i36 < 102; i36++) {
+            K->data[i36 + K->size[0] * i35] = d_H->data[i36 + 102 * i35];
           }
+        }
 
-          wj = 1.0F / A->data[ib + br];
-          for (ic = 0; ic < 102; ic++) {
-            c->data[ic + idx] *= wj;
+        unnamed_idx_1 = (unsigned int)K->size[1];
+        i35 = l_c->size[0] * l_c->size[1];
+        l_c->size[0] = 102;
+        l_c->size[1] = (int)unnamed_idx_1;
+        l_c->size[0] = 102;
+        emxEnsureCapacity((emxArray__common *)l_c, i35, (int)sizeof(float));
+        loop_ub = l_c->size[1];
+        for (i35 = 0; i35 < loop_ub; i35++) {
+          for (i36 = 0; i36 < 102; i36++) {
+            l_c->data[i36 + l_c->size[0] * i35] = 0.0F;
           }
         }
 
-        for (ib = S->size[1]; ib > 0; ib--) {
-          idx = 102 * (ib - 1);
-          br = ar * (ib - 1) - 1;
-          for (k = ib + 1; k <= ar; k++) {
-            mn = 102 * (k - 1);
-            if (A->data[k + br] != 0.0F) {
-              for (ic = 0; ic < 102; ic++) {
-                c->data[ic + idx] -= A->data[k + br] * c->data[ic + mn];
+        if (K->size[1] == 0) {
+        } else {
+          f_c = 102 * (K->size[1] - 1);
+          for (mn = 0; mn <= f_c; mn += 102) {
+            for (ic = mn + 1; ic <= mn + 102; ic++) {
+              l_c->data[ic - 1] = 0.0F;
+            }
+          }
+
+          br = 0;
+          for (mn = 0; mn <= f_c; mn += 102) {
+            ar = 0;
+            for (ib = br; ib + 1 <= br + 102; ib++) {
+              if (K->data[ib] != 0.0F) {
+                ia = ar;
+                for (ic = mn; ic + 1 <= mn + 102; ic++) {
+                  ia++;
+                  l_c->data[ic] += K->data[ib] * b_P[ia - 1];
+                }
               }
+
+              ar += 102;
             }
+
+            br += 102;
           }
         }
 
-        for (ar = S->size[1] - 2; ar + 1 > 0; ar--) {
-          if (jpvt->data[ar] != ar + 1) {
-            mn = jpvt->data[ar] - 1;
-            for (idx = 0; idx < 102; idx++) {
-              wj = c->data[idx + c->size[0] * ar];
-              c->data[idx + c->size[0] * ar] = c->data[idx + c->size[0] * mn];
-              c->data[idx + c->size[0] * mn] = wj;
-            }
+        if ((l_c->size[1] == 0) || ((S->size[0] == 0) || (S->size[1] == 0))) {
+          unnamed_idx_1 = (unsigned int)S->size[0];
+          i35 = c->size[0] * c->size[1];
+          c->size[0] = 102;
+          c->size[1] = (int)unnamed_idx_1;
+          emxEnsureCapacity((emxArray__common *)c, i35, (int)sizeof(float));
+          loop_ub = 102 * (int)unnamed_idx_1;
+          for (i35 = 0; i35 < loop_ub; i35++) {
+            c->data[i35] = 0.0F;
           }
-        }
-      } else {
-        i35 = A->size[0] * A->size[1];
-        A->size[0] = S->size[1];
-        A->size[1] = S->size[0];
-        emxEnsureCapacity((emxArray__common *)A, i35, (int)sizeof(float));
-        loop_ub = S->size[0];
-        for (i35 = 0; i35 < loop_ub; i35++) {
-          br = S->size[1];
-          for (i36 = 0; i36 < br; i36++) {
-            A->data[i36 + A->size[0] * i35] = S->data[i35 + S->size[0] * i36];
+        } else if (S->size[0] == S->size[1]) {
+          ar = S->size[1];
+          i35 = A->size[0] * A->size[1];
+          A->size[0] = S->size[0];
+          A->size[1] = S->size[1];
+          emxEnsureCapacity((emxArray__common *)A, i35, (int)sizeof(float));
+          loop_ub = S->size[0] * S->size[1];
+          for (i35 = 0; i35 < loop_ub; i35++) {
+            A->data[i35] = S->data[i35];
           }
-        }
 
-        xgeqp3(A, tau, jpvt);
-        ar = rankFromQR(A);
-        ia = A->size[1];
-        i35 = Y->size[0] * Y->size[1];
-        Y->size[0] = ia;
-        Y->size[1] = 102;
-        emxEnsureCapacity((emxArray__common *)Y, i35, (int)sizeof(float));
-        loop_ub = ia * 102;
-        for (i35 = 0; i35 < loop_ub; i35++) {
-          Y->data[i35] = 0.0F;
-        }
+          xgetrf(S->size[1], S->size[1], A, S->size[1], jpvt, &idx);
+          i35 = c->size[0] * c->size[1];
+          c->size[0] = 102;
+          c->size[1] = l_c->size[1];
+          emxEnsureCapacity((emxArray__common *)c, i35, (int)sizeof(float));
+          loop_ub = l_c->size[0] * l_c->size[1];
+          for (i35 = 0; i35 < loop_ub; i35++) {
+            c->data[i35] = l_c->data[i35];
+          }
 
-        i35 = B->size[0] * B->size[1];
-        B->size[0] = l_c->size[1];
-        B->size[1] = 102;
-        emxEnsureCapacity((emxArray__common *)B, i35, (int)sizeof(float));
-        for (i35 = 0; i35 < 102; i35++) {
-          loop_ub = l_c->size[1];
-          for (i36 = 0; i36 < loop_ub; i36++) {
-            B->data[i36 + B->size[0] * i35] = l_c->data[i35 + l_c->size[0] * i36];
+          for (ib = 0; ib + 1 <= ar; ib++) {
+            idx = 102 * ib;
+            br = ar * ib;
+            for (k = 1; k <= ib; k++) {
+              mn = 102 * (k - 1);
+              if (A->data[(k + br) - 1] != 0.0F) {
+                for (ic = 0; ic < 102; ic++) {
+                  c->data[ic + idx] -= A->data[(k + br) - 1] * c->data[ic + mn];
+                }
+              }
+            }
+
+            wj = 1.0F / A->data[ib + br];
+            for (ic = 0; ic < 102; ic++) {
+              c->data[ic + idx] *= wj;
+            }
           }
-        }
 
-        b_m = A->size[0];
-        idx = A->size[0];
-        mn = A->size[1];
-        if (idx <= mn) {
-          mn = idx;
-        }
+          for (ib = S->size[1]; ib > 0; ib--) {
+            idx = 102 * (ib - 1);
+            br = ar * (ib - 1) - 1;
+            for (k = ib + 1; k <= ar; k++) {
+              mn = 102 * (k - 1);
+              if (A->data[k + br] != 0.0F) {
+                for (ic = 0; ic < 102; ic++) {
+                  c->data[ic + idx] -= A->data[k + br] * c->data[ic + mn];
+                }
+              }
+            }
+          }
 
-        for (ib = 0; ib + 1 <= mn; ib++) {
-          if (tau->data[ib] != 0.0F) {
-            for (k = 0; k < 102; k++) {
-              wj = B->data[ib + B->size[0] * k];
-              for (ic = ib + 1; ic + 1 <= b_m; ic++) {
-                wj += A->data[ic + A->size[0] * ib] * B->data[ic + B->size[0] *
-                  k];
+          for (ar = S->size[1] - 2; ar + 1 > 0; ar--) {
+            if (jpvt->data[ar] != ar + 1) {
+              mn = jpvt->data[ar] - 1;
+              for (idx = 0; idx < 102; idx++) {
+                wj = c->data[idx + c->size[0] * ar];
+                c->data[idx + c->size[0] * ar] = c->data[idx + c->size[0] * mn];
+                c->data[idx + c->size[0] * mn] = wj;
               }
+            }
+          }
+        } else {
+          i35 = A->size[0] * A->size[1];
+          A->size[0] = S->size[1];
+          A->size[1] = S->size[0];
+          emxEnsureCapacity((emxArray__common *)A, i35, (int)sizeof(float));
+          loop_ub = S->size[0];
+          for (i35 = 0; i35 < loop_ub; i35++) {
+            br = S->size[1];
+            for (i36 = 0; i36 < br; i36++) {
+              A->data[i36 + A->size[0] * i35] = S->data[i35 + S->size[0] * i36];
+            }
+          }
 
-              wj *= tau->data[ib];
-              if (wj != 0.0F) {
-                B->data[ib + B->size[0] * k] -= wj;
+          xgeqp3(A, tau, jpvt);
+          ar = rankFromQR(A);
+          ia = A->size[1];
+          i35 = Y->size[0] * Y->size[1];
+          Y->size[0] = ia;
+          Y->size[1] = 102;
+          emxEnsureCapacity((emxArray__common *)Y, i35, (int)sizeof(float));
+          loop_ub = ia * 102;
+          for (i35 = 0; i35 < loop_ub; i35++) {
+            Y->data[i35] = 0.0F;
+          }
+
+          i35 = B->size[0] * B->size[1];
+          B->size[0] = l_c->size[1];
+          B->size[1] = 102;
+          emxEnsureCapacity((emxArray__common *)B, i35, (int)sizeof(float));
+          for (i35 = 0; i35 < 102; i35++) {
+            loop_ub = l_c->size[1];
+            for (i36 = 0; i36 < loop_ub; i36++) {
+              B->data[i36 + B->size[0] * i35] = l_c->data[i35 + l_c->size[0] * i36];
+            }
+          }
+
+          b_m = A->size[0];
+          idx = A->size[0];
+          mn = A->size[1];
+          if (idx <= mn) {
+            mn = idx;
+          }
+
+          for (ib = 0; ib + 1 <= mn; ib++) {
+            if (tau->data[ib] != 0.0F) {
+              for (k = 0; k < 102; k++) {
+                wj = B->data[ib + B->size[0] * k];
                 for (ic = ib + 1; ic + 1 <= b_m; ic++) {
-                  B->data[ic + B->size[0] * k] -= A->data[ic + A->size[0] * ib] *
-                    wj;
+                  wj += A->data[ic + A->size[0] * ib] * B->data[ic + B->size[0] *
+                    k];
+                }
+
+                wj *= tau->data[ib];
+                if (wj != 0.0F) {
+                  B->data[ib + B->size[0] * k] -= wj;
+                  for (ic = ib + 1; ic + 1 <= b_m; ic++) {
+                    B->data[ic + B->size[0] * k] -= A->data[ic + A->size[0] * ib] *
+                      wj;
+                  }
                 }
               }
             }
           }
-        }
 
-        for (k = 0; k < 102; k++) {
-          for (ic = 0; ic + 1 <= ar; ic++) {
-            Y->data[(jpvt->data[ic] + Y->size[0] * k) - 1] = B->data[ic +
-              B->size[0] * k];
+          for (k = 0; k < 102; k++) {
+            for (ic = 0; ic + 1 <= ar; ic++) {
+              Y->data[(jpvt->data[ic] + Y->size[0] * k) - 1] = B->data[ic +
+                B->size[0] * k];
+            }
+
+            for (ib = ar - 1; ib + 1 > 0; ib--) {
+              Y->data[(jpvt->data[ib] + Y->size[0] * k) - 1] /= A->data[ib +
+                A->size[0] * ib];
+              for (ic = 0; ic + 1 <= ib; ic++) {
+                Y->data[(jpvt->data[ic] + Y->size[0] * k) - 1] -= Y->data
+                  [(jpvt->data[ib] + Y->size[0] * k) - 1] * A->data[ic + A->size[0]
+                  * ib];
+              }
+            }
           }
 
-          for (ib = ar - 1; ib + 1 > 0; ib--) {
-            Y->data[(jpvt->data[ib] + Y->size[0] * k) - 1] /= A->data[ib +
-              A->size[0] * ib];
-            for (ic = 0; ic + 1 <= ib; ic++) {
-              Y->data[(jpvt->data[ic] + Y->size[0] * k) - 1] -= Y->data
-                [(jpvt->data[ib] + Y->size[0] * k) - 1] * A->data[ic + A->size[0]
-                * ib];
+          i35 = c->size[0] * c->size[1];
+          c->size[0] = 102;
+          c->size[1] = Y->size[0];
+          emxEnsureCapacity((emxArray__common *)c, i35, (int)sizeof(float));
+          loop_ub = Y->size[0];
+          for (i35 = 0; i35 < loop_ub; i35++) {
+            for (i36 = 0; i36 < 102; i36++) {
+              c->data[i36 + c->size[0] * i35] = Y->data[i35 + Y->size[0] * i36];
             }
           }
         }
 
-        i35 = c->size[0] * c->size[1];
-        c->size[0] = 102;
-        c->size[1] = Y->size[0];
-        emxEnsureCapacity((emxArray__common *)c, i35, (int)sizeof(float));
-        loop_ub = Y->size[0];
+        i35 = b_K->size[0] * b_K->size[1];
+        b_K->size[0] = 102;
+        b_K->size[1] = c->size[1];
+        emxEnsureCapacity((emxArray__common *)b_K, i35, (int)sizeof(float));
+        loop_ub = c->size[0] * c->size[1];
         for (i35 = 0; i35 < loop_ub; i35++) {
-          for (i36 = 0; i36 < 102; i36++) {
-            c->data[i36 + c->size[0] * i35] = Y->data[i35 + Y->size[0] * i36];
-          }
+          b_K->data[i35] = c->data[i35];
         }
       }
 
-      i35 = b_K->size[0] * b_K->size[1];
-      b_K->size[0] = 102;
-      b_K->size[1] = c->size[1];
-      emxEnsureCapacity((emxArray__common *)b_K, i35, (int)sizeof(float));
-      loop_ub = c->size[0] * c->size[1];
-      for (i35 = 0; i35 < loop_ub; i35++) {
-        b_K->data[i35] = c->data[i35];
-      }
-
       // 'OnePointRANSAC_EKF:241' x_it2 = K*(r + H * x_it);
       H_idx_0 = (unsigned int)b_H->size[0];
       i35 = m_c->size[0];
@@ -5185,6 +4175,13 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
     emxFree_real32_T(&l_c);
     emxFree_real32_T(&k_c);
 
+    telemetry.ekf_iterations = it - 1;
+    for (k = 0; k < 48; k++) {
+      if (HI_inlierStatus[k]) {
+        telemetry.hi_inliers++;
+      }
+    }
+
     // 'OnePointRANSAC_EKF:285' xt = xt_it;
     *b_xt = xt_it;
 
@@ -5815,7 +4812,6 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
     // 'log_error:8' elseif ~coder.target('MEX')
     // 'log_error:9' coder.cinclude('<vio_logging.h>')
     // 'log_error:10' coder.ceval('LOG_ERROR', [str, 0], varargin{:});
-    memcpy(&cv48[0], &cv49[0], 66U * sizeof(char));
     wj = roundf(100.0F - rejected_ratio * 100.0F);
     if (wj < 2.14748365E+9F) {
       i35 = (int)wj;
@@ -5823,7 +4819,7 @@ static void OnePointRANSAC_EKF(g_struct_T *b_xt, float b_P[10404], const float
       i35 = MAX_int32_T;
     }
 
-    LOG_ERROR(cv48, i35);
+    LOG_ERROR(cv49, i35);
 
     // 'OnePointRANSAC_EKF:322' gryro_bias_cov = P(10:12, 10:12);
     // 'OnePointRANSAC_EKF:323' acc_bias_cov = P(13:15, 13:15);
@@ -6016,7 +5012,6 @@ static void SLAM_init()
 //                float noiseParameters_image_noise
 //                float c_noiseParameters_inv_depth_ini
 //                const VIOParameters b_VIOParameters
-//                float b_map[144]
 //                float b_delayedStatus[48]
 // Return Type  : void
 //
@@ -6036,7 +5031,7 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
                      z_all_l[96], float z_all_r[96], float
                      noiseParameters_image_noise, float
                      c_noiseParameters_inv_depth_ini, const VIOParameters
-                     b_VIOParameters, float b_map[144], float b_delayedStatus[48])
+                     b_VIOParameters, float b_delayedStatus[48])
 {
   boolean_T x[48];
   int i;
@@ -6057,7 +5052,8 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
   boolean_T exitg9;
   boolean_T guard2 = false;
   signed char i_data[48];
-  emxArray_real32_T *qualities;
+  float qualities_data[48];
+  int qualities_size[1];
   int z_all_r_size[1];
   int anchorIdx;
   int featureIdx;
@@ -6067,35 +5063,36 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
   signed char active_feature[8];
   int iidx[8];
   float mtmp;
-  emxArray_real32_T *anchorInd;
-  emxArray_real32_T *featureInd;
-  emxArray_int32_T *b_iidx;
+  float anchorInd_data[48];
+  int anchorInd_size[1];
+  float featureInd_data[48];
+  int featureInd_size[1];
+  int b_iidx_data[48];
   float new_m_data[288];
   int c_triangulation_success_size_id;
   boolean_T triangulation_success_data[48];
   float fv25[2];
   float fv26[2];
-  __attribute__((aligned(16))) float z_curr_l[2];
-  float c;
-  __attribute__((aligned(16))) float z_curr_r[2];
   boolean_T success;
-  float b_m[6];
+  float new_z_l[96];
+  float new_z_r[96];
+  float new_fp[144];
+  float new_m_l[144];
+  int new_status[48];
   __attribute__((aligned(16))) float fp[3];
   __attribute__((aligned(16))) float new_origin_pos_rel[3];
-  boolean_T bv0[3];
   signed char i33;
-  __attribute__((aligned(16))) float h_u_r[2];
-  __attribute__((aligned(16))) float h_u_l[2];
   __attribute__((aligned(16))) float b_h_u_l[2];
-  boolean_T guard1 = false;
   float triangulated_depths_data[48];
   float triangulated_status_ind_data[48];
   float b_triangulated_status_ind_data[48];
   int c_triangulated_status_ind_size_;
   int trueCount;
   float untriangulated_depths_data[48];
-  emxArray_real32_T *auto_gen_tmp_4;
-  emxArray_real32_T *out;
+  float auto_gen_tmp_4_data[48];
+  int auto_gen_tmp_4_size[1];
+  float out_data[48];
+  int out_size[1];
   int tmp_data[48];
   float untriangulated_status_ind_data[48];
   float b_new_m_data[144];
@@ -6115,7 +5112,6 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
   boolean_T exitg8;
   float b_uncertainties[48];
   boolean_T has_active_features;
-  int uncertainties_size[1];
   float totalNumActiveFeatues;
   float numDelayedFeatures;
   float delayedIdx;
@@ -6128,7 +5124,6 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
   float b_has_active_features[6];
   float c_uncertainties[6];
   boolean_T exitg4;
-  char cv46[111];
   static const char cv47[111] = { 'P', 'i', 'c', 'k', 'e', 'd', ' ', 'a', 'n',
     ' ', 'a', 'n', 'c', 'h', 'o', 'r', ' ', 'w', 'i', 't', 'h', ' ', 'n', 'o',
     ' ', 'a', 'c', 't', 'i', 'v', 'e', ' ', 'f', 'e', 'a', 't', 'u', 'r', 'e',
@@ -6621,8 +5616,8 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
                  d_cameraParams_CameraParameters,
                  e_cameraParams_CameraParameters,
                  f_cameraParams_CameraParameters,
-                 g_cameraParams_CameraParameters, status_ind_data,
-                 status_ind_size);
+                 g_cameraParams_CameraParameters, undistortionMap_l,
+                 status_ind_data, status_ind_size);
   loop_ub = status_ind_size[0];
   for (i32 = 0; i32 < loop_ub; i32++) {
     z_all_l[(int)ind_l2_data[i32] - 1] = status_ind_data[i32];
@@ -6671,12 +5666,9 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
     i_data[i32] = (signed char)ii_data[i32];
   }
 
-  emxInit_real32_T(&qualities, 1);
-  i32 = qualities->size[0];
-  qualities->size[0] = yk;
-  emxEnsureCapacity((emxArray__common *)qualities, i32, (int)sizeof(float));
+  qualities_size[0] = yk;
   for (i32 = 0; i32 < yk; i32++) {
-    qualities->data[i32] = i_data[i32];
+    qualities_data[i32] = i_data[i32];
   }
 
   // 'SLAM_upd:13' if VIOParameters.full_stereo
@@ -6692,8 +5684,8 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
                    i_cameraParams_CameraParameters,
                    j_cameraParams_CameraParameters,
                    k_cameraParams_CameraParameters,
-                   l_cameraParams_CameraParameters, status_ind_data,
-                   status_ind_size);
+                   l_cameraParams_CameraParameters, undistortionMap_r,
+                   status_ind_data, status_ind_size);
     yk = status_ind_size[0];
     for (i32 = 0; i32 < yk; i32++) {
       z_all_r[(int)ind_l2_data[i32] - 1] = status_ind_data[i32];
@@ -6701,7 +5693,7 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
   } else {
     // 'SLAM_upd:15' else
     // 'SLAM_upd:16' ind_r2 = multiplyIdx(ind_r, 2);
-    multiplyIdx(qualities->data, qualities->size, ind_l2_data, ind_l2_size);
+    multiplyIdx(qualities_data, qualities_size, ind_l2_data, ind_l2_size);
 
     // 'SLAM_upd:17' z_all_r(ind_r2) = undistortPoint(z_all_r(ind_r2), cameraParams.CameraParameters2); 
     z_all_r_size[0] = ind_l2_size[0];
@@ -6714,8 +5706,8 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
                    i_cameraParams_CameraParameters,
                    j_cameraParams_CameraParameters,
                    k_cameraParams_CameraParameters,
-                   l_cameraParams_CameraParameters, status_ind_data,
-                   status_ind_size);
+                   l_cameraParams_CameraParameters, undistortionMap_r,
+                   status_ind_data, status_ind_size);
     yk = status_ind_size[0];
     for (i32 = 0; i32 < yk; i32++) {
       z_all_r[(int)ind_l2_data[i32] - 1] = status_ind_data[i32];
@@ -6812,7 +5804,7 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
       }
 
       // 'SLAM_upd:61' [~, sortIdx] = sort(uncertainties, 'ascend');
-      sort(uncertainties, iidx);
+      sorting_network::sort<8>(uncertainties, iidx);
       for (i = 0; i < 8; i++) {
         uncertainties[i] = (float)iidx[i];
       }
@@ -6873,7 +5865,7 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
                        b_VIOParameters.max_ekf_iterations,
                        b_VIOParameters.delayed_initialization,
                        b_VIOParameters.full_stereo, b_VIOParameters.RANSAC,
-                       updateVect);
+                       b_VIOParameters.jacobian_reuse_thresh, updateVect);
   } else {
     // 'SLAM_upd:75' else
     // 'SLAM_upd:76' P_apo = P_apr;
@@ -6881,9 +5873,6 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
 
   // % Initialize new anchors/features
   // 'SLAM_upd:80' if length(ind_r) >= minFeatureThreshold
-  emxInit_real32_T(&anchorInd, 1);
-  emxInit_real32_T(&featureInd, 1);
-  emxInit_int32_T(&b_iidx, 1);
   if (loop_ub >= 4) {
     //  try to triangulate all new features
     // 'SLAM_upd:82' new_depths = zeros(length(ind_r), 1);
@@ -6898,149 +5887,89 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
     }
 
     // 'SLAM_upd:84' triangulation_success = false(length(ind_r), 1);
-    c_triangulation_success_size_id = qualities->size[0];
-    loop_ub = qualities->size[0];
+    c_triangulation_success_size_id = qualities_size[0];
+    loop_ub = qualities_size[0];
     for (i32 = 0; i32 < loop_ub; i32++) {
       triangulation_success_data[i32] = false;
     }
 
-    // 'SLAM_upd:86' for i = 1:length(ind_r)
-    for (i = 0; i < qualities->size[0]; i++) {
-      // 'SLAM_upd:87' z_curr_l = z_all_l((ind_r(i)-1)*2 + (1:2));
-      mtmp = (qualities->data[i] - 1.0F) * 2.0F;
-      for (i32 = 0; i32 < 2; i32++) {
-        fv25[i32] = 1.0F + (float)i32;
-      }
-
-      ne10_addc_float_neon(&fv26[0], fv25, mtmp, 2U);
-      for (i32 = 0; i32 < 2; i32++) {
-        z_curr_l[i32] = z_all_l[(int)fv26[i32] - 1];
+    //  triangulate the new features together, the checks of SLAM_upd:93-117
+    //  are done for all points in triangulateStereo
+    if (!b_VIOParameters.mono) {
+      for (i = 0; i < qualities_size[0]; i++) {
+        // 'SLAM_upd:87' z_curr_l = z_all_l((ind_r(i)-1)*2 + (1:2));
+        // 'SLAM_upd:88' z_curr_r = z_all_r((ind_r(i)-1)*2 + (1:2));
+        yk = ((int)qualities_data[i] - 1) * 2;
+        for (i32 = 0; i32 < 2; i32++) {
+          new_z_l[i32 + 2 * i] = z_all_l[yk + i32];
+          new_z_r[i32 + 2 * i] = z_all_r[yk + i32];
+        }
       }
 
-      // 'SLAM_upd:88' z_curr_r = z_all_r((ind_r(i)-1)*2 + (1:2));
-      c = (qualities->data[i] - 1.0F) * 2.0F;
-      for (i32 = 0; i32 < 2; i32++) {
-        fv25[i32] = 1.0F + (float)i32;
-      }
+      triangulation::triangulateStereo(triangulation::StereoRig<float>
+        (d_cameraParams_CameraParameters, e_cameraParams_CameraParameters,
+         i_cameraParams_CameraParameters, j_cameraParams_CameraParameters,
+         cameraParams_r_lr, cameraParams_R_lr, cameraParams_R_rl),
+        (triangulation::Method)b_VIOParameters.triangulation_method, new_z_l,
+        new_z_r, qualities_size[0], new_fp, new_m_l, new_status);
+    }
 
-      ne10_addc_float_neon(&fv26[0], fv25, c, 2U);
-      for (i32 = 0; i32 < 2; i32++) {
-        z_curr_r[i32] = z_all_r[(int)fv26[i32] - 1];
-      }
+    // 'SLAM_upd:86' for i = 1:length(ind_r)
+    for (i = 0; i < qualities_size[0]; i++) {
+      mtmp = (qualities_data[i] - 1.0F) * 2.0F;
 
       // 'SLAM_upd:89' if ~VIOParameters.mono
       if (!b_VIOParameters.mono) {
         // 'SLAM_upd:90' [ fp, m, success ] = initializePoint(z_curr_l, z_curr_r, cameraParams); 
-        initializePoint(z_curr_l, z_curr_r, d_cameraParams_CameraParameters,
-                        e_cameraParams_CameraParameters,
-                        i_cameraParams_CameraParameters,
-                        j_cameraParams_CameraParameters, cameraParams_r_lr,
-                        cameraParams_R_lr, fp, b_m, &success);
-
         // 'SLAM_upd:91' m_l = m(:,1);
         for (i32 = 0; i32 < 3; i32++) {
-          new_origin_pos_rel[i32] = b_m[i32];
+          fp[i32] = new_fp[i32 + 3 * i];
+          new_origin_pos_rel[i32] = new_m_l[i32 + 3 * i];
         }
 
         // 'SLAM_upd:93' if success
-        if (success) {
-          //  perform further checks
-          // 'SLAM_upd:94' if any(isnan(fp))
-          for (yk = 0; yk < 3; yk++) {
-            bv0[yk] = rtIsNaNF(fp[yk]);
-          }
-
-          if (b_any(bv0)) {
-            // 'SLAM_upd:95' log_warn('Bad triangulation (nan) for point %d', int8(ind_r(i))); 
-            mtmp = roundf(qualities->data[i]);
-            if (mtmp < 128.0F) {
-              if (mtmp >= -128.0F) {
-                i33 = (signed char)mtmp;
-              } else {
-                i33 = MIN_int8_T;
-              }
-            } else if (mtmp >= 128.0F) {
-              i33 = MAX_int8_T;
+        success = (new_status[i] == triangulation::SUCCESS);
+        if (new_status[i] == triangulation::NOT_A_NUMBER) {
+          // 'SLAM_upd:95' log_warn('Bad triangulation (nan) for point %d', int8(ind_r(i))); 
+          mtmp = roundf(qualities_data[i]);
+          if (mtmp < 128.0F) {
+            if (mtmp >= -128.0F) {
+              i33 = (signed char)mtmp;
             } else {
-              i33 = 0;
+              i33 = MIN_int8_T;
             }
-
-            d_log_warn(i33);
-
-            // 'SLAM_upd:96' fp = m_l;
-            for (i32 = 0; i32 < 3; i32++) {
-              fp[i32] = b_m[i32];
-            }
-
-            // 'SLAM_upd:97' success = false;
-            success = false;
+          } else if (mtmp >= 128.0F) {
+            i33 = MAX_int8_T;
           } else {
-            // 'SLAM_upd:98' else
-            //  check reprojection error
-            // 'SLAM_upd:100' [h_u_l, h_u_r] = predictMeasurementStereo(fp, cameraParams); 
-            predictMeasurementStereo(fp, d_cameraParams_CameraParameters,
-              e_cameraParams_CameraParameters, i_cameraParams_CameraParameters,
-              j_cameraParams_CameraParameters, cameraParams_r_lr,
-              cameraParams_R_rl, h_u_l, h_u_r);
-
-            // 'SLAM_upd:102' reprojection_error_thresh = 5;
-            // 'SLAM_upd:103' if norm(h_u_l - z_curr_l) > reprojection_error_thresh || norm(h_u_r - z_curr_r) > reprojection_error_thresh 
-            mw_neon_mm_sub_f32x4(h_u_l, 2, 1, z_curr_l, &b_h_u_l[0]);
-            guard1 = false;
-            if (c_norm(b_h_u_l) > 5.0F) {
-              guard1 = true;
-            } else {
-              mw_neon_mm_sub_f32x4(h_u_r, 2, 1, z_curr_r, &b_h_u_l[0]);
-              if (c_norm(b_h_u_l) > 5.0F) {
-                guard1 = true;
-              } else {
-                // 'SLAM_upd:107' else
-                // 'SLAM_upd:108' if norm(fp) < 0.1
-                if (norm(fp) < 0.1F) {
-                  //  feature triangulated very close
-                  // 'SLAM_upd:109' log_warn('Feature %i is triangulated very close. Depth: %f', int32(ind_r(i)), norm(fp)); 
-                  mtmp = roundf(qualities->data[i]);
-                  if (mtmp < 2.14748365E+9F) {
-                    if (mtmp >= -2.14748365E+9F) {
-                      i32 = (int)mtmp;
-                    } else {
-                      i32 = MIN_int32_T;
-                    }
-                  } else if (mtmp >= 2.14748365E+9F) {
-                    i32 = MAX_int32_T;
-                  } else {
-                    i32 = 0;
-                  }
-
-                  e_log_warn(i32, norm(fp));
-
-                  // 'SLAM_upd:110' fp = m_l;
-                  for (i32 = 0; i32 < 3; i32++) {
-                    fp[i32] = b_m[i32];
-                  }
-
-                  // 'SLAM_upd:111' success = false;
-                  success = false;
-                }
-              }
-            }
+            i33 = 0;
+          }
 
-            if (guard1) {
-              //                          log_info('Bad triangulation (reprojection error) for point %d', int8(ind_r(i))); 
-              // 'SLAM_upd:105' fp = m_l;
-              for (i32 = 0; i32 < 3; i32++) {
-                fp[i32] = b_m[i32];
+          d_log_warn(i33);
+        } else {
+          if (new_status[i] == triangulation::TOO_CLOSE) {
+            //  feature triangulated very close
+            // 'SLAM_upd:109' log_warn('Feature %i is triangulated very close. Depth: %f', int32(ind_r(i)), norm(fp)); 
+            mtmp = roundf(qualities_data[i]);
+            if (mtmp < 2.14748365E+9F) {
+              if (mtmp >= -2.14748365E+9F) {
+                i32 = (int)mtmp;
+              } else {
+                i32 = MIN_int32_T;
               }
-
-              // 'SLAM_upd:106' success = false;
-              success = false;
+            } else if (mtmp >= 2.14748365E+9F) {
+              i32 = MAX_int32_T;
+            } else {
+              i32 = 0;
             }
+
+            e_log_warn(i32, norm(fp));
           }
-        } else {
-          // 'SLAM_upd:115' else
-          // 'SLAM_upd:116' fp = m_l;
+        }
+
+        if (!success) {
+          // 'SLAM_upd:96' fp = m_l;
           for (i32 = 0; i32 < 3; i32++) {
-            fp[i32] = b_m[i32];
+            fp[i32] = new_origin_pos_rel[i32];
           }
         }
       } else {
@@ -7117,20 +6046,16 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
     }
 
     // 'SLAM_upd:133' [triangulated_depths, triangulated_idx] = sort(triangulated_depths, 'ascend'); 
-    i32 = anchorInd->size[0];
-    anchorInd->size[0] = ix;
-    emxEnsureCapacity((emxArray__common *)anchorInd, i32, (int)sizeof(float));
+    anchorInd_size[0] = ix;
     for (i32 = 0; i32 < ix; i32++) {
-      anchorInd->data[i32] = triangulated_depths_data[i32];
+      anchorInd_data[i32] = triangulated_depths_data[i32];
     }
 
-    c_sort(anchorInd, b_iidx);
-    i32 = featureInd->size[0];
-    featureInd->size[0] = b_iidx->size[0];
-    emxEnsureCapacity((emxArray__common *)featureInd, i32, (int)sizeof(float));
-    loop_ub = b_iidx->size[0];
+    sorting_network::sort(anchorInd_data, b_iidx_data, anchorInd_size[0]);
+    featureInd_size[0] = anchorInd_size[0];
+    loop_ub = anchorInd_size[0];
     for (i32 = 0; i32 < loop_ub; i32++) {
-      featureInd->data[i32] = (float)b_iidx->data[i32];
+      featureInd_data[i32] = (float)b_iidx_data[i32];
     }
 
     // 'SLAM_upd:134' triangulated_m = new_m(:, triangulation_success);
@@ -7156,17 +6081,17 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
     yk = 0;
     for (i = 0; i <= idx; i++) {
       if (triangulation_success_data[i]) {
-        triangulated_status_ind_data[yk] = qualities->data[i];
+        triangulated_status_ind_data[yk] = qualities_data[i];
         yk++;
       }
     }
 
     // 'SLAM_upd:137' triangulated_status_ind = triangulated_status_ind(triangulated_idx); 
-    c_triangulated_status_ind_size_ = featureInd->size[0];
-    loop_ub = featureInd->size[0];
+    c_triangulated_status_ind_size_ = featureInd_size[0];
+    loop_ub = featureInd_size[0];
     for (i32 = 0; i32 < loop_ub; i32++) {
       b_triangulated_status_ind_data[i32] = triangulated_status_ind_data[(int)
-        featureInd->data[i32] - 1];
+        featureInd_data[i32] - 1];
     }
 
     for (i32 = 0; i32 < c_triangulated_status_ind_size_; i32++) {
@@ -7190,24 +6115,18 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
       }
     }
 
-    emxInit_real32_T(&auto_gen_tmp_4, 1);
-
     // 'SLAM_upd:140' [untriangulated_depths, untriangulated_idx] = sort(untriangulated_depths, 'ascend'); 
-    i32 = auto_gen_tmp_4->size[0];
-    auto_gen_tmp_4->size[0] = trueCount;
-    emxEnsureCapacity((emxArray__common *)auto_gen_tmp_4, i32, (int)sizeof(float));
+    auto_gen_tmp_4_size[0] = trueCount;
     for (i32 = 0; i32 < trueCount; i32++) {
-      auto_gen_tmp_4->data[i32] = untriangulated_depths_data[i32];
+      auto_gen_tmp_4_data[i32] = untriangulated_depths_data[i32];
     }
 
-    emxInit_real32_T(&out, 1);
-    c_sort(auto_gen_tmp_4, b_iidx);
-    i32 = out->size[0];
-    out->size[0] = b_iidx->size[0];
-    emxEnsureCapacity((emxArray__common *)out, i32, (int)sizeof(float));
-    loop_ub = b_iidx->size[0];
+    sorting_network::sort(auto_gen_tmp_4_data, b_iidx_data,
+                          auto_gen_tmp_4_size[0]);
+    out_size[0] = auto_gen_tmp_4_size[0];
+    loop_ub = auto_gen_tmp_4_size[0];
     for (i32 = 0; i32 < loop_ub; i32++) {
-      out->data[i32] = (float)b_iidx->data[i32];
+      out_data[i32] = (float)b_iidx_data[i32];
     }
 
     // 'SLAM_upd:141' untriangulated_m = new_m(:, ~triangulation_success);
@@ -7233,17 +6152,17 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
     yk = 0;
     for (i = 0; i <= idx; i++) {
       if (!triangulation_success_data[i]) {
-        untriangulated_status_ind_data[yk] = qualities->data[i];
+        untriangulated_status_ind_data[yk] = qualities_data[i];
         yk++;
       }
     }
 
     // 'SLAM_upd:144' untriangulated_status_ind = untriangulated_status_ind(untriangulated_idx); 
-    idx = out->size[0];
-    loop_ub = out->size[0];
+    idx = out_size[0];
+    loop_ub = out_size[0];
     for (i32 = 0; i32 < loop_ub; i32++) {
       b_triangulated_status_ind_data[i32] = untriangulated_status_ind_data[(int)
-        out->data[i32] - 1];
+        out_data[i32] - 1];
     }
 
     for (i32 = 0; i32 < idx; i32++) {
@@ -7251,19 +6170,17 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
     }
 
     // 'SLAM_upd:146' new_depths = [triangulated_depths; untriangulated_depths]; 
-    ind_l2_size[0] = anchorInd->size[0] + auto_gen_tmp_4->size[0];
-    loop_ub = anchorInd->size[0];
+    ind_l2_size[0] = anchorInd_size[0] + auto_gen_tmp_4_size[0];
+    loop_ub = anchorInd_size[0];
     for (i32 = 0; i32 < loop_ub; i32++) {
-      ind_l2_data[i32] = anchorInd->data[i32];
+      ind_l2_data[i32] = anchorInd_data[i32];
     }
 
-    loop_ub = auto_gen_tmp_4->size[0];
+    loop_ub = auto_gen_tmp_4_size[0];
     for (i32 = 0; i32 < loop_ub; i32++) {
-      ind_l2_data[i32 + anchorInd->size[0]] = auto_gen_tmp_4->data[i32];
+      ind_l2_data[i32 + anchorInd_size[0]] = auto_gen_tmp_4_data[i32];
     }
 
-    emxFree_real32_T(&auto_gen_tmp_4);
-
     // 'SLAM_upd:147' new_m = [triangulated_m, untriangulated_m];
     for (i32 = 0; i32 < ix; i32++) {
       for (i34 = 0; i34 < 3; i34++) {
@@ -7277,24 +6194,22 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
       }
     }
 
-    loop_ub = featureInd->size[0];
+    loop_ub = featureInd_size[0];
     for (i32 = 0; i32 < loop_ub; i32++) {
       for (i34 = 0; i34 < 3; i34++) {
         new_m_data[i34 + 3 * i32] = b_new_m_data[i34 + 3 * ((int)
-          featureInd->data[i32] - 1)];
+          featureInd_data[i32] - 1)];
       }
     }
 
-    loop_ub = out->size[0];
+    loop_ub = out_size[0];
     for (i32 = 0; i32 < loop_ub; i32++) {
       for (i34 = 0; i34 < 3; i34++) {
-        new_m_data[i34 + 3 * (i32 + featureInd->size[0])] = c_new_m_data[i34 + 3
-          * ((int)out->data[i32] - 1)];
+        new_m_data[i34 + 3 * (i32 + featureInd_size[0])] = c_new_m_data[i34 + 3
+          * ((int)out_data[i32] - 1)];
       }
     }
 
-    emxFree_real32_T(&out);
-
     // 'SLAM_upd:148' status_ind = [triangulated_status_ind; untriangulated_status_ind]; 
     for (i32 = 0; i32 < c_triangulated_status_ind_size_; i32++) {
       status_ind_data[i32] = triangulated_status_ind_data[i32];
@@ -7332,6 +6247,8 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
         if (getNumValidFeatures(b_xt->anchor_states[anchorIdx].feature_states) <
             4.0F) {
           //  anchor needs to be initialized
+          telemetry.anchor_initializations++;
+
           //  free up updateVect
           // 'SLAM_upd:164' for featureIdx = 1:numPointsPerAnchor
           for (featureIdx = 0; featureIdx < 8; featureIdx++) {
@@ -7763,6 +6680,7 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
             //                  log_info('Inserting feature %d as feature %i on anchor %i', int32(status_ind(new_feature_idx)), int32(featureIdx), int32(anchorIdx)) 
             // 'SLAM_upd:235' updateVect(status_ind(new_feature_idx)) = int32(1); 
             updateVect[(int)status_ind_data[new_feature_idx - 1] - 1] = 1;
+            telemetry.new_features++;
 
             // 'SLAM_upd:237' new_feature_idx = new_feature_idx + 1;
             new_feature_idx++;
@@ -7788,7 +6706,7 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
       }
     }
   } else {
-    if (!(qualities->size[0] == 0)) {
+    if (!(qualities_size[0] == 0)) {
       // 'SLAM_upd:245' elseif ~isempty(ind_r)
       // 'SLAM_upd:246' log_warn('Got %d new feautures but not enough for a new anchor (min %d)', length(ind_r), int32(minFeatureThreshold)) 
       f_log_warn((float)loop_ub);
@@ -7853,12 +6771,11 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
         }
       }
 
-      uncertainties_size[0] = ix;
       for (i32 = 0; i32 < ix; i32++) {
         b_triangulated_status_ind_data[i32] = b_uncertainties[ii_data[i32] - 1];
       }
 
-      mtmp = median(b_triangulated_status_ind_data, uncertainties_size);
+      mtmp = sorting_network::median(b_triangulated_status_ind_data, ix);
 
       //  because coder does not support nanflag
       //  check if a delayed initialization feature has converged
@@ -7915,31 +6832,25 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
       numDelayedFeatures = getTotalNumDelayedFeatures(b_xt->anchor_states);
 
       // 'SLAM_upd:293' qualities = zeros(numDelayedFeatures, 1);
-      i32 = qualities->size[0];
-      qualities->size[0] = (int)numDelayedFeatures;
-      emxEnsureCapacity((emxArray__common *)qualities, i32, (int)sizeof(float));
+      qualities_size[0] = (int)numDelayedFeatures;
       loop_ub = (int)numDelayedFeatures;
       for (i32 = 0; i32 < loop_ub; i32++) {
-        qualities->data[i32] = 0.0F;
+        qualities_data[i32] = 0.0F;
       }
 
       //  quality measures of each delayed feature
       // 'SLAM_upd:294' anchorInd = qualities;
-      i32 = anchorInd->size[0];
-      anchorInd->size[0] = qualities->size[0];
-      emxEnsureCapacity((emxArray__common *)anchorInd, i32, (int)sizeof(float));
-      loop_ub = qualities->size[0];
+      anchorInd_size[0] = qualities_size[0];
+      loop_ub = qualities_size[0];
       for (i32 = 0; i32 < loop_ub; i32++) {
-        anchorInd->data[i32] = qualities->data[i32];
+        anchorInd_data[i32] = qualities_data[i32];
       }
 
       // 'SLAM_upd:295' featureInd = qualities;
-      i32 = featureInd->size[0];
-      featureInd->size[0] = qualities->size[0];
-      emxEnsureCapacity((emxArray__common *)featureInd, i32, (int)sizeof(float));
-      loop_ub = qualities->size[0];
+      featureInd_size[0] = qualities_size[0];
+      loop_ub = qualities_size[0];
       for (i32 = 0; i32 < loop_ub; i32++) {
-        featureInd->data[i32] = qualities->data[i32];
+        featureInd_data[i32] = qualities_data[i32];
       }
 
       // 'SLAM_upd:297' delayedIdx = 1;
@@ -7955,16 +6866,16 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
             // 'SLAM_upd:301' rho_unc = P_apo(xt.anchor_states(anchorIdx).feature_states(featureIdx).P_idx, xt.anchor_states(anchorIdx).feature_states(featureIdx).P_idx); 
             // 'SLAM_upd:303' quality = rho_unc/noiseParameters.inv_depth_initial_unc; 
             // 'SLAM_upd:305' qualities(delayedIdx) = quality;
-            qualities->data[(int)delayedIdx - 1] = P_apr[(b_xt->
+            qualities_data[(int)delayedIdx - 1] = P_apr[(b_xt->
               anchor_states[anchorIdx].feature_states[featureIdx].P_idx + 102 *
               (b_xt->anchor_states[anchorIdx].feature_states[featureIdx].P_idx -
                1)) - 1] / c_noiseParameters_inv_depth_ini;
 
             // 'SLAM_upd:306' anchorInd(delayedIdx) = anchorIdx;
-            anchorInd->data[(int)delayedIdx - 1] = (float)anchorIdx + 1.0F;
+            anchorInd_data[(int)delayedIdx - 1] = (float)anchorIdx + 1.0F;
 
             // 'SLAM_upd:307' featureInd(delayedIdx) = featureIdx;
-            featureInd->data[(int)delayedIdx - 1] = (float)featureIdx + 1.0F;
+            featureInd_data[(int)delayedIdx - 1] = (float)featureIdx + 1.0F;
 
             // 'SLAM_upd:309' delayedIdx = delayedIdx + 1;
             delayedIdx++;
@@ -7973,13 +6884,10 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
       }
 
       // 'SLAM_upd:314' [~, sortInd] = sort(qualities, 'ascend');
-      c_sort(qualities, b_iidx);
-      i32 = qualities->size[0];
-      qualities->size[0] = b_iidx->size[0];
-      emxEnsureCapacity((emxArray__common *)qualities, i32, (int)sizeof(float));
-      loop_ub = b_iidx->size[0];
+      sorting_network::sort(qualities_data, b_iidx_data, qualities_size[0]);
+      loop_ub = qualities_size[0];
       for (i32 = 0; i32 < loop_ub; i32++) {
-        qualities->data[i32] = (float)b_iidx->data[i32];
+        qualities_data[i32] = (float)b_iidx_data[i32];
       }
 
       // 'SLAM_upd:314' ~
@@ -7988,47 +6896,47 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
 
       // 'SLAM_upd:318' for i = 1:length(sortInd)
       i = 0;
-      while ((i <= (int)(float)qualities->size[0] - 1) &&
+      while ((i <= (int)(float)qualities_size[0] - 1) &&
              (!(numActivatedFeatures > ceilf(19.2F - totalNumActiveFeatues))) &&
              (!(numActivatedFeatures > numDelayedFeatures))) {
         // 'SLAM_upd:319' if numActivatedFeatures > ceil(minActiveFeatureRatio*single(numTrackFeatures) - totalNumActiveFeatues) || numActivatedFeatures > numDelayedFeatures 
         // 'SLAM_upd:322' if xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).inverse_depth < 0 
-        if (b_xt->anchor_states[(int)anchorInd->data[(int)qualities->data[(int)
+        if (b_xt->anchor_states[(int)anchorInd_data[(int)qualities_data[(int)
             (1.0F + (float)i) - 1] - 1] - 1].feature_states[(int)
-            featureInd->data[(int)qualities->data[(int)(1.0F + (float)i) - 1] -
+            featureInd_data[(int)qualities_data[(int)(1.0F + (float)i) - 1] -
             1] - 1].inverse_depth < 0.0F) {
           // 'SLAM_upd:323' xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).status = int32(0); 
-          b_xt->anchor_states[(int)anchorInd->data[(int)qualities->data[(int)
+          b_xt->anchor_states[(int)anchorInd_data[(int)qualities_data[(int)
             (1.0F + (float)i) - 1] - 1] - 1].feature_states[(int)
-            featureInd->data[(int)qualities->data[(int)(1.0F + (float)i) - 1] -
+            featureInd_data[(int)qualities_data[(int)(1.0F + (float)i) - 1] -
             1] - 1].status = 0;
 
           // 'SLAM_upd:324' updateVect(xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).status_idx) = int32(0); 
-          updateVect[b_xt->anchor_states[(int)anchorInd->data[(int)
-            qualities->data[(int)(1.0F + (float)i) - 1] - 1] - 1]
-            .feature_states[(int)featureInd->data[(int)qualities->data[(int)
+          updateVect[b_xt->anchor_states[(int)anchorInd_data[(int)
+            qualities_data[(int)(1.0F + (float)i) - 1] - 1] - 1]
+            .feature_states[(int)featureInd_data[(int)qualities_data[(int)
             (1.0F + (float)i) - 1] - 1] - 1].status_idx - 1] = 0;
 
           // 'SLAM_upd:325' log_warn('Trying to force insert feature %i behind its anchor', xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).status_idx) 
-          h_log_warn(b_xt->anchor_states[(int)anchorInd->data[(int)
-                     qualities->data[(int)(1.0F + (float)i) - 1] - 1] - 1].
-                     feature_states[(int)featureInd->data[(int)qualities->data
+          h_log_warn(b_xt->anchor_states[(int)anchorInd_data[(int)
+                     qualities_data[(int)(1.0F + (float)i) - 1] - 1] - 1].
+                     feature_states[(int)featureInd_data[(int)qualities_data
                      [(int)(1.0F + (float)i) - 1] - 1] - 1].status_idx);
         } else {
           // 'SLAM_upd:326' else
           // 'SLAM_upd:327' xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).status = int32(1); 
-          b_xt->anchor_states[(int)anchorInd->data[(int)qualities->data[(int)
+          b_xt->anchor_states[(int)anchorInd_data[(int)qualities_data[(int)
             (1.0F + (float)i) - 1] - 1] - 1].feature_states[(int)
-            featureInd->data[(int)qualities->data[(int)(1.0F + (float)i) - 1] -
+            featureInd_data[(int)qualities_data[(int)(1.0F + (float)i) - 1] -
             1] - 1].status = 1;
 
           // 'SLAM_upd:328' log_info('Forcing activation of feature %i (%i on anchor %i)', xt.anchor_states(anchorInd(sortInd(i))).feature_states(featureInd(sortInd(i))).status_idx, featureInd(sortInd(i)), anchorInd(sortInd(i))); 
-          f_log_info(b_xt->anchor_states[(int)anchorInd->data[(int)
-                     qualities->data[(int)(1.0F + (float)i) - 1] - 1] - 1].
-                     feature_states[(int)featureInd->data[(int)qualities->data
+          f_log_info(b_xt->anchor_states[(int)anchorInd_data[(int)
+                     qualities_data[(int)(1.0F + (float)i) - 1] - 1] - 1].
+                     feature_states[(int)featureInd_data[(int)qualities_data
                      [(int)(1.0F + (float)i) - 1] - 1] - 1].status_idx,
-                     featureInd->data[(int)qualities->data[(int)(1.0F + (float)i)
-                     - 1] - 1], anchorInd->data[(int)qualities->data[(int)(1.0F
+                     featureInd_data[(int)qualities_data[(int)(1.0F + (float)i)
+                     - 1] - 1], anchorInd_data[(int)qualities_data[(int)(1.0F
                       + (float)i) - 1] - 1]);
 
           // 'SLAM_upd:329' numActivatedFeatures = numActivatedFeatures + 1;
@@ -8040,11 +6948,6 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
     }
   }
 
-  emxFree_int32_T(&b_iidx);
-  emxFree_real32_T(&featureInd);
-  emxFree_real32_T(&anchorInd);
-  emxFree_real32_T(&qualities);
-
   //  check if new features need to be requested
   // 'SLAM_upd:336' request_new_features = false;
   request_new_features = false;
@@ -8170,7 +7073,8 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
           }
         }
 
-        mtmp = d_norm(b_P_apr);
+        mtmp = SLAM_anchorUncertainty(b_P_apr,
+          b_VIOParameters.origin_anchor_metric);
         c_uncertainties[anchorIdx] = mtmp;
 
         // 'SLAM_upd:386' has_active_features(anchorIdx) = 1;
@@ -8236,12 +7140,12 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
         // 'log_error:8' elseif ~coder.target('MEX')
         // 'log_error:9' coder.cinclude('<vio_logging.h>')
         // 'log_error:10' coder.ceval('LOG_ERROR', [str, 0], varargin{:});
-        memcpy(&cv46[0], &cv47[0], 111U * sizeof(char));
-        LOG_ERROR(cv46, b_xt->origin.anchor_idx);
+        LOG_ERROR(cv47, b_xt->origin.anchor_idx);
       } else {
         // 'SLAM_upd:398' else
         // 'SLAM_upd:399' log_info('Setting anchor %i as origin', int32(xt.origin.anchor_idx)) 
         g_log_info(b_xt->origin.anchor_idx);
+        telemetry.origin_anchor_switch = 1;
 
         // 'SLAM_upd:401' new_origin_pos_rel = xt.anchor_states(xt.origin.anchor_idx).pos; 
         for (i = 0; i < 3; i++) {
@@ -9329,10 +8233,7 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
   }
 
   // % aposteriori measurement prediction
-  // 'SLAM_upd:444' [map] = getMap(xt);
-  getMap(b_xt->origin.pos, b_xt->origin.att, b_xt->anchor_states, b_map);
-
-  //  get map for output
+  //  the map for the output is built by SLAM if it is requested
   // 'SLAM_upd:446' delayedStatus = zeros(size(updateVect));
   memset(&b_delayedStatus[0], 0, 48U * sizeof(float));
 
@@ -9351,6 +8252,24 @@ static void SLAM_upd(float P_apr[10404], g_struct_T *b_xt, int
       }
     }
   }
+
+  for (anchorIdx = 0; anchorIdx < 6; anchorIdx++) {
+    for (featureIdx = 0; featureIdx < 8; featureIdx++) {
+      if (b_xt->anchor_states[anchorIdx].feature_states[featureIdx].status == 1)
+      {
+        telemetry.active_features++;
+      } else {
+        if (b_xt->anchor_states[anchorIdx].feature_states[featureIdx].status ==
+            2) {
+          telemetry.delayed_features++;
+        }
+      }
+    }
+  }
+
+  for (i = 0; i < 18; i++) {
+    telemetry.robot_cov_trace += P_apr[103 * i];
+  }
 }
 
 //
@@ -9408,30 +8327,6 @@ static boolean_T anyActiveAnchorFeatures(const e_struct_T
   return ret;
 }
 
-//
-// Arguments    : const boolean_T x[3]
-// Return Type  : boolean_T
-//
-static boolean_T b_any(const boolean_T x[3])
-{
-  boolean_T y;
-  int k;
-  boolean_T exitg1;
-  y = false;
-  k = 0;
-  exitg1 = false;
-  while ((!exitg1) && (k < 3)) {
-    if (!!x[k]) {
-      y = true;
-      exitg1 = true;
-    } else {
-      k++;
-    }
-  }
-
-  return y;
-}
-
 //
 // Arguments    : void
 // Return Type  : double
@@ -10945,8 +9840,6 @@ static void b_getH_R_res(const float xt_robot_state_pos[3], const float
 //
 static void b_log_error()
 {
-  char cv20[14];
-  int i18;
   static const char cv21[14] = { 'i', 'n', 'c', 'o', 'n', 's', 'i', 's', 't',
     'e', 'n', 'c', 'y', '\x00' };
 
@@ -10954,11 +9847,7 @@ static void b_log_error()
   // 'log_error:8' elseif ~coder.target('MEX')
   // 'log_error:9' coder.cinclude('<vio_logging.h>')
   // 'log_error:10' coder.ceval('LOG_ERROR', [str, 0], varargin{:});
-  for (i18 = 0; i18 < 14; i18++) {
-    cv20[i18] = cv21[i18];
-  }
-
-  LOG_ERROR(cv20);
+  LOG_ERROR(cv21);
 }
 
 //
@@ -10972,8 +9861,6 @@ static void b_log_error()
 //
 static void b_log_info(int varargin_1, int varargin_2, int varargin_3)
 {
-  char cv14[44];
-  int i12;
   static const char cv15[44] = { 'F', 'i', 'x', 'i', 'n', 'g', ' ', 'f', 'e',
     'a', 't', 'u', 'r', 'e', ' ', '%', 'i', ' ', '(', 'f', 'e', 'a', 't', 'u',
     'r', 'e', ' ', '%', 'i', ' ', 'o', 'n', ' ', 'a', 'n', 'c', 'h', 'o', 'r',
@@ -10986,11 +9873,7 @@ static void b_log_info(int varargin_1, int varargin_2, int varargin_3)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i12 = 0; i12 < 44; i12++) {
-      cv14[i12] = cv15[i12];
-    }
-
-    LOG_INFO(cv14, varargin_1, varargin_2, varargin_3);
+    LOG_INFO(cv15, varargin_1, varargin_2, varargin_3);
   }
 }
 
@@ -11003,8 +9886,6 @@ static void b_log_info(int varargin_1, int varargin_2, int varargin_3)
 //
 static void b_log_warn()
 {
-  char cv18[44];
-  int i17;
   static const char cv19[44] = { '1', '-', 'P', 'o', 'i', 'n', 't', ' ', 'R',
     'A', 'N', 'S', 'A', 'C', ' ', 'd', 'i', 'd', 'n', 't', ' ', 'f', 'i', 'n',
     'd', ' ', 'e', 'n', 'o', 'u', 'g', 'h', ' ', 'L', 'I', ' ', 'i', 'n', 'l',
@@ -11017,73 +9898,7 @@ static void b_log_warn()
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i17 = 0; i17 < 44; i17++) {
-      cv18[i17] = cv19[i17];
-    }
-
-    LOG_WARN(cv18);
-  }
-}
-
-//
-// Arguments    : emxArray_int32_T *idx
-//                emxArray_real32_T *x
-//                int offset
-//                int np
-//                int nq
-//                emxArray_int32_T *iwork
-//                emxArray_real32_T *xwork
-// Return Type  : void
-//
-static void b_merge(emxArray_int32_T *idx, emxArray_real32_T *x, int offset, int
-                    np, int nq, emxArray_int32_T *iwork, emxArray_real32_T
-                    *xwork)
-{
-  int n;
-  int qend;
-  int p;
-  int iout;
-  int exitg1;
-  if (nq == 0) {
-  } else {
-    n = np + nq;
-    for (qend = 0; qend + 1 <= n; qend++) {
-      iwork->data[qend] = idx->data[offset + qend];
-      xwork->data[qend] = x->data[offset + qend];
-    }
-
-    p = 0;
-    n = np;
-    qend = np + nq;
-    iout = offset - 1;
-    do {
-      exitg1 = 0;
-      iout++;
-      if (xwork->data[p] <= xwork->data[n]) {
-        idx->data[iout] = iwork->data[p];
-        x->data[iout] = xwork->data[p];
-        if (p + 1 < np) {
-          p++;
-        } else {
-          exitg1 = 1;
-        }
-      } else {
-        idx->data[iout] = iwork->data[n];
-        x->data[iout] = xwork->data[n];
-        if (n + 1 < qend) {
-          n++;
-        } else {
-          n = (iout - p) + 1;
-          while (p + 1 <= np) {
-            idx->data[n + p] = iwork->data[p];
-            x->data[n + p] = xwork->data[p];
-            p++;
-          }
-
-          exitg1 = 1;
-        }
-      }
-    } while (exitg1 == 0);
+    LOG_WARN(cv19);
   }
 }
 
@@ -11115,210 +9930,6 @@ static float b_norm(const float x[4])
   return scale * sqrtf(y);
 }
 
-//
-// Arguments    : float x[8]
-//                int idx[8]
-// Return Type  : void
-//
-static void b_sort(float x[8], int idx[8])
-{
-  int b_m;
-  float x4[4];
-  signed char idx4[4];
-  float xwork[8];
-  int nNaNs;
-  int ib;
-  int k;
-  int bLen;
-  int nPairs;
-  int i4;
-  signed char perm[4];
-  int iwork[8];
-  for (b_m = 0; b_m < 8; b_m++) {
-    idx[b_m] = 0;
-  }
-
-  for (b_m = 0; b_m < 4; b_m++) {
-    x4[b_m] = 0.0F;
-    idx4[b_m] = 0;
-  }
-
-  for (b_m = 0; b_m < 8; b_m++) {
-    xwork[b_m] = 0.0F;
-  }
-
-  nNaNs = -7;
-  ib = 0;
-  for (k = 0; k < 8; k++) {
-    if (rtIsNaNF(x[k])) {
-      idx[-nNaNs] = k + 1;
-      xwork[-nNaNs] = x[k];
-      nNaNs++;
-    } else {
-      ib++;
-      idx4[ib - 1] = (signed char)(k + 1);
-      x4[ib - 1] = x[k];
-      if (ib == 4) {
-        ib = (k - nNaNs) - 10;
-        if (x4[0] <= x4[1]) {
-          b_m = 1;
-          bLen = 2;
-        } else {
-          b_m = 2;
-          bLen = 1;
-        }
-
-        if (x4[2] <= x4[3]) {
-          nPairs = 3;
-          i4 = 4;
-        } else {
-          nPairs = 4;
-          i4 = 3;
-        }
-
-        if (x4[b_m - 1] <= x4[nPairs - 1]) {
-          if (x4[bLen - 1] <= x4[nPairs - 1]) {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)bLen;
-            perm[2] = (signed char)nPairs;
-            perm[3] = (signed char)i4;
-          } else if (x4[bLen - 1] <= x4[i4 - 1]) {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)nPairs;
-            perm[2] = (signed char)bLen;
-            perm[3] = (signed char)i4;
-          } else {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)nPairs;
-            perm[2] = (signed char)i4;
-            perm[3] = (signed char)bLen;
-          }
-        } else if (x4[b_m - 1] <= x4[i4 - 1]) {
-          if (x4[bLen - 1] <= x4[i4 - 1]) {
-            perm[0] = (signed char)nPairs;
-            perm[1] = (signed char)b_m;
-            perm[2] = (signed char)bLen;
-            perm[3] = (signed char)i4;
-          } else {
-            perm[0] = (signed char)nPairs;
-            perm[1] = (signed char)b_m;
-            perm[2] = (signed char)i4;
-            perm[3] = (signed char)bLen;
-          }
-        } else {
-          perm[0] = (signed char)nPairs;
-          perm[1] = (signed char)i4;
-          perm[2] = (signed char)b_m;
-          perm[3] = (signed char)bLen;
-        }
-
-        idx[ib] = idx4[perm[0] - 1];
-        idx[ib + 1] = idx4[perm[1] - 1];
-        idx[ib + 2] = idx4[perm[2] - 1];
-        idx[ib + 3] = idx4[perm[3] - 1];
-        x[ib] = x4[perm[0] - 1];
-        x[ib + 1] = x4[perm[1] - 1];
-        x[ib + 2] = x4[perm[2] - 1];
-        x[ib + 3] = x4[perm[3] - 1];
-        ib = 0;
-      }
-    }
-  }
-
-  if (ib > 0) {
-    for (b_m = 0; b_m < 4; b_m++) {
-      perm[b_m] = 0;
-    }
-
-    if (ib == 1) {
-      perm[0] = 1;
-    } else if (ib == 2) {
-      if (x4[0] <= x4[1]) {
-        perm[0] = 1;
-        perm[1] = 2;
-      } else {
-        perm[0] = 2;
-        perm[1] = 1;
-      }
-    } else if (x4[0] <= x4[1]) {
-      if (x4[1] <= x4[2]) {
-        perm[0] = 1;
-        perm[1] = 2;
-        perm[2] = 3;
-      } else if (x4[0] <= x4[2]) {
-        perm[0] = 1;
-        perm[1] = 3;
-        perm[2] = 2;
-      } else {
-        perm[0] = 3;
-        perm[1] = 1;
-        perm[2] = 2;
-      }
-    } else if (x4[0] <= x4[2]) {
-      perm[0] = 2;
-      perm[1] = 1;
-      perm[2] = 3;
-    } else if (x4[1] <= x4[2]) {
-      perm[0] = 2;
-      perm[1] = 3;
-      perm[2] = 1;
-    } else {
-      perm[0] = 3;
-      perm[1] = 2;
-      perm[2] = 1;
-    }
-
-    for (k = 1; k <= ib; k++) {
-      idx[(k - nNaNs) - ib] = idx4[perm[k - 1] - 1];
-      x[(k - nNaNs) - ib] = x4[perm[k - 1] - 1];
-    }
-  }
-
-  b_m = (nNaNs + 7) >> 1;
-  for (k = 1; k <= b_m; k++) {
-    ib = idx[k - nNaNs];
-    idx[k - nNaNs] = idx[8 - k];
-    idx[8 - k] = ib;
-    x[k - nNaNs] = xwork[8 - k];
-    x[8 - k] = xwork[k - nNaNs];
-  }
-
-  if (((nNaNs + 7) & 1) != 0) {
-    x[(b_m - nNaNs) + 1] = xwork[(b_m - nNaNs) + 1];
-  }
-
-  if (1 - nNaNs > 1) {
-    for (b_m = 0; b_m < 8; b_m++) {
-      iwork[b_m] = 0;
-    }
-
-    nPairs = (1 - nNaNs) >> 2;
-    bLen = 4;
-    while (nPairs > 1) {
-      if ((nPairs & 1) != 0) {
-        nPairs--;
-        ib = bLen * nPairs;
-        b_m = 1 - (nNaNs + ib);
-        if (b_m > bLen) {
-          merge(idx, x, ib, bLen, b_m - bLen, iwork, xwork);
-        }
-      }
-
-      ib = bLen << 1;
-      nPairs >>= 1;
-      for (k = 1; k <= nPairs; k++) {
-        merge(idx, x, (k - 1) * ib, bLen, bLen, iwork, xwork);
-      }
-
-      bLen = ib;
-    }
-
-    if (1 - nNaNs > bLen) {
-      merge(idx, x, 0, bLen, 1 - (nNaNs + bLen), iwork, xwork);
-    }
-  }
-}
-
 //
 // Arguments    : int n
 //                float a
@@ -11346,277 +9957,6 @@ static void b_xaxpy(int n, float a, const float x[36], int ix0, float y[6], int
   }
 }
 
-//
-// Arguments    : float A[30]
-//                float tau[5]
-//                int jpvt[5]
-// Return Type  : void
-//
-static void b_xgeqp3(float A[30], float tau[5], int jpvt[5])
-{
-  float vn1[5];
-  float vn2[5];
-  int k;
-  int iy;
-  float work[5];
-  float smax;
-  float temp2;
-  int itemp;
-  float absxk;
-  float t;
-  int i;
-  int i_i;
-  int ix;
-  int pvt;
-  int i43;
-  int i_ip1;
-  int lastv;
-  int lastc;
-  boolean_T exitg2;
-  int exitg1;
-  k = 1;
-  for (iy = 0; iy < 5; iy++) {
-    jpvt[iy] = 1 + iy;
-    work[iy] = 0.0F;
-    smax = 0.0F;
-    temp2 = 1.17549435E-38F;
-    for (itemp = k; itemp <= k + 5; itemp++) {
-      absxk = fabsf(A[itemp - 1]);
-      if (absxk > temp2) {
-        t = temp2 / absxk;
-        smax = 1.0F + smax * t * t;
-        temp2 = absxk;
-      } else {
-        t = absxk / temp2;
-        smax += t * t;
-      }
-    }
-
-    smax = temp2 * sqrtf(smax);
-    vn1[iy] = smax;
-    vn2[iy] = vn1[iy];
-    k += 6;
-  }
-
-  for (i = 0; i < 5; i++) {
-    i_i = i + i * 6;
-    itemp = 0;
-    if (5 - i > 1) {
-      ix = i;
-      smax = vn1[i];
-      for (k = 1; k + 1 <= 5 - i; k++) {
-        ix++;
-        if (vn1[ix] > smax) {
-          itemp = k;
-          smax = vn1[ix];
-        }
-      }
-    }
-
-    pvt = i + itemp;
-    if (pvt + 1 != i + 1) {
-      ix = 6 * pvt;
-      iy = 6 * i;
-      for (k = 0; k < 6; k++) {
-        smax = A[ix];
-        A[ix] = A[iy];
-        A[iy] = smax;
-        ix++;
-        iy++;
-      }
-
-      itemp = jpvt[pvt];
-      jpvt[pvt] = jpvt[i];
-      jpvt[i] = itemp;
-      vn1[pvt] = vn1[i];
-      vn2[pvt] = vn2[i];
-    }
-
-    absxk = A[i_i];
-    temp2 = 0.0F;
-    smax = d_xnrm2(5 - i, A, i_i + 2);
-    if (smax != 0.0F) {
-      smax = hypotf(A[i_i], smax);
-      if (A[i_i] >= 0.0F) {
-        smax = -smax;
-      }
-
-      if (fabsf(smax) < 9.86076132E-32F) {
-        itemp = 0;
-        do {
-          itemp++;
-          i43 = i_i - i;
-          for (k = i_i + 1; k + 1 <= i43 + 6; k++) {
-            A[k] *= 1.01412048E+31F;
-          }
-
-          smax *= 1.01412048E+31F;
-          absxk *= 1.01412048E+31F;
-        } while (!(fabsf(smax) >= 9.86076132E-32F));
-
-        smax = hypotf(absxk, d_xnrm2(5 - i, A, i_i + 2));
-        if (absxk >= 0.0F) {
-          smax = -smax;
-        }
-
-        temp2 = (smax - absxk) / smax;
-        absxk = 1.0F / (absxk - smax);
-        i43 = i_i - i;
-        for (k = i_i + 1; k + 1 <= i43 + 6; k++) {
-          A[k] *= absxk;
-        }
-
-        for (k = 1; k <= itemp; k++) {
-          smax *= 9.86076132E-32F;
-        }
-
-        absxk = smax;
-      } else {
-        temp2 = (smax - A[i_i]) / smax;
-        absxk = 1.0F / (A[i_i] - smax);
-        i43 = i_i - i;
-        for (k = i_i + 1; k + 1 <= i43 + 6; k++) {
-          A[k] *= absxk;
-        }
-
-        absxk = smax;
-      }
-    }
-
-    tau[i] = temp2;
-    A[i_i] = absxk;
-    if (i + 1 < 5) {
-      absxk = A[i_i];
-      A[i_i] = 1.0F;
-      i_ip1 = (i + (i + 1) * 6) + 1;
-      if (tau[i] != 0.0F) {
-        lastv = 6 - i;
-        itemp = i_i - i;
-        while ((lastv > 0) && (A[itemp + 5] == 0.0F)) {
-          lastv--;
-          itemp--;
-        }
-
-        lastc = 4 - i;
-        exitg2 = false;
-        while ((!exitg2) && (lastc > 0)) {
-          itemp = i_ip1 + (lastc - 1) * 6;
-          k = itemp;
-          do {
-            exitg1 = 0;
-            if (k <= (itemp + lastv) - 1) {
-              if (A[k - 1] != 0.0F) {
-                exitg1 = 1;
-              } else {
-                k++;
-              }
-            } else {
-              lastc--;
-              exitg1 = 2;
-            }
-          } while (exitg1 == 0);
-
-          if (exitg1 == 1) {
-            exitg2 = true;
-          }
-        }
-      } else {
-        lastv = 0;
-        lastc = 0;
-      }
-
-      if (lastv > 0) {
-        if (lastc == 0) {
-        } else {
-          for (iy = 1; iy <= lastc; iy++) {
-            work[iy - 1] = 0.0F;
-          }
-
-          iy = 0;
-          i43 = i_ip1 + 6 * (lastc - 1);
-          for (itemp = i_ip1; itemp <= i43; itemp += 6) {
-            ix = i_i;
-            smax = 0.0F;
-            pvt = (itemp + lastv) - 1;
-            for (k = itemp; k <= pvt; k++) {
-              smax += A[k - 1] * A[ix];
-              ix++;
-            }
-
-            work[iy] += smax;
-            iy++;
-          }
-        }
-
-        if (-tau[i] == 0.0F) {
-        } else {
-          itemp = i_ip1 - 1;
-          pvt = 0;
-          for (iy = 1; iy <= lastc; iy++) {
-            if (work[pvt] != 0.0F) {
-              smax = work[pvt] * -tau[i];
-              ix = i_i;
-              i43 = lastv + itemp;
-              for (k = itemp; k + 1 <= i43; k++) {
-                A[k] += A[ix] * smax;
-                ix++;
-              }
-            }
-
-            pvt++;
-            itemp += 6;
-          }
-        }
-      }
-
-      A[i_i] = absxk;
-    }
-
-    for (iy = i + 1; iy + 1 < 6; iy++) {
-      itemp = (i + 6 * iy) + 1;
-      if (vn1[iy] != 0.0F) {
-        smax = fabsf(A[i + 6 * iy]) / vn1[iy];
-        smax = 1.0F - smax * smax;
-        if (smax < 0.0F) {
-          smax = 0.0F;
-        }
-
-        temp2 = vn1[iy] / vn2[iy];
-        temp2 = smax * (temp2 * temp2);
-        if (temp2 <= 0.000345266977F) {
-          smax = 0.0F;
-          if (5 - i == 1) {
-            smax = fabsf(A[itemp]);
-          } else {
-            temp2 = 1.17549435E-38F;
-            pvt = (itemp - i) + 5;
-            while (itemp + 1 <= pvt) {
-              absxk = fabsf(A[itemp]);
-              if (absxk > temp2) {
-                t = temp2 / absxk;
-                smax = 1.0F + smax * t * t;
-                temp2 = absxk;
-              } else {
-                t = absxk / temp2;
-                smax += t * t;
-              }
-
-              itemp++;
-            }
-
-            smax = temp2 * sqrtf(smax);
-          }
-
-          vn1[iy] = smax;
-          vn2[iy] = vn1[iy];
-        } else {
-          vn1[iy] *= sqrtf(smax);
-        }
-      }
-    }
-  }
-}
-
 //
 // Arguments    : int n
 //                const emxArray_real32_T *x
@@ -11722,8 +10062,6 @@ static double c_fprintf(float varargin_1)
 //
 static void c_log_info(int varargin_1, int varargin_2)
 {
-  char cv28[44];
-  int i23;
   static const char cv29[44] = { 'S', 'u', 'c', 'c', 'e', 's', 's', 'f', 'u',
     'l', 'l', 'y', ' ', 't', 'r', 'i', 'a', 'n', 'g', 'u', 'l', 'a', 't', 'e',
     'd', ' ', '%', 'd', ' ', 'o', 'f', ' ', '%', 'd', ' ', 'f', 'e', 'a', 't',
@@ -11736,11 +10074,7 @@ static void c_log_info(int varargin_1, int varargin_2)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i23 = 0; i23 < 44; i23++) {
-      cv28[i23] = cv29[i23];
-    }
-
-    LOG_INFO(cv28, varargin_1, varargin_2);
+    LOG_INFO(cv29, varargin_1, varargin_2);
   }
 }
 
@@ -11754,8 +10088,6 @@ static void c_log_info(int varargin_1, int varargin_2)
 //
 static void c_log_warn(int varargin_1, float varargin_2)
 {
-  char cv22[36];
-  int i19;
   static const char cv23[36] = { 'F', 'e', 'a', 't', 'u', 'r', 'e', ' ', '%',
     'i', ' ', 'i', 's', ' ', 'v', 'e', 'r', 'y', ' ', 'c', 'l', 'o', 's', 'e',
     '.', ' ', 'D', 'e', 'p', 't', 'h', ':', ' ', '%', 'f', '\x00' };
@@ -11767,11 +10099,7 @@ static void c_log_warn(int varargin_1, float varargin_2)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i19 = 0; i19 < 36; i19++) {
-      cv22[i19] = cv23[i19];
-    }
-
-    LOG_WARN(cv22, varargin_1, varargin_2);
+    LOG_WARN(cv23, varargin_1, varargin_2);
   }
 }
 
@@ -11803,22 +10131,6 @@ static float c_norm(const float x[2])
   return scale * sqrtf(y);
 }
 
-//
-// Arguments    : emxArray_real32_T *x
-//                emxArray_int32_T *idx
-// Return Type  : void
-//
-static void c_sort(emxArray_real32_T *x, emxArray_int32_T *idx)
-{
-  int dim;
-  dim = 2;
-  if (x->size[0] != 1) {
-    dim = 1;
-  }
-
-  d_sort(x, dim, idx);
-}
-
 //
 // Arguments    : int n
 //                float a
@@ -11952,8 +10264,6 @@ static double d_fprintf(float varargin_1)
 //
 static void d_log_info(int varargin_1)
 {
-  char cv30[52];
-  int i24;
   static const char cv31[52] = { 'I', 'n', 'i', 't', 'i', 'a', 'l', 'i', 'z',
     'i', 'n', 'g', ' ', 'a', 'n', 'c', 'h', 'o', 'r', ' ', '%', 'i', ',', ' ',
     'w', 'h', 'i', 'c', 'h', ' ', 'w', 'a', 's', ' ', 't', 'h', 'e', ' ', 'o',
@@ -11966,11 +10276,7 @@ static void d_log_info(int varargin_1)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i24 = 0; i24 < 52; i24++) {
-      cv30[i24] = cv31[i24];
-    }
-
-    LOG_INFO(cv30, varargin_1);
+    LOG_INFO(cv31, varargin_1);
   }
 }
 
@@ -11983,8 +10289,6 @@ static void d_log_info(int varargin_1)
 //
 static void d_log_warn(signed char varargin_1)
 {
-  char cv24[37];
-  int i21;
   static const char cv25[37] = { 'B', 'a', 'd', ' ', 't', 'r', 'i', 'a', 'n',
     'g', 'u', 'l', 'a', 't', 'i', 'o', 'n', ' ', '(', 'n', 'a', 'n', ')', ' ',
     'f', 'o', 'r', ' ', 'p', 'o', 'i', 'n', 't', ' ', '%', 'd', '\x00' };
@@ -11996,11 +10300,7 @@ static void d_log_warn(signed char varargin_1)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i21 = 0; i21 < 37; i21++) {
-      cv24[i21] = cv25[i21];
-    }
-
-    LOG_WARN(cv24, varargin_1);
+    LOG_WARN(cv25, varargin_1);
   }
 }
 
@@ -12040,99 +10340,6 @@ static float d_norm(const float x[36])
   return y;
 }
 
-//
-// Arguments    : emxArray_real32_T *x
-//                int dim
-//                emxArray_int32_T *idx
-// Return Type  : void
-//
-static void d_sort(emxArray_real32_T *x, int dim, emxArray_int32_T *idx)
-{
-  int i44;
-  emxArray_real32_T *vwork;
-  int vstride;
-  int x_idx_0;
-  int j;
-  emxArray_int32_T *iidx;
-  if (dim <= 1) {
-    i44 = x->size[0];
-  } else {
-    i44 = 1;
-  }
-
-  emxInit_real32_T(&vwork, 1);
-  vstride = vwork->size[0];
-  vwork->size[0] = i44;
-  emxEnsureCapacity((emxArray__common *)vwork, vstride, (int)sizeof(float));
-  x_idx_0 = x->size[0];
-  vstride = idx->size[0];
-  idx->size[0] = x_idx_0;
-  emxEnsureCapacity((emxArray__common *)idx, vstride, (int)sizeof(int));
-  vstride = 1;
-  x_idx_0 = 1;
-  while (x_idx_0 <= dim - 1) {
-    vstride *= x->size[0];
-    x_idx_0 = 2;
-  }
-
-  j = 0;
-  emxInit_int32_T(&iidx, 1);
-  while (j + 1 <= vstride) {
-    for (x_idx_0 = 0; x_idx_0 + 1 <= i44; x_idx_0++) {
-      vwork->data[x_idx_0] = x->data[j + x_idx_0 * vstride];
-    }
-
-    sortIdx(vwork, iidx);
-    for (x_idx_0 = 0; x_idx_0 + 1 <= i44; x_idx_0++) {
-      x->data[j + x_idx_0 * vstride] = vwork->data[x_idx_0];
-      idx->data[j + x_idx_0 * vstride] = iidx->data[x_idx_0];
-    }
-
-    j++;
-  }
-
-  emxFree_int32_T(&iidx);
-  emxFree_real32_T(&vwork);
-}
-
-//
-// Arguments    : int n
-//                const float x[30]
-//                int ix0
-// Return Type  : float
-//
-static float d_xnrm2(int n, const float x[30], int ix0)
-{
-  float y;
-  float scale;
-  int kend;
-  int k;
-  float absxk;
-  float t;
-  y = 0.0F;
-  if (n == 1) {
-    y = fabsf(x[ix0 - 1]);
-  } else {
-    scale = 1.17549435E-38F;
-    kend = (ix0 + n) - 1;
-    for (k = ix0; k <= kend; k++) {
-      absxk = fabsf(x[k - 1]);
-      if (absxk > scale) {
-        t = scale / absxk;
-        y = 1.0F + y * t * t;
-        scale = absxk;
-      } else {
-        t = absxk / scale;
-        y += t * t;
-      }
-    }
-
-    y = scale * sqrtf(y);
-  }
-
-  return y;
-}
-
 //
 // Arguments    : const float v[3]
 //                float d[9]
@@ -12234,8 +10441,6 @@ static double e_fprintf(float varargin_1)
 //
 static void e_log_info(int varargin_1)
 {
-  char cv32[45];
-  int i25;
   static const char cv33[45] = { 'F', 'e', 'a', 't', 'u', 'r', 'e', ' ', '%',
     'd', ' ', 'i', 's', ' ', 't', 'o', 'o', ' ', 'f', 'a', 'r', ' ', 'a', 'w',
     'a', 'y', ' ', 't', 'o', ' ', 't', 'r', 'i', 'a', 'n', 'g', 'u', 'l', 'a',
@@ -12248,11 +10453,7 @@ static void e_log_info(int varargin_1)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i25 = 0; i25 < 45; i25++) {
-      cv32[i25] = cv33[i25];
-    }
-
-    LOG_INFO(cv32, varargin_1);
+    LOG_INFO(cv33, varargin_1);
   }
 }
 
@@ -12266,8 +10467,6 @@ static void e_log_info(int varargin_1)
 //
 static void e_log_warn(int varargin_1, float varargin_2)
 {
-  char cv26[49];
-  int i22;
   static const char cv27[49] = { 'F', 'e', 'a', 't', 'u', 'r', 'e', ' ', '%',
     'i', ' ', 'i', 's', ' ', 't', 'r', 'i', 'a', 'n', 'g', 'u', 'l', 'a', 't',
     'e', 'd', ' ', 'v', 'e', 'r', 'y', ' ', 'c', 'l', 'o', 's', 'e', '.', ' ',
@@ -12280,11 +10479,7 @@ static void e_log_warn(int varargin_1, float varargin_2)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i22 = 0; i22 < 49; i22++) {
-      cv26[i22] = cv27[i22];
-    }
-
-    LOG_WARN(cv26, varargin_1, varargin_2);
+    LOG_WARN(cv27, varargin_1, varargin_2);
   }
 }
 
@@ -12425,27 +10620,6 @@ static void emxFree_real32_T(emxArray_real32_T **pEmxArray)
   }
 }
 
-//
-// Arguments    : emxArray_int32_T **pEmxArray
-//                int b_numDimensions
-// Return Type  : void
-//
-static void emxInit_int32_T(emxArray_int32_T **pEmxArray, int b_numDimensions)
-{
-  emxArray_int32_T *emxArray;
-  int i;
-  *pEmxArray = (emxArray_int32_T *)malloc(sizeof(emxArray_int32_T));
-  emxArray = *pEmxArray;
-  emxArray->data = (int *)NULL;
-  emxArray->numDimensions = b_numDimensions;
-  emxArray->size = (int *)malloc((unsigned int)(sizeof(int) * b_numDimensions));
-  emxArray->allocatedSize = 0;
-  emxArray->canFreeData = true;
-  for (i = 0; i < b_numDimensions; i++) {
-    emxArray->size[i] = 0;
-  }
-}
-
 //
 // Arguments    : emxArray_int32_T **pEmxArray
 //                int b_numDimensions
@@ -12545,8 +10719,6 @@ static double f_fprintf(float varargin_1)
 //
 static void f_log_info(int varargin_1, float varargin_2, float varargin_3)
 {
-  char cv40[51];
-  int i29;
   static const char cv41[51] = { 'F', 'o', 'r', 'c', 'i', 'n', 'g', ' ', 'a',
     'c', 't', 'i', 'v', 'a', 't', 'i', 'o', 'n', ' ', 'o', 'f', ' ', 'f', 'e',
     'a', 't', 'u', 'r', 'e', ' ', '%', 'i', ' ', '(', '%', 'i', ' ', 'o', 'n',
@@ -12559,11 +10731,7 @@ static void f_log_info(int varargin_1, float varargin_2, float varargin_3)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i29 = 0; i29 < 51; i29++) {
-      cv40[i29] = cv41[i29];
-    }
-
-    LOG_INFO(cv40, varargin_1, varargin_2, varargin_3);
+    LOG_INFO(cv41, varargin_1, varargin_2, varargin_3);
   }
 }
 
@@ -12576,8 +10744,6 @@ static void f_log_info(int varargin_1, float varargin_2, float varargin_3)
 //
 static void f_log_warn(float varargin_1)
 {
-  char cv34[62];
-  int i26;
   static const char cv35[62] = { 'G', 'o', 't', ' ', '%', 'd', ' ', 'n', 'e',
     'w', ' ', 'f', 'e', 'a', 'u', 't', 'u', 'r', 'e', 's', ' ', 'b', 'u', 't',
     ' ', 'n', 'o', 't', ' ', 'e', 'n', 'o', 'u', 'g', 'h', ' ', 'f', 'o', 'r',
@@ -12591,11 +10757,7 @@ static void f_log_warn(float varargin_1)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i26 = 0; i26 < 62; i26++) {
-      cv34[i26] = cv35[i26];
-    }
-
-    LOG_WARN(cv34, varargin_1, 4);
+    LOG_WARN(cv35, varargin_1, 4);
   }
 }
 
@@ -12676,8 +10838,6 @@ static double g_fprintf(float varargin_1)
 //
 static void g_log_info(int varargin_1)
 {
-  char cv44[28];
-  int i31;
   static const char cv45[28] = { 'S', 'e', 't', 't', 'i', 'n', 'g', ' ', 'a',
     'n', 'c', 'h', 'o', 'r', ' ', '%', 'i', ' ', 'a', 's', ' ', 'o', 'r', 'i',
     'g', 'i', 'n', '\x00' };
@@ -12689,11 +10849,7 @@ static void g_log_info(int varargin_1)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i31 = 0; i31 < 28; i31++) {
-      cv44[i31] = cv45[i31];
-    }
-
-    LOG_INFO(cv44, varargin_1);
+    LOG_INFO(cv45, varargin_1);
   }
 }
 
@@ -12708,8 +10864,6 @@ static void g_log_info(int varargin_1)
 //
 static void g_log_warn(int varargin_1, int varargin_2, int varargin_3)
 {
-  char cv36[57];
-  int i27;
   static const char cv37[57] = { 'F', 'e', 'a', 't', 'u', 'r', 'e', ' ', '%',
     'i', ' ', '(', '%', 'i', ' ', 'o', 'n', ' ', 'a', 'n', 'c', 'h', 'o', 'r',
     ' ', '%', 'i', ')', ' ', 'c', 'o', 'n', 'v', 'e', 'r', 'g', 'e', 'd', ' ',
@@ -12723,11 +10877,7 @@ static void g_log_warn(int varargin_1, int varargin_2, int varargin_3)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i27 = 0; i27 < 57; i27++) {
-      cv36[i27] = cv37[i27];
-    }
-
-    LOG_WARN(cv36, varargin_1, varargin_2, varargin_3);
+    LOG_WARN(cv37, varargin_1, varargin_2, varargin_3);
   }
 }
 
@@ -15293,8 +13443,6 @@ static double h_fprintf(float varargin_1, float varargin_2, float varargin_3)
 //
 static void h_log_warn(int varargin_1)
 {
-  char cv38[52];
-  int i28;
   static const char cv39[52] = { 'T', 'r', 'y', 'i', 'n', 'g', ' ', 't', 'o',
     ' ', 'f', 'o', 'r', 'c', 'e', ' ', 'i', 'n', 's', 'e', 'r', 't', ' ', 'f',
     'e', 'a', 't', 'u', 'r', 'e', ' ', '%', 'i', ' ', 'b', 'e', 'h', 'i', 'n',
@@ -15307,11 +13455,7 @@ static void h_log_warn(int varargin_1)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i28 = 0; i28 < 52; i28++) {
-      cv38[i28] = cv39[i28];
-    }
-
-    LOG_WARN(cv38, varargin_1);
+    LOG_WARN(cv39, varargin_1);
   }
 }
 
@@ -15352,8 +13496,6 @@ static double i_fprintf(float varargin_1, float varargin_2, float varargin_3)
 //
 static void i_log_warn()
 {
-  char cv42[54];
-  int i30;
   static const char cv43[54] = { 'C', 'a', 'n', '\'', 't', ' ', 'f', 'i', 'x',
     ' ', 'a', 'n', ' ', 'a', 'n', 'c', 'h', 'o', 'r', ' ', 'b', 'e', 'c', 'a',
     'u', 's', 'e', ' ', 'n', 'o', 'n', 'e', ' ', 'h', 'a', 'v', 'e', ' ', 'a',
@@ -15367,242 +13509,7 @@ static void i_log_warn()
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i30 = 0; i30 < 54; i30++) {
-      cv42[i30] = cv43[i30];
-    }
-
-    LOG_WARN(cv42);
-  }
-}
-
-//
-// INITIALIZEPOINT Initialize a feature point from undistorted measurements
-//
-//  INPUT ARGUMENTS:
-//  - cameraparams: The camera parameter struct
-//  - z_l: The undistorted measurement of the feature in the left camera
-//  - z_r: The undistorted measurement of the feature in the right camera
-//
-//  OUTPUT ARGUMENTS:
-//  - fp: The feature point in the camera frame
-//  - m:  The ray in the left and right camera frame to the feature
-// Arguments    : const float z_u_l[2]
-//                const float z_u_r[2]
-//                const float c_cameraparams_CameraParameters[2]
-//                const float d_cameraparams_CameraParameters[2]
-//                const float e_cameraparams_CameraParameters[2]
-//                const float f_cameraparams_CameraParameters[2]
-//                const float cameraparams_r_lr[3]
-//                const float cameraparams_R_lr[9]
-//                float fp[3]
-//                float b_m[6]
-//                boolean_T *success
-// Return Type  : void
-//
-static void initializePoint(const float z_u_l[2], const float z_u_r[2], const
-  float c_cameraparams_CameraParameters[2], const float
-  d_cameraparams_CameraParameters[2], const float
-  e_cameraparams_CameraParameters[2], const float
-  f_cameraparams_CameraParameters[2], const float cameraparams_r_lr[3], const
-  float cameraparams_R_lr[9], float fp[3], float b_m[6], boolean_T *success)
-{
-  float ml[3];
-  float mr[3];
-  float tol;
-  float fcnOutput;
-  float b_pos[6];
-  int i;
-  int i20;
-  static const signed char iv0[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
-
-  float rot[18];
-  float A[30];
-  float b[6];
-  int anchorIdx;
-  int rankR;
-  int j;
-  float b_rot[9];
-  static const signed char iv1[9] = { -1, 0, 0, 0, -1, 0, 0, 0, -1 };
-
-  int jpvt[5];
-  float tau[5];
-  float x[5];
-
-  // 'initializePoint:13' fx_l = cameraparams.CameraParameters1.FocalLength(1);
-  // 'initializePoint:14' fy_l = cameraparams.CameraParameters1.FocalLength(2);
-  // 'initializePoint:15' Cx_l = cameraparams.CameraParameters1.PrincipalPoint(1); 
-  // 'initializePoint:16' Cy_l = cameraparams.CameraParameters1.PrincipalPoint(2); 
-  // 'initializePoint:18' fx_r = cameraparams.CameraParameters2.FocalLength(1);
-  // 'initializePoint:19' fy_r = cameraparams.CameraParameters2.FocalLength(2);
-  // 'initializePoint:20' Cx_r = cameraparams.CameraParameters2.PrincipalPoint(1); 
-  // 'initializePoint:21' Cy_r = cameraparams.CameraParameters2.PrincipalPoint(2); 
-  // 'initializePoint:23' pos = [zeros(3,1), cameraparams.r_lr];
-  // 'initializePoint:24' rot = [eye(3), cameraparams.R_lr'];
-  // 'initializePoint:26' z_n_l = [(z_u_l(1) - Cx_l)/fx_l; (z_u_l(2) - Cy_l)/fy_l]; 
-  // 'initializePoint:27' z_n_r = [(z_u_r(1) - Cx_r)/fx_r; (z_u_r(2) - Cy_r)/fy_r]; 
-  // 'initializePoint:29' ml = [z_n_l; 1];
-  ml[0] = (z_u_l[0] - d_cameraparams_CameraParameters[0]) /
-    c_cameraparams_CameraParameters[0];
-  ml[1] = (z_u_l[1] - d_cameraparams_CameraParameters[1]) /
-    c_cameraparams_CameraParameters[1];
-  ml[2] = 1.0F;
-
-  // 'initializePoint:30' mr = [z_n_r; 1];
-  mr[0] = (z_u_r[0] - f_cameraparams_CameraParameters[0]) /
-    e_cameraparams_CameraParameters[0];
-  mr[1] = (z_u_r[1] - f_cameraparams_CameraParameters[1]) /
-    e_cameraparams_CameraParameters[1];
-  mr[2] = 1.0F;
-
-  // 'initializePoint:31' m = [ml/norm(ml),mr/norm(mr)];
-  tol = norm(ml);
-  fcnOutput = norm(mr);
-  for (i = 0; i < 3; i++) {
-    b_pos[i] = 0.0F;
-    b_pos[3 + i] = cameraparams_r_lr[i];
-    for (i20 = 0; i20 < 3; i20++) {
-      rot[i20 + 3 * i] = iv0[i20 + 3 * i];
-      rot[i20 + 3 * (i + 3)] = cameraparams_R_lr[i + 3 * i20];
-    }
-
-    b_m[i] = ml[i] / tol;
-    b_m[3 + i] = mr[i] / fcnOutput;
-  }
-
-  //  normalized rays in left frame
-  // 'initializePoint:34' ml_n_l = m(:,1);
-  // 'initializePoint:35' mr_n_r = cameraparams.R_lr * m(:,2);
-  for (i = 0; i < 3; i++) {
-    ml[i] = 0.0F;
-    for (i20 = 0; i20 < 3; i20++) {
-      ml[i] += cameraparams_R_lr[i + 3 * i20] * b_m[3 + i20];
-    }
-  }
-
-  // 'initializePoint:36' cross_prod = cross(ml_n_l, mr_n_r);
-  // 'initializePoint:37' if cross_prod(2) > 0
-  if (b_m[2] * ml[0] - b_m[0] * ml[2] > 0.0F) {
-    // 'initializePoint:38' success = false;
-    *success = false;
-
-    // 'initializePoint:39' fp = m(:,1);
-    for (i = 0; i < 3; i++) {
-      fp[i] = b_m[i];
-    }
-  } else {
-    // 'initializePoint:42' success = true;
-    *success = true;
-
-    // 'initializePoint:44' [ fp ] = triangulatePoint( pos, rot, m );
-    // triangulatePoint Triangulate a point from several measurements
-    //    Calculate the world position of a point given measurements of it from
-    //    different positions. The solution minimizes the least squares error
-    //
-    //  INPUTS:
-    //  pos: a 3 x n matrix containing the positions of the cameras
-    //  rot: a 4 x n matrix containing the JPL quaternions of the cameras
-    //  m: a 3 x n matrix containing the unit vectors pointing towards the
-    //      feature in the camera frame
-    //  where n is the number of poses
-    //
-    //  OUTPUTS:
-    //  pf: the feature position in world coordinates
-    //  condition: the condition number of the least squares problem. High
-    //      numbers mean a badly conditiond problem and a bad result
-    // 'triangulatePoint:18' numAnchors = size(pos, 2);
-    // 'triangulatePoint:20' A = zeros(3*numAnchors, numAnchors + 3);
-    memset(&A[0], 0, 30U * sizeof(float));
-
-    // 'triangulatePoint:21' b = zeros(3*numAnchors, 1);
-    for (i = 0; i < 6; i++) {
-      b[i] = 0.0F;
-    }
-
-    // 'triangulatePoint:23' for anchorIdx = 1:numAnchors
-    for (anchorIdx = 0; anchorIdx < 2; anchorIdx++) {
-      // 'triangulatePoint:24' currentAnchorPos = pos(:,anchorIdx);
-      // 'triangulatePoint:25' currentAnchorRot = rot(:, (anchorIdx-1)*3 + (1:3)); 
-      rankR = anchorIdx * 3;
-
-      // 'triangulatePoint:26' currentM = m(:,anchorIdx);
-      // 'triangulatePoint:28' A((anchorIdx-1)*3 + (1:3), anchorIdx) = currentAnchorRot'*currentM; 
-      j = anchorIdx * 3;
-      for (i = 0; i < 3; i++) {
-        for (i20 = 0; i20 < 3; i20++) {
-          b_rot[i20 + 3 * i] = rot[i + 3 * (i20 + rankR)];
-        }
-      }
-
-      for (i = 0; i < 3; i++) {
-        A[(i + j) + 6 * anchorIdx] = 0.0F;
-        for (i20 = 0; i20 < 3; i20++) {
-          A[(i + j) + 6 * anchorIdx] += b_rot[i + 3 * i20] * b_m[i20 + 3 *
-            anchorIdx];
-        }
-      }
-
-      // 'triangulatePoint:29' A((anchorIdx-1)*3 + (1:3), end - 3 + (1:3)) = -eye(3); 
-      rankR = anchorIdx * 3;
-
-      // 'triangulatePoint:31' b((anchorIdx-1)*3 + (1:3)) = - currentAnchorPos;
-      j = anchorIdx * 3;
-      for (i = 0; i < 3; i++) {
-        for (i20 = 0; i20 < 3; i20++) {
-          A[(i20 + rankR) + 6 * (2 + i)] = iv1[i20 + 3 * i];
-        }
-
-        b[i + j] = -b_pos[i + 3 * anchorIdx];
-      }
-    }
-
-    //  condition = cond(A);
-    // 'triangulatePoint:35' x = A\b;
-    b_xgeqp3(A, tau, jpvt);
-    rankR = 0;
-    tol = 6.0F * fabsf(A[0]) * 1.1920929E-7F;
-    while ((rankR < 5) && (fabsf(A[rankR + 6 * rankR]) >= tol)) {
-      rankR++;
-    }
-
-    for (j = 0; j < 5; j++) {
-      x[j] = 0.0F;
-      if (tau[j] != 0.0F) {
-        tol = b[j];
-        for (i = j + 1; i + 1 < 7; i++) {
-          tol += A[i + 6 * j] * b[i];
-        }
-
-        tol *= tau[j];
-        if (tol != 0.0F) {
-          b[j] -= tol;
-          for (i = j + 1; i + 1 < 7; i++) {
-            b[i] -= A[i + 6 * j] * tol;
-          }
-        }
-      }
-    }
-
-    for (i = 0; i + 1 <= rankR; i++) {
-      x[jpvt[i] - 1] = b[i];
-    }
-
-    for (j = rankR - 1; j + 1 > 0; j--) {
-      x[jpvt[j] - 1] /= A[j + 6 * j];
-      for (i = 0; i + 1 <= j; i++) {
-        x[jpvt[i] - 1] -= x[jpvt[j] - 1] * A[i + 6 * j];
-      }
-    }
-
-    // 'triangulatePoint:36' pf = x(end-2:end);
-    for (i = 0; i < 3; i++) {
-      fp[i] = x[i + 2];
-    }
-
-    //  is this better?
-    //  A = [cameraparams.R_rl * ml, -mr];
-    //  b = cameraparams.r_lr;
-    //  x = A\b;
-    //  fp = ml*x(1);
+    LOG_WARN(cv43);
   }
 }
 
@@ -15692,8 +13599,6 @@ static double l_fprintf(int varargin_1)
 //
 static void log_error()
 {
-  char cv12[27];
-  int i11;
   static const char cv13[27] = { 'p', 'i', 'c', 'k', 'e', 'd', ' ', 'a', 'n',
     ' ', 'i', 'n', 'a', 'c', 't', 'i', 'v', 'e', ' ', 'f', 'e', 'a', 't', 'u',
     'r', 'e', '\x00' };
@@ -15702,11 +13607,7 @@ static void log_error()
   // 'log_error:8' elseif ~coder.target('MEX')
   // 'log_error:9' coder.cinclude('<vio_logging.h>')
   // 'log_error:10' coder.ceval('LOG_ERROR', [str, 0], varargin{:});
-  for (i11 = 0; i11 < 27; i11++) {
-    cv12[i11] = cv13[i11];
-  }
-
-  LOG_ERROR(cv12);
+  LOG_ERROR(cv13);
 }
 
 //
@@ -15720,8 +13621,6 @@ static void log_error()
 //
 static void log_info(int varargin_1, int varargin_2, int varargin_3)
 {
-  char cv10[54];
-  int i10;
   static const char cv11[54] = { 'F', 'i', 'x', 'e', 'd', ' ', 'f', 'e', 'a',
     't', 'u', 'r', 'e', ' ', '%', 'i', ' ', '(', '%', 'i', ' ', 'o', 'n', ' ',
     'a', 'n', 'c', 'h', 'o', 'r', ' ', '%', 'i', ')', ' ', 'i', 's', ' ', 'n',
@@ -15735,11 +13634,7 @@ static void log_info(int varargin_1, int varargin_2, int varargin_3)
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i10 = 0; i10 < 54; i10++) {
-      cv10[i10] = cv11[i10];
-    }
-
-    LOG_INFO(cv10, varargin_1, varargin_2, varargin_3);
+    LOG_INFO(cv11, varargin_1, varargin_2, varargin_3);
   }
 }
 
@@ -15754,8 +13649,6 @@ static void log_info(int varargin_1, int varargin_2, int varargin_3)
 //
 static void log_warn(int varargin_1, int varargin_2, int varargin_3)
 {
-  char cv16[54];
-  int i16;
   static const char cv17[54] = { 'F', 'e', 'a', 't', 'u', 'r', 'e', ' ', '%',
     'i', ' ', '(', '%', 'i', ' ', 'o', 'n', ' ', '%', 'i', ')', ' ', 'i', 's',
     ' ', 'b', 'e', 'h', 'i', 'n', 'd', ' ', 'i', 't', 's', ' ', 'a', 'n', 'c',
@@ -15769,11 +13662,7 @@ static void log_warn(int varargin_1, int varargin_2, int varargin_3)
   // 'log_warn:14' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-    for (i16 = 0; i16 < 54; i16++) {
-      cv16[i16] = cv17[i16];
-    }
-
-    LOG_WARN(cv16, varargin_1, varargin_2, varargin_3);
+    LOG_WARN(cv17, varargin_1, varargin_2, varargin_3);
   }
 }
 
@@ -15813,252 +13702,6 @@ static double m_fprintf(const char varargin_1_data[], const int varargin_1_size
   return nbytesint;
 }
 
-//
-// Arguments    : const float x_data[]
-//                const int x_size[1]
-// Return Type  : float
-//
-static float median(const float x_data[], const int x_size[1])
-{
-  float y;
-  int k;
-  int midm1;
-  int i;
-  int idx_data[48];
-  emxArray_int32_T *iwork;
-  int n;
-  int iwork_data[48];
-  boolean_T p;
-  int i2;
-  int j;
-  int pEnd;
-  int b_p;
-  int q;
-  int qEnd;
-  int kEnd;
-  if (x_size[0] == 0) {
-    y = ((real32_T)rtNaN);
-  } else {
-    k = x_size[0];
-    midm1 = k / 2;
-    i = (signed char)x_size[0];
-    for (k = 0; k < i; k++) {
-      idx_data[k] = 0;
-    }
-
-    emxInit_int32_T(&iwork, 1);
-    n = x_size[0] + 1;
-    k = iwork->size[0];
-    iwork->size[0] = (signed char)x_size[0];
-    emxEnsureCapacity((emxArray__common *)iwork, k, (int)sizeof(int));
-    i = iwork->size[0];
-    for (k = 0; k < i; k++) {
-      iwork_data[k] = iwork->data[k];
-    }
-
-    emxFree_int32_T(&iwork);
-    for (k = 1; k <= n - 2; k += 2) {
-      if ((x_data[k - 1] <= x_data[k]) || rtIsNaNF(x_data[k])) {
-        p = true;
-      } else {
-        p = false;
-      }
-
-      if (p) {
-        idx_data[k - 1] = k;
-        idx_data[k] = k + 1;
-      } else {
-        idx_data[k - 1] = k + 1;
-        idx_data[k] = k;
-      }
-    }
-
-    if ((x_size[0] & 1) != 0) {
-      idx_data[x_size[0] - 1] = x_size[0];
-    }
-
-    i = 2;
-    while (i < n - 1) {
-      i2 = i << 1;
-      j = 1;
-      for (pEnd = 1 + i; pEnd < n; pEnd = qEnd + i) {
-        b_p = j;
-        q = pEnd - 1;
-        qEnd = j + i2;
-        if (qEnd > n) {
-          qEnd = n;
-        }
-
-        k = 0;
-        kEnd = qEnd - j;
-        while (k + 1 <= kEnd) {
-          if ((x_data[idx_data[b_p - 1] - 1] <= x_data[idx_data[q] - 1]) ||
-              rtIsNaNF(x_data[idx_data[q] - 1])) {
-            p = true;
-          } else {
-            p = false;
-          }
-
-          if (p) {
-            iwork_data[k] = idx_data[b_p - 1];
-            b_p++;
-            if (b_p == pEnd) {
-              while (q + 1 < qEnd) {
-                k++;
-                iwork_data[k] = idx_data[q];
-                q++;
-              }
-            }
-          } else {
-            iwork_data[k] = idx_data[q];
-            q++;
-            if (q + 1 == qEnd) {
-              while (b_p < pEnd) {
-                k++;
-                iwork_data[k] = idx_data[b_p - 1];
-                b_p++;
-              }
-            }
-          }
-
-          k++;
-        }
-
-        for (k = 0; k + 1 <= kEnd; k++) {
-          idx_data[(j + k) - 1] = iwork_data[k];
-        }
-
-        j = qEnd;
-      }
-
-      i = i2;
-    }
-
-    if (rtIsNaNF(x_data[idx_data[(signed char)x_size[0] - 1] - 1])) {
-      y = x_data[idx_data[(signed char)x_size[0] - 1] - 1];
-    } else if (midm1 << 1 == x_size[0]) {
-      if (((x_data[idx_data[midm1 - 1] - 1] < 0.0F) && (x_data[idx_data[midm1] -
-            1] >= 0.0F)) || rtIsInfF(x_data[idx_data[midm1 - 1] - 1]) ||
-          rtIsInfF(x_data[idx_data[midm1] - 1])) {
-        y = (x_data[idx_data[midm1 - 1] - 1] + x_data[idx_data[midm1] - 1]) /
-          2.0F;
-      } else {
-        y = x_data[idx_data[midm1 - 1] - 1] + (x_data[idx_data[midm1] - 1] -
-          x_data[idx_data[midm1 - 1] - 1]) / 2.0F;
-      }
-    } else {
-      y = x_data[idx_data[midm1] - 1];
-    }
-  }
-
-  return y;
-}
-
-//
-// Arguments    : int idx[8]
-//                float x[8]
-//                int offset
-//                int np
-//                int nq
-//                int iwork[8]
-//                float xwork[8]
-// Return Type  : void
-//
-static void merge(int idx[8], float x[8], int offset, int np, int nq, int iwork
-                  [8], float xwork[8])
-{
-  int n;
-  int qend;
-  int p;
-  int iout;
-  int exitg1;
-  if (nq == 0) {
-  } else {
-    n = np + nq;
-    for (qend = 0; qend + 1 <= n; qend++) {
-      iwork[qend] = idx[offset + qend];
-      xwork[qend] = x[offset + qend];
-    }
-
-    p = 0;
-    n = np;
-    qend = np + nq;
-    iout = offset - 1;
-    do {
-      exitg1 = 0;
-      iout++;
-      if (xwork[p] <= xwork[n]) {
-        idx[iout] = iwork[p];
-        x[iout] = xwork[p];
-        if (p + 1 < np) {
-          p++;
-        } else {
-          exitg1 = 1;
-        }
-      } else {
-        idx[iout] = iwork[n];
-        x[iout] = xwork[n];
-        if (n + 1 < qend) {
-          n++;
-        } else {
-          n = (iout - p) + 1;
-          while (p + 1 <= np) {
-            idx[n + p] = iwork[p];
-            x[n + p] = xwork[p];
-            p++;
-          }
-
-          exitg1 = 1;
-        }
-      }
-    } while (exitg1 == 0);
-  }
-}
-
-//
-// Arguments    : emxArray_int32_T *idx
-//                emxArray_real32_T *x
-//                int offset
-//                int n
-//                int preSortLevel
-//                emxArray_int32_T *iwork
-//                emxArray_real32_T *xwork
-// Return Type  : void
-//
-static void merge_block(emxArray_int32_T *idx, emxArray_real32_T *x, int offset,
-  int n, int preSortLevel, emxArray_int32_T *iwork, emxArray_real32_T *xwork)
-{
-  int nPairs;
-  int bLen;
-  int tailOffset;
-  int nTail;
-  nPairs = n >> preSortLevel;
-  bLen = 1 << preSortLevel;
-  while (nPairs > 1) {
-    if ((nPairs & 1) != 0) {
-      nPairs--;
-      tailOffset = bLen * nPairs;
-      nTail = n - tailOffset;
-      if (nTail > bLen) {
-        b_merge(idx, x, offset + tailOffset, bLen, nTail - bLen, iwork, xwork);
-      }
-    }
-
-    tailOffset = bLen << 1;
-    nPairs >>= 1;
-    for (nTail = 1; nTail <= nPairs; nTail++) {
-      b_merge(idx, x, offset + (nTail - 1) * tailOffset, bLen, bLen, iwork,
-              xwork);
-    }
-
-    bLen = tailOffset;
-  }
-
-  if (n > bLen) {
-    b_merge(idx, x, offset, bLen, n - bLen, iwork, xwork);
-  }
-}
-
 //
 // Arguments    : int a
 //                int b
@@ -16433,12 +14076,10 @@ static void printParams(float c_noiseParameters_process_noise, float
   c_VIOParameters_delayed_initial, boolean_T VIOParameters_mono, boolean_T
   VIOParameters_full_stereo, boolean_T VIOParameters_RANSAC)
 {
-  char cv0[18];
   int i1;
   static const char cv1[18] = { 'N', 'o', 'i', 's', 'e', ' ', 'p', 'a', 'r', 'a',
     'm', 'e', 't', 'e', 'r', 's', ':', '\x00' };
 
-  char cv2[15];
   static const char cv3[15] = { 'V', 'I', 'O', ' ', 'p', 'a', 'r', 'a', 'm', 'e',
     't', 'e', 'r', 's', '\x00' };
 
@@ -16462,11 +14103,7 @@ static void printParams(float c_noiseParameters_process_noise, float
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0F) {
     // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i1 = 0; i1 < 18; i1++) {
-      cv0[i1] = cv1[i1];
-    }
-
-    LOG_INFO(cv0);
+    LOG_INFO(cv1);
   }
 
   // 'SLAM:134' fprintf('\tqv: %f\n', noiseParameters.process_noise.qv);
@@ -16511,12 +14148,8 @@ static void printParams(float c_noiseParameters_process_noise, float
   // 'log_info:12' coder.cinclude('<vio_logging.h>')
   // 'log_info:13' if debug_level >= 2
   if (debug_level >= 2.0F) {
-    // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
-    for (i1 = 0; i1 < 15; i1++) {
-      cv2[i1] = cv3[i1];
-    }
-
-    LOG_INFO(cv2);
+    // 'log_info:14' coder.ceval('LOG_INFO', [str, 0], varargin{:});
+    LOG_INFO(cv3);
   }
 
   // 'SLAM:146' fprintf('\tmax_ekf_iterations: %d\n', int32(VIOParameters.max_ekf_iterations)); 
@@ -16764,312 +14397,6 @@ static void rdivide(const float x[3], float y, float z[3])
   }
 }
 
-//
-// Arguments    : float x[8]
-//                int idx[8]
-// Return Type  : void
-//
-static void sort(float x[8], int idx[8])
-{
-  b_sort(x, idx);
-}
-
-//
-// Arguments    : emxArray_real32_T *x
-//                emxArray_int32_T *idx
-// Return Type  : void
-//
-static void sortIdx(emxArray_real32_T *x, emxArray_int32_T *idx)
-{
-  emxArray_real32_T *b_x;
-  int ib;
-  int wOffset;
-  int b_m;
-  int n;
-  float x4[4];
-  int idx4[4];
-  emxArray_int32_T *iwork;
-  emxArray_real32_T *xwork;
-  int nNaNs;
-  int k;
-  int i3;
-  int i4;
-  signed char perm[4];
-  int nNonNaN;
-  int nBlocks;
-  int b_iwork[256];
-  float b_xwork[256];
-  int bLen2;
-  int nPairs;
-  int exitg1;
-  emxInit_real32_T(&b_x, 1);
-  ib = x->size[0];
-  wOffset = b_x->size[0];
-  b_x->size[0] = x->size[0];
-  emxEnsureCapacity((emxArray__common *)b_x, wOffset, (int)sizeof(float));
-  b_m = x->size[0];
-  for (wOffset = 0; wOffset < b_m; wOffset++) {
-    b_x->data[wOffset] = x->data[wOffset];
-  }
-
-  wOffset = idx->size[0];
-  idx->size[0] = ib;
-  emxEnsureCapacity((emxArray__common *)idx, wOffset, (int)sizeof(int));
-  for (wOffset = 0; wOffset < ib; wOffset++) {
-    idx->data[wOffset] = 0;
-  }
-
-  n = x->size[0];
-  for (b_m = 0; b_m < 4; b_m++) {
-    x4[b_m] = 0.0F;
-    idx4[b_m] = 0;
-  }
-
-  emxInit_int32_T(&iwork, 1);
-  wOffset = iwork->size[0];
-  iwork->size[0] = ib;
-  emxEnsureCapacity((emxArray__common *)iwork, wOffset, (int)sizeof(int));
-  b_m = iwork->size[0];
-  wOffset = iwork->size[0];
-  iwork->size[0] = b_m;
-  emxEnsureCapacity((emxArray__common *)iwork, wOffset, (int)sizeof(int));
-  for (wOffset = 0; wOffset < b_m; wOffset++) {
-    iwork->data[wOffset] = 0;
-  }
-
-  emxInit_real32_T(&xwork, 1);
-  b_m = x->size[0];
-  wOffset = xwork->size[0];
-  xwork->size[0] = b_m;
-  emxEnsureCapacity((emxArray__common *)xwork, wOffset, (int)sizeof(float));
-  b_m = xwork->size[0];
-  wOffset = xwork->size[0];
-  xwork->size[0] = b_m;
-  emxEnsureCapacity((emxArray__common *)xwork, wOffset, (int)sizeof(float));
-  for (wOffset = 0; wOffset < b_m; wOffset++) {
-    xwork->data[wOffset] = 0.0F;
-  }
-
-  nNaNs = 1;
-  ib = 0;
-  for (k = 0; k + 1 <= n; k++) {
-    if (rtIsNaNF(b_x->data[k])) {
-      idx->data[n - nNaNs] = k + 1;
-      xwork->data[n - nNaNs] = b_x->data[k];
-      nNaNs++;
-    } else {
-      ib++;
-      idx4[ib - 1] = k + 1;
-      x4[ib - 1] = b_x->data[k];
-      if (ib == 4) {
-        ib = k - nNaNs;
-        if (x4[0] <= x4[1]) {
-          b_m = 1;
-          wOffset = 2;
-        } else {
-          b_m = 2;
-          wOffset = 1;
-        }
-
-        if (x4[2] <= x4[3]) {
-          i3 = 3;
-          i4 = 4;
-        } else {
-          i3 = 4;
-          i4 = 3;
-        }
-
-        if (x4[b_m - 1] <= x4[i3 - 1]) {
-          if (x4[wOffset - 1] <= x4[i3 - 1]) {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)wOffset;
-            perm[2] = (signed char)i3;
-            perm[3] = (signed char)i4;
-          } else if (x4[wOffset - 1] <= x4[i4 - 1]) {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)i3;
-            perm[2] = (signed char)wOffset;
-            perm[3] = (signed char)i4;
-          } else {
-            perm[0] = (signed char)b_m;
-            perm[1] = (signed char)i3;
-            perm[2] = (signed char)i4;
-            perm[3] = (signed char)wOffset;
-          }
-        } else if (x4[b_m - 1] <= x4[i4 - 1]) {
-          if (x4[wOffset - 1] <= x4[i4 - 1]) {
-            perm[0] = (signed char)i3;
-            perm[1] = (signed char)b_m;
-            perm[2] = (signed char)wOffset;
-            perm[3] = (signed char)i4;
-          } else {
-            perm[0] = (signed char)i3;
-            perm[1] = (signed char)b_m;
-            perm[2] = (signed char)i4;
-            perm[3] = (signed char)wOffset;
-          }
-        } else {
-          perm[0] = (signed char)i3;
-          perm[1] = (signed char)i4;
-          perm[2] = (signed char)b_m;
-          perm[3] = (signed char)wOffset;
-        }
-
-        idx->data[ib - 2] = idx4[perm[0] - 1];
-        idx->data[ib - 1] = idx4[perm[1] - 1];
-        idx->data[ib] = idx4[perm[2] - 1];
-        idx->data[ib + 1] = idx4[perm[3] - 1];
-        b_x->data[ib - 2] = x4[perm[0] - 1];
-        b_x->data[ib - 1] = x4[perm[1] - 1];
-        b_x->data[ib] = x4[perm[2] - 1];
-        b_x->data[ib + 1] = x4[perm[3] - 1];
-        ib = 0;
-      }
-    }
-  }
-
-  wOffset = x->size[0] - nNaNs;
-  if (ib > 0) {
-    for (b_m = 0; b_m < 4; b_m++) {
-      perm[b_m] = 0;
-    }
-
-    if (ib == 1) {
-      perm[0] = 1;
-    } else if (ib == 2) {
-      if (x4[0] <= x4[1]) {
-        perm[0] = 1;
-        perm[1] = 2;
-      } else {
-        perm[0] = 2;
-        perm[1] = 1;
-      }
-    } else if (x4[0] <= x4[1]) {
-      if (x4[1] <= x4[2]) {
-        perm[0] = 1;
-        perm[1] = 2;
-        perm[2] = 3;
-      } else if (x4[0] <= x4[2]) {
-        perm[0] = 1;
-        perm[1] = 3;
-        perm[2] = 2;
-      } else {
-        perm[0] = 3;
-        perm[1] = 1;
-        perm[2] = 2;
-      }
-    } else if (x4[0] <= x4[2]) {
-      perm[0] = 2;
-      perm[1] = 1;
-      perm[2] = 3;
-    } else if (x4[1] <= x4[2]) {
-      perm[0] = 2;
-      perm[1] = 3;
-      perm[2] = 1;
-    } else {
-      perm[0] = 3;
-      perm[1] = 2;
-      perm[2] = 1;
-    }
-
-    for (k = 1; k <= ib; k++) {
-      idx->data[(wOffset - ib) + k] = idx4[perm[k - 1] - 1];
-      b_x->data[(wOffset - ib) + k] = x4[perm[k - 1] - 1];
-    }
-  }
-
-  b_m = (nNaNs - 1) >> 1;
-  for (k = 1; k <= b_m; k++) {
-    ib = idx->data[wOffset + k];
-    idx->data[wOffset + k] = idx->data[n - k];
-    idx->data[n - k] = ib;
-    b_x->data[wOffset + k] = xwork->data[n - k];
-    b_x->data[n - k] = xwork->data[wOffset + k];
-  }
-
-  if (((nNaNs - 1) & 1) != 0) {
-    b_x->data[(wOffset + b_m) + 1] = xwork->data[(wOffset + b_m) + 1];
-  }
-
-  nNonNaN = (x->size[0] - nNaNs) + 1;
-  b_m = 2;
-  if (nNonNaN > 1) {
-    if (x->size[0] >= 256) {
-      nBlocks = nNonNaN >> 8;
-      if (nBlocks > 0) {
-        for (i3 = 1; i3 <= nBlocks; i3++) {
-          i4 = ((i3 - 1) << 8) - 1;
-          for (nNaNs = 0; nNaNs < 6; nNaNs++) {
-            n = 1 << (nNaNs + 2);
-            bLen2 = n << 1;
-            nPairs = 256 >> (nNaNs + 3);
-            for (k = 1; k <= nPairs; k++) {
-              b_m = i4 + (k - 1) * bLen2;
-              for (ib = 1; ib <= bLen2; ib++) {
-                b_iwork[ib - 1] = idx->data[b_m + ib];
-                b_xwork[ib - 1] = b_x->data[b_m + ib];
-              }
-
-              wOffset = 0;
-              ib = n;
-              do {
-                exitg1 = 0;
-                b_m++;
-                if (b_xwork[wOffset] <= b_xwork[ib]) {
-                  idx->data[b_m] = b_iwork[wOffset];
-                  b_x->data[b_m] = b_xwork[wOffset];
-                  if (wOffset + 1 < n) {
-                    wOffset++;
-                  } else {
-                    exitg1 = 1;
-                  }
-                } else {
-                  idx->data[b_m] = b_iwork[ib];
-                  b_x->data[b_m] = b_xwork[ib];
-                  if (ib + 1 < bLen2) {
-                    ib++;
-                  } else {
-                    ib = b_m - wOffset;
-                    while (wOffset + 1 <= n) {
-                      idx->data[(ib + wOffset) + 1] = b_iwork[wOffset];
-                      b_x->data[(ib + wOffset) + 1] = b_xwork[wOffset];
-                      wOffset++;
-                    }
-
-                    exitg1 = 1;
-                  }
-                }
-              } while (exitg1 == 0);
-            }
-          }
-        }
-
-        b_m = nBlocks << 8;
-        ib = nNonNaN - b_m;
-        if (ib > 0) {
-          merge_block(idx, b_x, b_m, ib, 2, iwork, xwork);
-        }
-
-        b_m = 8;
-      }
-    }
-
-    merge_block(idx, b_x, 0, nNonNaN, b_m, iwork, xwork);
-  }
-
-  emxFree_real32_T(&xwork);
-  emxFree_int32_T(&iwork);
-  wOffset = x->size[0];
-  x->size[0] = b_x->size[0];
-  emxEnsureCapacity((emxArray__common *)x, wOffset, (int)sizeof(float));
-  b_m = b_x->size[0];
-  for (wOffset = 0; wOffset < b_m; wOffset++) {
-    x->data[wOffset] = b_x->data[wOffset];
-  }
-
-  emxFree_real32_T(&b_x);
-}
-
 //
 // Arguments    : const float A[36]
 //                float U[6]
@@ -17406,7 +14733,9 @@ static void svd(const float A[36], float U[6])
 // the calibration cameraparams
 //    Undistort a point or set of points from one camera. Depending on the
 //    camera model used to calibrate the camera, the appropriate undistortion
-//    is applied
+//    is applied. The model is dispatched once for all points, the per point
+//    math is the camera_model instantiation of that model. If a lookup
+//    table built for this calibration is registered, it replaces the model.
 // Arguments    : const float pt_d_data[]
 //                const int pt_d_size[1]
 //                int cameraparams_ATAN
@@ -17414,6 +14743,7 @@ static void svd(const float A[36], float U[6])
 //                const float cameraparams_PrincipalPoint[2]
 //                const float cameraparams_RadialDistortion[3]
 //                int cameraparams_DistortionModel
+//                const UndistortionMap *undistortion_map
 //                float pt_u_data[]
 //                int pt_u_size[1]
 // Return Type  : void
@@ -17421,337 +14751,55 @@ static void svd(const float A[36], float U[6])
 static void undistortPoint(const float pt_d_data[], const int pt_d_size[1], int
   cameraparams_ATAN, const float cameraparams_FocalLength[2], const float
   cameraparams_PrincipalPoint[2], const float cameraparams_RadialDistortion[3],
-  int cameraparams_DistortionModel, float pt_u_data[], int pt_u_size[1])
+  int cameraparams_DistortionModel, const UndistortionMap *undistortion_map,
+  float pt_u_data[], int pt_u_size[1])
 {
-  int rankR;
-  int i9;
-  float fx;
-  float fy;
-  float Cx;
-  float Cy;
-  float c;
-  int i;
-  float pt_d_n[2];
-  float x;
-  float b_x[3];
-  float c_x[3];
-  float A[3];
-  float xnorm;
-  float atmp;
-  float tau;
-  int knt;
-  float r_u;
-  int b_i;
-  float k1;
-  float k2;
-  float k3;
-  float r_d_sq;
-  float r_u_sq;
-  int c_i;
-  boolean_T exitg1;
-  float diff;
-  char cv6[48];
+  camera_model::UndistortionReport<float> report;
   static const char cv7[48] = { 'P', 'i', 'x', 'e', 'l', ' ', 'r', 'a', 'd', 'i',
     'u', 's', ' ', 'i', 'n', 'v', 'e', 'r', 's', 'i', 'o', 'n', ':', ' ', 'R',
     'e', 'a', 'c', 'h', 'e', 'd', ' ', 'i', 't', 'e', 'r', 'a', 't', 'i', 'o',
     'n', ' ', 'l', 'i', 'm', 'i', 't', '\x00' };
 
-  char cv8[52];
   static const char cv9[52] = { 'n', 'e', 'g', 'a', 't', 'i', 'v', 'e', ' ', 'u',
     'n', 'd', 'i', 's', 't', 'o', 'r', 't', 'e', 'd', ' ', 'r', 'a', 'd', 'i',
     'u', 's', '.', ' ', 'r', 'd', '_', 's', 'q', ' ', '=', ' ', '%', 'f', ',',
     ' ', 'r', 'u', '_', 's', 'q', ' ', '=', ' ', '%', 'f', '\x00' };
 
-  float coeff;
+  pt_u_size[0] = pt_d_size[0];
 
-  // 'undistortPoint:8' if cameraparams.DistortionModel == cameraparams.ATAN
-  if (cameraparams_DistortionModel == cameraparams_ATAN) {
+  if ((undistortion_map != NULL) && undistortion_map->matches
+      (cameraparams_FocalLength, cameraparams_PrincipalPoint,
+       cameraparams_RadialDistortion, cameraparams_DistortionModel)) {
+    undistortion_map->undistortPoints(pt_d_data, pt_d_size[0] / 2, pt_u_data,
+      report);
+  } else if (cameraparams_DistortionModel == cameraparams_ATAN) {
+    // 'undistortPoint:8' if cameraparams.DistortionModel == cameraparams.ATAN
     // 'undistortPoint:9' pt_u = undistortPointAtan(pt_d, cameraparams);
-    // % Atan
-    // 'undistortPoint:20' if mod(length(pt_d), 2)
-    // 'undistortPoint:24' pt_u = pt_d;
-    pt_u_size[0] = pt_d_size[0];
-    rankR = pt_d_size[0];
-    for (i9 = 0; i9 < rankR; i9++) {
-      pt_u_data[i9] = pt_d_data[i9];
-    }
-
-    // 'undistortPoint:26' fx = cameraparams.FocalLength(1);
-    fx = cameraparams_FocalLength[0];
-
-    // 'undistortPoint:27' fy = cameraparams.FocalLength(2);
-    fy = cameraparams_FocalLength[1];
-
-    // 'undistortPoint:28' Cx = cameraparams.PrincipalPoint(1);
-    Cx = cameraparams_PrincipalPoint[0];
-
-    // 'undistortPoint:29' Cy = cameraparams.PrincipalPoint(2);
-    Cy = cameraparams_PrincipalPoint[1];
-
-    // 'undistortPoint:30' w  = cameraparams.RadialDistortion;
-    // 'undistortPoint:32' for i = 1:length(pt_d)/2
-    c = (float)pt_d_size[0] / 2.0F;
-    for (i = 0; i < (int)c; i++) {
-      // 'undistortPoint:34' pt_d_n = [(pt_d((i-1)*2 + 1)-Cx)/fx;
-      // 'undistortPoint:35'     (pt_d((i-1)*2 + 2)-Cy)/fy];
-      pt_d_n[0] = (pt_d_data[i << 1] - Cx) / fx;
-      pt_d_n[1] = (pt_d_data[(i << 1) + 1] - Cy) / fy;
-
-      // 'undistortPoint:37' r_d = sqrt(pt_d_n(1)^2 + pt_d_n(2)^2);
-      x = sqrtf(pt_d_n[0] * pt_d_n[0] + pt_d_n[1] * pt_d_n[1]);
-
-      // 'undistortPoint:39' if r_d > 0.001
-      if (x > 0.001F) {
-        // 'undistortPoint:40' r_u = tan(r_d * w)/(2*tan(w/2));
-        for (rankR = 0; rankR < 3; rankR++) {
-          xnorm = 2.0F * tanf(cameraparams_RadialDistortion[rankR] / 2.0F);
-          A[rankR] = xnorm;
-          b_x[rankR] = tanf(x * cameraparams_RadialDistortion[rankR]);
-          c_x[rankR] = xnorm;
-        }
-
-        atmp = c_x[0];
-        tau = 0.0F;
-        xnorm = xnrm2(c_x);
-        if (xnorm != 0.0F) {
-          xnorm = hypotf(c_x[0], xnorm);
-          if (c_x[0] >= 0.0F) {
-            xnorm = -xnorm;
-          }
-
-          if (fabsf(xnorm) < 9.86076132E-32F) {
-            knt = 0;
-            do {
-              knt++;
-              for (rankR = 0; rankR < 2; rankR++) {
-                A[rankR + 1] *= 1.01412048E+31F;
-              }
-
-              xnorm *= 1.01412048E+31F;
-              atmp *= 1.01412048E+31F;
-            } while (!(fabsf(xnorm) >= 9.86076132E-32F));
-
-            xnorm = hypotf(atmp, xnrm2(A));
-            if (atmp >= 0.0F) {
-              xnorm = -xnorm;
-            }
-
-            tau = (xnorm - atmp) / xnorm;
-            atmp = 1.0F / (atmp - xnorm);
-            for (rankR = 0; rankR < 2; rankR++) {
-              A[rankR + 1] *= atmp;
-            }
-
-            for (rankR = 1; rankR <= knt; rankR++) {
-              xnorm *= 9.86076132E-32F;
-            }
-
-            atmp = xnorm;
-          } else {
-            tau = (xnorm - c_x[0]) / xnorm;
-            atmp = 1.0F / (c_x[0] - xnorm);
-            for (rankR = 0; rankR < 2; rankR++) {
-              A[rankR + 1] *= atmp;
-            }
-
-            atmp = xnorm;
-          }
-        }
-
-        A[0] = atmp;
-        rankR = 0;
-        xnorm = 3.0F * fabsf(atmp) * 1.1920929E-7F;
-        while ((rankR < 1) && (fabsf(atmp) >= xnorm)) {
-          rankR = 1;
-        }
-
-        r_u = 0.0F;
-        for (i9 = 0; i9 < 3; i9++) {
-          c_x[i9] = b_x[i9];
-        }
-
-        if (tau != 0.0F) {
-          xnorm = b_x[0];
-          for (b_i = 0; b_i < 2; b_i++) {
-            xnorm += A[b_i + 1] * b_x[b_i + 1];
-          }
-
-          xnorm *= tau;
-          if (xnorm != 0.0F) {
-            c_x[0] = b_x[0] - xnorm;
-            for (b_i = 0; b_i < 2; b_i++) {
-              c_x[b_i + 1] -= A[b_i + 1] * xnorm;
-            }
-          }
-        }
-
-        b_i = 1;
-        while (b_i <= rankR) {
-          r_u = c_x[0];
-          b_i = 2;
-        }
-
-        while (rankR > 0) {
-          r_u /= atmp;
-          rankR = 0;
-        }
-
-        // 'undistortPoint:42' pt_u_n = pt_d_n*r_u/r_d;
-        for (i9 = 0; i9 < 2; i9++) {
-          pt_d_n[i9] = pt_d_n[i9] * r_u / x;
-        }
-
-        // 'undistortPoint:43' pt_u((i-1)*2 + (1:2)) = [pt_u_n(1)*fx + Cx; pt_u_n(2)*fy + Cy]; 
-        rankR = (i << 1) - 1;
-        pt_u_data[rankR + 1] = pt_d_n[0] * fx + Cx;
-        pt_u_data[rankR + 2] = pt_d_n[1] * fy + Cy;
-      } else {
-        // 'undistortPoint:45' else
-        // 'undistortPoint:46' pt_u((i-1)*2 + (1:2)) = pt_d((i-1)*2 + (1:2));
-        rankR = (i << 1) - 1;
-        knt = (i << 1) - 1;
-        for (i9 = 0; i9 < 2; i9++) {
-          pt_u_data[(i9 + rankR) + 1] = pt_d_data[(i9 + knt) + 1];
-        }
-      }
-    }
+    camera_model::undistortPoints(camera_model::Atan<float>
+      (cameraparams_FocalLength, cameraparams_PrincipalPoint,
+       cameraparams_RadialDistortion), pt_d_data, pt_d_size[0] / 2, pt_u_data,
+      report);
   } else {
     // 'undistortPoint:10' else
     // 'undistortPoint:11' pt_u = undistortPointPB(pt_d, cameraparams);
-    // % Plumb Bob
-    // 'undistortPoint:58' if mod(length(pt_d), 2)
-    // 'undistortPoint:62' pt_u = pt_d;
-    pt_u_size[0] = pt_d_size[0];
-    rankR = pt_d_size[0];
-    for (i9 = 0; i9 < rankR; i9++) {
-      pt_u_data[i9] = pt_d_data[i9];
-    }
-
-    // 'undistortPoint:64' fx = cameraParameters.FocalLength(1);
-    fx = cameraparams_FocalLength[0];
-
-    // 'undistortPoint:65' fy = cameraParameters.FocalLength(2);
-    fy = cameraparams_FocalLength[1];
-
-    // 'undistortPoint:66' Cx = cameraParameters.PrincipalPoint(1);
-    Cx = cameraparams_PrincipalPoint[0];
-
-    // 'undistortPoint:67' Cy = cameraParameters.PrincipalPoint(2);
-    Cy = cameraparams_PrincipalPoint[1];
-
-    // 'undistortPoint:68' k1 = cameraParameters.RadialDistortion(1);
-    k1 = cameraparams_RadialDistortion[0];
-
-    // 'undistortPoint:69' k2 = cameraParameters.RadialDistortion(2);
-    k2 = cameraparams_RadialDistortion[1];
-
-    // 'undistortPoint:70' k3 = cameraParameters.RadialDistortion(3);
-    k3 = cameraparams_RadialDistortion[2];
-
-    // 'undistortPoint:72' for i = 1:length(pt_d)/2
-    c = (float)pt_d_size[0] / 2.0F;
-    for (i = 0; i < (int)c; i++) {
-      // 'undistortPoint:74' pt_d_n = [(pt_d((i-1)*2 + 1)-Cx)/fx;
-      // 'undistortPoint:75'     (pt_d((i-1)*2 + 2)-Cy)/fy];
-      pt_d_n[0] = (pt_d_data[i << 1] - Cx) / fx;
-      pt_d_n[1] = (pt_d_data[(i << 1) + 1] - Cy) / fy;
-
-      // 'undistortPoint:77' r_d_sq = pt_d_n(1)^2 + pt_d_n(2)^2;
-      r_d_sq = pt_d_n[0] * pt_d_n[0] + pt_d_n[1] * pt_d_n[1];
-
-      // 'undistortPoint:78' r_u_sq = get_r_u(k1, k2, k3, r_d_sq);
-      // get_r_u Get undistorted radius from distorted radius
-      //    Get the pixel radius of the undistorted pixels from a distorted pixel 
-      //    radius and distortion parameters
-      // 'get_r_u:5' x = rd_sq;
-      r_u_sq = r_d_sq;
-
-      // 'get_r_u:6' thresh = 1e-6;
-      // 'get_r_u:8' for i = 1:100
-      b_i = 1;
-      c_i = 0;
-      exitg1 = false;
-      while ((!exitg1) && (c_i < 100)) {
-        b_i = c_i + 1;
-
-        // 'get_r_u:9' f_x = x * (1 + k1*x + k2*x^2 + k3*x^3)^2 - rd_sq;
-        xnorm = ((1.0F + k1 * r_u_sq) + k2 * (r_u_sq * r_u_sq)) + k3 * powf
-          (r_u_sq, 3.0F);
-
-        // 'get_r_u:10' f_prime_x = (1 + k1*x + k2*x^2 + k3*x^3)^2 + 2*x*(1 + k1*x + k2*x^2 + k3*x^3)^2*(k1 + 2*k2*x + 2*k3*x^2); 
-        atmp = ((1.0F + k1 * r_u_sq) + k2 * (r_u_sq * r_u_sq)) + k3 * powf
-          (r_u_sq, 3.0F);
-        tau = ((1.0F + k1 * r_u_sq) + k2 * (r_u_sq * r_u_sq)) + k3 * powf(r_u_sq,
-          3.0F);
-
-        // 'get_r_u:13' diff = f_x / f_prime_x;
-        diff = (r_u_sq * (xnorm * xnorm) - r_d_sq) / (atmp * atmp + 2.0F *
-          r_u_sq * (tau * tau) * ((k1 + 2.0F * k2 * r_u_sq) + 2.0F * k3 *
-          (r_u_sq * r_u_sq)));
-
-        // 'get_r_u:14' x = x - diff;
-        r_u_sq -= diff;
-
-        // 'get_r_u:15' if diff < thresh && diff > -thresh
-        if ((diff < 1.0E-6F) && (diff > -1.0E-6F)) {
-          exitg1 = true;
-        } else {
-          c_i++;
-        }
-      }
-
-      // 'get_r_u:20' if i == 100
-      if ((b_i == 100) && (debug_level >= 2.0F)) {
-        // 'get_r_u:21' log_warn('Pixel radius inversion: Reached iteration limit') 
-        // log_warn Print to console in Matlab
-        //  in C++, vio_logging.h needs to be created to define what LOG_WARN does, 
-        //  e.g. redefine ROS_WARN
-        //  debug_level == 0: print errors, == 1: print warnings, == 2: print info 
-        // 'log_warn:8' if coder.target('MATLAB')
-        // 'log_warn:12' elseif ~coder.target('MEX')
-        // 'log_warn:13' coder.cinclude('<vio_logging.h>')
-        // 'log_warn:14' if debug_level >= 2
-        // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-        for (i9 = 0; i9 < 48; i9++) {
-          cv6[i9] = cv7[i9];
-        }
-
-        LOG_WARN(cv6);
-      }
-
-      // 'get_r_u:24' if x < 0
-      if ((r_u_sq < 0.0F) && (debug_level >= 2.0F)) {
-        // 'get_r_u:25' log_warn('negative undistorted radius. rd_sq = %f, ru_sq = %f', rd_sq, x); 
-        // log_warn Print to console in Matlab
-        //  in C++, vio_logging.h needs to be created to define what LOG_WARN does, 
-        //  e.g. redefine ROS_WARN
-        //  debug_level == 0: print errors, == 1: print warnings, == 2: print info 
-        // 'log_warn:8' if coder.target('MATLAB')
-        // 'log_warn:12' elseif ~coder.target('MEX')
-        // 'log_warn:13' coder.cinclude('<vio_logging.h>')
-        // 'log_warn:14' if debug_level >= 2
-        // 'log_warn:15' coder.ceval('LOG_WARN', [str, 0], varargin{:});
-        for (i9 = 0; i9 < 52; i9++) {
-          cv8[i9] = cv9[i9];
-        }
+    camera_model::undistortPoints(camera_model::PlumbBob<float>
+      (cameraparams_FocalLength, cameraparams_PrincipalPoint,
+       cameraparams_RadialDistortion), pt_d_data, pt_d_size[0] / 2, pt_u_data,
+      report);
+  }
 
-        LOG_WARN(cv8, r_d_sq, r_u_sq);
-      }
+  // 'get_r_u:20' if i == 100
+  if ((report.iteration_limit > 0) && (debug_level >= 2.0F)) {
+    // 'get_r_u:21' log_warn('Pixel radius inversion: Reached iteration limit') 
 
-      // 'undistortPoint:80' coeff = (1 + k1*r_u_sq + k2*r_u_sq^2 + k3*r_u_sq^3); 
-      coeff = ((1.0F + k1 * r_u_sq) + k2 * (r_u_sq * r_u_sq)) + k3 * powf(r_u_sq,
-        3.0F);
+    LOG_WARN(cv7);
+  }
 
-      // 'undistortPoint:82' pt_u_n = pt_d_n / coeff;
-      for (i9 = 0; i9 < 2; i9++) {
-        pt_d_n[i9] /= coeff;
-      }
+  // 'get_r_u:24' if x < 0
+  if ((report.negative_radius > 0) && (debug_level >= 2.0F)) {
+    // 'get_r_u:25' log_warn('negative undistorted radius. rd_sq = %f, ru_sq = %f', rd_sq, x); 
 
-      // 'undistortPoint:84' pt_u((i-1)*2 + (1:2)) = [pt_u_n(1)*fx + Cx; pt_u_n(2)*fy + Cy]; 
-      rankR = (i << 1) - 1;
-      pt_u_data[rankR + 1] = pt_d_n[0] * fx + Cx;
-      pt_u_data[rankR + 2] = pt_d_n[1] * fy + Cy;
-    }
+    LOG_WARN(cv9, report.rd_sq, report.ru_sq);
   }
 }
 
@@ -18226,34 +15274,6 @@ static void xgetrf(int b_m, int n, emxArray_real32_T *A, int lda,
   *info = b_info;
 }
 
-//
-// Arguments    : const float x[3]
-// Return Type  : float
-//
-static float xnrm2(const float x[3])
-{
-  float y;
-  float scale;
-  int k;
-  float absxk;
-  float t;
-  y = 0.0F;
-  scale = 1.17549435E-38F;
-  for (k = 0; k < 2; k++) {
-    absxk = fabsf(x[k + 1]);
-    if (absxk > scale) {
-      t = scale / absxk;
-      y = 1.0F + y * t * t;
-      scale = absxk;
-    } else {
-      t = absxk / scale;
-      y += t * t;
-    }
-  }
-
-  return scale * sqrtf(y);
-}
-
 //
 // Arguments    : float *a
 //                float *b
@@ -18340,6 +15360,7 @@ static void xscal(int n, float a, emxArray_real32_T *x, int ix0)
 //                const VIOParameters *b_VIOParameters
 //                boolean_T vision
 //                boolean_T reset
+//                int outputs
 //                RobotState *xt_out
 //                float map_out[144]
 //                AnchorPose anchor_poses_out[6]
@@ -18350,8 +15371,8 @@ void SLAM(int updateVect[48], const float z_all_l[96], const float z_all_r[96],
           float dt, const VIOMeasurements *measurements, const DUOParameters
           *cameraParameters, const NoiseParameters *noiseParameters, const
           VIOParameters *b_VIOParameters, boolean_T vision, boolean_T reset,
-          RobotState *xt_out, float map_out[144], AnchorPose anchor_poses_out[6],
-          float delayedStatus_out[48])
+          int outputs, RobotState *xt_out, float map_out[144], AnchorPose
+          anchor_poses_out[6], float delayedStatus_out[48])
 {
   int ixstart;
   float varargin_1[4];
@@ -18510,6 +15531,11 @@ void SLAM(int updateVect[48], const float z_all_l[96], const float z_all_r[96],
   // 'SLAM:22' assert ( all ( size (dt) == [1] ) )
   // 'SLAM:23' assert(isa(vision,'logical'));
   // 'SLAM:24' assert(isa(reset,'logical'));
+  //  the telemetry describes the last vision update
+  if (vision) {
+    memset(&telemetry, 0, sizeof(VIOTelemetry));
+  }
+
   // 'SLAM:28' if isempty(initialized) || reset
   if ((!initialized_not_empty) || reset) {
     // 'SLAM:29' initialized = [];
@@ -19639,45 +16665,55 @@ void SLAM(int updateVect[48], const float z_all_l[96], const float z_all_r[96],
                cameraParameters->r_lr, cameraParameters->R_lr,
                cameraParameters->R_rl, updateVect, b_z_all_l, b_z_all_r,
                noiseParameters->image_noise,
-               noiseParameters->inv_depth_initial_unc, *b_VIOParameters, map,
+               noiseParameters->inv_depth_initial_unc, *b_VIOParameters,
                delayedStatus);
     }
   }
 
-  // 'SLAM:109' map_out = map;
-  memcpy(&map_out[0], &map[0], 144U * sizeof(float));
+  //  only the requested outputs are computed, the others are left as they are
+  if ((outputs & SLAM_OUTPUT_ROBOT_STATE) != 0) {
+    // 'SLAM:110' xt_out = getWorldState(xt);
+    getWorldState(xt.robot_state.IMU.pos, xt.robot_state.IMU.att,
+                  xt.robot_state.IMU.gyro_bias, xt.robot_state.IMU.acc_bias,
+                  xt.robot_state.pos, xt.robot_state.att, xt.robot_state.vel,
+                  xt.origin.pos, xt.origin.att, t0_pos, varargin_1, t0_vel,
+                  t0_IMU_gyro_bias, t0_IMU_acc_bias, c, t0_IMU_att);
+    for (ixstart = 0; ixstart < 3; ixstart++) {
+      xt_out->pos[ixstart] = t0_pos[ixstart];
+    }
+
+    for (ixstart = 0; ixstart < 4; ixstart++) {
+      xt_out->att[ixstart] = varargin_1[ixstart];
+    }
 
-  // 'SLAM:110' xt_out = getWorldState(xt);
-  getWorldState(xt.robot_state.IMU.pos, xt.robot_state.IMU.att,
-                xt.robot_state.IMU.gyro_bias, xt.robot_state.IMU.acc_bias,
-                xt.robot_state.pos, xt.robot_state.att, xt.robot_state.vel,
-                xt.origin.pos, xt.origin.att, t0_pos, varargin_1, t0_vel,
-                t0_IMU_gyro_bias, t0_IMU_acc_bias, c, t0_IMU_att);
-  for (ixstart = 0; ixstart < 3; ixstart++) {
-    xt_out->pos[ixstart] = t0_pos[ixstart];
-  }
+    for (ixstart = 0; ixstart < 3; ixstart++) {
+      xt_out->vel[ixstart] = t0_vel[ixstart];
+      xt_out->IMU.gyro_bias[ixstart] = t0_IMU_gyro_bias[ixstart];
+      xt_out->IMU.acc_bias[ixstart] = t0_IMU_acc_bias[ixstart];
+      xt_out->IMU.pos[ixstart] = c[ixstart];
+    }
 
-  for (ixstart = 0; ixstart < 4; ixstart++) {
-    xt_out->att[ixstart] = varargin_1[ixstart];
+    for (ixstart = 0; ixstart < 4; ixstart++) {
+      xt_out->IMU.att[ixstart] = t0_IMU_att[ixstart];
+    }
   }
 
-  for (ixstart = 0; ixstart < 3; ixstart++) {
-    xt_out->vel[ixstart] = t0_vel[ixstart];
-    xt_out->IMU.gyro_bias[ixstart] = t0_IMU_gyro_bias[ixstart];
-    xt_out->IMU.acc_bias[ixstart] = t0_IMU_acc_bias[ixstart];
-    xt_out->IMU.pos[ixstart] = c[ixstart];
+  if ((outputs & SLAM_OUTPUT_MAP) != 0) {
+    // 'SLAM:109' map_out = map;
+    getMap(xt.origin.pos, xt.origin.att, xt.anchor_states, map);
+    memcpy(&map_out[0], &map[0], 144U * sizeof(float));
   }
 
-  for (ixstart = 0; ixstart < 4; ixstart++) {
-    xt_out->IMU.att[ixstart] = t0_IMU_att[ixstart];
+  if ((outputs & SLAM_OUTPUT_ANCHOR_POSES) != 0) {
+    // 'SLAM:111' anchor_poses_out = getAnchorPoses(xt);
+    getAnchorPoses(xt.origin.pos, xt.origin.att, xt.anchor_states, rv1);
+    cast(rv1, anchor_poses_out);
   }
 
-  // 'SLAM:111' anchor_poses_out = getAnchorPoses(xt);
-  getAnchorPoses(xt.origin.pos, xt.origin.att, xt.anchor_states, rv1);
-  cast(rv1, anchor_poses_out);
-
-  // 'SLAM:112' delayedStatus_out = delayedStatus;
-  memcpy(&delayedStatus_out[0], &delayedStatus[0], 48U * sizeof(float));
+  if ((outputs & SLAM_OUTPUT_DELAYED_STATUS) != 0) {
+    // 'SLAM:112' delayedStatus_out = delayedStatus;
+    memcpy(&delayedStatus_out[0], &delayedStatus[0], 48U * sizeof(float));
+  }
 
   //  output
   //  coder.cstructname(xt_out, 'RobotState');
@@ -19692,6 +16728,135 @@ void SLAM(int updateVect[48], const float z_all_l[96], const float z_all_r[96],
   // 'SLAM:126' assert ( all ( size (delayedStatus_out) == [numTrackFeatures 1] ) ) 
 }
 
+//
+// SLAM_setUndistortionMaps Register lookup tables that replace the
+// undistortion of the left and right camera. A map is only used while it
+// matches the calibration in the cameraParameters, NULL disables it.
+// Arguments    : const UndistortionMap *map_l
+//                const UndistortionMap *map_r
+// Return Type  : void
+//
+void SLAM_setUndistortionMaps(const UndistortionMap *map_l, const
+  UndistortionMap *map_r)
+{
+  undistortionMap_l = map_l;
+  undistortionMap_r = map_r;
+}
+
+//
+// Arguments    : unsigned char dst[]
+//                const void *src
+//                int n
+// Return Type  : int
+//
+static int copyStateSection(unsigned char dst[], const void *src, int n)
+{
+  int padded;
+
+  // sections are 8 byte aligned so the state can be used in place when mapped
+  padded = (n + 7) & ~7;
+  memcpy(&dst[0], src, (unsigned int)n);
+  memset(&dst[n], 0, (unsigned int)(padded - n));
+  return padded;
+}
+
+//
+// SLAM_anchorUncertainty Scalar uncertainty of the covariance block of an
+// anchor pose, the origin anchor is chosen as the anchor that minimizes it.
+// metric selects one of the VIOParameters::ANCHOR_METRIC measures, the
+// spectral norm is the default. The power iteration approximates it without
+// the SVD.
+// Arguments    : const float P_anchor[36]
+//                int metric
+// Return Type  : float
+//
+float SLAM_anchorUncertainty(const float P_anchor[36], int metric)
+{
+  float y;
+  switch (metric) {
+   case VIOParameters::ANCHOR_METRIC_TRACE:
+    y = small_matrix::trace<6>(P_anchor);
+    break;
+
+   case VIOParameters::ANCHOR_METRIC_FROBENIUS:
+    y = small_matrix::frobeniusNorm<6>(P_anchor);
+    break;
+
+   case VIOParameters::ANCHOR_METRIC_POWER:
+    y = small_matrix::spectralNormPower<6>(P_anchor, 8);
+    break;
+
+   default:
+    y = d_norm(P_anchor);
+    break;
+  }
+
+  return y;
+}
+
+//
+// SLAM_getStateSize Size in bytes of the persistent filter state written by
+// SLAM_getState: the initialization flag, xt, P, map and delayedStatus.
+// Arguments    : void
+// Return Type  : int
+//
+int SLAM_getStateSize()
+{
+  return (int)(8 + ((sizeof(xt) + 7) & ~7) + ((sizeof(P) + 7) & ~7) + ((sizeof
+    (map) + 7) & ~7) + ((sizeof(delayedStatus) + 7) & ~7));
+}
+
+//
+// SLAM_getTelemetry Copy the telemetry of the last vision update.
+// Arguments    : VIOTelemetry *telemetry_out
+// Return Type  : void
+//
+void SLAM_getTelemetry(VIOTelemetry *telemetry_out)
+{
+  *telemetry_out = telemetry;
+}
+
+//
+// SLAM_getState Copy the persistent filter state into state, which must hold
+// SLAM_getStateSize() bytes.
+// Arguments    : unsigned char state[]
+// Return Type  : void
+//
+void SLAM_getState(unsigned char state[])
+{
+  int offset;
+  memset(&state[0], 0, 8U);
+  state[0] = (unsigned char)initialized_not_empty;
+  offset = 8;
+  offset += copyStateSection(&state[offset], &xt, (int)sizeof(xt));
+  offset += copyStateSection(&state[offset], P, (int)sizeof(P));
+  offset += copyStateSection(&state[offset], map, (int)sizeof(map));
+  copyStateSection(&state[offset], delayedStatus, (int)sizeof(delayedStatus));
+}
+
+//
+// SLAM_setState Replace the persistent filter state with one written by
+// SLAM_getState of the same build.
+// Arguments    : const unsigned char state[]
+// Return Type  : void
+//
+void SLAM_setState(const unsigned char state[])
+{
+  int offset;
+  initialized_not_empty = (state[0] != 0);
+  initialized.size[0] = (int)initialized_not_empty;
+  initialized.size[1] = (int)initialized_not_empty;
+  initialized.data[0] = 1.0F;
+  offset = 8;
+  memcpy(&xt, &state[offset], sizeof(xt));
+  offset += (sizeof(xt) + 7) & ~7;
+  memcpy(P, &state[offset], sizeof(P));
+  offset += (sizeof(P) + 7) & ~7;
+  memcpy(map, &state[offset], sizeof(map));
+  offset += (sizeof(map) + 7) & ~7;
+  memcpy(delayedStatus, &state[offset], sizeof(delayedStatus));
+}
+
 //
 // Arguments    : void
 // Return Type  : void
@@ -58,15 +58,24 @@
 // Type Definitions
 #include <stdio.h>
 
+class UndistortionMap;
+
 // Function Declarations
 extern void SLAM(int updateVect[48], const float z_all_l[96], const float
                  z_all_r[96], float dt, const VIOMeasurements *measurements,
                  const DUOParameters *cameraParameters, const NoiseParameters
                  *noiseParameters, const VIOParameters *b_VIOParameters,
-                 boolean_T vision, boolean_T reset, RobotState *xt_out, float
-                 map_out[144], AnchorPose anchor_poses_out[6], float
-                 delayedStatus_out[48]);
+                 boolean_T vision, boolean_T reset, int outputs, RobotState
+                 *xt_out, float map_out[144], AnchorPose anchor_poses_out[6],
+                 float delayedStatus_out[48]);
+extern float SLAM_anchorUncertainty(const float P_anchor[36], int metric);
+extern void SLAM_getState(unsigned char state[]);
+extern int SLAM_getStateSize();
+extern void SLAM_getTelemetry(VIOTelemetry *telemetry_out);
 extern void SLAM_initialize();
+extern void SLAM_setUndistortionMaps(const UndistortionMap *map_l, const
+  UndistortionMap *map_r);
+extern void SLAM_setState(const unsigned char state[]);
 extern void SLAM_terminate();
 
 #endif
@@ -0,0 +1,23 @@
+#include <nodelet/nodelet.h>
+#include <pluginlib/class_list_macros.h>
+#include <boost/shared_ptr.hpp>
+
+#include "DuoVio.h"
+
+namespace duo_vio {
+
+class DuoVioNodelet : public nodelet::Nodelet
+{
+  boost::shared_ptr<DuoVio> duo_vio_;
+
+  virtual void onInit()
+  {
+    // the single threaded handle keeps the callbacks serialized like in the node.
+    // A bad calibration must not exit the process of the camera driver
+    duo_vio_.reset(new DuoVio(getPrivateNodeHandle(), false));
+  }
+};
+
+}  // namespace duo_vio
+
+PLUGINLIB_EXPORT_CLASS(duo_vio::DuoVioNodelet, nodelet::Nodelet)
@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2015-2016 AIT, ETH Zurich. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name AIT nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/*
+ * vio_logging.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "vio_logging.h"
+
+#include <string.h>
+#include <algorithm>
+
+namespace vio_logging {
+
+static const int LOG_POLL_USEC = 1000;
+
+Logger &Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() :
+                running_(false),
+                dropped_(0) {
+}
+
+Logger::~Logger() {
+    stop();
+}
+
+void Logger::start() {
+    if (running_)
+        return;
+    running_ = true;
+    thread_ = boost::thread(&Logger::run, this);
+}
+
+void Logger::stop() {
+    if (!running_)
+        return;
+    running_ = false;
+    thread_.join();
+    flush();
+}
+
+void Logger::run() {
+    while (running_) {
+        flush();
+        boost::this_thread::sleep(boost::posix_time::microseconds(LOG_POLL_USEC));
+    }
+}
+
+void Logger::flush() {
+    LogEvent event;
+    while (queue_.pop(event))
+        print(event);
+
+    int dropped = dropped_.exchange(0);
+    if (dropped)
+        ROS_WARN("Dropped %d log messages of the filter", dropped);
+}
+
+// Format the event one conversion at a time, with the argument cast to the
+// type of the conversion. The length modifier of the format is replaced: the
+// integers are stored as long and printed with an l, the floats as double.
+void Logger::print(const LogEvent &event) {
+    char msg[512];
+    char spec[32];
+    int len = 0;
+    int arg = 0;
+    const char *c = event.format;
+
+    while (*c && len < (int) sizeof(msg) - 1) {
+        if (*c != '%') {
+            msg[len++] = *c++;
+            continue;
+        }
+        if (c[1] == '%') {
+            msg[len++] = '%';
+            c += 2;
+            continue;
+        }
+
+        int spec_len = strcspn(c + 1, "diouxXcfFeEgGaA") + 2;
+        if (spec_len >= (int) sizeof(spec) - 1 || !c[spec_len - 1] || arg >= event.num_args)
+            break;
+        char conversion = c[spec_len - 1];
+        int n = 0;
+        for (const char *s = c; s < c + spec_len - 1; s++)
+            if (!strchr("hlLqjzt", *s))
+                spec[n++] = *s;
+        if (strchr("diouxX", conversion))
+            spec[n++] = 'l';
+        spec[n++] = conversion;
+        spec[n] = '\0';
+        c += spec_len;
+
+        long i = event.is_float[arg] ? (long) event.args[arg].f : event.args[arg].i;
+        if (strchr("di", conversion))
+            n = snprintf(msg + len, sizeof(msg) - len, spec, i);
+        else if (strchr("ouxX", conversion))
+            n = snprintf(msg + len, sizeof(msg) - len, spec, (unsigned long) i);
+        else if (conversion == 'c')
+            n = snprintf(msg + len, sizeof(msg) - len, spec, (int) i);
+        else
+            n = snprintf(msg + len, sizeof(msg) - len, spec, event.is_float[arg] ? event.args[arg].f : (double) event.args[arg].i);
+        arg++;
+        if (n > 0)
+            len = std::min(len + n, (int) sizeof(msg) - 1);
+    }
+    msg[len] = '\0';
+
+    switch (event.level) {
+    case INFO:
+        ROS_INFO("%s", msg);
+        break;
+    case WARN:
+        ROS_WARN("%s", msg);
+        break;
+    default:
+        ROS_ERROR("%s", msg);
+        break;
+    }
+}
+
+}  // namespace vio_logging